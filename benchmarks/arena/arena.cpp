@@ -0,0 +1,126 @@
+#include <biscuit/assembler.hpp>
+#include <biscuit/code_arena.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+
+using namespace biscuit;
+
+namespace {
+
+constexpr size_t blocks_per_thread = 32 * 1024;
+constexpr size_t max_block_size = 128;
+constexpr size_t blocks_per_publish = 64;
+constexpr int num_rounds = 5;
+
+// A small translated block: some arithmetic, guest state accesses and an exit.
+void EmitBlock(Assembler& as, size_t index) {
+    const auto imm = static_cast<int32_t>(index % 2048);
+    for (int i = 0; i < 4; i++) {
+        as.LD(a0, 8 * i, s1);
+        as.ADDI(a0, a0, imm);
+        as.XOR(a1, a1, a0);
+        as.SD(a1, 8 * i, s1);
+    }
+    as.JALR(ra, 0, t0);
+    as.RET();
+}
+
+// Runs `work` on `num_threads` threads at once and returns the best
+// rate of emitted bytes per second out of a few rounds.
+template <typename Setup, typename Work>
+double MeasureThreads(size_t num_threads, Setup&& setup, Work&& work) {
+    using Clock = std::chrono::steady_clock;
+
+    double best = 0.0;
+    for (int round = 0; round < num_rounds; round++) {
+        auto state = setup();
+        std::vector<size_t> emitted(num_threads);
+
+        const auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < num_threads; i++) {
+            threads.emplace_back([&, i] { emitted[i] = work(*state); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        size_t total = 0;
+        for (const auto bytes : emitted) {
+            total += bytes;
+        }
+        best = std::max(best, static_cast<double>(total) / elapsed.count());
+    }
+    return best;
+}
+
+// The approach CodeArena replaces: one assembler shared by all threads,
+// with a lock held for every block.
+struct SharedAssembler {
+    explicit SharedAssembler(size_t capacity) : as(capacity) {}
+
+    std::mutex mutex;
+    Assembler as;
+};
+
+size_t EmitShared(SharedAssembler& shared) {
+    size_t emitted = 0;
+    for (size_t i = 0; i < blocks_per_thread; i++) {
+        std::scoped_lock lock{shared.mutex};
+        const auto start = shared.as.GetCodeBuffer().GetCursorOffset();
+        EmitBlock(shared.as, i);
+        emitted += static_cast<size_t>(shared.as.GetCodeBuffer().GetCursorOffset() - start);
+    }
+    return emitted;
+}
+
+size_t EmitArena(CodeArena& arena) {
+    auto worker = arena.CreateWorker();
+    size_t emitted = 0;
+    for (size_t i = 0; i < blocks_per_thread; i++) {
+        auto* as = worker.Begin(max_block_size);
+        const auto start = as->GetCodeBuffer().GetCursorAddress();
+        EmitBlock(*as, i);
+        emitted += as->GetCodeBuffer().GetCursorAddress() - start;
+        (void)worker.End();
+
+        if ((i + 1) % blocks_per_publish == 0) {
+            worker.Publish();
+        }
+    }
+    worker.Publish();
+    return emitted;
+}
+
+} // Anonymous namespace
+
+int main() {
+    const auto max_threads = std::max(std::thread::hardware_concurrency(), 4U);
+
+    std::printf("Bytes emitted per second, %zu blocks per thread\n", blocks_per_thread);
+    for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        const auto capacity = num_threads * blocks_per_thread * max_block_size;
+
+        const auto shared_rate = MeasureThreads(
+            num_threads, [&] { return std::make_unique<SharedAssembler>(capacity); }, EmitShared);
+        const auto arena_rate = MeasureThreads(
+            num_threads, [&] { return std::make_unique<CodeArena>(capacity); }, EmitArena);
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "%zu thread(s), mutex around assembler", num_threads);
+        bench::PrintRate(name, shared_rate, "bytes");
+        std::snprintf(name, sizeof(name), "%zu thread(s), code arena", num_threads);
+        bench::PrintRate(name, arena_rate, "bytes");
+    }
+
+    return 0;
+}
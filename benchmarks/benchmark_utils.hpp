@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Small helpers shared between the benchmark programs.
+
+namespace biscuit::bench {
+
+/**
+ * Runs `func` repeatedly until at least `min_seconds` have elapsed and
+ * returns the rate of work items processed per second.
+ *
+ * @param items_per_call The number of work items a single call of `func` processes.
+ * @param min_seconds    The minimum amount of time to spend running `func`.
+ * @param func           The function to measure.
+ */
+template <typename Func>
+double MeasureRate(uint64_t items_per_call, double min_seconds, Func&& func) {
+    using Clock = std::chrono::steady_clock;
+
+    // Warm up any caches, pools or lazily initialized state.
+    func();
+
+    uint64_t calls = 0;
+    const auto start = Clock::now();
+    auto elapsed = std::chrono::duration<double>::zero();
+    do {
+        func();
+        calls++;
+        elapsed = Clock::now() - start;
+    } while (elapsed.count() < min_seconds);
+
+    return static_cast<double>(calls * items_per_call) / elapsed.count();
+}
+
+/// Prints a single named rate result in a consistent format.
+inline void PrintRate(const char* name, double rate, const char* unit) {
+    std::printf("%-48s %14.0f %s/s\n", name, rate, unit);
+}
+
+} // namespace biscuit::bench
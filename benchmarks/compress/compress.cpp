@@ -0,0 +1,161 @@
+#include <biscuit/assembler.hpp>
+
+#include <array>
+#include <cstdio>
+
+#include "benchmark_utils.hpp"
+
+using namespace biscuit;
+
+namespace {
+
+constexpr size_t buffer_size = 4 * 1024 * 1024;
+constexpr size_t num_blocks = 2048;
+
+// Registers a simple JIT register allocator would hand out, with the x8-x15
+// range that compressed instructions can address appearing most frequently.
+constexpr std::array<GPR, 12> allocatable = {
+    a0, a1, a2, a3, a4, a5, s0, s1, a0, a1, t0, t1,
+};
+
+// Minimal xorshift generator, so that every configuration emits the same code.
+struct Random {
+    uint32_t Next() noexcept {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<uint32_t>(state);
+    }
+
+    GPR Reg() noexcept {
+        return allocatable[Next() % allocatable.size()];
+    }
+
+    uint64_t state = 0x9E3779B97F4A7C15;
+};
+
+// Emits a block resembling the output of a simple binary translator: a stack frame,
+// guest state loads and stores relative to s1, arithmetic, narrow memory accesses,
+// extensions, a helper call and a conditional exit.
+void EmitBlock(Assembler& as, Random& rng) {
+    as.ADDI(sp, sp, -32);
+    as.SD(ra, 24, sp);
+    as.SD(s0, 16, sp);
+
+    for (int i = 0; i < 24; i++) {
+        const auto rd = rng.Reg();
+        const auto rs = rng.Reg();
+
+        switch (rng.Next() % 16) {
+        case 0:
+        case 1:
+            as.LD(rd, static_cast<int32_t>(rng.Next() % 32) * 8, s1);
+            break;
+        case 2:
+            as.SD(rd, static_cast<int32_t>(rng.Next() % 32) * 8, s1);
+            break;
+        case 3:
+            as.ADD(rd, rd, rs);
+            break;
+        case 4:
+            as.ADDI(rd, rd, static_cast<int32_t>(rng.Next() % 64) - 32);
+            break;
+        case 5:
+            as.MV(rd, rs);
+            break;
+        case 6:
+            as.SLLI(rd, rd, rng.Next() % 63 + 1);
+            break;
+        case 7:
+            as.SRLI(rd, rd, rng.Next() % 63 + 1);
+            break;
+        case 8:
+            as.AND(rd, rd, rs);
+            break;
+        case 9:
+            as.LBU(rd, static_cast<int32_t>(rng.Next() % 4), rs);
+            break;
+        case 10:
+            as.LHU(rd, static_cast<int32_t>(rng.Next() % 2) * 2, rs);
+            break;
+        case 11:
+            as.SB(rd, static_cast<int32_t>(rng.Next() % 4), rs);
+            break;
+        case 12:
+            as.ANDI(rd, rd, 0xFF);
+            break;
+        case 13:
+            as.ZEXTW(rd, rd);
+            break;
+        case 14:
+            as.MUL(rd, rd, rs);
+            break;
+        default:
+            as.NOT(rd, rd);
+            break;
+        }
+    }
+
+    as.JALR(ra, 0, t0);
+    as.BEQZ(a0, 8);
+    as.LD(ra, 24, sp);
+    as.LD(s0, 16, sp);
+    as.ADDI(sp, sp, 32);
+    as.RET();
+}
+
+size_t EmitAll(Assembler& as) {
+    Random rng;
+    as.RewindBuffer();
+    for (size_t i = 0; i < num_blocks; i++) {
+        EmitBlock(as, rng);
+    }
+    return static_cast<size_t>(as.GetCodeBuffer().GetCursorOffset());
+}
+
+struct Config {
+    const char* name;
+    Optimization optimizations;
+    Extension extensions;
+};
+
+void Configure(Assembler& as, const Config& config) {
+    as.DisableOptimization(Optimization::AutoCompress);
+    as.DisableExtension(Extension::Zca | Extension::Zcb | Extension::Zcd | Extension::Zcf);
+    as.EnableOptimization(config.optimizations);
+    as.EnableExtension(config.extensions);
+}
+
+} // Anonymous namespace
+
+int main() {
+    Assembler as(buffer_size);
+
+    const Config configs[] = {
+        {"uncompressed", Optimization::None, Extension::None},
+        {"autocompress, zca+zcd", Optimization::AutoCompress, Extension::Zca | Extension::Zcd},
+        {"autocompress, zca+zcd+zcb", Optimization::AutoCompress,
+         Extension::Zca | Extension::Zcd | Extension::Zcb},
+    };
+
+    std::printf("Code size for %zu translated blocks\n", num_blocks);
+    size_t baseline = 0;
+    for (const auto& config : configs) {
+        Configure(as, config);
+        const auto size = EmitAll(as);
+        if (baseline == 0) {
+            baseline = size;
+        }
+        std::printf("%-36s %9zu bytes  %6.1f%% smaller\n", config.name, size,
+                    100.0 * (1.0 - static_cast<double>(size) / static_cast<double>(baseline)));
+    }
+
+    std::printf("\nBlocks emitted per second\n");
+    for (const auto& config : configs) {
+        Configure(as, config);
+        const auto rate = bench::MeasureRate(num_blocks, 0.5, [&] { EmitAll(as); });
+        bench::PrintRate(config.name, rate, "blocks");
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <biscuit/assembler.hpp>
+#include <biscuit/decoder.hpp>
+
+#include <cstdio>
+#include <span>
+
+#include "benchmark_utils.hpp"
+
+using namespace biscuit;
+
+namespace {
+
+constexpr size_t buffer_size = 1024 * 1024;
+
+// Emits one round of the mix: compressed and base integer instructions,
+// loads and stores, branches, floating-point and vector instructions.
+void EmitMix(Assembler& as) {
+    as.C_ADDI(a0, 1);
+    as.C_LD(a1, 8, s0);
+    as.ADD(a0, a1, a2);
+    as.ADDI(a0, a0, 1);
+    as.SLLI(a1, a0, 3);
+    as.LD(a0, 16, sp);
+    as.SD(a0, 24, sp);
+    as.C_MV(a2, a0);
+    as.BNE(a0, a1, -64);
+    as.JAL(ra, 2048);
+    as.MUL(a0, a1, a2);
+    as.AMOADD_D(Ordering::AQRL, a0, a1, a2);
+    as.FADD_D(fa0, fa1, fa2, RMode::DYN);
+    as.FMADD_S(fa0, fa1, fa2, fa3);
+    as.FLD(fa0, 8, a0);
+    as.FCVT_D_L(fa0, a0);
+    as.VSETVLI(t0, a0, SEW::E32, LMUL::M1);
+    as.VADD(v1, v2, v3);
+    as.VADD(v1, v2, a0, VecMask::Yes);
+    as.VLE32(v4, a1);
+    as.VFMACC(v1, v2, v3);
+    as.VREDSUM(v1, v2, v3);
+    as.C_SW(a0, 4, s1);
+    as.C_J(-32);
+}
+
+} // Anonymous namespace
+
+int main() {
+    Assembler as(buffer_size);
+    while (as.GetCodeBuffer().GetRemainingBytes() >= 128) {
+        EmitMix(as);
+    }
+
+    const auto& buffer = as.GetCodeBuffer();
+    const std::span code{buffer.GetOffsetPointer(0), buffer.GetSizeInBytes()};
+    const Decoder decoder;
+
+    size_t num_instructions = 0;
+    for (auto remaining = code; !remaining.empty(); num_instructions++) {
+        remaining = remaining.subspan(decoder.Decode(remaining).length);
+    }
+
+    std::printf("Instructions decoded per second\n");
+
+    uint32_t checksum = 0;
+    const auto rate = bench::MeasureRate(num_instructions, 0.5, [&] {
+        for (auto remaining = code; !remaining.empty();) {
+            const auto insn = decoder.Decode(remaining);
+            checksum += static_cast<uint32_t>(insn.id) + insn.rd;
+            remaining = remaining.subspan(insn.length);
+        }
+    });
+    bench::PrintRate("mixed", rate, "instructions");
+
+    // Keeps the decoded results alive.
+    std::printf("(checksum %u over %zu instructions)\n", checksum, num_instructions);
+    return 0;
+}
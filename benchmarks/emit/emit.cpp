@@ -0,0 +1,85 @@
+#include <biscuit/assembler.hpp>
+#include <biscuit/reserved_emitter.hpp>
+
+#include <array>
+#include <cstdio>
+
+#include "benchmark_utils.hpp"
+
+using namespace biscuit;
+
+namespace {
+
+constexpr size_t buffer_size = 1024 * 1024;
+constexpr size_t num_instructions = buffer_size / sizeof(uint32_t);
+
+// A handful of pre-encoded instructions, standing in for a template
+// that a JIT copies into the buffer (ADD, ADDI, LD, SD, SLLI, XOR, BNE, JALR).
+constexpr std::array<uint32_t, 8> encoded = {
+    0x00C58533, 0x00150513, 0x0084B503, 0x00A4B423,
+    0x00351513, 0x00C54533, 0xFE051EE3, 0x000080E7,
+};
+
+} // Anonymous namespace
+
+int main() {
+    Assembler as(buffer_size);
+    auto& buffer = as.GetCodeBuffer();
+
+    std::printf("Instructions emitted per second\n");
+
+    const auto assembler_rate = bench::MeasureRate(num_instructions, 0.5, [&] {
+        as.RewindBuffer();
+        for (size_t i = 0; i < num_instructions; i += 4) {
+            as.ADD(a0, a1, a2);
+            as.ADDI(a0, a0, 1);
+            as.LD(a0, 8, s1);
+            as.SD(a0, 8, s1);
+        }
+    });
+    bench::PrintRate("assembler", assembler_rate, "instructions");
+
+    const auto reserved_rate = bench::MeasureRate(num_instructions, 0.5, [&] {
+        as.RewindBuffer();
+        ReservedEmitter reserved{as, num_instructions};
+        for (size_t i = 0; i < num_instructions; i += 4) {
+            reserved.ADD(a0, a1, a2);
+            reserved.ADDI(a0, a0, 1);
+            reserved.LD(a0, 8, s1);
+            reserved.SD(a0, 8, s1);
+        }
+    });
+    bench::PrintRate("assembler, reserved", reserved_rate, "instructions");
+
+    const auto reserved_block_rate = bench::MeasureRate(num_instructions, 0.5, [&] {
+        as.RewindBuffer();
+        for (size_t i = 0; i < num_instructions; i += 4) {
+            ReservedEmitter reserved{as, 4};
+            reserved.ADD(a0, a1, a2);
+            reserved.ADDI(a0, a0, 1);
+            reserved.LD(a0, 8, s1);
+            reserved.SD(a0, 8, s1);
+        }
+    });
+    bench::PrintRate("assembler, reserved per 4 instructions", reserved_block_rate, "instructions");
+
+    // Copying pre-encoded instructions bounds what emission can achieve.
+    const auto checked_rate = bench::MeasureRate(num_instructions, 0.5, [&] {
+        buffer.RewindCursor();
+        for (size_t i = 0; i < num_instructions; i++) {
+            buffer.Emit32(encoded[i % encoded.size()]);
+        }
+    });
+    bench::PrintRate("code buffer, pre-encoded", checked_rate, "instructions");
+
+    const auto copy_rate = bench::MeasureRate(num_instructions, 0.5, [&] {
+        buffer.RewindCursor();
+        auto reservation = buffer.Reserve(num_instructions * sizeof(uint32_t));
+        for (size_t i = 0; i < num_instructions; i++) {
+            reservation.Emit32(encoded[i % encoded.size()]);
+        }
+    });
+    bench::PrintRate("code buffer, pre-encoded and reserved", copy_rate, "instructions");
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <biscuit/code_buffer.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+using namespace biscuit;
+
+namespace {
+
+constexpr size_t buffer_size = 64 * 1024 * 1024;
+
+#ifdef __linux__
+struct PageUsage {
+    size_t rss_kb = 0;
+    size_t anon_huge_kb = 0;
+    size_t hugetlb_kb = 0;
+};
+
+long GetMinorFaults() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+// Sums up the page usage of every mapping in the given address range, as reported by the kernel.
+PageUsage GetPageUsage(uintptr_t begin, uintptr_t end) {
+    PageUsage usage;
+    auto* const file = std::fopen("/proc/self/smaps", "r");
+    if (file == nullptr) {
+        return usage;
+    }
+
+    char line[256];
+    bool in_range = false;
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        unsigned long map_begin = 0;
+        unsigned long map_end = 0;
+        if (std::sscanf(line, "%lx-%lx ", &map_begin, &map_end) == 2) {
+            in_range = map_begin < end && map_end > begin;
+            continue;
+        }
+        if (!in_range) {
+            continue;
+        }
+
+        size_t kb = 0;
+        if (std::sscanf(line, "Rss: %zu kB", &kb) == 1) {
+            usage.rss_kb += kb;
+        } else if (std::sscanf(line, "AnonHugePages: %zu kB", &kb) == 1) {
+            usage.anon_huge_kb += kb;
+        } else if (std::sscanf(line, "Private_Hugetlb: %zu kB", &kb) == 1) {
+            usage.hugetlb_kb += kb;
+        }
+    }
+
+    std::fclose(file);
+    return usage;
+}
+
+void Measure(const char* name, CodeBufferBacking backing) {
+    if (!CodeBuffer::IsBackingSupported(backing)) {
+        std::printf("%-12s unsupported on this host\n", name);
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    const auto faults_before = GetMinorFaults();
+    const auto start = Clock::now();
+
+    CodeBuffer buffer(buffer_size, backing, buffer_size);
+    {
+        auto reservation = buffer.Reserve(buffer_size);
+        for (size_t i = 0; i < buffer_size / sizeof(uint32_t); i++) {
+            reservation.Emit32(0x00000013);
+        }
+    }
+
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    const auto faults = GetMinorFaults() - faults_before;
+
+    const auto begin = buffer.GetOffsetAddress(0);
+    const auto usage = GetPageUsage(begin, begin + buffer_size);
+
+    std::printf("%-12s %9.1f ms %9ld faults %8zu KiB requested %8zu KiB rss %8zu KiB huge %8zu KiB hugetlb\n",
+                name, elapsed.count() * 1000.0, faults, buffer.GetRequestedPageSize() / 1024,
+                usage.rss_kb, usage.anon_huge_kb, usage.hugetlb_kb);
+}
+#endif
+
+} // Anonymous namespace
+
+int main() {
+#ifdef __linux__
+    std::printf("Filling a %zu MiB code buffer\n", buffer_size / (1024 * 1024));
+    Measure("default", CodeBufferBacking::Default);
+    Measure("reserved", CodeBufferBacking::Reserved);
+    Measure("huge pages", CodeBufferBacking::HugePages);
+#else
+    std::printf("Page fault and page usage statistics are only available on Linux\n");
+#endif
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <biscuit/assembler.hpp>
+#include <biscuit/basic_assembler.hpp>
+
+#include <cstdio>
+
+#include "benchmark_utils.hpp"
+
+// Built twice: once as inline_benchmark against the library as configured, and
+// once as inline_emitters_benchmark against a copy of the library built with
+// BISCUIT_INLINE_EMITTERS, so that the results of both can be compared directly.
+
+using namespace biscuit;
+
+namespace {
+
+constexpr size_t buffer_size = 1024 * 1024;
+constexpr size_t num_instructions = buffer_size / sizeof(uint32_t);
+
+#ifdef BISCUIT_INLINE_EMITTERS
+constexpr const char* emitters = "inline";
+#else
+constexpr const char* emitters = "out-of-line";
+#endif
+
+template <typename AssemblerType, typename Func>
+void Measure(AssemblerType& as, const char* name, Func&& func) {
+    const auto rate = bench::MeasureRate(num_instructions, 0.5, [&] {
+        as.RewindBuffer();
+        for (size_t i = 0; i < num_instructions; i += 4) {
+            func();
+        }
+    });
+    bench::PrintRate(name, rate, "instructions");
+}
+
+template <typename AssemblerType>
+void MeasureAll(AssemblerType& as) {
+    Measure(as, "arithmetic", [&] {
+        as.ADD(a0, a1, a2);
+        as.ADDI(a0, a0, 1);
+        as.SLLI(a1, a0, 3);
+        as.XOR(a2, a1, a3);
+    });
+
+    Measure(as, "loads and stores", [&] {
+        as.LD(a0, 8, s1);
+        as.SD(a0, 16, s1);
+        as.LW(a1, 24, s2);
+        as.SW(a1, 32, s2);
+    });
+
+    Measure(as, "branches", [&] {
+        as.BEQ(a0, a1, 64);
+        as.BNE(a0, a1, -64);
+        as.BLT(a2, a3, 128);
+        as.BGEU(a2, a3, -128);
+    });
+
+    Measure(as, "mixed", [&] {
+        as.LD(a0, 8, s1);
+        as.ADDI(a0, a0, 1);
+        as.SD(a0, 8, s1);
+        as.BNE(a0, a1, -12);
+    });
+}
+
+} // Anonymous namespace
+
+int main() {
+    Assembler as(buffer_size);
+    as.EnableOptimization(Optimization::AutoCompress);
+
+    std::printf("Instructions emitted per second, %s emitters\n", emitters);
+    MeasureAll(as);
+
+    std::printf("\nInstructions emitted per second, %s emitters, without compression\n", emitters);
+    as.DisableOptimization(Optimization::AutoCompress);
+    MeasureAll(as);
+
+    // BasicAssembler's emitters are always inline, with the configuration fixed at compile time.
+    BasicAssembler<Xlen::RV64, CompressPolicy<>> compressed(buffer_size);
+    std::printf("\nInstructions emitted per second, BasicAssembler<Xlen::RV64, CompressPolicy<>>\n");
+    MeasureAll(compressed);
+
+    BasicAssembler<Xlen::RV64, NoCompressPolicy> uncompressed(buffer_size);
+    std::printf("\nInstructions emitted per second, BasicAssembler<Xlen::RV64, NoCompressPolicy>\n");
+    MeasureAll(uncompressed);
+
+    return 0;
+}
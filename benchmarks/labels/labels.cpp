@@ -0,0 +1,104 @@
+#include <biscuit/assembler.hpp>
+
+#include <cstdio>
+
+#include "benchmark_utils.hpp"
+
+using namespace biscuit;
+
+namespace {
+
+constexpr size_t buffer_size = 1024 * 1024;
+constexpr uint64_t labels_per_call = 1024;
+
+// Links `num_branches` forward branches to each short-lived label,
+// binds it, and lets it go out of scope, like a translator handling
+// the control flow of a single guest block would.
+void LinkAndResolve(Assembler& as, uint32_t num_branches) {
+    as.RewindBuffer();
+
+    for (uint64_t i = 0; i < labels_per_call; i++) {
+        Label label;
+        for (uint32_t b = 0; b < num_branches; b++) {
+            as.BNE(x10, x11, &label);
+        }
+        as.ADD(x10, x10, x11);
+        as.Bind(&label);
+    }
+}
+
+// Binds each label first and then links backward branches to it.
+void LinkBound(Assembler& as, uint32_t num_branches) {
+    as.RewindBuffer();
+
+    for (uint64_t i = 0; i < labels_per_call; i++) {
+        Label label;
+        as.Bind(&label);
+        as.ADD(x10, x10, x11);
+        for (uint32_t b = 0; b < num_branches; b++) {
+            as.BNE(x10, x11, &label);
+        }
+    }
+}
+
+// Same as LinkAndResolve, but with labels from the assembler's label pool,
+// which are all released at once after the block is done.
+void LinkAndResolvePooled(Assembler& as, uint32_t num_branches) {
+    as.RewindBuffer();
+
+    for (uint64_t i = 0; i < labels_per_call; i++) {
+        const auto label = as.NewLabel();
+        for (uint32_t b = 0; b < num_branches; b++) {
+            as.BNE(x10, x11, label);
+        }
+        as.ADD(x10, x10, x11);
+        as.Bind(label);
+    }
+
+    as.ResetLabels();
+}
+
+// Same as LinkAndResolvePooled, but with all fixups applied at once by Finalize().
+void LinkAndResolveDeferred(Assembler& as, uint32_t num_branches) {
+    as.EnableOptimization(Optimization::DeferFixups);
+    LinkAndResolvePooled(as, num_branches);
+    as.Finalize();
+    as.DisableOptimization(Optimization::DeferFixups);
+}
+
+} // Anonymous namespace
+
+int main() {
+    Assembler as(buffer_size);
+
+    const struct {
+        const char* name;
+        uint32_t num_branches;
+        void (*func)(Assembler&, uint32_t);
+    } cases[] = {
+        {"forward, 1 branch per label", 1, LinkAndResolve},
+        {"forward, 3 branches per label", 3, LinkAndResolve},
+        {"forward, 16 branches per label", 16, LinkAndResolve},
+        {"forward, 64 branches per label", 64, LinkAndResolve},
+        {"backward, 1 branch per label", 1, LinkBound},
+        {"backward, 3 branches per label", 3, LinkBound},
+        {"pooled, forward, 1 branch per label", 1, LinkAndResolvePooled},
+        {"pooled, forward, 3 branches per label", 3, LinkAndResolvePooled},
+        {"pooled, forward, 16 branches per label", 16, LinkAndResolvePooled},
+        {"pooled, forward, 64 branches per label", 64, LinkAndResolvePooled},
+        {"deferred, forward, 1 branch per label", 1, LinkAndResolveDeferred},
+        {"deferred, forward, 3 branches per label", 3, LinkAndResolveDeferred},
+        {"deferred, forward, 16 branches per label", 16, LinkAndResolveDeferred},
+        {"deferred, forward, 64 branches per label", 64, LinkAndResolveDeferred},
+    };
+
+    std::printf("Labels linked and resolved per second\n");
+    for (const auto& c : cases) {
+        const auto rate = bench::MeasureRate(labels_per_call, 0.5, [&] {
+            c.func(as, c.num_branches);
+        });
+        bench::PrintRate(c.name, rate, "labels");
+    }
+
+    return 0;
+}
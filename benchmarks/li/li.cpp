@@ -0,0 +1,130 @@
+#include <biscuit/assembler.hpp>
+
+#include <array>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+
+using namespace biscuit;
+
+namespace {
+
+constexpr size_t buffer_size = 1024 * 1024;
+constexpr size_t num_random_constants = 4096;
+constexpr size_t max_sequence_length = 8;
+
+// Constants that commonly show up in JIT output: masks, sign bits,
+// floating-point bit patterns, hashing multipliers and host addresses.
+constexpr uint64_t real_world_constants[] = {
+    0x0000000000000001, 0x00000000000000FF, 0x000000000000FFFF, 0x00000000FFFFFFFF,
+    0xFFFFFFFF00000000, 0xFFFFFFFFFFFFF000, 0x7FFFFFFFFFFFFFFF, 0x8000000000000000,
+    0x0000000080000000, 0x00000000FFFFF800, 0xFFFF000000000000, 0x0000FFFFFFFFFFFF,
+    0x000FFFFFFFFFFFFF, 0x7FF0000000000000, 0xFFF0000000000000, 0x3FF0000000000000,
+    0xBFF0000000000000, 0x4000000000000000, 0x3FE0000000000000, 0x400921FB54442D18,
+    0x3F800000, 0x7F800000, 0x4F000000, 0x5F000000,
+    0x5555555555555555, 0x3333333333333333, 0x0F0F0F0F0F0F0F0F, 0x0101010101010101,
+    0x00FF00FF00FF00FF, 0x0000FFFF0000FFFF, 0xAAAAAAAAAAAAAAAA, 0x8080808080808080,
+    0x9E3779B97F4A7C15, 0xBF58476D1CE4E5B9, 0x94D049BB133111EB, 0xFF51AFD7ED558CCD,
+    0xC4CEB9FE1A85EC53, 0x100000001B3, 0xCBF29CE484222325, 0x61C8864680B583EB,
+    0x00007FFFF7A12340, 0x00007FFFF7FC1000, 0x0000555555554000, 0x0000555555558010,
+    0x0000003FC0001000, 0x0000004000000000, 0x0000002AAAB12000, 0x0000000010010000,
+    0x0000000000010000, 0x0000000000100000, 0x0000000001000000, 0x0000000100000000,
+    0x0000000000000800, 0xFFFFFFFFFFFFF800, 0x00000000000007FF, 0x0000000000012345,
+    0x0000000012345678, 0x123456789ABCDEF0, 0x8000000000000001, 0xF00000000000000F,
+};
+
+std::vector<uint64_t> MakeRandomConstants() {
+    std::vector<uint64_t> constants(num_random_constants);
+    uint64_t state = 0x853C49E6748FEA9B;
+    for (auto& constant : constants) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        constant = state;
+    }
+    return constants;
+}
+
+struct Config {
+    const char* name;
+    Extension extensions;
+    Optimization optimizations;
+    LICostModel cost_model;
+};
+
+void Configure(Assembler& as, const Config& config) {
+    as.RewindBuffer();
+    as.ResetLiteralPool();
+    as.DisableExtension(Extension::Zba | Extension::Zbb | Extension::Zbs);
+    as.EnableExtension(config.extensions);
+    as.DisableOptimization(Optimization::LIFromLiteralPool);
+    as.EnableOptimization(config.optimizations);
+    as.SetLICostModel(config.cost_model);
+}
+
+void MaterializeAll(Assembler& as, std::span<const uint64_t> constants) {
+    for (const auto constant : constants) {
+        as.LI(x10, constant);
+    }
+    as.EmitLiteralPool();
+}
+
+void PrintDistribution(Assembler& as, const Config& config, const char* corpus_name,
+                       std::span<const uint64_t> constants) {
+    Configure(as, config);
+
+    std::array<size_t, max_sequence_length + 1> histogram{};
+    size_t total = 0;
+    for (const auto constant : constants) {
+        const auto start = as.GetCodeBuffer().GetCursorOffset();
+        as.LI(x10, constant);
+        const auto length = static_cast<size_t>(as.GetCodeBuffer().GetCursorOffset() - start) / 4;
+        histogram[length]++;
+        total += length;
+    }
+    as.EmitLiteralPool();
+
+    std::printf("%-36s %-12s mean %.2f |", config.name, corpus_name,
+                static_cast<double>(total) / static_cast<double>(constants.size()));
+    for (size_t length = 1; length <= max_sequence_length; length++) {
+        std::printf(" %zu:%5.1f%%", length,
+                    100.0 * static_cast<double>(histogram[length]) / static_cast<double>(constants.size()));
+    }
+    std::printf("\n");
+}
+
+} // Anonymous namespace
+
+int main() {
+    Assembler as(buffer_size);
+    const auto random_constants = MakeRandomConstants();
+
+    const Config configs[] = {
+        {"base", Extension::None, Optimization::None, LICostModel::Size},
+        {"zba+zbb+zbs", Extension::Zba | Extension::Zbb | Extension::Zbs, Optimization::None,
+         LICostModel::Size},
+        {"zba+zbb+zbs, literal pool (size)", Extension::Zba | Extension::Zbb | Extension::Zbs,
+         Optimization::LIFromLiteralPool, LICostModel::Size},
+        {"zba+zbb+zbs, literal pool (latency)", Extension::Zba | Extension::Zbb | Extension::Zbs,
+         Optimization::LIFromLiteralPool, LICostModel::Latency},
+    };
+
+    std::printf("LI sequence lengths in instructions (pooled loads count as 2)\n");
+    for (const auto& config : configs) {
+        PrintDistribution(as, config, "random", random_constants);
+        PrintDistribution(as, config, "real-world", real_world_constants);
+    }
+
+    std::printf("\nConstants materialized per second (random corpus)\n");
+    for (const auto& config : configs) {
+        Configure(as, config);
+        const auto rate = bench::MeasureRate(random_constants.size(), 0.5, [&] {
+            as.RewindBuffer();
+            as.ResetLiteralPool();
+            MaterializeAll(as, random_constants);
+        });
+        bench::PrintRate(config.name, rate, "constants");
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <biscuit/assembler.hpp>
+#include <biscuit/stencil.hpp>
+
+#include <cstdio>
+
+#include "benchmark_utils.hpp"
+
+using namespace biscuit;
+
+namespace {
+
+constexpr size_t buffer_size = 1024 * 1024;
+constexpr size_t handler_size = 8 * sizeof(uint32_t);
+constexpr size_t num_handlers = buffer_size / handler_size;
+
+// A typical handler for a guest register-register ALU instruction: load both guest
+// registers from the context in s1, operate on them, store the result back,
+// bump the guest PC and bail out to the dispatcher once the cycle budget runs out.
+void EmitHandler(Assembler& as, int32_t src1, int32_t src2, int32_t dst, int64_t exit) {
+    as.LD(a0, src1, s1);
+    as.LD(a1, src2, s1);
+    as.ADD(a0, a0, a1);
+    as.SD(a0, dst, s1);
+    as.ADDI(s2, s2, 4);
+    as.ADDI(s3, s3, -1);
+    as.BLT(s3, x0, static_cast<int32_t>(exit - static_cast<int64_t>(as.GetCodeBuffer().GetCursorAddress())));
+    as.NOP();
+}
+
+Stencil BuildHandlerStencil() {
+    Assembler as{4096};
+    as.DisableOptimization(Optimization::AutoCompress);
+
+    StencilBuilder builder{as};
+    as.LD(a0, 0, s1);
+    builder.Hole("src1", StencilField::IImm);
+    as.LD(a1, 0, s1);
+    builder.Hole("src2", StencilField::IImm);
+    as.ADD(a0, a0, a1);
+    as.SD(a0, 0, s1);
+    builder.Hole("dst", StencilField::SImm);
+    as.ADDI(s2, s2, 4);
+    as.ADDI(s3, s3, -1);
+    as.BLT(s3, x0, 0);
+    builder.Hole("exit", StencilField::BTarget);
+    as.NOP();
+
+    return builder.Build();
+}
+
+} // Anonymous namespace
+
+int main() {
+    std::printf("Guest instruction handlers (8 instructions each) emitted per second\n");
+
+    // The exit is placed at the start of the buffer, and handlers are emitted
+    // within branch range of it, so each pass only covers the first 4KB.
+    constexpr size_t handlers_per_pass = 4096 / handler_size - 1;
+
+    for (const bool compress : {true, false}) {
+        Assembler as(buffer_size);
+        if (!compress) {
+            as.DisableOptimization(Optimization::AutoCompress);
+        }
+
+        const auto exit = static_cast<int64_t>(as.GetCodeBuffer().GetOffsetAddress(0));
+        const auto rate = bench::MeasureRate(num_handlers, 0.5, [&] {
+            for (size_t i = 0; i < num_handlers; i += handlers_per_pass) {
+                as.RewindBuffer();
+                as.NOP();
+                for (size_t j = 0; j < handlers_per_pass; j++) {
+                    const auto src1 = static_cast<int32_t>((j & 31) * 8);
+                    const auto src2 = static_cast<int32_t>(((j + 1) & 31) * 8);
+                    const auto dst = static_cast<int32_t>(((j + 2) & 31) * 8);
+                    EmitHandler(as, src1, src2, dst, exit);
+                }
+            }
+        });
+        bench::PrintRate(compress ? "assembler, auto-compress" : "assembler", rate, "handlers");
+    }
+
+    {
+        const Stencil stencil = BuildHandlerStencil();
+        CodeBuffer buffer{buffer_size};
+
+        const auto exit = static_cast<int64_t>(buffer.GetOffsetAddress(0));
+        const auto rate = bench::MeasureRate(num_handlers, 0.5, [&] {
+            for (size_t i = 0; i < num_handlers; i += handlers_per_pass) {
+                buffer.RewindCursor();
+                buffer.Emit32(0x00000013);
+                for (size_t j = 0; j < handlers_per_pass; j++) {
+                    const auto src1 = static_cast<int64_t>((j & 31) * 8);
+                    const auto src2 = static_cast<int64_t>(((j + 1) & 31) * 8);
+                    const auto dst = static_cast<int64_t>(((j + 2) & 31) * 8);
+                    stencil.Stamp(buffer, {src1, src2, dst, exit});
+                }
+            }
+        });
+        bench::PrintRate("stencil", rate, "handlers");
+    }
+
+    return 0;
+}
@@ -5,11 +5,18 @@
 #include <biscuit/enum_utils.hpp>
 #include <biscuit/isa.hpp>
 #include <biscuit/label.hpp>
+#include <biscuit/label_pool.hpp>
 #include <biscuit/literal.hpp>
+#include <biscuit/literal_pool.hpp>
 #include <biscuit/registers.hpp>
+#include <biscuit/relocation.hpp>
 #include <biscuit/vector.hpp>
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace biscuit {
 
@@ -43,11 +50,149 @@ enum class Optimization : uint32_t {
      * Automatically converts instructions to their compressed 2-byte form whenever possible.
      * For example, this optimization mode will convert a MV instruction to a C.MV instruction
      * as long as rd and rs are not the zero register.
+     *
+     * Which compressed instructions may be used is determined by the enabled compressed
+     * extensions (see Extension). Zca, Zcf and Zcd, which make up the C extension, are
+     * enabled by default, while the Zcb forms (e.g. C.LBU, C.ZEXT.B and C.MUL) are only
+     * used once Extension::Zcb is enabled.
      */
     AutoCompress = 1,
+
+    /**
+     * Lets branches and jumps to pooled labels (see NewLabel()) grow when their target
+     * ends up out of range, instead of asserting.
+     *
+     * While enabled, such branches are only recorded, and their final form is decided
+     * by Finalize() once all label locations are known:
+     *
+     * - Conditional branches stay a single branch (or C.BEQZ/C.BNEZ with AutoCompress)
+     *   when in range, become an inverted branch around a J when the target is within
+     *   the J-type range, and otherwise an inverted branch around AUIPC+JALR.
+     *
+     * - Jumps stay a single JAL (or C.J/C.JAL with AutoCompress) when in range,
+     *   and otherwise become AUIPC+JALR.
+     *
+     * AUIPC+JALR sequences for jumps that don't link (i.e. rd is x0) need a scratch
+     * register, which can be set with SetRelaxationScratch() and defaults to t1, the
+     * same register the standard `tail` pseudo-instruction uses.
+     *
+     * @note Finalize() moves the code following a relaxed branch. Label objects and
+     *       literals may not be used while relaxed branches are pending, and any
+     *       PC-relative offsets calculated manually by the user across them are
+     *       not adjusted.
+     */
+    RelaxBranches = 2,
+
+    /**
+     * Defers patching of label branches and literal loads until Finalize() is called,
+     * instead of patching them as soon as their label is bound or literal is placed.
+     *
+     * All fixups are collected into a single flat list, which Finalize() sorts by
+     * location and applies in one sequential pass over the code buffer. For blocks
+     * with many branches this avoids a random-access read-modify-write on every bind.
+     *
+     * @note Until Finalize() is called, the affected instructions still encode a zero offset.
+     */
+    DeferFixups = 4,
+
+    /**
+     * Lets LI() load a constant from the literal pool (see LoadConstant()) with AUIPC+LD
+     * instead, whenever the cost model considers that cheaper. See SetLICostModel().
+     *
+     * @note Since this makes LI() put constants into the literal pool, the same
+     *       restrictions as with LoadConstant() apply. This only applies to RV64.
+     *
+     * @note While branches are pending relaxation (see RelaxBranches), LI() always
+     *       emits an instruction sequence, since literals can't be loaded until
+     *       the pending branches have been resolved.
+     */
+    LIFromLiteralPool = 8,
+
+    /**
+     * Lets J and JAL to labels reach targets beyond the range of JAL through veneers,
+     * instead of asserting. Jumps that are in range stay a single instruction.
+     *
+     * Jumps to bound labels that are out of range, and jumps to unbound labels that could
+     * end up out of range, are recorded as pending. Pending jumps that need a veneer are
+     * redirected to an AUIPC+JALR veneer placed in an island:
+     *
+     * - Right after the next unconditional control transfer, for jumps whose target is
+     *   known to be out of range or that are at risk of falling out of range of the island.
+     *
+     * - Behind a jump around the island, if the next jump to a label or an explicit call
+     *   to EmitIslandIfNeeded() finds a pending jump at risk of falling out of range.
+     *
+     * - When Finalize() is called.
+     *
+     * Jumps to labels that are bound while still in range are patched as usual and
+     * never get a veneer. Since veneers are placed ahead of their jumps, jumps to
+     * unbound labels are always emitted uncompressed. Veneers clobber the scratch
+     * register set with SetRelaxationScratch(), which defaults to t1.
+     *
+     * @note Code that grows by more than the margin of EmitIslandIfNeeded() without
+     *       any jumps to labels or unconditional control transfers in between has to
+     *       call EmitIslandIfNeeded() in between to keep pending jumps in range.
+     *
+     * @note Jumps to pooled labels are relaxed instead while RelaxBranches is enabled.
+     */
+    JumpVeneers = 16,
 };
 BISCUIT_DEFINE_ENUM_FLAG_OPERATORS(Optimization);
 
+/**
+ * Optional ISA extensions that the assembler may make use of on its own accord, e.g. when
+ * selecting the instruction sequence for a pseudo-instruction like LI.
+ *
+ * These don't restrict which instructions may be emitted explicitly. Aside from the
+ * compressed extensions that make up the C extension (Zca, Zcf and Zcd), they're
+ * disabled by default, and can be enabled with EnableExtension once the target is
+ * known to support them:
+ *
+ * @code{.cpp}
+ *     as.EnableExtension(Extension::Zba | Extension::Zbb | Extension::Zbs);
+ * @endcode
+ */
+enum class Extension : uint32_t {
+    None = 0,
+
+    /// Address generation instructions (e.g. ADD.UW and SH1ADD).
+    Zba = 1U << 0,
+
+    /// Basic bit-manipulation instructions (e.g. RORI).
+    Zbb = 1U << 1,
+
+    /// Single-bit instructions (e.g. BSETI and BCLRI).
+    Zbs = 1U << 2,
+
+    /// Bit-manipulation instructions for cryptography (e.g. PACK).
+    Zbkb = 1U << 3,
+
+    /// Compressed integer instructions, i.e. the C extension without floating-point loads and stores.
+    Zca = 1U << 4,
+
+    /// Additional compressed instructions (e.g. C.LBU, C.ZEXT.B and C.MUL).
+    Zcb = 1U << 5,
+
+    /// Compressed double-precision loads and stores (e.g. C.FLD).
+    Zcd = 1U << 6,
+
+    /// Compressed single-precision loads and stores (e.g. C.FLW). Only exists for RV32.
+    Zcf = 1U << 7,
+};
+BISCUIT_DEFINE_ENUM_FLAG_OPERATORS(Extension);
+
+/**
+ * What LI() considers the cheapest way of materializing a 64-bit constant, when
+ * extensions are enabled (see Extension) or Optimization::LIFromLiteralPool is enabled.
+ */
+enum class LICostModel : uint32_t {
+    /// Prefers the fewest bytes, counting literal pool data that still needs to be placed.
+    Size,
+
+    /// Prefers the shortest dependency chain, treating loads as taking three cycles.
+    Latency,
+};
+
 /**
  * Defines the set of features that a particular assembler instance
  * would like to assemble for.
@@ -64,6 +209,30 @@ enum class ArchFeature : uint32_t {
     RV128, //< 128-bit RISC-V
 };
 
+// Helpers for siloing away particular comparisons for behavior.
+constexpr bool IsRV32(ArchFeature feature) {
+    return feature == ArchFeature::RV32;
+}
+constexpr bool IsRV64(ArchFeature feature) {
+    return feature == ArchFeature::RV64;
+}
+constexpr bool IsRV128(ArchFeature feature) {
+    return feature == ArchFeature::RV128;
+}
+constexpr bool IsRV32OrRV64(ArchFeature feature) {
+    return IsRV32(feature) || IsRV64(feature);
+}
+constexpr bool IsRV64OrRV128(ArchFeature feature) {
+    return IsRV64(feature) || IsRV128(feature);
+}
+
+namespace detail {
+struct BaseEmitters;
+} // namespace detail
+
+template <typename AssemblerType>
+class ReservedEmitter;
+
 /**
  * Code generator for RISC-V code.
  *
@@ -72,6 +241,12 @@ enum class ArchFeature : uint32_t {
  */
 class Assembler {
 public:
+    // The furthest a JAL can reach forward, and thus the furthest a veneer may be placed.
+    static constexpr ptrdiff_t max_jump_veneer_distance = 0x7FFFE;
+
+    // Default margin that EmitIslandIfNeeded() leaves for code emitted until the next check.
+    static constexpr ptrdiff_t default_island_margin = 4096;
+
     /**
      * Constructor
      *
@@ -101,6 +276,15 @@ public:
     [[nodiscard]] explicit Assembler(uint8_t* buffer, size_t capacity,
                                      ArchFeature features = ArchFeature::RV64);
 
+    /**
+     * Constructor
+     *
+     * @param buffer   The code buffer to assemble into.
+     * @param features Architectural features to make the assembler aware of.
+     */
+    [[nodiscard]] explicit Assembler(CodeBuffer&& buffer,
+                                     ArchFeature features = ArchFeature::RV64);
+
     // Copy constructor and assignment.
     Assembler(const Assembler&) = delete;
     Assembler& operator=(const Assembler&) = delete;
@@ -122,6 +306,11 @@ public:
         m_features = features;
     }
 
+    /// Retrieves the features that the assembler is assembling for.
+    [[nodiscard]] ArchFeature GetArchFeatures() const noexcept {
+        return m_features;
+    }
+
     /// Gets the underlying code buffer being managed by this assembler.
     CodeBuffer& GetCodeBuffer();
 
@@ -172,7 +361,7 @@ public:
     }
 
     /// Sets the cursor pointer for the underlying code buffer.
-    void SetCursorPointer(uint8_t* ptr) noexcept {
+    void SetCursorPointer(uint8_t* ptr) {
         m_buffer.SetCursorPointer(ptr);
     }
 
@@ -215,6 +404,101 @@ public:
         m_optimizations &= ~opt;
     }
 
+    /**
+     * Checks if an extension has been enabled.
+     *
+     * @param ext The extension(s) to check. If this contains multiple,
+     *            then this will only return true if all are enabled.
+     */
+    [[nodiscard]] bool IsExtensionEnabled(Extension ext) const noexcept {
+        return (m_extensions & ext) == ext;
+    }
+
+    /**
+     * Enables the use of an extension (or multiple) by the assembler itself.
+     *
+     * @param ext The extension(s) to enable.
+     */
+    void EnableExtension(Extension ext) noexcept {
+        m_extensions |= ext;
+    }
+
+    /**
+     * Disables the use of an extension (or multiple) by the assembler itself.
+     *
+     * @param ext The extension(s) to disable.
+     */
+    void DisableExtension(Extension ext) noexcept {
+        m_extensions &= ~ext;
+    }
+
+    /// Retrieves all extensions that are currently enabled.
+    [[nodiscard]] Extension GetEnabledExtensions() const noexcept {
+        return m_extensions;
+    }
+
+    /**
+     * Sets what LI() optimizes for when choosing between instruction sequences.
+     * Defaults to LICostModel::Size.
+     */
+    void SetLICostModel(LICostModel model) noexcept {
+        m_li_cost_model = model;
+    }
+
+    /**
+     * Sets the maximum distance, in bytes, that may lie between a jump and the veneer
+     * it's redirected to. Lowering this keeps veneers closer to their jumps.
+     * See Optimization::JumpVeneers.
+     *
+     * @param distance The distance, which defaults to the maximum reachable by JAL.
+     *                 Must be at least 64 bytes.
+     */
+    void SetJumpVeneerMaxDistance(ptrdiff_t distance) noexcept {
+        BISCUIT_ASSERT(distance >= 64 && distance <= max_jump_veneer_distance);
+        m_jump_veneer_max_distance = distance;
+    }
+
+    /**
+     * Emits an island behind a jump around it, if any pending jump to a label
+     * (see Optimization::JumpVeneers) or pending literal pool load
+     * (see LoadConstant()) would otherwise fall out of range once another
+     * `margin` bytes of code have been emitted.
+     *
+     * Calling this at regular safe points (e.g. the end of each basic block) keeps
+     * code of any size within range, while the islands themselves stay rare.
+     *
+     * @param margin The number of bytes that may be emitted before the next call.
+     *
+     * @returns Whether or not an island was emitted.
+     */
+    bool EmitIslandIfNeeded(ptrdiff_t margin = default_island_margin);
+
+    /**
+     * Sets the scratch register used by relaxed jumps that can't use their
+     * destination register for the target address, and by jump veneers.
+     * See Optimization::RelaxBranches and Optimization::JumpVeneers.
+     */
+    void SetRelaxationScratch(GPR scratch) noexcept {
+        BISCUIT_ASSERT(scratch != x0);
+        m_relaxation_scratch = scratch;
+    }
+
+    /**
+     * Finishes up any work that was deferred until all code has been emitted.
+     *
+     * This lays out all branches recorded while Optimization::RelaxBranches
+     * was enabled. Layout is iterated until every branch uses the smallest form
+     * that can reach its target. Afterwards, any fixups that were deferred with
+     * Optimization::DeferFixups are applied. Jumps still waiting on a veneer
+     * (see Optimization::JumpVeneers) get one at the end of the code.
+     *
+     * @pre All pooled labels referenced by relaxed branches must be bound.
+     *
+     * @note Relaxing branches may move code, so this must be called before
+     *       taking any pointers into the emitted code.
+     */
+    void Finalize();
+
     /**
      * Binds a label to the current offset within the code buffer
      *
@@ -222,6 +506,49 @@ public:
      */
     void Bind(Label* label);
 
+    /**
+     * Creates a new unbound label owned by this assembler's label pool.
+     *
+     * Pooled labels don't need to be destroyed individually. Instead all of
+     * them are released at once with ResetLabels().
+     */
+    [[nodiscard]] LabelHandle NewLabel() {
+        return m_label_pool.Create();
+    }
+
+    /**
+     * Binds a pooled label to the current offset within the code buffer
+     *
+     * @param label A valid label handle created by this assembler.
+     */
+    void Bind(LabelHandle label);
+
+    /**
+     * Retrieves the location of a pooled label.
+     *
+     * @note If the returned location is empty, then the label has not been
+     *       bound to a location yet.
+     */
+    [[nodiscard]] LabelPool::Location GetLabelLocation(LabelHandle label) const noexcept {
+        return m_label_pool.GetLocation(label);
+    }
+
+    /**
+     * Releases all pooled labels at once, invalidating all handles
+     * previously returned by NewLabel().
+     *
+     * @pre All pooled labels that have been referenced by instructions
+     *      must have been bound to a location.
+     */
+    void ResetLabels() noexcept {
+        BISCUIT_ASSERT(m_relaxation_sites.empty());
+        BISCUIT_ASSERT(std::none_of(m_pending_veneers.begin(), m_pending_veneers.end(),
+                                    [](const PendingVeneer& pending) {
+                                        return !pending.target && pending.label == nullptr;
+                                    }));
+        m_label_pool.Reset();
+    }
+
     /**
      * Places a literal at the current offset within the code buffer.
      *
@@ -232,6 +559,160 @@ public:
         PlaceAtOffset(literal, m_buffer.GetCursorOffset());
     }
 
+    /**
+     * Loads a 64-bit constant into a register with an AUIPC+LD sequence that
+     * refers to a constant in the assembler's literal pool.
+     *
+     * Constants are deduplicated, so loading the same value multiple times only places it
+     * in the code buffer once. Pending constants are placed as an 8-byte aligned pool island:
+     *
+     * - Right after the next unconditional control transfer (J, JR, RET, C.J, C.JR, and
+     *   any JAL/JALR with x0 as the destination register).
+     *
+     * - When EmitLiteralPool() or Finalize() is called.
+     *
+     * - Behind a jump around the island, if the next load of a constant would otherwise
+     *   leave the oldest pending load out of range (see SetLiteralPoolMaxDistance()).
+     *
+     * @param rd    The register to load the constant into.
+     * @param value The constant to load.
+     *
+     * @note Since islands follow unconditional jumps, code that relies on a sequence
+     *       of jumps being contiguous (e.g. jump tables) must not be emitted while
+     *       constants are pending. Call EmitLiteralPool() before emitting such code.
+     *
+     * @note With Optimization::RelaxBranches, pending constants are placed behind a jump
+     *       before the first relaxable branch, since code following such a branch may
+     *       still move. Constants can't be loaded while relaxable branches are pending,
+     *       i.e. until Finalize() is called.
+     *
+     * @note This is only available on RV64.
+     */
+    void LoadConstant(GPR rd, uint64_t value);
+
+    /**
+     * Loads a double-precision constant into a floating-point register with an AUIPC+FLD
+     * sequence that refers to a constant in the assembler's literal pool.
+     *
+     * This behaves the same way as the GPR variant of LoadConstant(), but
+     * avoids going through a GPR and FMV.D.X for the value itself.
+     *
+     * @param rd      The register to load the constant into.
+     * @param value   The constant to load.
+     * @param scratch A scratch register that AUIPC writes the constant's address to.
+     */
+    void LoadConstant(FPR rd, double value, GPR scratch);
+
+    /**
+     * Places all pending literal pool constants at the current location.
+     *
+     * @note No jump is emitted around the constants, so this should be done at a
+     *       location that isn't reached by falling through from preceding code.
+     */
+    void EmitLiteralPool();
+
+    /**
+     * Sets the maximum distance, in bytes, that may lie between a load from the literal pool
+     * and the constant it loads. Lowering this can keep constants closer to their users.
+     *
+     * @param distance The distance, which defaults to the maximum reachable by AUIPC+LD.
+     *                 Must be at least 64 bytes.
+     */
+    void SetLiteralPoolMaxDistance(ptrdiff_t distance) noexcept {
+        m_literal_pool.SetMaxDistance(distance);
+    }
+
+    /**
+     * Releases all constants in the literal pool, so that later loads
+     * of constants will no longer refer to previously placed ones.
+     *
+     * This must be used after rewinding the code buffer over placed constants.
+     *
+     * @pre No constants may be pending.
+     */
+    void ResetLiteralPool() noexcept {
+        m_literal_pool.Reset();
+    }
+
+    /**
+     * Loads the address of a symbol into a register with a fixed-length sequence of
+     * 8 instructions and records a RelocationKind::AbsoluteLI relocation for it.
+     *
+     * Unlike LI(GPR, uint64_t), the sequence is the same for every address, so it can be
+     * patched to refer to a different address later on (see ApplyRelocation()).
+     *
+     * @param rd     The register to load the address into. Must not be x0.
+     * @param symbol The symbol to load the address of.
+     *
+     * @note This is only available on RV64.
+     */
+    void LI(GPR rd, const SymbolReference& symbol);
+
+    /**
+     * Calls a symbol with an AUIPC+JALR sequence through x1 (ra), and records
+     * a RelocationKind::PCRelativePair relocation for it.
+     *
+     * Unlike CALL(int32_t), the call keeps referring to the same function when
+     * the code is moved with Relocate(), as long as the function stays within
+     * +/-2GB of the code. Calls to host functions, which may end up arbitrarily
+     * far away from relocated or cached code, should use CALL(const SymbolReference&, GPR)
+     * instead.
+     *
+     * @param symbol The symbol to call. Must be within +/-2GB of the cursor.
+     */
+    void CALL(const SymbolReference& symbol);
+
+    /**
+     * Calls a symbol at any address by loading its address into a scratch register
+     * with LI(GPR, const SymbolReference&) and calling it with a JALR through x1 (ra).
+     *
+     * The address is recorded as a RelocationKind::AbsoluteLI relocation, which can
+     * always be applied, so this is the way to call host functions from code that is
+     * moved with Relocate() or loaded from a code cache, e.g. with a symbol created
+     * by SymbolReference::Absolute().
+     *
+     * @param symbol  The symbol to call.
+     * @param scratch The register to load the address into. Must not be x0.
+     *
+     * @note This is only available on RV64.
+     */
+    void CALL(const SymbolReference& symbol, GPR scratch);
+
+    /**
+     * Jumps to a symbol with a JAL through x0, and records a RelocationKind::Jump
+     * relocation for it.
+     *
+     * @param symbol The symbol to jump to. Must be within range of JAL from the cursor.
+     */
+    void J(const SymbolReference& symbol);
+
+    /**
+     * Emits the 64-bit address of a symbol as data, e.g. as an entry of a jump table,
+     * and records a RelocationKind::Absolute64 relocation for it.
+     *
+     * @param symbol The symbol to emit the address of.
+     */
+    void EmitAddress(const SymbolReference& symbol);
+
+    /**
+     * Retrieves all relocations recorded so far, in the order they were emitted in.
+     *
+     * Offsets are relative to the start of the code buffer, and are kept up to date
+     * by branch relaxation (see RelaxBranches()).
+     */
+    [[nodiscard]] std::span<const Relocation> GetRelocations() const noexcept {
+        return m_relocations;
+    }
+
+    /**
+     * Discards all recorded relocations.
+     *
+     * This must be used after rewinding the code buffer over code that contains relocations.
+     */
+    void ClearRelocations() noexcept {
+        m_relocations.clear();
+    }
+
     // RV32I Instructions
 
     void ADD(GPR rd, GPR lhs, GPR rhs) noexcept;
@@ -258,6 +739,23 @@ public:
     void BNE(GPR rs1, GPR rs2, Label* label) noexcept;
     void BNEZ(GPR rs, Label* label) noexcept;
 
+    void BEQ(GPR rs1, GPR rs2, LabelHandle label) noexcept;
+    void BEQZ(GPR rs, LabelHandle label) noexcept;
+    void BGE(GPR rs1, GPR rs2, LabelHandle label) noexcept;
+    void BGEU(GPR rs1, GPR rs2, LabelHandle label) noexcept;
+    void BGEZ(GPR rs, LabelHandle label) noexcept;
+    void BGT(GPR rs, GPR rt, LabelHandle label) noexcept;
+    void BGTU(GPR rs, GPR rt, LabelHandle label) noexcept;
+    void BGTZ(GPR rs, LabelHandle label) noexcept;
+    void BLE(GPR rs, GPR rt, LabelHandle label) noexcept;
+    void BLEU(GPR rs, GPR rt, LabelHandle label) noexcept;
+    void BLEZ(GPR rs, LabelHandle label) noexcept;
+    void BLT(GPR rs1, GPR rs2, LabelHandle label) noexcept;
+    void BLTU(GPR rs1, GPR rs2, LabelHandle label) noexcept;
+    void BLTZ(GPR rs, LabelHandle label) noexcept;
+    void BNE(GPR rs1, GPR rs2, LabelHandle label) noexcept;
+    void BNEZ(GPR rs, LabelHandle label) noexcept;
+
     void BEQ(GPR rs1, GPR rs2, int32_t imm) noexcept;
     void BEQZ(GPR rs, int32_t imm) noexcept;
     void BGE(GPR rs1, GPR rs2, int32_t imm) noexcept;
@@ -289,6 +787,10 @@ public:
     void JAL(Label* label) noexcept;
     void JAL(GPR rd, Label* label) noexcept;
 
+    void J(LabelHandle label) noexcept;
+    void JAL(LabelHandle label) noexcept;
+    void JAL(GPR rd, LabelHandle label) noexcept;
+
     void J(int32_t imm) noexcept;
     void JAL(int32_t imm) noexcept;
     void JAL(GPR rd, int32_t imm) noexcept;
@@ -297,13 +799,39 @@ public:
     void JR(GPR rs) noexcept;
     void JR(GPR rs, int32_t imm) noexcept;
 
+    template <typename T>
+    void LA(GPR rd, Literal<T>* literal) noexcept {
+        const auto offset = LinkAndGetOffset(literal);
+        EmitLiteralLoad(rd, rd, offset, 0b000, 0b0010011);
+    }
     void LB(GPR rd, int32_t imm, GPR rs) noexcept;
     void LBU(GPR rd, int32_t imm, GPR rs) noexcept;
     void LH(GPR rd, int32_t imm, GPR rs) noexcept;
     void LHU(GPR rd, int32_t imm, GPR rs) noexcept;
     void LI(GPR rd, uint64_t imm) noexcept;
+
+    /**
+     * Loads a constant like LI(GPR, uint64_t), but may use a scratch register to build
+     * the upper and lower 32 bits of a 64-bit constant independently of one another.
+     *
+     * The halves are merged with PACK if Extension::Zbkb is enabled, or with SLLI+ADD
+     * otherwise. This is only done if it results in a shorter dependency chain than
+     * building the constant in a single register, which trades a few more instructions
+     * for being able to execute them in parallel.
+     *
+     * @param rd      The register to load the constant into.
+     * @param imm     The constant to load.
+     * @param scratch A register that may be clobbered. Must not be rd or x0.
+     */
+    void LI(GPR rd, uint64_t imm, GPR scratch) noexcept;
     void LUI(GPR rd, uint32_t imm) noexcept;
     void LW(GPR rd, int32_t imm, GPR rs) noexcept;
+    template <typename T>
+    void LW(GPR rd, Literal<T>* literal) noexcept {
+        static_assert(sizeof(T) >= 4);
+        const auto offset = LinkAndGetOffset(literal);
+        EmitLiteralLoad(rd, rd, offset, 0b010, 0b0000011);
+    }
 
     void MV(GPR rd, GPR rs) noexcept;
     void NEG(GPR rd, GPR rs) noexcept;
@@ -358,10 +886,7 @@ public:
     void LD(GPR rd, Literal<T>* literal) noexcept {
         static_assert(sizeof(T) >= 8);
         const auto offset = LinkAndGetOffset(literal);
-        const auto hi20 = static_cast<int32_t>((static_cast<uint32_t>(offset) + 0x800) >> 12 & 0xFFFFF);
-        const auto lo12 = static_cast<int32_t>(offset << 20) >> 20;
-        AUIPC(rd, hi20);
-        LD(rd, lo12, rd);
+        EmitLiteralLoad(rd, rd, offset, 0b011, 0b0000011);
     }
     void LWU(GPR rd, int32_t imm, GPR rs) noexcept;
 
@@ -547,6 +1072,12 @@ public:
     void FLE_S(GPR rd, FPR rs1, FPR rs2) noexcept;
     void FLT_S(GPR rd, FPR rs1, FPR rs2) noexcept;
     void FLW(FPR rd, int32_t offset, GPR rs) noexcept;
+    template <typename T>
+    void FLW(FPR rd, Literal<T>* literal, GPR scratch) noexcept {
+        static_assert(sizeof(T) >= 4);
+        const auto offset = LinkAndGetOffset(literal);
+        EmitLiteralLoad(rd, scratch, offset, 0b010, 0b0000111);
+    }
     void FMADD_S(FPR rd, FPR rs1, FPR rs2, FPR rs3, RMode rmode = RMode::DYN) noexcept;
     void FMAX_S(FPR rd, FPR rs1, FPR rs2) noexcept;
     void FMIN_S(FPR rd, FPR rs1, FPR rs2) noexcept;
@@ -589,6 +1120,12 @@ public:
     void FLE_D(GPR rd, FPR rs1, FPR rs2) noexcept;
     void FLT_D(GPR rd, FPR rs1, FPR rs2) noexcept;
     void FLD(FPR rd, int32_t offset, GPR rs) noexcept;
+    template <typename T>
+    void FLD(FPR rd, Literal<T>* literal, GPR scratch) noexcept {
+        static_assert(sizeof(T) >= 8);
+        const auto offset = LinkAndGetOffset(literal);
+        EmitLiteralLoad(rd, scratch, offset, 0b011, 0b0000111);
+    }
     void FMADD_D(FPR rd, FPR rs1, FPR rs2, FPR rs3, RMode rmode = RMode::DYN) noexcept;
     void FMAX_D(FPR rd, FPR rs1, FPR rs2) noexcept;
     void FMIN_D(FPR rd, FPR rs1, FPR rs2) noexcept;
@@ -676,6 +1213,12 @@ public:
     void FEQ_H(GPR rd, FPR rs1, FPR rs2) noexcept;
     void FLE_H(GPR rd, FPR rs1, FPR rs2) noexcept;
     void FLH(FPR rd, int32_t offset, GPR rs) noexcept;
+    template <typename T>
+    void FLH(FPR rd, Literal<T>* literal, GPR scratch) noexcept {
+        static_assert(sizeof(T) >= 2);
+        const auto offset = LinkAndGetOffset(literal);
+        EmitLiteralLoad(rd, scratch, offset, 0b001, 0b0000111);
+    }
     void FLT_H(GPR rd, FPR rs1, FPR rs2) noexcept;
     void FMADD_H(FPR rd, FPR rs1, FPR rs2, FPR rs3, RMode rmode = RMode::DYN) noexcept;
     void FMAX_H(FPR rd, FPR rs1, FPR rs2) noexcept;
@@ -849,8 +1392,10 @@ public:
     void C_ANDI(GPR rd, uint32_t imm) noexcept;
     void C_BEQZ(GPR rs, int32_t offset) noexcept;
     void C_BEQZ(GPR rs, Label* label) noexcept;
+    void C_BEQZ(GPR rs, LabelHandle label) noexcept;
     void C_BNEZ(GPR rs, int32_t offset) noexcept;
     void C_BNEZ(GPR rs, Label* label) noexcept;
+    void C_BNEZ(GPR rs, LabelHandle label) noexcept;
     void C_EBREAK() noexcept;
     void C_FLD(FPR rd, uint32_t imm, GPR rs) noexcept;
     void C_FLDSP(FPR rd, uint32_t imm) noexcept;
@@ -862,7 +1407,9 @@ public:
     void C_FSWSP(FPR rs, uint32_t imm) noexcept;
     void C_J(int32_t offset) noexcept;
     void C_J(Label* label) noexcept;
+    void C_J(LabelHandle label) noexcept;
     void C_JAL(Label* label) noexcept;
+    void C_JAL(LabelHandle label) noexcept;
     void C_JAL(int32_t offset) noexcept;
     void C_JALR(GPR rs) noexcept;
     void C_JR(GPR rs) noexcept;
@@ -1636,6 +2183,10 @@ public:
     void VFWMACCBF16(Vec vd, Vec vs1, Vec vs2, VecMask mask = VecMask::No) noexcept;
 
 private:
+    friend struct detail::BaseEmitters;
+    template <typename AssemblerType>
+    friend class ReservedEmitter;
+
     // Binds a label to a given offset.
     void BindToOffset(Label* label, Label::LocationOffset offset);
 
@@ -1647,10 +2198,81 @@ private:
     // requires them.
     void ResolveLabelOffsets(Label* label);
 
+    // Binds a pooled label to a given offset.
+    void BindToOffset(LabelHandle label, LabelPool::LocationOffset offset);
+
+    // Links the given pooled label and returns the offset to it.
+    ptrdiff_t LinkAndGetOffset(LabelHandle label);
+
+    // Patches the branch instruction at the given offset so that
+    // it branches to the given label location.
+    void PatchLabelOffset(ptrdiff_t label_location, ptrdiff_t offset);
+
+    // A branch or jump to a pooled label whose final form is decided by Finalize().
+    struct RelaxationSite {
+        enum class Kind : uint8_t {
+            Branch, //< Conditional branch, rs1 and rs2 are the compared registers.
+            Jump,   //< JAL, rs1 is the link register.
+        };
+
+        ptrdiff_t offset;
+        LabelHandle label;
+        GPR rs1;
+        GPR rs2;
+        Kind kind;
+        uint8_t funct3;
+        uint8_t size;
+        bool allow_compressed;
+    };
+
+    // Places pending literal pool constants if no relaxable branches have been recorded yet.
+    void PlacePendingLiteralsBeforeRelaxation();
+
+    // Records a relaxable branch to the given pooled label. `allow_compressed`
+    // indicates whether or not the branch may be turned into C.BEQZ/C.BNEZ.
+    void EmitRelaxableBranch(uint32_t funct3, GPR rs1, GPR rs2, LabelHandle label,
+                             bool allow_compressed);
+
+    // Records a relaxable jump to the given pooled label. `allow_compressed`
+    // indicates whether or not the jump may be turned into C.J/C.JAL.
+    void EmitRelaxableJump(GPR rd, LabelHandle label, bool allow_compressed);
+
+    // Settles the layout of all recorded relaxable branches
+    // and rewrites the code to match it.
+    void RelaxBranches();
+
+    // Determines the smallest size in bytes that the given site
+    // can be emitted with in order to cover the given distance.
+    [[nodiscard]] uint8_t GetRelaxedSize(const RelaxationSite& site, ptrdiff_t distance) const;
+
+    // Emits the final form of a relaxed site at the current cursor.
+    void EmitRelaxedSite(const RelaxationSite& site, ptrdiff_t distance);
+
+    // A label branch or literal load whose patching was deferred until Finalize().
+    struct DeferredFixup {
+        enum class Kind : uint8_t {
+            Branch,      //< Branch or jump to a label, see PatchLabelOffset.
+            LiteralLoad, //< AUIPC-based literal load, see PatchLiteralOffset.
+        };
+
+        ptrdiff_t offset;
+        ptrdiff_t target;
+        Kind kind;
+    };
+
+    // Patches the instruction(s) at `offset` so that they refer to `target`,
+    // or records the fixup if Optimization::DeferFixups is enabled.
+    void ResolveFixup(DeferredFixup::Kind kind, ptrdiff_t target, ptrdiff_t offset);
+
+    // Applies all deferred fixups in order of their offset.
+    void ApplyDeferredFixups();
+
     // Places a literal at the given offset.
     template <typename T>
     void PlaceAtOffset(Literal<T>* literal, Literal<T>::LocationOffset offset) {
         BISCUIT_ASSERT(literal != nullptr);
+        // Literals can't be adjusted if pending relaxed branches end up moving code.
+        BISCUIT_ASSERT(m_relaxation_sites.empty());
         BISCUIT_ASSERT(offset >= 0 && offset <= m_buffer.GetCursorOffset());
 
         const T& value = literal->Place(offset);
@@ -1664,6 +2286,7 @@ private:
     template <typename T>
     ptrdiff_t LinkAndGetOffset(Literal<T>* literal) {
         BISCUIT_ASSERT(literal != nullptr);
+        BISCUIT_ASSERT(m_relaxation_sites.empty());
 
         // If we have a placed literal, then it's straightforward to calculate
         // the offsets.
@@ -1681,13 +2304,97 @@ private:
         return 0;
     }
 
+    // Materializes a 64-bit constant with the cheapest sequence that
+    // enabled extensions and the literal pool allow for.
+    void LIWithCostModel(GPR rd, uint64_t imm);
+
+    // Retrieves the pooled literal for the given constant that the instruction at the
+    // cursor can reach, placing the pending island first if it would fall out of range.
+    [[nodiscard]] Literal<uint64_t>* GetPooledConstant(uint64_t value);
+
+    // Places all pending literal pool constants at the cursor, behind a jump around them.
+    void EmitLiteralPoolWithJump();
+
+    // Whether or not the oldest pending literal pool load would be out of range
+    // of an island emitted at the cursor, once another `margin` bytes have been emitted.
+    [[nodiscard]] bool IsLiteralPoolDue(ptrdiff_t margin) const noexcept;
+
+    // Emits an uncompressed AUIPC+load sequence for the given offset, with `base` being
+    // the GPR that AUIPC writes to. The load (or ADDI) must use the I-type encoding.
+    void EmitLiteralLoad(Register rd, GPR base, ptrdiff_t offset, uint32_t funct3, uint32_t opcode);
+
+    // Records a reference to `symbol` emitted at `offset`, patching it right away if the
+    // symbol's address is already known.
+    void AddRelocation(ptrdiff_t offset, RelocationKind kind, const SymbolReference& symbol);
+
+    // Whether or not AutoCompress may emit instructions from the given compressed extension.
+    [[nodiscard]] bool CanCompress(Extension ext) const noexcept {
+        return IsOptimizationEnabled(Optimization::AutoCompress) && IsExtensionEnabled(ext);
+    }
+
+    // Places pending veneers that are due and literal pool constants
+    // after an unconditional control transfer.
+    void OnUnconditionalTransfer() {
+        if (!m_pending_veneers.empty()) [[unlikely]] {
+            EmitJumpVeneers(default_island_margin, false);
+        }
+        if (m_literal_pool.HasPending()) [[unlikely]] {
+            EmitLiteralPool();
+        }
+    }
+
+    // A jump to a label that may have to be redirected to a veneer.
+    struct PendingVeneer {
+        ptrdiff_t jump_offset;
+
+        // Known for labels that are bound out of range of the jump. Otherwise the label
+        // is unbound, and either `label` or `handle` identifies it.
+        std::optional<ptrdiff_t> target;
+        Label* label;
+        LabelHandle handle;
+        GPR rd;
+    };
+
+    // Emits a JAL to a label, recording it as a pending jump if it could need a veneer.
+    void EmitVeneerableJump(GPR rd, std::optional<ptrdiff_t> location, Label* label, LabelHandle handle);
+
+    // Whether or not the oldest pending jump would be out of range of an island
+    // emitted at the cursor, once another `margin` bytes have been emitted.
+    [[nodiscard]] bool IsJumpVeneerIslandDue(ptrdiff_t margin) const noexcept;
+
+    // Emits veneers at the cursor for pending jumps to known out of range targets
+    // and pending jumps that are due, or for all of them if `all` is set.
+    void EmitJumpVeneers(ptrdiff_t margin, bool all);
+
+    // Drops pending jumps to a label that's being bound to `location`, if they are in range
+    // of it. The others are kept pending as jumps to a known target.
+    void DropPendingVeneers(Label* label, LabelHandle handle, ptrdiff_t location);
+
     // Resolves all literal offsets and patches any necessary
     // offsets into the load instructions that require them.
-    void ResolveLiteralOffsetsRaw(ptrdiff_t location, const std::set<ptrdiff_t>& offsets);
+    void ResolveLiteralOffsetsRaw(ptrdiff_t location, std::span<const ptrdiff_t> offsets);
+
+    // Patches the AUIPC-based load at the given offset so that
+    // it loads from the given literal location.
+    void PatchLiteralOffset(ptrdiff_t location, ptrdiff_t offset);
 
     CodeBuffer m_buffer;
+    LabelPool m_label_pool;
+    LiteralPool m_literal_pool;
+    std::vector<RelaxationSite> m_relaxation_sites;
+    GPR m_relaxation_scratch = t1;
+    std::vector<DeferredFixup> m_deferred_fixups;
+    std::vector<Relocation> m_relocations;
+    std::vector<PendingVeneer> m_pending_veneers;
+    ptrdiff_t m_jump_veneer_max_distance = max_jump_veneer_distance;
     ArchFeature m_features = ArchFeature::RV64;
     Optimization m_optimizations = Optimization::None;
+    Extension m_extensions = Extension::Zca | Extension::Zcd | Extension::Zcf;
+    LICostModel m_li_cost_model = LICostModel::Size;
 };
 
 } // namespace biscuit
+
+#ifdef BISCUIT_INLINE_EMITTERS
+#include <biscuit/assembler_inline.hpp>
+#endif
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+#include <biscuit/base_emitters.hpp>
+
+// Definitions of the emitters that JITs call the most: the base integer,
+// load/store and branch instructions, whose bodies live in biscuit/base_emitters.hpp.
+//
+// By default these are compiled into the library like every other emitter.
+// With BISCUIT_INLINE_EMITTERS defined, biscuit/assembler.hpp includes this
+// header, so that the emitters are inlined into the code calling them and
+// operands that are constants at the call site can be folded, e.g. the
+// compression checks of `as.ADDI(a0, a0, 1)`.
+//
+// BISCUIT_INLINE_EMITTERS must be defined for the library and everything
+// using it alike, which the BISCUIT_INLINE_EMITTERS CMake option takes care of.
+
+#ifdef BISCUIT_INLINE_EMITTERS
+#define BISCUIT_EMITTER inline
+#else
+#define BISCUIT_EMITTER
+#endif
+
+namespace biscuit {
+
+// RV32I Instructions
+
+BISCUIT_EMITTER void Assembler::ADD(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::ADD(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::ADDI(GPR rd, GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::ADDI(*this, rd, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::AND(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::AND(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::ANDI(GPR rd, GPR rs, uint32_t imm) noexcept {
+    detail::BaseEmitters::ANDI(*this, rd, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::AUIPC(GPR rd, int32_t imm) noexcept {
+    detail::BaseEmitters::AUIPC(*this, rd, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BEQ(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    detail::BaseEmitters::BEQ(*this, rs1, rs2, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BEQZ(GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::BEQZ(*this, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BGE(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    detail::BaseEmitters::BGE(*this, rs1, rs2, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BGEU(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    detail::BaseEmitters::BGEU(*this, rs1, rs2, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BGEZ(GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::BGEZ(*this, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BGT(GPR rs, GPR rt, int32_t imm) noexcept {
+    detail::BaseEmitters::BGT(*this, rs, rt, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BGTU(GPR rs, GPR rt, int32_t imm) noexcept {
+    detail::BaseEmitters::BGTU(*this, rs, rt, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BGTZ(GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::BGTZ(*this, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BLE(GPR rs, GPR rt, int32_t imm) noexcept {
+    detail::BaseEmitters::BLE(*this, rs, rt, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BLEU(GPR rs, GPR rt, int32_t imm) noexcept {
+    detail::BaseEmitters::BLEU(*this, rs, rt, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BLEZ(GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::BLEZ(*this, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BLT(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    detail::BaseEmitters::BLT(*this, rs1, rs2, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BLTU(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    detail::BaseEmitters::BLTU(*this, rs1, rs2, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BLTZ(GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::BLTZ(*this, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BNE(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    detail::BaseEmitters::BNE(*this, rs1, rs2, imm);
+}
+
+BISCUIT_EMITTER void Assembler::BNEZ(GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::BNEZ(*this, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::LB(GPR rd, int32_t imm, GPR rs) noexcept {
+    detail::BaseEmitters::LB(*this, rd, imm, rs);
+}
+
+BISCUIT_EMITTER void Assembler::LBU(GPR rd, int32_t imm, GPR rs) noexcept {
+    detail::BaseEmitters::LBU(*this, rd, imm, rs);
+}
+
+BISCUIT_EMITTER void Assembler::LH(GPR rd, int32_t imm, GPR rs) noexcept {
+    detail::BaseEmitters::LH(*this, rd, imm, rs);
+}
+
+BISCUIT_EMITTER void Assembler::LHU(GPR rd, int32_t imm, GPR rs) noexcept {
+    detail::BaseEmitters::LHU(*this, rd, imm, rs);
+}
+
+BISCUIT_EMITTER void Assembler::LUI(GPR rd, uint32_t imm) noexcept {
+    detail::BaseEmitters::LUI(*this, rd, imm);
+}
+
+BISCUIT_EMITTER void Assembler::LW(GPR rd, int32_t imm, GPR rs) noexcept {
+    detail::BaseEmitters::LW(*this, rd, imm, rs);
+}
+
+BISCUIT_EMITTER void Assembler::MV(GPR rd, GPR rs) noexcept {
+    detail::BaseEmitters::MV(*this, rd, rs);
+}
+
+BISCUIT_EMITTER void Assembler::NEG(GPR rd, GPR rs) noexcept {
+    detail::BaseEmitters::NEG(*this, rd, rs);
+}
+
+BISCUIT_EMITTER void Assembler::NOP() noexcept {
+    detail::BaseEmitters::NOP(*this);
+}
+
+BISCUIT_EMITTER void Assembler::NOT(GPR rd, GPR rs) noexcept {
+    detail::BaseEmitters::NOT(*this, rd, rs);
+}
+
+BISCUIT_EMITTER void Assembler::OR(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::OR(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::ORI(GPR rd, GPR rs, uint32_t imm) noexcept {
+    detail::BaseEmitters::ORI(*this, rd, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::SB(GPR rs2, int32_t imm, GPR rs1) noexcept {
+    detail::BaseEmitters::SB(*this, rs2, imm, rs1);
+}
+
+BISCUIT_EMITTER void Assembler::SEQZ(GPR rd, GPR rs) noexcept {
+    detail::BaseEmitters::SEQZ(*this, rd, rs);
+}
+
+BISCUIT_EMITTER void Assembler::SGT(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SGT(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SGTU(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SGTU(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SGTZ(GPR rd, GPR rs) noexcept {
+    detail::BaseEmitters::SGTZ(*this, rd, rs);
+}
+
+BISCUIT_EMITTER void Assembler::SH(GPR rs2, int32_t imm, GPR rs1) noexcept {
+    detail::BaseEmitters::SH(*this, rs2, imm, rs1);
+}
+
+BISCUIT_EMITTER void Assembler::SLL(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SLL(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SLLI(GPR rd, GPR rs, uint32_t shift) noexcept {
+    detail::BaseEmitters::SLLI(*this, rd, rs, shift);
+}
+
+BISCUIT_EMITTER void Assembler::SLT(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SLT(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SLTI(GPR rd, GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::SLTI(*this, rd, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::SLTIU(GPR rd, GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::SLTIU(*this, rd, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::SLTU(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SLTU(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SLTZ(GPR rd, GPR rs) noexcept {
+    detail::BaseEmitters::SLTZ(*this, rd, rs);
+}
+
+BISCUIT_EMITTER void Assembler::SNEZ(GPR rd, GPR rs) noexcept {
+    detail::BaseEmitters::SNEZ(*this, rd, rs);
+}
+
+BISCUIT_EMITTER void Assembler::SRA(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SRA(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SRAI(GPR rd, GPR rs, uint32_t shift) noexcept {
+    detail::BaseEmitters::SRAI(*this, rd, rs, shift);
+}
+
+BISCUIT_EMITTER void Assembler::SRL(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SRL(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SRLI(GPR rd, GPR rs, uint32_t shift) noexcept {
+    detail::BaseEmitters::SRLI(*this, rd, rs, shift);
+}
+
+BISCUIT_EMITTER void Assembler::SUB(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SUB(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SW(GPR rs2, int32_t imm, GPR rs1) noexcept {
+    detail::BaseEmitters::SW(*this, rs2, imm, rs1);
+}
+
+BISCUIT_EMITTER void Assembler::XOR(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::XOR(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::XORI(GPR rd, GPR rs, uint32_t imm) noexcept {
+    detail::BaseEmitters::XORI(*this, rd, rs, imm);
+}
+
+// RV64I Instructions
+
+BISCUIT_EMITTER void Assembler::ADDIW(GPR rd, GPR rs, int32_t imm) noexcept {
+    detail::BaseEmitters::ADDIW(*this, rd, rs, imm);
+}
+
+BISCUIT_EMITTER void Assembler::ADDW(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::ADDW(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::LD(GPR rd, int32_t imm, GPR rs) noexcept {
+    detail::BaseEmitters::LD(*this, rd, imm, rs);
+}
+
+BISCUIT_EMITTER void Assembler::LWU(GPR rd, int32_t imm, GPR rs) noexcept {
+    detail::BaseEmitters::LWU(*this, rd, imm, rs);
+}
+
+BISCUIT_EMITTER void Assembler::NEGW(GPR rd, GPR rs) noexcept {
+    detail::BaseEmitters::NEGW(*this, rd, rs);
+}
+
+BISCUIT_EMITTER void Assembler::SD(GPR rs2, int32_t imm, GPR rs1) noexcept {
+    detail::BaseEmitters::SD(*this, rs2, imm, rs1);
+}
+
+BISCUIT_EMITTER void Assembler::SLLIW(GPR rd, GPR rs, uint32_t shift) noexcept {
+    detail::BaseEmitters::SLLIW(*this, rd, rs, shift);
+}
+
+BISCUIT_EMITTER void Assembler::SRAIW(GPR rd, GPR rs, uint32_t shift) noexcept {
+    detail::BaseEmitters::SRAIW(*this, rd, rs, shift);
+}
+
+BISCUIT_EMITTER void Assembler::SRLIW(GPR rd, GPR rs, uint32_t shift) noexcept {
+    detail::BaseEmitters::SRLIW(*this, rd, rs, shift);
+}
+
+BISCUIT_EMITTER void Assembler::SLLW(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SLLW(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SRAW(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SRAW(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SRLW(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SRLW(*this, rd, lhs, rhs);
+}
+
+BISCUIT_EMITTER void Assembler::SUBW(GPR rd, GPR lhs, GPR rhs) noexcept {
+    detail::BaseEmitters::SUBW(*this, rd, lhs, rhs);
+}
+
+} // namespace biscuit
+
+#undef BISCUIT_EMITTER
@@ -0,0 +1,721 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+#include <biscuit/assert.hpp>
+#include <biscuit/encode.hpp>
+
+namespace biscuit::detail {
+
+// The bodies of the base integer, load/store and branch emitters, shared by
+// Assembler and BasicAssembler.
+//
+// Each emitter is written against the assembler it emits for, so that
+// BasicAssembler can substitute compile-time answers for CanCompress()
+// and GetArchFeatures(), which lets the compiler fold away the checks
+// that don't apply to its configuration.
+struct BaseEmitters {
+    // RV32I Instructions
+
+    template <typename Emitter>
+    static void ADD(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        if (as.CanCompress(Extension::Zca) && rd != x0) {
+            // Unlike most other compressed arithmetic, C.ADD and C.MV aren't limited to x8-x15.
+            if (rd == lhs && rhs != x0) {
+                as.C_ADD(rd, rhs);
+                return;
+            } else if (rd == rhs && lhs != x0) {
+                as.C_ADD(rd, lhs);
+                return;
+            } else if (lhs == x0 && rhs != x0) {
+                as.C_MV(rd, rhs);
+                return;
+            } else if (rhs == x0 && lhs != x0) {
+                as.C_MV(rd, lhs);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::ADD(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void ADDI(Emitter& as, GPR rd, GPR rs, int32_t imm) noexcept {
+        if (as.CanCompress(Extension::Zca)) {
+            if (imm == 0 && rd != x0 && rs != x0) {
+                as.C_MV(rd, rs);
+                return;
+            } else if (imm == 0 && rd == x0 && rs == x0) {
+                as.C_NOP();
+                return;
+            } else if (rd != x0 && rs == x0 && encode::IsValidSigned6BitImm(imm)) {
+                as.C_LI(rd, imm);
+                return;
+            } else if (rd == x2 && rd == rs && imm != 0 && (imm & 0b1111) == 0 && imm >= -512 && imm <= 496) {
+                as.C_ADDI16SP(imm);
+                return;
+            } else if (encode::IsValid3BitCompressedReg(rd) && rs == x2 && (imm & 0b11) == 0 && imm > 0 && imm <= 1020) {
+                as.C_ADDI4SPN(rd, static_cast<uint32_t>(imm));
+                return;
+            } else if (rd != x0 && rd == rs && imm != 0 && encode::IsValidSigned6BitImm(imm)) {
+                as.C_ADDI(rd, imm);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::ADDI(rd, rs, imm));
+    }
+
+    template <typename Emitter>
+    static void AND(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        if (as.CanCompress(Extension::Zca)) {
+            if (encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(lhs) && encode::IsValid3BitCompressedReg(rhs)) {
+                if (rd == lhs) {
+                    as.C_AND(rd, rhs);
+                    return;
+                } else if (rd == rhs) {
+                    as.C_AND(rd, lhs);
+                    return;
+                }
+            }
+        }
+
+        as.m_buffer.Emit32(encode::AND(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void ANDI(Emitter& as, GPR rd, GPR rs, uint32_t imm) noexcept {
+        if (as.CanCompress(Extension::Zca)) {
+            uint32_t sign_extended = static_cast<uint32_t>(static_cast<int32_t>(imm << 26) >> 26);
+            if (rd == rs  && encode::IsValid3BitCompressedReg(rd) && (imm & 0xFFF) == (sign_extended & 0xFFF)) {
+                as.C_ANDI(rd, imm);
+                return;
+            }
+        }
+        if (as.CanCompress(Extension::Zcb)) {
+            if (rd == rs && encode::IsValid3BitCompressedReg(rd) && (imm & 0xFFF) == 0xFF) {
+                as.C_ZEXT_B(rd);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::IType(imm, rs, 0b111, rd, 0b0010011));
+    }
+
+    template <typename Emitter>
+    static void AUIPC(Emitter& as, GPR rd, int32_t imm) noexcept {
+        as.m_buffer.Emit32(encode::AUIPC(rd, imm));
+    }
+
+    template <typename Emitter>
+    static void BEQ(Emitter& as, GPR rs1, GPR rs2, int32_t imm) noexcept {
+        BISCUIT_ASSERT(encode::IsValidBTypeImm(imm));
+
+        if (as.CanCompress(Extension::Zca)) {
+            if (encode::IsValidCBTypeImm(imm) && (imm & 0b1) == 0) {
+                if (rs1 == x0 && encode::IsValid3BitCompressedReg(rs2)) {
+                    as.C_BEQZ(rs2, imm);
+                    return;
+                } else if (rs2 == x0 && encode::IsValid3BitCompressedReg(rs1)) {
+                    as.C_BEQZ(rs1, imm);
+                    return;
+                }
+            }
+        }
+
+        as.m_buffer.Emit32(encode::BEQ(rs1, rs2, imm));
+    }
+
+    template <typename Emitter>
+    static void BEQZ(Emitter& as, GPR rs, int32_t imm) noexcept {
+        as.BEQ(rs, x0, imm);
+    }
+
+    template <typename Emitter>
+    static void BGE(Emitter& as, GPR rs1, GPR rs2, int32_t imm) noexcept {
+        BISCUIT_ASSERT(encode::IsValidBTypeImm(imm));
+        as.m_buffer.Emit32(encode::BGE(rs1, rs2, imm));
+    }
+
+    template <typename Emitter>
+    static void BGEU(Emitter& as, GPR rs1, GPR rs2, int32_t imm) noexcept {
+        BISCUIT_ASSERT(encode::IsValidBTypeImm(imm));
+        as.m_buffer.Emit32(encode::BGEU(rs1, rs2, imm));
+    }
+
+    template <typename Emitter>
+    static void BGEZ(Emitter& as, GPR rs, int32_t imm) noexcept {
+        as.BGE(rs, x0, imm);
+    }
+
+    template <typename Emitter>
+    static void BGT(Emitter& as, GPR rs, GPR rt, int32_t imm) noexcept {
+        as.BLT(rt, rs, imm);
+    }
+
+    template <typename Emitter>
+    static void BGTU(Emitter& as, GPR rs, GPR rt, int32_t imm) noexcept {
+        as.BLTU(rt, rs, imm);
+    }
+
+    template <typename Emitter>
+    static void BGTZ(Emitter& as, GPR rs, int32_t imm) noexcept {
+        as.BLT(x0, rs, imm);
+    }
+
+    template <typename Emitter>
+    static void BLE(Emitter& as, GPR rs, GPR rt, int32_t imm) noexcept {
+        as.BGE(rt, rs, imm);
+    }
+
+    template <typename Emitter>
+    static void BLEU(Emitter& as, GPR rs, GPR rt, int32_t imm) noexcept {
+        as.BGEU(rt, rs, imm);
+    }
+
+    template <typename Emitter>
+    static void BLEZ(Emitter& as, GPR rs, int32_t imm) noexcept {
+        as.BGE(x0, rs, imm);
+    }
+
+    template <typename Emitter>
+    static void BLT(Emitter& as, GPR rs1, GPR rs2, int32_t imm) noexcept {
+        BISCUIT_ASSERT(encode::IsValidBTypeImm(imm));
+        as.m_buffer.Emit32(encode::BLT(rs1, rs2, imm));
+    }
+
+    template <typename Emitter>
+    static void BLTU(Emitter& as, GPR rs1, GPR rs2, int32_t imm) noexcept {
+        BISCUIT_ASSERT(encode::IsValidBTypeImm(imm));
+        as.m_buffer.Emit32(encode::BLTU(rs1, rs2, imm));
+    }
+
+    template <typename Emitter>
+    static void BLTZ(Emitter& as, GPR rs, int32_t imm) noexcept {
+        as.BLT(rs, x0, imm);
+    }
+
+    template <typename Emitter>
+    static void BNE(Emitter& as, GPR rs1, GPR rs2, int32_t imm) noexcept {
+        BISCUIT_ASSERT(encode::IsValidBTypeImm(imm));
+
+        if (as.CanCompress(Extension::Zca)) {
+            if (encode::IsValidCBTypeImm(imm) && (imm & 0b1) == 0) {
+                if (rs1 == x0 && encode::IsValid3BitCompressedReg(rs2)) {
+                    as.C_BNEZ(rs2, imm);
+                    return;
+                } else if (rs2 == x0 && encode::IsValid3BitCompressedReg(rs1)) {
+                    as.C_BNEZ(rs1, imm);
+                    return;
+                }
+            }
+        }
+
+        as.m_buffer.Emit32(encode::BNE(rs1, rs2, imm));
+    }
+
+    template <typename Emitter>
+    static void BNEZ(Emitter& as, GPR rs, int32_t imm) noexcept {
+        as.BNE(x0, rs, imm);
+    }
+
+    template <typename Emitter>
+    static void LB(Emitter& as, GPR rd, int32_t imm, GPR rs) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+        as.m_buffer.Emit32(encode::LB(rd, imm, rs));
+    }
+
+    template <typename Emitter>
+    static void LBU(Emitter& as, GPR rd, int32_t imm, GPR rs) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+
+        if (as.CanCompress(Extension::Zcb)) {
+            if (imm >= 0 && imm <= 3 && encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(rs)) {
+                as.C_LBU(rd, static_cast<uint32_t>(imm), rs);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::LBU(rd, imm, rs));
+    }
+
+    template <typename Emitter>
+    static void LH(Emitter& as, GPR rd, int32_t imm, GPR rs) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+
+        if (as.CanCompress(Extension::Zcb)) {
+            if ((imm == 0 || imm == 2) && encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(rs)) {
+                as.C_LH(rd, static_cast<uint32_t>(imm), rs);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::LH(rd, imm, rs));
+    }
+
+    template <typename Emitter>
+    static void LHU(Emitter& as, GPR rd, int32_t imm, GPR rs) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+
+        if (as.CanCompress(Extension::Zcb)) {
+            if ((imm == 0 || imm == 2) && encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(rs)) {
+                as.C_LHU(rd, static_cast<uint32_t>(imm), rs);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::LHU(rd, imm, rs));
+    }
+
+    template <typename Emitter>
+    static void LUI(Emitter& as, GPR rd, uint32_t imm) noexcept {
+        if (as.CanCompress(Extension::Zca)) {
+            // Sign-extend the bottom 6 bits to check if the 20 bits we are using LUI on are 6 sign-extended bits
+            uint32_t sign_extended = static_cast<uint32_t>(static_cast<int32_t>(imm << 26) >> 26);
+            if ((sign_extended & 0x000FFFFF) == (imm & 0x000FFFFF)) {
+                if (rd != x0 && rd != x2 && imm != 0) {
+                    as.C_LUI(rd, imm & 0x3F);
+                    return;
+                }
+            }
+        }
+
+        as.m_buffer.Emit32(encode::LUI(rd, imm));
+    }
+
+    template <typename Emitter>
+    static void LW(Emitter& as, GPR rd, int32_t imm, GPR rs) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+
+        if (as.CanCompress(Extension::Zca)) {
+            if (rs == sp && rd != x0 && imm >= 0 && imm <= 252 && (imm & 0b11) == 0) {
+                as.C_LWSP(rd, static_cast<uint32_t>(imm));
+                return;
+            } else if (imm >= 0 && imm <= 124 && (imm & 0b11) == 0 && encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(rs)) {
+                as.C_LW(rd, static_cast<uint32_t>(imm), rs);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::LW(rd, imm, rs));
+    }
+
+    template <typename Emitter>
+    static void MV(Emitter& as, GPR rd, GPR rs) noexcept {
+        as.ADDI(rd, rs, 0);
+    }
+
+    template <typename Emitter>
+    static void NEG(Emitter& as, GPR rd, GPR rs) noexcept {
+        as.SUB(rd, x0, rs);
+    }
+
+    template <typename Emitter>
+    static void NOP(Emitter& as) noexcept {
+        as.ADDI(x0, x0, 0);
+    }
+
+    template <typename Emitter>
+    static void NOT(Emitter& as, GPR rd, GPR rs) noexcept {
+        as.XORI(rd, rs, UINT32_MAX);
+    }
+
+    template <typename Emitter>
+    static void OR(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        if (as.CanCompress(Extension::Zca)) {
+            if (encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(lhs) && encode::IsValid3BitCompressedReg(rhs)) {
+                if (rd == lhs) {
+                    as.C_OR(rd, rhs);
+                    return;
+                } else if (rd == rhs) {
+                    as.C_OR(rd, lhs);
+                    return;
+                }
+            }
+        }
+
+        as.m_buffer.Emit32(encode::OR(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void ORI(Emitter& as, GPR rd, GPR rs, uint32_t imm) noexcept {
+        as.m_buffer.Emit32(encode::IType(imm, rs, 0b110, rd, 0b0010011));
+    }
+
+    template <typename Emitter>
+    static void SB(Emitter& as, GPR rs2, int32_t imm, GPR rs1) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+
+        if (as.CanCompress(Extension::Zcb)) {
+            if (imm >= 0 && imm <= 3 && encode::IsValid3BitCompressedReg(rs2) && encode::IsValid3BitCompressedReg(rs1)) {
+                as.C_SB(rs2, static_cast<uint32_t>(imm), rs1);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::SB(rs2, imm, rs1));
+    }
+
+    template <typename Emitter>
+    static void SEQZ(Emitter& as, GPR rd, GPR rs) noexcept {
+        as.SLTIU(rd, rs, 1);
+    }
+
+    template <typename Emitter>
+    static void SGT(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        as.SLT(rd, rhs, lhs);
+    }
+
+    template <typename Emitter>
+    static void SGTU(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        as.SLTU(rd, rhs, lhs);
+    }
+
+    template <typename Emitter>
+    static void SGTZ(Emitter& as, GPR rd, GPR rs) noexcept {
+        as.SLT(rd, x0, rs);
+    }
+
+    template <typename Emitter>
+    static void SH(Emitter& as, GPR rs2, int32_t imm, GPR rs1) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+
+        if (as.CanCompress(Extension::Zcb)) {
+            if ((imm == 0 || imm == 2) && encode::IsValid3BitCompressedReg(rs2) && encode::IsValid3BitCompressedReg(rs1)) {
+                as.C_SH(rs2, static_cast<uint32_t>(imm), rs1);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::SH(rs2, imm, rs1));
+    }
+
+    template <typename Emitter>
+    static void SLL(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        as.m_buffer.Emit32(encode::SLL(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void SLLI(Emitter& as, GPR rd, GPR rs, uint32_t shift) noexcept {
+        if (IsRV32(as.GetArchFeatures())) {
+            BISCUIT_ASSERT(shift <= 31);
+
+            if (as.CanCompress(Extension::Zca)) {
+                if (rd != x0 && rd == rs && shift != 0) {
+                    as.C_SLLI(rd, shift);
+                    return;
+                }
+            }
+
+            as.m_buffer.Emit32(encode::SLLI(rd, rs, shift));
+        } else {
+            BISCUIT_ASSERT(shift <= 63);
+
+            if (as.CanCompress(Extension::Zca)) {
+                if (rd != x0 && rd == rs && shift != 0) {
+                    as.C_SLLI(rd, shift);
+                    return;
+                }
+            }
+
+            as.m_buffer.Emit32(encode::SLLI(rd, rs, shift));
+        }
+    }
+
+    template <typename Emitter>
+    static void SLT(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        as.m_buffer.Emit32(encode::SLT(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void SLTI(Emitter& as, GPR rd, GPR rs, int32_t imm) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+        as.m_buffer.Emit32(encode::SLTI(rd, rs, imm));
+    }
+
+    template <typename Emitter>
+    static void SLTIU(Emitter& as, GPR rd, GPR rs, int32_t imm) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+        as.m_buffer.Emit32(encode::SLTIU(rd, rs, imm));
+    }
+
+    template <typename Emitter>
+    static void SLTU(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        as.m_buffer.Emit32(encode::SLTU(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void SLTZ(Emitter& as, GPR rd, GPR rs) noexcept {
+        as.SLT(rd, rs, x0);
+    }
+
+    template <typename Emitter>
+    static void SNEZ(Emitter& as, GPR rd, GPR rs) noexcept {
+        as.SLTU(rd, x0, rs);
+    }
+
+    template <typename Emitter>
+    static void SRA(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        as.m_buffer.Emit32(encode::SRA(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void SRAI(Emitter& as, GPR rd, GPR rs, uint32_t shift) noexcept {
+        if (IsRV32(as.GetArchFeatures())) {
+            BISCUIT_ASSERT(shift <= 31);
+
+            if (as.CanCompress(Extension::Zca)) {
+                if (rd != x0 && rd == rs && encode::IsValid3BitCompressedReg(rd) && shift != 0) {
+                    as.C_SRAI(rd, shift);
+                    return;
+                }
+            }
+
+            as.m_buffer.Emit32(encode::SRAI(rd, rs, shift));
+        } else {
+            BISCUIT_ASSERT(shift <= 63);
+
+            if (as.CanCompress(Extension::Zca)) {
+                if (IsRV64(as.GetArchFeatures()) && rd != x0 && rd == rs && encode::IsValid3BitCompressedReg(rd) && shift != 0) {
+                    as.C_SRAI(rd, shift);
+                    return;
+                }
+            }
+
+            as.m_buffer.Emit32(encode::SRAI(rd, rs, shift));
+        }
+    }
+
+    template <typename Emitter>
+    static void SRL(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        as.m_buffer.Emit32(encode::SRL(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void SRLI(Emitter& as, GPR rd, GPR rs, uint32_t shift) noexcept {
+        if (IsRV32(as.GetArchFeatures())) {
+            BISCUIT_ASSERT(shift <= 31);
+
+            if (as.CanCompress(Extension::Zca)) {
+                if (rd != x0 && rd == rs && encode::IsValid3BitCompressedReg(rd) && shift != 0) {
+                    as.C_SRLI(rd, shift);
+                    return;
+                }
+            }
+
+            as.m_buffer.Emit32(encode::SRLI(rd, rs, shift));
+        } else {
+            BISCUIT_ASSERT(shift <= 63);
+
+            if (as.CanCompress(Extension::Zca)) {
+                if (IsRV64(as.GetArchFeatures()) && rd != x0 && rd == rs && encode::IsValid3BitCompressedReg(rd) && shift != 0) {
+                    as.C_SRLI(rd, shift);
+                    return;
+                }
+            }
+
+            as.m_buffer.Emit32(encode::SRLI(rd, rs, shift));
+        }
+    }
+
+    template <typename Emitter>
+    static void SUB(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        if (as.CanCompress(Extension::Zca)) {
+            if (encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(rhs)) {
+                if (rd == lhs) {
+                    as.C_SUB(rd, rhs);
+                    return;
+                }
+            }
+        }
+
+        as.m_buffer.Emit32(encode::SUB(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void SW(Emitter& as, GPR rs2, int32_t imm, GPR rs1) noexcept {
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+
+        if (as.CanCompress(Extension::Zca)) {
+            if (rs1 == sp && imm >= 0 && imm <= 252 && (imm & 0b11) == 0) {
+                as.C_SWSP(rs2, static_cast<uint32_t>(imm));
+                return;
+            } else if (imm >= 0 && imm <= 124 && (imm & 0b11) == 0 && encode::IsValid3BitCompressedReg(rs2) && encode::IsValid3BitCompressedReg(rs1)) {
+                as.C_SW(rs2, static_cast<uint32_t>(imm), rs1);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::SW(rs2, imm, rs1));
+    }
+
+    template <typename Emitter>
+    static void XOR(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        if (as.CanCompress(Extension::Zca)) {
+            if (encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(lhs) && encode::IsValid3BitCompressedReg(rhs)) {
+                if (rd == lhs) {
+                    as.C_XOR(rd, rhs);
+                    return;
+                } else if (rd == rhs) {
+                    as.C_XOR(rd, lhs);
+                    return;
+                }
+            }
+        }
+
+        as.m_buffer.Emit32(encode::XOR(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void XORI(Emitter& as, GPR rd, GPR rs, uint32_t imm) noexcept {
+        if (as.CanCompress(Extension::Zcb)) {
+            if (rd == rs && encode::IsValid3BitCompressedReg(rd) && (imm & 0xFFF) == 0xFFF) {
+                as.C_NOT(rd);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::IType(imm, rs, 0b100, rd, 0b0010011));
+    }
+
+    // RV64I Instructions
+
+    template <typename Emitter>
+    static void ADDIW(Emitter& as, GPR rd, GPR rs, int32_t imm) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+
+        if (as.CanCompress(Extension::Zca)) {
+            if (rd != x0 && rd == rs && encode::IsValidSigned6BitImm(imm)) {
+                as.C_ADDIW(rd, imm);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::ADDIW(rd, rs, imm));
+    }
+
+    template <typename Emitter>
+    static void ADDW(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+
+        if (as.CanCompress(Extension::Zca)) {
+            if (encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(lhs) && encode::IsValid3BitCompressedReg(rhs)) {
+                if (rd == lhs) {
+                    as.C_ADDW(rd, rhs);
+                    return;
+                } else if (rd == rhs) {
+                    as.C_ADDW(rd, lhs);
+                    return;
+                }
+            }
+        }
+
+        as.m_buffer.Emit32(encode::ADDW(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void LD(Emitter& as, GPR rd, int32_t imm, GPR rs) noexcept {
+        BISCUIT_ASSERT(IsRV32OrRV64(as.GetArchFeatures()));
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+
+        // C.LD and C.LDSP share their encodings with C.FLW and C.FLWSP on RV32.
+        if (as.CanCompress(Extension::Zca) && IsRV64(as.GetArchFeatures())) {
+            if (rs == sp && rd != x0 && imm >= 0 && imm <= 504 && (imm & 0b111) == 0) {
+                as.C_LDSP(rd, static_cast<uint32_t>(imm));
+                return;
+            } else if (imm >= 0 && imm <= 248 && (imm & 0b111) == 0 && encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(rs)) {
+                as.C_LD(rd, static_cast<uint32_t>(imm), rs);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::LD(rd, imm, rs));
+    }
+
+    template <typename Emitter>
+    static void LWU(Emitter& as, GPR rd, int32_t imm, GPR rs) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+        as.m_buffer.Emit32(encode::LWU(rd, imm, rs));
+    }
+
+    template <typename Emitter>
+    static void NEGW(Emitter& as, GPR rd, GPR rs) noexcept {
+        as.SUBW(rd, x0, rs);
+    }
+
+    template <typename Emitter>
+    static void SD(Emitter& as, GPR rs2, int32_t imm, GPR rs1) noexcept {
+        BISCUIT_ASSERT(IsRV32OrRV64(as.GetArchFeatures()));
+        BISCUIT_ASSERT(encode::IsValidSigned12BitImm(imm));
+
+        // C.SD and C.SDSP share their encodings with C.FSW and C.FSWSP on RV32.
+        if (as.CanCompress(Extension::Zca) && IsRV64(as.GetArchFeatures())) {
+            if (rs1 == sp && imm >= 0 && imm <= 504 && (imm & 0b111) == 0) {
+                as.C_SDSP(rs2, static_cast<uint32_t>(imm));
+                return;
+            } else if (imm >= 0 && imm <= 248 && (imm & 0b111) == 0 && encode::IsValid3BitCompressedReg(rs2) && encode::IsValid3BitCompressedReg(rs1)) {
+                as.C_SD(rs2, static_cast<uint32_t>(imm), rs1);
+                return;
+            }
+        }
+
+        as.m_buffer.Emit32(encode::SD(rs2, imm, rs1));
+    }
+
+    template <typename Emitter>
+    static void SLLIW(Emitter& as, GPR rd, GPR rs, uint32_t shift) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+        BISCUIT_ASSERT(shift <= 31);
+        as.m_buffer.Emit32(encode::SLLIW(rd, rs, shift));
+    }
+
+    template <typename Emitter>
+    static void SRAIW(Emitter& as, GPR rd, GPR rs, uint32_t shift) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+        BISCUIT_ASSERT(shift <= 31);
+        as.m_buffer.Emit32(encode::SRAIW(rd, rs, shift));
+    }
+
+    template <typename Emitter>
+    static void SRLIW(Emitter& as, GPR rd, GPR rs, uint32_t shift) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+        BISCUIT_ASSERT(shift <= 31);
+        as.m_buffer.Emit32(encode::SRLIW(rd, rs, shift));
+    }
+
+    template <typename Emitter>
+    static void SLLW(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+        as.m_buffer.Emit32(encode::SLLW(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void SRAW(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+        as.m_buffer.Emit32(encode::SRAW(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void SRLW(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+        as.m_buffer.Emit32(encode::SRLW(rd, lhs, rhs));
+    }
+
+    template <typename Emitter>
+    static void SUBW(Emitter& as, GPR rd, GPR lhs, GPR rhs) noexcept {
+        BISCUIT_ASSERT(IsRV64(as.GetArchFeatures()));
+
+        if (as.CanCompress(Extension::Zca)) {
+            if (encode::IsValid3BitCompressedReg(rd) && encode::IsValid3BitCompressedReg(rhs)) {
+                if (rd == lhs) {
+                    as.C_SUBW(rd, rhs);
+                    return;
+                }
+            }
+        }
+
+        as.m_buffer.Emit32(encode::SUBW(rd, lhs, rhs));
+    }
+};
+
+} // namespace biscuit::detail
@@ -0,0 +1,552 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+#include <biscuit/assert.hpp>
+#include <biscuit/base_emitters.hpp>
+#include <biscuit/code_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace biscuit {
+
+/**
+ * The register width that a BasicAssembler targets.
+ */
+enum class Xlen : uint32_t {
+    /// Decided at runtime through the ArchFeature the assembler is given.
+    Runtime,
+
+    /// Always targets RV32.
+    RV32,
+
+    /// Always targets RV64.
+    RV64,
+};
+
+/**
+ * A BasicAssembler policy that leaves compression up to the runtime
+ * configuration, i.e. Optimization::AutoCompress and the enabled extensions.
+ *
+ * A policy fixing compression instead provides:
+ *
+ * @code{.cpp}
+ * struct Policy {
+ *     static constexpr bool is_fixed = true;
+ *
+ *     // Whether or not instructions are compressed where possible.
+ *     static constexpr bool auto_compress = true;
+ *
+ *     // The compressed extensions that may be used for it.
+ *     static constexpr Extension compressed_extensions = Extension::Zca;
+ * };
+ * @endcode
+ */
+struct RuntimePolicy {
+    static constexpr bool is_fixed = false;
+};
+
+/**
+ * A BasicAssembler policy that always compresses instructions where possible,
+ * using the given compressed extensions.
+ *
+ * @tparam Extensions The compressed extensions that may be used. By default,
+ *                    the ones that make up the C extension.
+ */
+template <Extension Extensions = Extension::Zca | Extension::Zcd | Extension::Zcf>
+struct CompressPolicy {
+    static constexpr bool is_fixed = true;
+    static constexpr bool auto_compress = true;
+    static constexpr Extension compressed_extensions = Extensions;
+};
+
+/**
+ * A BasicAssembler policy that never compresses instructions.
+ */
+struct NoCompressPolicy {
+    static constexpr bool is_fixed = true;
+    static constexpr bool auto_compress = false;
+    static constexpr Extension compressed_extensions = Extension::None;
+};
+
+/**
+ * An assembler whose register width and compression policy are fixed at compile time.
+ *
+ * The base integer, load/store and branch emitters of Assembler check the target
+ * and whether or not compression is enabled every time they are called. BasicAssembler
+ * answers those checks at compile time instead, so that the paths which can't apply
+ * to its configuration are folded away when these emitters are inlined into the caller.
+ * Everything else behaves exactly as it does for Assembler, which the runtime
+ * configuration is kept in sync with.
+ *
+ * `BasicAssembler<Xlen::Runtime, RuntimePolicy>` leaves everything to the runtime
+ * configuration, just like Assembler.
+ *
+ * @par
+ * An example of an assembler for RV64GC:
+ * @code{.cpp}
+ * using RV64GCAssembler = BasicAssembler<Xlen::RV64, CompressPolicy<>>;
+ *
+ * RV64GCAssembler as{4096};
+ * as.ADDI(a0, a0, 1); // Always emitted as C.ADDI, without checking the configuration.
+ * @endcode
+ *
+ * @tparam X      The register width to target.
+ * @tparam Policy The compression policy, e.g. RuntimePolicy or CompressPolicy.
+ *
+ * @note The compile-time configuration only applies when the emitters are called
+ *       on a BasicAssembler directly. Calling them through an Assembler reference
+ *       checks the runtime configuration, which still agrees with it.
+ */
+template <Xlen X, typename Policy = RuntimePolicy>
+class BasicAssembler : public Assembler {
+public:
+    /// The architectural features implied by the register width.
+    static constexpr ArchFeature default_features = X == Xlen::RV32 ? ArchFeature::RV32 : ArchFeature::RV64;
+
+    /**
+     * Constructor
+     *
+     * Initializes the underlying code buffer to be able to hold `capacity` bytes.
+     *
+     * @param capacity The capacity for the underlying code buffer in bytes.
+     */
+    [[nodiscard]] explicit BasicAssembler(size_t capacity = CodeBuffer::default_capacity)
+        : Assembler(capacity) {
+        Configure(default_features);
+    }
+
+    /**
+     * Constructor
+     *
+     * @param buffer   A non-null pointer to an allocated buffer of size `capacity`.
+     * @param capacity The capacity of the memory pointed to by `buffer`.
+     * @param features Architectural features to make the assembler aware of.
+     *                 Must match the register width, unless it's Xlen::Runtime.
+     *
+     * @note The caller is responsible for managing the lifetime of the given memory.
+     */
+    [[nodiscard]] explicit BasicAssembler(uint8_t* buffer, size_t capacity,
+                                          ArchFeature features = default_features)
+        : Assembler(buffer, capacity, features) {
+        Configure(features);
+    }
+
+    /**
+     * Constructor
+     *
+     * @param buffer   The code buffer to assemble into.
+     * @param features Architectural features to make the assembler aware of.
+     *                 Must match the register width, unless it's Xlen::Runtime.
+     */
+    [[nodiscard]] explicit BasicAssembler(CodeBuffer&& buffer,
+                                          ArchFeature features = default_features)
+        : Assembler(std::move(buffer), features) {
+        Configure(features);
+    }
+
+    /**
+     * Tells the assembler what features to take into account.
+     *
+     * @pre Unless the register width is Xlen::Runtime, the features must match it.
+     */
+    void SetArchFeatures(ArchFeature features) noexcept {
+        if constexpr (X != Xlen::Runtime) {
+            BISCUIT_ASSERT(features == default_features);
+        }
+        Assembler::SetArchFeatures(features);
+    }
+
+    /// Retrieves the features that the assembler is assembling for.
+    [[nodiscard]] ArchFeature GetArchFeatures() const noexcept {
+        if constexpr (X != Xlen::Runtime) {
+            return default_features;
+        } else {
+            return Assembler::GetArchFeatures();
+        }
+    }
+
+    /**
+     * Enables optimizations.
+     *
+     * @pre Optimization::AutoCompress may only be enabled if the policy isn't fixed.
+     */
+    void EnableOptimization(Optimization opt) noexcept {
+        if constexpr (Policy::is_fixed) {
+            BISCUIT_ASSERT(Policy::auto_compress || (opt & Optimization::AutoCompress) == Optimization::None);
+        }
+        Assembler::EnableOptimization(opt);
+    }
+
+    /**
+     * Disables optimizations.
+     *
+     * @pre Optimization::AutoCompress may only be disabled if the policy isn't fixed.
+     */
+    void DisableOptimization(Optimization opt) noexcept {
+        if constexpr (Policy::is_fixed) {
+            BISCUIT_ASSERT(!Policy::auto_compress || (opt & Optimization::AutoCompress) == Optimization::None);
+        }
+        Assembler::DisableOptimization(opt);
+    }
+
+    /**
+     * Enables extensions.
+     *
+     * @pre If the policy is fixed, no compressed extensions beyond those of the policy
+     *      may be enabled.
+     */
+    void EnableExtension(Extension ext) noexcept {
+        if constexpr (Policy::is_fixed) {
+            BISCUIT_ASSERT((ext & compressed_extensions & ~Policy::compressed_extensions) == Extension::None);
+        }
+        Assembler::EnableExtension(ext);
+    }
+
+    /**
+     * Disables extensions.
+     *
+     * @pre If the policy is fixed, none of the compressed extensions of the policy
+     *      may be disabled.
+     */
+    void DisableExtension(Extension ext) noexcept {
+        if constexpr (Policy::is_fixed) {
+            BISCUIT_ASSERT((ext & Policy::compressed_extensions) == Extension::None);
+        }
+        Assembler::DisableExtension(ext);
+    }
+
+    // The overloads that these don't specialize, such as those taking labels,
+    // are still available and check the runtime configuration.
+    using Assembler::BEQ;
+    using Assembler::BEQZ;
+    using Assembler::BGE;
+    using Assembler::BGEU;
+    using Assembler::BGEZ;
+    using Assembler::BGT;
+    using Assembler::BGTU;
+    using Assembler::BGTZ;
+    using Assembler::BLE;
+    using Assembler::BLEU;
+    using Assembler::BLEZ;
+    using Assembler::BLT;
+    using Assembler::BLTU;
+    using Assembler::BLTZ;
+    using Assembler::BNE;
+    using Assembler::BNEZ;
+    using Assembler::LD;
+    using Assembler::LW;
+
+    // RV32I Instructions
+
+    void ADD(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::ADD(*this, rd, lhs, rhs);
+    }
+
+    void ADDI(GPR rd, GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::ADDI(*this, rd, rs, imm);
+    }
+
+    void AND(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::AND(*this, rd, lhs, rhs);
+    }
+
+    void ANDI(GPR rd, GPR rs, uint32_t imm) noexcept {
+        detail::BaseEmitters::ANDI(*this, rd, rs, imm);
+    }
+
+    void AUIPC(GPR rd, int32_t imm) noexcept {
+        detail::BaseEmitters::AUIPC(*this, rd, imm);
+    }
+
+    void BEQ(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BEQ(*this, rs1, rs2, imm);
+    }
+
+    void BEQZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BEQZ(*this, rs, imm);
+    }
+
+    void BGE(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BGE(*this, rs1, rs2, imm);
+    }
+
+    void BGEU(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BGEU(*this, rs1, rs2, imm);
+    }
+
+    void BGEZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BGEZ(*this, rs, imm);
+    }
+
+    void BGT(GPR rs, GPR rt, int32_t imm) noexcept {
+        detail::BaseEmitters::BGT(*this, rs, rt, imm);
+    }
+
+    void BGTU(GPR rs, GPR rt, int32_t imm) noexcept {
+        detail::BaseEmitters::BGTU(*this, rs, rt, imm);
+    }
+
+    void BGTZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BGTZ(*this, rs, imm);
+    }
+
+    void BLE(GPR rs, GPR rt, int32_t imm) noexcept {
+        detail::BaseEmitters::BLE(*this, rs, rt, imm);
+    }
+
+    void BLEU(GPR rs, GPR rt, int32_t imm) noexcept {
+        detail::BaseEmitters::BLEU(*this, rs, rt, imm);
+    }
+
+    void BLEZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BLEZ(*this, rs, imm);
+    }
+
+    void BLT(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BLT(*this, rs1, rs2, imm);
+    }
+
+    void BLTU(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BLTU(*this, rs1, rs2, imm);
+    }
+
+    void BLTZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BLTZ(*this, rs, imm);
+    }
+
+    void BNE(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BNE(*this, rs1, rs2, imm);
+    }
+
+    void BNEZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BNEZ(*this, rs, imm);
+    }
+
+    void LB(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LB(*this, rd, imm, rs);
+    }
+
+    void LBU(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LBU(*this, rd, imm, rs);
+    }
+
+    void LH(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LH(*this, rd, imm, rs);
+    }
+
+    void LHU(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LHU(*this, rd, imm, rs);
+    }
+
+    void LUI(GPR rd, uint32_t imm) noexcept {
+        detail::BaseEmitters::LUI(*this, rd, imm);
+    }
+
+    void LW(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LW(*this, rd, imm, rs);
+    }
+
+    void MV(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::MV(*this, rd, rs);
+    }
+
+    void NEG(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::NEG(*this, rd, rs);
+    }
+
+    void NOP() noexcept {
+        detail::BaseEmitters::NOP(*this);
+    }
+
+    void NOT(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::NOT(*this, rd, rs);
+    }
+
+    void OR(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::OR(*this, rd, lhs, rhs);
+    }
+
+    void ORI(GPR rd, GPR rs, uint32_t imm) noexcept {
+        detail::BaseEmitters::ORI(*this, rd, rs, imm);
+    }
+
+    void SB(GPR rs2, int32_t imm, GPR rs1) noexcept {
+        detail::BaseEmitters::SB(*this, rs2, imm, rs1);
+    }
+
+    void SEQZ(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::SEQZ(*this, rd, rs);
+    }
+
+    void SGT(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SGT(*this, rd, lhs, rhs);
+    }
+
+    void SGTU(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SGTU(*this, rd, lhs, rhs);
+    }
+
+    void SGTZ(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::SGTZ(*this, rd, rs);
+    }
+
+    void SH(GPR rs2, int32_t imm, GPR rs1) noexcept {
+        detail::BaseEmitters::SH(*this, rs2, imm, rs1);
+    }
+
+    void SLL(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SLL(*this, rd, lhs, rhs);
+    }
+
+    void SLLI(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SLLI(*this, rd, rs, shift);
+    }
+
+    void SLT(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SLT(*this, rd, lhs, rhs);
+    }
+
+    void SLTI(GPR rd, GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::SLTI(*this, rd, rs, imm);
+    }
+
+    void SLTIU(GPR rd, GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::SLTIU(*this, rd, rs, imm);
+    }
+
+    void SLTU(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SLTU(*this, rd, lhs, rhs);
+    }
+
+    void SLTZ(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::SLTZ(*this, rd, rs);
+    }
+
+    void SNEZ(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::SNEZ(*this, rd, rs);
+    }
+
+    void SRA(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SRA(*this, rd, lhs, rhs);
+    }
+
+    void SRAI(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SRAI(*this, rd, rs, shift);
+    }
+
+    void SRL(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SRL(*this, rd, lhs, rhs);
+    }
+
+    void SRLI(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SRLI(*this, rd, rs, shift);
+    }
+
+    void SUB(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SUB(*this, rd, lhs, rhs);
+    }
+
+    void SW(GPR rs2, int32_t imm, GPR rs1) noexcept {
+        detail::BaseEmitters::SW(*this, rs2, imm, rs1);
+    }
+
+    void XOR(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::XOR(*this, rd, lhs, rhs);
+    }
+
+    void XORI(GPR rd, GPR rs, uint32_t imm) noexcept {
+        detail::BaseEmitters::XORI(*this, rd, rs, imm);
+    }
+
+    // RV64I Instructions
+
+    void ADDIW(GPR rd, GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::ADDIW(*this, rd, rs, imm);
+    }
+
+    void ADDW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::ADDW(*this, rd, lhs, rhs);
+    }
+
+    void LD(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LD(*this, rd, imm, rs);
+    }
+
+    void LWU(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LWU(*this, rd, imm, rs);
+    }
+
+    void NEGW(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::NEGW(*this, rd, rs);
+    }
+
+    void SD(GPR rs2, int32_t imm, GPR rs1) noexcept {
+        detail::BaseEmitters::SD(*this, rs2, imm, rs1);
+    }
+
+    void SLLIW(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SLLIW(*this, rd, rs, shift);
+    }
+
+    void SRAIW(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SRAIW(*this, rd, rs, shift);
+    }
+
+    void SRLIW(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SRLIW(*this, rd, rs, shift);
+    }
+
+    void SLLW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SLLW(*this, rd, lhs, rhs);
+    }
+
+    void SRAW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SRAW(*this, rd, lhs, rhs);
+    }
+
+    void SRLW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SRLW(*this, rd, lhs, rhs);
+    }
+
+    void SUBW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SUBW(*this, rd, lhs, rhs);
+    }
+
+private:
+    friend struct detail::BaseEmitters;
+    template <typename AssemblerType>
+    friend class ReservedEmitter;
+
+    static constexpr Extension compressed_extensions = Extension::Zca | Extension::Zcb |
+                                                       Extension::Zcd | Extension::Zcf;
+
+    // Brings the runtime configuration in line with the compile-time one.
+    void Configure(ArchFeature features) noexcept {
+        if constexpr (X != Xlen::Runtime) {
+            BISCUIT_ASSERT(features == default_features);
+        }
+        Assembler::SetArchFeatures(features);
+
+        if constexpr (Policy::is_fixed) {
+            if constexpr (Policy::auto_compress) {
+                Assembler::EnableOptimization(Optimization::AutoCompress);
+            } else {
+                Assembler::DisableOptimization(Optimization::AutoCompress);
+            }
+            Assembler::DisableExtension(compressed_extensions);
+            Assembler::EnableExtension(Policy::compressed_extensions);
+        }
+    }
+
+    [[nodiscard]] bool CanCompress(Extension ext) const noexcept {
+        if constexpr (Policy::is_fixed) {
+            return Policy::auto_compress && (Policy::compressed_extensions & ext) == ext;
+        } else {
+            return IsOptimizationEnabled(Optimization::AutoCompress) && IsExtensionEnabled(ext);
+        }
+    }
+};
+
+} // namespace biscuit
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+#include <biscuit/assert.hpp>
+#include <biscuit/code_buffer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace biscuit {
+
+/**
+ * A region of executable memory that multiple threads can emit code into at once.
+ *
+ * Each thread emits through its own CodeArena::Worker, which claims private chunks
+ * of the arena with a single atomic bump of a shared offset. Emission itself never
+ * touches shared state, so threads don't need to synchronize with each other
+ * beyond claiming a chunk every once in a while.
+ *
+ * @par
+ * An example of compiling on a background thread:
+ * @code{.cpp}
+ * CodeArena arena{256 * 1024 * 1024, CodeBufferBacking::DualMapped};
+ *
+ * // On each compilation thread:
+ * auto worker = arena.CreateWorker();
+ * for (auto& function : queue) {
+ *     Assembler* as = worker.Begin(function.max_code_size);
+ *     Compile(*as, function);
+ *     function.pending_entry = worker.End();
+ * }
+ *
+ * // Synchronize the instruction cache for everything emitted so far once,
+ * // then hand the entry points over to the executing threads.
+ * worker.Publish();
+ * for (auto& function : queue) {
+ *     function.entry.store(function.pending_entry, std::memory_order_release);
+ * }
+ * @endcode
+ *
+ * @note Chunks are never returned to the arena. Freeing code is left up to
+ *       dropping the whole arena, e.g. when flushing a translation cache.
+ */
+class CodeArena {
+public:
+    // Default chunk size of 64KB.
+    static constexpr size_t default_chunk_size = 64 * 1024;
+
+    /**
+     * A thread's handle for emitting code into a CodeArena.
+     *
+     * @note A worker may only be used by one thread at a time, and must
+     *       not outlive the arena it was created from.
+     */
+    class Worker {
+    public:
+        Worker(const Worker&) = delete;
+        Worker& operator=(const Worker&) = delete;
+
+        Worker(Worker&&) = default;
+        Worker& operator=(Worker&&) = default;
+
+        /**
+         * Begins emitting a run of code, e.g. a single function or translated block.
+         *
+         * @param max_size The largest number of bytes the code may take up, including
+         *                 anything placed when the run is finalized by End().
+         *
+         * @returns The assembler to emit the code with, positioned at a location that
+         *          has at least `max_size` bytes of space. If the arena has run out of
+         *          chunks to hand out, then nullptr is returned instead.
+         *
+         * @pre `max_size` must not be zero.
+         * @pre Labels and literals must not be shared between separate runs of code,
+         *      as the run may be placed in a different chunk than the previous one.
+         */
+        [[nodiscard]] Assembler* Begin(size_t max_size);
+
+        /**
+         * Finishes the run of code started with Begin().
+         *
+         * The assembler is finalized (see Assembler::Finalize()), so that nothing
+         * pending for the run, such as literal pool constants or jump veneers, is
+         * carried over into a run that may be placed in a different chunk.
+         *
+         * @returns The executable address of the start of the run.
+         *
+         * @note The code may not be executed before a call to Publish().
+         */
+        uintptr_t End();
+
+        /**
+         * Makes all code finished since the last call to Publish() executable.
+         *
+         * The instruction cache is synchronized for all of that code at once, followed
+         * by a release fence. Any thread that observes a store made after this call
+         * with acquire ordering (e.g. of an entry point returned by End()) may then
+         * execute the code.
+         */
+        void Publish();
+
+        /// Retrieves the assembler used by this worker.
+        [[nodiscard]] Assembler& GetAssembler() noexcept {
+            return m_assembler;
+        }
+
+    private:
+        friend class CodeArena;
+
+        Worker(CodeArena& arena, ArchFeature features);
+
+        CodeArena* m_arena;
+        Assembler m_assembler;
+        uintptr_t m_run_start = 0;
+    };
+
+    /**
+     * Constructor
+     *
+     * @param capacity   The size of the arena in bytes.
+     * @param backing    The kind of memory to back the arena with.
+     * @param chunk_size The number of bytes workers claim at a time.
+     *
+     * @pre `chunk_size` must be a non-zero multiple of 64, so that
+     *      chunks of different workers never share a cache line.
+     */
+    explicit CodeArena(size_t capacity,
+                       CodeBufferBacking backing = CodeBufferBacking::Default,
+                       size_t chunk_size = default_chunk_size);
+
+    CodeArena(const CodeArena&) = delete;
+    CodeArena& operator=(const CodeArena&) = delete;
+    CodeArena(CodeArena&&) = delete;
+    CodeArena& operator=(CodeArena&&) = delete;
+
+    /**
+     * Creates a worker for emitting code into the arena from the calling thread.
+     *
+     * @param features Architectural features to make the worker's assembler aware of.
+     */
+    [[nodiscard]] Worker CreateWorker(ArchFeature features = ArchFeature::RV64) {
+        return Worker{*this, features};
+    }
+
+    /// Retrieves the number of bytes chunks can be claimed from.
+    [[nodiscard]] size_t GetCapacity() const noexcept {
+        return m_capacity;
+    }
+
+    /// Retrieves the number of bytes workers claim at a time.
+    [[nodiscard]] size_t GetChunkSize() const noexcept {
+        return m_chunk_size;
+    }
+
+    /// Retrieves the number of bytes claimed by workers so far.
+    [[nodiscard]] size_t GetClaimedBytes() const noexcept {
+        return std::min(m_next_offset.load(std::memory_order_relaxed), m_capacity);
+    }
+
+    /**
+     * Retrieves the code buffer backing the whole arena, e.g. to change
+     * the page protections of all chunks at once.
+     */
+    [[nodiscard]] CodeBuffer& GetRegion() noexcept {
+        return m_region;
+    }
+
+private:
+    // Claims a run of at least `size` bytes, rounded up to whole chunks.
+    [[nodiscard]] std::optional<CodeBuffer> ClaimChunk(size_t size) noexcept;
+
+    CodeBuffer m_region;
+    size_t m_base_offset = 0;
+    size_t m_capacity = 0;
+    size_t m_chunk_size = 0;
+
+    // Kept on its own cache line, as this is the only state workers contend on.
+    alignas(64) std::atomic<size_t> m_next_offset{0};
+};
+
+} // namespace biscuit
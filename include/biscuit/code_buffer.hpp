@@ -3,12 +3,62 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 #include <biscuit/assert.hpp>
 
 namespace biscuit {
 
+/**
+ * The kind of memory that a code buffer which manages its own memory is backed by.
+ */
+enum class CodeBufferBacking : uint32_t {
+    /// Memory allocated with new[], or mmap if BISCUIT_CODE_BUFFER_MMAP is enabled.
+    Default,
+
+    /**
+     * The same pages mapped twice, once as read/write and once as read/execute.
+     *
+     * Code is written and patched through the writable view, while all addresses
+     * reported by the code buffer (e.g. GetCursorAddress()) refer to the executable
+     * view. This means code can be executed without ever changing page protections,
+     * so SetExecutable() and SetWritable() do nothing for these buffers.
+     *
+     * Like CodeBufferBacking::Reserved, both views are placed in a range of address
+     * space reserved up front, so growing the buffer doesn't move either of them.
+     *
+     * @note Only supported on Linux (see CodeBuffer::IsBackingSupported()).
+     */
+    DualMapped,
+
+    /**
+     * A large range of address space that is reserved up front, with pages
+     * only being committed as the buffer grows into them. The buffer's
+     * address never changes when growing, up to the reserved size.
+     *
+     * @note Only supported on Linux (see CodeBuffer::IsBackingSupported()).
+     */
+    Reserved,
+
+    /**
+     * Like CodeBufferBacking::Reserved, but backed by 2MB huge pages where possible,
+     * which greatly reduces the number of instruction TLB entries large amounts of
+     * code take up.
+     *
+     * Explicit huge pages (MAP_HUGETLB) are tried first, which requires the huge page
+     * pool to be able to cover the whole reserved size up front. Otherwise, a 2MB
+     * aligned reservation is requested to be backed by transparent huge pages, which
+     * the kernel may or may not honor. GetRequestedPageSize() reports which of these
+     * was requested, while whether transparent huge pages were actually obtained is
+     * only visible in the AnonHugePages count of /proc/self/smaps.
+     *
+     * @note Only supported on Linux (see CodeBuffer::IsBackingSupported()).
+     */
+    HugePages,
+};
+
 /**
  * An arbitrarily sized buffer that code is written into.
  *
@@ -20,6 +70,118 @@ public:
     // Default capacity of 4KB.
     static constexpr size_t default_capacity = 4096;
 
+    // Default amount of address space reserved by reserving backings (1GB).
+    static constexpr size_t default_reserve_size = size_t{1} << 30;
+
+    // Size of the huge pages requested by CodeBufferBacking::HugePages (2MB).
+    static constexpr size_t huge_page_size = size_t{2} << 20;
+
+    // Dirty ranges closer together than this are flushed as one (4KB).
+    static constexpr size_t icache_coalesce_gap = 4096;
+
+    /// A range of bytes within a code buffer.
+    struct Range {
+        ptrdiff_t offset;
+        size_t size;
+    };
+
+    /**
+     * A run of bytes reserved at the cursor of a code buffer, which can be emitted
+     * into without checking the capacity of the buffer on every write.
+     *
+     * Obtained through CodeBuffer::Reserve(). Once the reservation goes out of scope,
+     * the cursor of the code buffer is moved past everything emitted through it.
+     *
+     * @par
+     * An example of emitting a fixed-size run of instructions:
+     * @code{.cpp}
+     * {
+     *     auto reservation = buffer.Reserve(encoded.size() * sizeof(uint32_t));
+     *     for (const uint32_t instruction : encoded) {
+     *         reservation.Emit32(instruction);
+     *     }
+     * }
+     * @endcode
+     *
+     * @note The code buffer itself may not be emitted into or have its cursor
+     *       moved while a reservation on it is alive, other than through
+     *       EmitThroughBuffer(). See ReservedEmitter for emitting instructions
+     *       of an assembler into a reservation.
+     */
+    class Reservation {
+    public:
+        ~Reservation() noexcept {
+            BISCUIT_ASSERT(m_buffer.m_cursor == m_start);
+            BISCUIT_ASSERT(m_cursor <= m_end);
+            m_buffer.m_cursor = m_cursor;
+        }
+
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+        Reservation(Reservation&&) = delete;
+        Reservation& operator=(Reservation&&) = delete;
+
+        /// Retrieves the offset within the code buffer that the next write goes to.
+        [[nodiscard]] ptrdiff_t GetCursorOffset() const noexcept {
+            return m_cursor - m_buffer.m_buffer;
+        }
+
+        /**
+         * Emits a given value into the reserved bytes.
+         *
+         * @param value The value to emit.
+         * @tparam T    A trivially-copyable type.
+         */
+        template <typename T>
+        void Emit(T value) noexcept {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "It's undefined behavior to memcpy a non-trivially-copyable type.");
+
+            std::memcpy(m_cursor, &value, sizeof(T));
+            m_cursor += sizeof(T);
+        }
+
+        /// Emits a 16-bit value into the reserved bytes.
+        void Emit16(uint32_t value) noexcept {
+            Emit(static_cast<uint16_t>(value));
+        }
+
+        /// Emits a 32-bit value into the reserved bytes.
+        void Emit32(uint32_t value) noexcept {
+            Emit(value);
+        }
+
+        /**
+         * Lets `func` emit through the code buffer itself at the cursor of the
+         * reservation, e.g. for an assembler method that only writes to the code
+         * buffer, and continues the reservation after whatever it emitted.
+         *
+         * @pre `func` may emit at most as many bytes as are left in the reservation.
+         */
+        template <typename Func>
+        void EmitThroughBuffer(Func&& func) {
+            m_buffer.m_cursor = m_cursor;
+            func();
+            m_cursor = m_buffer.m_cursor;
+            m_buffer.m_cursor = m_start;
+            BISCUIT_ASSERT(m_cursor <= m_end);
+        }
+
+    private:
+        friend class CodeBuffer;
+
+        Reservation(CodeBuffer& buffer, size_t num_bytes) noexcept
+            : m_buffer{buffer}
+            , m_start{buffer.m_cursor}
+            , m_cursor{buffer.m_cursor}
+            , m_end{buffer.m_cursor + num_bytes} {}
+
+        CodeBuffer& m_buffer;
+        uint8_t* m_start;
+        uint8_t* m_cursor;
+        uint8_t* m_end;
+    };
+
     /**
      * Constructor
      *
@@ -27,6 +189,19 @@ public:
      */
     explicit CodeBuffer(size_t capacity = default_capacity);
 
+    /**
+     * Constructor
+     *
+     * @param capacity     The initial capacity of the code buffer in bytes.
+     * @param backing      The kind of memory to back the code buffer with.
+     * @param reserve_size The amount of address space to reserve for backings that
+     *                     reserve address space up front. Ignored otherwise.
+     *
+     * @pre `backing` must be supported on the host (see IsBackingSupported()).
+     */
+    explicit CodeBuffer(size_t capacity, CodeBufferBacking backing,
+                        size_t reserve_size = default_reserve_size);
+
     /**
      * Constructor
      *
@@ -41,6 +216,21 @@ public:
      */
     explicit CodeBuffer(uint8_t* buffer, size_t capacity);
 
+    /**
+     * Constructor
+     *
+     * @param buffer      A non-null pointer to writable memory of size `capacity`.
+     * @param exec_buffer A non-null pointer to an executable view of the same memory.
+     * @param capacity    The capacity of the memory pointed to by both pointers.
+     *
+     * Like CodeBufferBacking::DualMapped buffers, all addresses reported by the code
+     * buffer refer to `exec_buffer`, while code is written through `buffer`.
+     *
+     * @note The caller is responsible for managing the lifetime of the given memory.
+     *       CodeBuffer will *not* free the memory once it goes out of scope.
+     */
+    explicit CodeBuffer(uint8_t* buffer, uint8_t* exec_buffer, size_t capacity);
+
     // Copy constructor and assignment is deleted in order to prevent unintentional memory leaks.
     CodeBuffer(const CodeBuffer&) = delete;
     CodeBuffer& operator=(const CodeBuffer&) = delete;
@@ -61,6 +251,51 @@ public:
     /// Returns whether or not the memory is managed by the code buffer.
     [[nodiscard]] bool IsManaged() const noexcept { return m_is_managed; }
 
+    /// Returns whether or not the code buffer has separate writable and executable views.
+    [[nodiscard]] bool IsDualMapped() const noexcept { return m_backing == CodeBufferBacking::DualMapped; }
+
+    /// Returns the kind of memory backing the code buffer.
+    [[nodiscard]] CodeBufferBacking GetBacking() const noexcept { return m_backing; }
+
+    /// Returns whether or not the given backing can be used on this host.
+    [[nodiscard]] static bool IsBackingSupported(CodeBufferBacking backing) noexcept;
+
+    /**
+     * Returns the size of the pages that were requested to back the code buffer in bytes.
+     *
+     * For CodeBufferBacking::HugePages this is huge_page_size if either explicit huge
+     * pages were obtained, or transparent huge pages were requested and are enabled on
+     * the host. Otherwise this is the regular page size of the host.
+     *
+     * @note With transparent huge pages, the kernel decides when faulting pages in
+     *       whether they're actually backed by huge pages, so they may still end up
+     *       being regular pages. Only explicit huge pages are guaranteed, see
+     *       IsUsingExplicitHugePages().
+     */
+    [[nodiscard]] size_t GetRequestedPageSize() const noexcept { return m_requested_page_size; }
+
+    /// Returns whether or not the code buffer is backed by explicit (MAP_HUGETLB) huge pages.
+    [[nodiscard]] bool IsUsingExplicitHugePages() const noexcept { return m_is_hugetlb; }
+
+    /// Returns whether or not the buffer grows automatically when running out of space.
+    [[nodiscard]] bool IsAutoGrowEnabled() const noexcept { return m_auto_grow; }
+
+    /**
+     * Sets whether or not the buffer grows automatically when running out of space,
+     * instead of asserting. Disabled by default.
+     *
+     * The capacity at least doubles on every growth, so that emitting code stays
+     * amortized constant time. Offsets within the buffer (and therefore bound labels
+     * and placed literals) remain valid across growths. Pointers into the buffer only
+     * remain valid for reserving backings (i.e. all but CodeBufferBacking::Default).
+     *
+     * @pre The underlying memory of the code buffer must be managed by the code buffer.
+     */
+    void SetAutoGrow(bool enabled) noexcept {
+        BISCUIT_ASSERT(!enabled || IsManaged());
+        m_auto_grow = enabled;
+    }
+
     /// Retrieves the current cursor position within the buffer.
     [[nodiscard]] ptrdiff_t GetCursorOffset() const noexcept {
         return m_cursor - m_buffer;
@@ -82,14 +317,21 @@ public:
     }
 
     /// Sets the cursor pointer
-    void SetCursorPointer(uint8_t* ptr) noexcept {
+    void SetCursorPointer(uint8_t* ptr) {
         BISCUIT_ASSERT(ptr >= m_buffer && ptr < m_buffer + m_capacity);
-        m_cursor = ptr;
+        MoveCursor(ptr);
     }
 
-    /// Retrieves the address of an arbitrary offset within the buffer.
+    /**
+     * Retrieves the address of an arbitrary offset within the buffer.
+     *
+     * @note For dual-mapped buffers this is the address within the executable
+     *       view, which may not be written to. Use GetOffsetPointer() to
+     *       get a writable pointer instead.
+     */
     [[nodiscard]] uintptr_t GetOffsetAddress(ptrdiff_t offset) const noexcept {
-        return reinterpret_cast<uintptr_t>(GetOffsetPointer(offset));
+        const auto* pointer = GetOffsetPointer(offset);
+        return reinterpret_cast<uintptr_t>(m_exec_buffer + (pointer - m_buffer));
     }
 
     /// Retrieves the pointer to an arbitrary location within the buffer.
@@ -117,10 +359,10 @@ public:
      * @note The offset may not be larger than the current cursor offset
      *       and may not be less than the current buffer starting address.
      */
-    void RewindCursor(ptrdiff_t offset = 0) noexcept {
+    void RewindCursor(ptrdiff_t offset = 0) {
         auto* rewound = m_buffer + offset;
         BISCUIT_ASSERT(m_buffer <= rewound && rewound <= m_cursor);
-        m_cursor = rewound;
+        MoveCursor(rewound);
     }
 
     /**
@@ -131,10 +373,10 @@ public:
      * @note The offset may not be smaller than the current cursor offset 
      *       and may not be larger than the current buffer capacity.
      */
-    void AdvanceCursor(ptrdiff_t offset) noexcept {
+    void AdvanceCursor(ptrdiff_t offset) {
         auto* forward = m_buffer + offset;
-        BISCUIT_ASSERT(m_cursor <= forward && forward < m_buffer + m_capacity);
-        m_cursor = forward;
+        BISCUIT_ASSERT(m_cursor <= forward && forward <= m_buffer + m_capacity);
+        MoveCursor(forward);
     }
 
     /**
@@ -172,9 +414,25 @@ public:
      * @note Calling this with a new capacity that is less than or equal
      *       to the current capacity of the buffer will result in
      *       this function doing nothing.
+     *
+     * @note For reserving backings, the new capacity may not exceed the
+     *       amount of address space that was reserved.
      */
     void Grow(size_t new_capacity);
 
+    /**
+     * Reserves the given number of bytes at the cursor, so that they can be
+     * emitted without any further capacity checks. See Reservation.
+     *
+     * @param num_bytes The number of bytes to reserve.
+     *
+     * @pre The buffer must have space for `num_bytes`.
+     */
+    [[nodiscard]] Reservation Reserve(size_t num_bytes) {
+        EnsureSpaceFor(num_bytes);
+        return Reservation{*this, num_bytes};
+    }
+
     /**
      * Emits a given value into the code buffer.
      *
@@ -185,7 +443,8 @@ public:
     void Emit(T value) noexcept {
         static_assert(std::is_trivially_copyable_v<T>,
                       "It's undefined behavior to memcpy a non-trivially-copyable type.");
-        BISCUIT_ASSERT(HasSpaceFor(sizeof(T)));
+
+        EnsureSpaceFor(sizeof(T));
 
         std::memcpy(m_cursor, &value, sizeof(T));
         m_cursor += sizeof(T);
@@ -201,12 +460,78 @@ public:
         Emit(value);
     }
 
+    /**
+     * Emits an arbitrary run of bytes into the code buffer.
+     *
+     * @param data      A pointer to the bytes to emit.
+     * @param num_bytes The number of bytes to emit.
+     *
+     * @note `data` may not point into the region being written to.
+     */
+    void EmitBytes(const void* data, size_t num_bytes) noexcept {
+        EnsureSpaceFor(num_bytes);
+
+        std::memcpy(m_cursor, data, num_bytes);
+        m_cursor += num_bytes;
+    }
+
+    /**
+     * Marks a range of the buffer as modified, so that FlushICache() covers it.
+     *
+     * Everything emitted at the cursor is tracked automatically. This only needs to
+     * be called after writing to the buffer through a pointer, e.g. when patching
+     * previously emitted code via GetOffsetPointer().
+     *
+     * @param offset The offset of the first modified byte.
+     * @param size   The number of modified bytes.
+     */
+    void MarkDirty(ptrdiff_t offset, size_t size) {
+        // Patches within the code emitted since the last flush are common
+        // (e.g. branches to labels bound shortly after), and already covered.
+        if (offset >= m_emit_start && offset + static_cast<ptrdiff_t>(size) <= GetCursorOffset()) {
+            return;
+        }
+        AddDirtyRange({offset, size});
+    }
+
+    /**
+     * Determines whether or not anything has been written to the buffer
+     * since the last call to FlushICache().
+     */
+    [[nodiscard]] bool HasDirtyRanges() const noexcept {
+        return !m_dirty_ranges.empty() || GetCursorOffset() > m_emit_start;
+    }
+
+    /**
+     * Retrieves the ranges of the buffer that have been written to since the last
+     * call to FlushICache(), sorted by offset and with nearby ranges merged.
+     *
+     * @note The returned span is invalidated by any further modification of the buffer.
+     */
+    [[nodiscard]] std::span<const Range> GetDirtyRanges();
+
+    /**
+     * Makes everything written to the buffer since the last call visible
+     * to instruction fetch on every hart of the process.
+     *
+     * Modified ranges are sorted and merged first, so that as few cache
+     * maintenance operations (system calls on RISC-V Linux) as possible
+     * are issued. Ranges less than `icache_coalesce_gap` bytes apart are
+     * merged, as flushing a few extra bytes is far cheaper than another call.
+     *
+     * @returns The number of ranges that were flushed.
+     */
+    size_t FlushICache();
+
     /**
      * Sets the internal code buffer to be executable.
      *
      * @note This will make the contained region of memory non-writable
      *       to satisfy operating under W^X contexts. To make the
      *       region writable again, use SetWritable().
+     *
+     * @note Dual-mapped buffers are always executable through their
+     *       executable view, so this does nothing for them.
      */
     void SetExecutable();
 
@@ -216,6 +541,9 @@ public:
      * @note This will make the contained region of memory non-executable
      *       to satisfy operating under W^X contexts. To make the region
      *       executable again, use SetExecutable().
+     *
+     * @note Dual-mapped buffers are always writable through their
+     *       writable view, so this does nothing for them.
      */
     void SetWritable();
 
@@ -224,10 +552,70 @@ private:
         BISCUIT_ASSERT(m_cursor >= m_buffer && m_cursor <= m_buffer + m_capacity);
     }
 
+    // Makes sure there's room for the given number of bytes, growing the buffer if allowed.
+    void EnsureSpaceFor(size_t num_bytes) {
+        // The cursor never leaves the buffer, so checking the remaining space suffices.
+        if (num_bytes > static_cast<size_t>(m_buffer + m_capacity - m_cursor)) [[unlikely]] {
+            GrowFor(num_bytes);
+        }
+    }
+
+    // Moves the cursor, noting everything emitted at the old position as dirty.
+    void MoveCursor(uint8_t* cursor) {
+        if (m_cursor != cursor) {
+            NoteEmittedRange();
+            m_cursor = cursor;
+            m_emit_start = GetCursorOffset();
+        }
+    }
+
+    // Adds everything emitted since the cursor was last moved to the dirty ranges.
+    void NoteEmittedRange();
+
+    void AddDirtyRange(Range range);
+    void CoalesceDirtyRanges();
+
+    // Grows the buffer geometrically so that it has room for the given number of bytes.
+    void GrowFor(size_t num_bytes);
+
+    // Sets up the address space reservation (and views) for reserving backings.
+    void MapReservation();
+
+    // Sets up the 2MB aligned reservation for CodeBufferBacking::HugePages.
+    void MapHugePageReservation();
+
+    // Makes the first `capacity` bytes of a reserving backing usable.
+    void CommitReservation(size_t capacity);
+
     uint8_t* m_buffer = nullptr;
     uint8_t* m_cursor = nullptr;
+
+    // The executable view of the memory. Same as m_buffer, unless dual-mapped.
+    uint8_t* m_exec_buffer = nullptr;
+
     size_t m_capacity = 0;
+
+    // The amount of address space reserved for reserving backings, otherwise 0.
+    size_t m_reserve_size = 0;
+
+    // The memory file backing both views of a dual-mapped buffer, otherwise -1.
+    int m_fd = -1;
+
+    // Where the cursor was when it was last moved or the buffer last flushed.
+    // Everything between here and the cursor is implicitly dirty, which keeps
+    // tracking out of the emission path entirely.
+    ptrdiff_t m_emit_start = 0;
+
+    // Explicitly tracked dirty ranges, other than the ones implied above.
+    std::vector<Range> m_dirty_ranges;
+
+    // The size of the pages requested to back the buffer.
+    size_t m_requested_page_size = 4096;
+
+    CodeBufferBacking m_backing = CodeBufferBacking::Default;
     bool m_is_managed = false;
+    bool m_auto_grow = false;
+    bool m_is_hugetlb = false;
 };
 
 } // namespace biscuit
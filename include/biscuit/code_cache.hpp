@@ -0,0 +1,151 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+#include <biscuit/relocation.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace biscuit {
+
+/**
+ * Identifies the configuration that cached code was generated for.
+ *
+ * A code cache is only ever loaded if its key matches the key of the
+ * loading process exactly, so that code using instructions the host
+ * doesn't support, or code from an outdated code generator, is never run.
+ */
+struct CodeCacheKey {
+    /// Creates a key for the configuration of the given assembler.
+    [[nodiscard]] static CodeCacheKey For(const Assembler& as, uint64_t user_tag = 0) noexcept {
+        return {as.GetArchFeatures(), as.GetEnabledExtensions(), user_tag};
+    }
+
+    [[nodiscard]] bool operator==(const CodeCacheKey&) const noexcept = default;
+
+    ArchFeature features = ArchFeature::RV64;
+    Extension extensions = Extension::None;
+
+    /// Identifies anything else the code depends on, e.g. a hash of the code generator's version.
+    uint64_t user_tag = 0;
+};
+
+/**
+ * Reasons for a code cache being rejected when loading it.
+ */
+enum class CodeCacheError : uint32_t {
+    None,
+
+    /// The file couldn't be opened, read or mapped.
+    IOError,
+
+    /// The file isn't a code cache, or is truncated.
+    InvalidFormat,
+
+    /// The file was written by a different version of biscuit.
+    VersionMismatch,
+
+    /// The file was written for a different CodeCacheKey.
+    KeyMismatch,
+
+    /// The contents of the file don't match the checksum in its header.
+    ChecksumMismatch,
+
+    /// A relocation refers to a symbol that no address was provided for.
+    UnresolvedSymbol,
+
+    /**
+     * A PC-relative relocation can't reach its target from where the code was loaded,
+     * e.g. a CALL to a host function that is more than 2GB away from the mapping.
+     */
+    RelocationOutOfRange,
+};
+
+/**
+ * Serializes the code emitted by an assembler, along with its relocations
+ * (see Assembler::GetRelocations()), into the code cache file format.
+ *
+ * The format consists of a 64-byte header holding the biscuit version, the key,
+ * sizes and a checksum, followed by the code and then the relocation records.
+ * All values are stored in little-endian byte order.
+ *
+ * @pre All labels must be bound and no literal pool constants may be pending.
+ */
+[[nodiscard]] std::vector<uint8_t> SerializeCodeCache(Assembler& as, const CodeCacheKey& key);
+
+/**
+ * Writes the output of SerializeCodeCache() to a file.
+ *
+ * @returns Whether or not the whole file could be written.
+ */
+[[nodiscard]] bool WriteCodeCache(const char* path, Assembler& as, const CodeCacheKey& key);
+
+/**
+ * Code loaded from a code cache file, ready to be executed.
+ *
+ * The file is mapped privately, relocated in place and then made executable,
+ * so no code has to be emitted again. Offsets within the code are the same
+ * as the offsets within the code buffer of the assembler that emitted it.
+ */
+class CodeCache {
+public:
+    /**
+     * Loads a code cache file.
+     *
+     * @param path    The path of the file to load.
+     * @param key     The key the file has to have been written with.
+     * @param symbols The addresses of all symbols referred to by relocations,
+     *                indexed by symbol identifier. code_base_symbol and
+     *                absolute_symbol are resolved automatically.
+     * @param error   If not null, receives the reason for rejecting the file.
+     *
+     * @returns An empty optional if the file was rejected.
+     *
+     * @note Only supported on Linux. On other hosts, CodeCacheError::IOError
+     *       is always reported.
+     */
+    [[nodiscard]] static std::optional<CodeCache> Load(const char* path, const CodeCacheKey& key,
+                                                       std::span<const uint64_t> symbols,
+                                                       CodeCacheError* error = nullptr);
+
+    CodeCache(const CodeCache&) = delete;
+    CodeCache& operator=(const CodeCache&) = delete;
+
+    CodeCache(CodeCache&& other) noexcept;
+    CodeCache& operator=(CodeCache&& other) noexcept;
+
+    ~CodeCache() noexcept;
+
+    /// Retrieves the address of an offset within the loaded code.
+    [[nodiscard]] uintptr_t GetOffsetAddress(ptrdiff_t offset) const noexcept {
+        BISCUIT_ASSERT(offset >= 0 && static_cast<size_t>(offset) < m_code_size);
+        return reinterpret_cast<uintptr_t>(m_mapping + code_offset + offset);
+    }
+
+    /// Retrieves the size of the loaded code in bytes.
+    [[nodiscard]] size_t GetSizeInBytes() const noexcept {
+        return m_code_size;
+    }
+
+    /// Retrieves the relocations that were applied to the loaded code.
+    [[nodiscard]] std::span<const Relocation> GetRelocations() const noexcept {
+        return m_relocations;
+    }
+
+private:
+    // Code follows right after the header.
+    static constexpr size_t code_offset = 64;
+
+    CodeCache(uint8_t* mapping, size_t mapping_size, size_t code_size,
+              std::vector<Relocation> relocations) noexcept;
+
+    uint8_t* m_mapping = nullptr;
+    size_t m_mapping_size = 0;
+    size_t m_code_size = 0;
+    std::vector<Relocation> m_relocations;
+};
+
+} // namespace biscuit
@@ -0,0 +1,339 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+#include <biscuit/assert.hpp>
+#include <biscuit/code_buffer.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace biscuit {
+
+/**
+ * A reference to a block of code allocated from a CodeHeap.
+ *
+ * Handles stay cheap to copy and compare, and are able to detect when the
+ * block they refer to has been freed or evicted (see CodeHeap::IsLive()).
+ */
+class CodeBlockHandle {
+public:
+    constexpr CodeBlockHandle() noexcept = default;
+    constexpr CodeBlockHandle(uint32_t index, uint32_t serial) noexcept
+        : m_index{index}, m_serial{serial} {}
+
+    /// Retrieves the index of the block record within its heap.
+    [[nodiscard]] constexpr uint32_t Index() const noexcept { return m_index; }
+
+    /// Retrieves the serial number that distinguishes reuses of the same block record.
+    [[nodiscard]] constexpr uint32_t Serial() const noexcept { return m_serial; }
+
+    /// Determines whether or not this handle was ever assigned a block.
+    [[nodiscard]] constexpr bool IsValid() const noexcept { return m_index != invalid_index; }
+
+    [[nodiscard]] constexpr bool operator==(const CodeBlockHandle&) const noexcept = default;
+
+private:
+    static constexpr uint32_t invalid_index = UINT32_MAX;
+
+    uint32_t m_index = invalid_index;
+    uint32_t m_serial = 0;
+};
+
+/**
+ * How a CodeHeap makes room for an allocation once it is full.
+ */
+enum class CodeHeapEviction : uint32_t {
+    /// Never evict blocks. Allocations fail once there is no space left.
+    None,
+
+    /**
+     * Evict the least recently used blocks, one at a time, until the allocation fits.
+     * Blocks are considered used when allocated or passed to CodeHeap::Touch().
+     */
+    LeastRecentlyUsed,
+
+    /**
+     * Evict all blocks of the oldest generation at once, until the allocation fits.
+     * A new generation is started with CodeHeap::NextGeneration().
+     */
+    Generation,
+};
+
+/**
+ * A heap of executable memory that individual blocks of code are allocated from.
+ *
+ * Blocks are carved out of a single code buffer, aligned to the alignment the heap
+ * was constructed with. Free space is kept in lists segregated by power-of-two size
+ * classes, so finding a fitting block takes constant time regardless of how many
+ * blocks are live. Freed blocks are merged with adjacent free blocks right away,
+ * which keeps fragmentation in check.
+ *
+ * Each block can be assembled into by getting a code buffer or assembler that views
+ * only that block (see GetCodeBuffer() and GetAssembler()).
+ *
+ * @par
+ * An example of translating a block of guest code:
+ * @code{.cpp}
+ * CodeHeap heap{64 * 1024 * 1024, CodeBufferBacking::DualMapped};
+ * heap.SetEvictionPolicy(CodeHeapEviction::LeastRecentlyUsed);
+ * heap.SetEvictionCallback([&](CodeBlockHandle block) { UnlinkBlock(block); });
+ *
+ * const auto block = heap.AllocateOrEvict(max_block_size);
+ * auto as = heap.GetAssembler(block);
+ * TranslateBlock(as);
+ * heap.Shrink(block, as.GetCodeBuffer().GetSizeInBytes());
+ * @endcode
+ */
+class CodeHeap {
+public:
+    // Default block alignment of 64 bytes, which is a cache line on most hosts.
+    static constexpr size_t default_alignment = 64;
+
+    using EvictionCallback = std::function<void(CodeBlockHandle)>;
+
+    /**
+     * Constructor
+     *
+     * @param capacity  The size of the heap in bytes.
+     * @param backing   The kind of memory to back the heap with.
+     * @param alignment The alignment of every block in bytes.
+     *
+     * @pre `alignment` must be a power of two that is at least 4.
+     * @pre `capacity` must be able to hold at least one aligned block.
+     */
+    explicit CodeHeap(size_t capacity,
+                      CodeBufferBacking backing = CodeBufferBacking::Default,
+                      size_t alignment = default_alignment);
+
+    CodeHeap(const CodeHeap&) = delete;
+    CodeHeap& operator=(const CodeHeap&) = delete;
+
+    CodeHeap(CodeHeap&&) = default;
+    CodeHeap& operator=(CodeHeap&&) = default;
+
+    /**
+     * Allocates a block of at least `size` bytes.
+     *
+     * @returns An empty optional if there is no free space large enough.
+     *          Blocks are never evicted by this function.
+     */
+    [[nodiscard]] std::optional<CodeBlockHandle> Allocate(size_t size);
+
+    /**
+     * Allocates a block of at least `size` bytes, evicting blocks according
+     * to the eviction policy until there is enough space for it.
+     *
+     * @pre The eviction policy must not be CodeHeapEviction::None.
+     * @pre `size` must fit within the heap's capacity.
+     */
+    [[nodiscard]] CodeBlockHandle AllocateOrEvict(size_t size);
+
+    /**
+     * Returns a block to the heap.
+     *
+     * @pre The block must be live.
+     */
+    void Free(CodeBlockHandle block) noexcept;
+
+    /**
+     * Shrinks a block to `size` bytes, returning the remainder to the heap.
+     *
+     * Useful for allocating a block for the worst case size of the code to be
+     * emitted, and then giving back what ended up not being used.
+     *
+     * @pre The block must be live.
+     * @pre `size` must not be larger than the current size of the block.
+     */
+    void Shrink(CodeBlockHandle block, size_t size);
+
+    /**
+     * Marks a block as used, which moves it to the back of the eviction order
+     * under CodeHeapEviction::LeastRecentlyUsed. Does nothing under other policies.
+     *
+     * @pre The block must be live.
+     */
+    void Touch(CodeBlockHandle block) noexcept;
+
+    /**
+     * Starts a new generation. Blocks allocated from here on out belong to it.
+     *
+     * @returns The new generation.
+     */
+    uint32_t NextGeneration() noexcept {
+        return ++m_generation;
+    }
+
+    /// Retrieves the generation that new blocks are allocated in.
+    [[nodiscard]] uint32_t GetCurrentGeneration() const noexcept {
+        return m_generation;
+    }
+
+    /// Retrieves the policy used to make room for allocations.
+    [[nodiscard]] CodeHeapEviction GetEvictionPolicy() const noexcept {
+        return m_eviction;
+    }
+
+    /**
+     * Sets the policy used to make room for allocations.
+     *
+     * @pre No block may be live, as the eviction order of existing blocks
+     *      depends on the policy they were allocated under.
+     */
+    void SetEvictionPolicy(CodeHeapEviction policy) noexcept {
+        BISCUIT_ASSERT(m_num_live_blocks == 0);
+        m_eviction = policy;
+    }
+
+    /**
+     * Sets a function to be invoked with every block right before it is evicted,
+     * so that anything referring to the block can be unlinked from it.
+     *
+     * @note The callback must not allocate from or free blocks of the heap.
+     */
+    void SetEvictionCallback(EvictionCallback callback) {
+        m_eviction_callback = std::move(callback);
+    }
+
+    /// Determines whether or not the given handle refers to a block that is still allocated.
+    [[nodiscard]] bool IsLive(CodeBlockHandle block) const noexcept;
+
+    /// Retrieves a writable pointer to the start of a live block.
+    [[nodiscard]] uint8_t* GetPointer(CodeBlockHandle block) noexcept;
+
+    /// Retrieves the executable address of the start of a live block.
+    [[nodiscard]] uintptr_t GetAddress(CodeBlockHandle block) const noexcept;
+
+    /// Retrieves the size of a live block in bytes.
+    [[nodiscard]] size_t GetSize(CodeBlockHandle block) const noexcept;
+
+    /// Retrieves the generation that a live block was allocated in.
+    [[nodiscard]] uint32_t GetGeneration(CodeBlockHandle block) const noexcept;
+
+    /// Retrieves the user-defined value attached to a live block. Zero by default.
+    [[nodiscard]] uint64_t GetUserData(CodeBlockHandle block) const noexcept;
+
+    /// Attaches a user-defined value to a live block, e.g. the guest address it translates.
+    void SetUserData(CodeBlockHandle block, uint64_t data) noexcept;
+
+    /**
+     * Retrieves a code buffer that views only the given live block.
+     *
+     * @note The returned code buffer doesn't manage its memory, and must not
+     *       be used after the block has been freed or evicted.
+     */
+    [[nodiscard]] CodeBuffer GetCodeBuffer(CodeBlockHandle block) noexcept;
+
+    /**
+     * Retrieves an assembler that emits into the given live block.
+     *
+     * @note The same lifetime restrictions as GetCodeBuffer() apply.
+     */
+    [[nodiscard]] Assembler GetAssembler(CodeBlockHandle block,
+                                         ArchFeature features = ArchFeature::RV64);
+
+    /**
+     * Retrieves the code buffer backing the whole heap, e.g. to change
+     * the page protections of all blocks at once.
+     */
+    [[nodiscard]] CodeBuffer& GetRegion() noexcept {
+        return m_region;
+    }
+
+    /// Retrieves the number of bytes blocks can be allocated from.
+    [[nodiscard]] size_t GetCapacity() const noexcept {
+        return m_capacity;
+    }
+
+    /// Retrieves the number of bytes taken up by live blocks.
+    [[nodiscard]] size_t GetUsedBytes() const noexcept {
+        return m_used_bytes;
+    }
+
+    /// Retrieves the number of live blocks.
+    [[nodiscard]] size_t GetNumLiveBlocks() const noexcept {
+        return m_num_live_blocks;
+    }
+
+    /// Retrieves the number of blocks evicted over the lifetime of the heap.
+    [[nodiscard]] size_t GetNumEvictions() const noexcept {
+        return m_num_evictions;
+    }
+
+private:
+    static constexpr uint32_t null_index = UINT32_MAX;
+    static constexpr size_t num_size_classes = 64;
+
+    enum class BlockState : uint8_t {
+        Unused, // Record is not describing any memory and is up for reuse.
+        Free,
+        Allocated,
+    };
+
+    struct Block {
+        size_t offset = 0;
+        size_t size = 0;
+
+        // Neighbouring blocks in memory.
+        uint32_t prev_phys = null_index;
+        uint32_t next_phys = null_index;
+
+        // Neighbours within the free list of the block's size class
+        // if free, or within the eviction order if allocated.
+        uint32_t prev_link = null_index;
+        uint32_t next_link = null_index;
+
+        uint32_t serial = 0;
+        uint32_t generation = 0;
+        uint64_t user_data = 0;
+        BlockState state = BlockState::Unused;
+    };
+
+    [[nodiscard]] const Block& GetLiveBlock(CodeBlockHandle block) const noexcept;
+    [[nodiscard]] Block& GetLiveBlock(CodeBlockHandle block) noexcept;
+
+    [[nodiscard]] uint32_t NewRecord();
+    void ReleaseRecord(uint32_t index) noexcept;
+
+    [[nodiscard]] size_t SizeClassFor(size_t size) const noexcept;
+    [[nodiscard]] uint32_t FindFreeBlock(size_t size) const noexcept;
+    void LinkFree(uint32_t index) noexcept;
+    void UnlinkFree(uint32_t index) noexcept;
+    void LinkAllocated(uint32_t index) noexcept;
+    void UnlinkAllocated(uint32_t index) noexcept;
+
+    [[nodiscard]] uint32_t SplitOff(uint32_t index, size_t size);
+    void MergeWithNext(uint32_t index) noexcept;
+    void MakeFree(uint32_t index) noexcept;
+    void EvictOldest();
+
+    CodeBuffer m_region;
+    size_t m_base_offset = 0;
+    size_t m_capacity = 0;
+    size_t m_alignment = 0;
+
+    std::vector<Block> m_blocks;
+    std::vector<uint32_t> m_unused_records;
+
+    // Heads of the free lists, and a bitmap of which of them are non-empty.
+    std::array<uint32_t, num_size_classes> m_free_heads{};
+    uint64_t m_free_classes = 0;
+
+    // Allocated blocks, in the order they are to be evicted in.
+    uint32_t m_evict_head = null_index;
+    uint32_t m_evict_tail = null_index;
+
+    CodeHeapEviction m_eviction = CodeHeapEviction::None;
+    EvictionCallback m_eviction_callback;
+    uint32_t m_generation = 0;
+
+    size_t m_used_bytes = 0;
+    size_t m_num_live_blocks = 0;
+    size_t m_num_evictions = 0;
+};
+
+} // namespace biscuit
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace biscuit {
+
+/**
+ * Identifies an instruction recognized by the Decoder.
+ *
+ * Identifiers are named after the Assembler function that emits the instruction.
+ * Vector instructions that come in several forms are suffixed with the form
+ * (e.g. VADD_VV, VADD_VX and VADD_VI), since they share a function name.
+ *
+ * Pseudo-instructions (e.g. MV, NOT or RET) are decoded as the
+ * instruction they expand to.
+ */
+enum class InstructionId : uint16_t {
+    Invalid,
+
+#define BISCUIT_INSTRUCTION(id) id,
+#include <biscuit/decoder_ids.inc>
+#undef BISCUIT_INSTRUCTION
+};
+
+/**
+ * A decoded instruction.
+ *
+ * Register operands are returned by the position they are encoded in, regardless
+ * of whether they are general-purpose, floating-point or vector registers, and are
+ * zero if the instruction doesn't encode them. For 32-bit instructions, these are:
+ *
+ * - rd: bits [11:7]
+ * - rs1: bits [19:15]
+ * - rs2: bits [24:20]
+ * - rs3: bits [31:27]
+ *
+ * Compressed instructions have their register operands returned in the slots
+ * of the 32-bit instruction they expand to (e.g. both rd and rs1 for C.ADDI),
+ * with 3-bit register fields already mapped to the registers they refer to.
+ * Registers that are only implied by a compressed instruction (e.g. sp for C.LWSP)
+ * aren't filled in.
+ *
+ * Instructions that encode a 5-bit immediate in place of rs1 alongside another
+ * immediate (e.g. CSRRWI and VSETIVLI) return it in rs1.
+ */
+struct DecodedInstruction {
+    /// The instruction, or InstructionId::Invalid if the encoding isn't recognized.
+    InstructionId id = InstructionId::Invalid;
+
+    /// The size of the instruction in bytes. Either 2 or 4, or 0 if invalid.
+    uint8_t length = 0;
+
+    uint8_t rd = 0;
+    uint8_t rs1 = 0;
+    uint8_t rs2 = 0;
+    uint8_t rs3 = 0;
+
+    /**
+     * An encoded field that modifies the operation, depending on the instruction:
+     *
+     * - The rounding mode of floating-point instructions, as an RMode.
+     * - The memory ordering of atomic instructions, as an Ordering.
+     * - Whether a vector instruction is masked, as a VecMask.
+     * - The register list (rlist) of Zcmp push and pop instructions.
+     */
+    uint8_t modifier = 0;
+
+    /**
+     * The immediate, if the instruction has one.
+     *
+     * Immediates are sign-extended unless the field is unsigned (e.g. CSR numbers,
+     * shift amounts and compressed load/store offsets), and have already been scaled
+     * and reassembled, so they match the value given to the Assembler function.
+     *
+     * A few instructions have immediates made up of several operands:
+     *
+     * - FENCE: pred in bits [7:4] and succ in bits [3:0].
+     * - VSETVLI and VSETIVLI: the vtype bits, as in the vtype CSR.
+     * - Vector segment loads and stores: the number of segments.
+     */
+    int32_t imm = 0;
+
+    [[nodiscard]] bool operator==(const DecodedInstruction&) const = default;
+};
+
+/**
+ * Decodes RISC-V instructions into their instruction ID and operands.
+ *
+ * Decoding is driven by a table of mask and match values, covering every instruction
+ * that the Assembler can emit. On construction, the decoder selects the entries that
+ * apply to the given architecture and extensions, and sorts them into buckets by
+ * opcode and funct3 (and by the funct6/funct7 bits shared by all entries of larger
+ * buckets), so that each decode only scans a handful of candidates.
+ *
+ * The architecture and extensions resolve encodings that mean different things
+ * in different configurations, such as C.JAL on RV32 and C.ADDIW on RV64. All
+ * 32-bit instructions are decoded regardless of the enabled extensions.
+ *
+ * The decoder recognizes instructions, but doesn't validate their operands, so
+ * reserved operand combinations (e.g. misaligned vector register groups) are
+ * decoded like any other.
+ *
+ * @par
+ * An example of walking over a code buffer:
+ * @code{.cpp}
+ * const Decoder decoder{ArchFeature::RV64};
+ * auto code = std::span{buffer.GetOffsetPointer(0), buffer.GetSizeInBytes()};
+ *
+ * while (!code.empty()) {
+ *     const auto insn = decoder.Decode(code);
+ *     if (insn.id == InstructionId::Invalid) {
+ *         break;
+ *     }
+ *     code = code.subspan(insn.length);
+ * }
+ * @endcode
+ */
+class Decoder {
+public:
+    /**
+     * Constructor
+     *
+     * @param features   The architecture to decode instructions for.
+     * @param extensions The compressed extensions to decode instructions from.
+     *                   Zcmp and Zcmt reuse the encodings of Zcd, so they are
+     *                   decoded when Zcd isn't enabled.
+     *
+     * @note The default extensions are the same as the Assembler's.
+     */
+    explicit Decoder(ArchFeature features = ArchFeature::RV64,
+                     Extension extensions = Extension::Zca | Extension::Zcd | Extension::Zcf);
+
+    /// Retrieves the architecture the decoder decodes instructions for.
+    [[nodiscard]] ArchFeature GetArchFeatures() const noexcept {
+        return m_features;
+    }
+
+    /// Retrieves the compressed extensions the decoder decodes instructions from.
+    [[nodiscard]] Extension GetEnabledExtensions() const noexcept {
+        return m_extensions;
+    }
+
+    /**
+     * Decodes a single instruction.
+     *
+     * @param instruction The instruction, with compressed instructions in the lower
+     *                    16 bits. The upper 16 bits are ignored for those.
+     *
+     * @returns The decoded instruction, with an ID of InstructionId::Invalid if the
+     *          encoding isn't recognized (including encodings longer than 32 bits).
+     */
+    [[nodiscard]] DecodedInstruction Decode(uint32_t instruction) const noexcept;
+
+    /**
+     * Decodes the instruction at the start of a span of code.
+     *
+     * @returns The decoded instruction, with an ID of InstructionId::Invalid
+     *          if the span is too short to hold the whole instruction.
+     */
+    [[nodiscard]] DecodedInstruction Decode(std::span<const uint8_t> code) const noexcept;
+
+    /// Retrieves the name of an instruction ID, e.g. "FADD_S".
+    [[nodiscard]] static std::string_view GetName(InstructionId id) noexcept;
+
+private:
+    struct Entry {
+        uint32_t mask;
+        uint32_t match;
+        InstructionId id;
+        uint16_t registers;
+        uint8_t immediate;
+        uint8_t modifier;
+    };
+
+    // A range of entries, or if shift is non-zero, a range of sub-buckets
+    // that is indexed with the bits of the instruction from shift upwards.
+    struct Bucket {
+        uint16_t begin;
+        uint16_t end;
+        uint8_t shift;
+    };
+
+    [[nodiscard]] DecodedInstruction Extract(const Entry& entry, uint32_t instruction) const noexcept;
+
+    ArchFeature m_features;
+    Extension m_extensions;
+    std::vector<Entry> m_entries;
+    std::vector<Bucket> m_buckets;
+};
+
+} // namespace biscuit
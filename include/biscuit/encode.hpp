@@ -0,0 +1,535 @@
+#pragma once
+
+#include <biscuit/assert.hpp>
+#include <biscuit/registers.hpp>
+#include <biscuit/vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Constexpr instruction encoders that return the encoding of an instruction
+ * instead of emitting it into a code buffer.
+ *
+ * These perform no feature checks, compression or other optimizations, so
+ * each function always produces exactly the instruction it is named after.
+ * The assembler's emitters are built on top of them.
+ *
+ * @par
+ * An example of pre-encoding a stub at compile time:
+ * @code{.cpp}
+ * constexpr std::array<uint32_t, 3> stub = {
+ *     encode::LD(a0, 8, s1),
+ *     encode::ADDI(a0, a0, 1),
+ *     encode::SD(a0, 8, s1),
+ * };
+ * @endcode
+ *
+ * @note Out of range operands are caught with BISCUIT_ASSERT, which fails
+ *       compilation when encoding at compile time.
+ */
+namespace biscuit::encode {
+
+// Determines if a value lies within the range of a 6-bit immediate.
+[[nodiscard]] constexpr bool IsValidSigned6BitImm(ptrdiff_t value) {
+    return value >= -32 && value <= 31;
+}
+
+// S-type and I-type immediates are 12 bits in size
+[[nodiscard]] constexpr bool IsValidSigned12BitImm(ptrdiff_t value) {
+    return value >= -2048 && value <= 2047;
+}
+
+// B-type immediates only provide -4KiB to +4KiB range branches.
+[[nodiscard]] constexpr bool IsValidBTypeImm(ptrdiff_t value) {
+    return value >= -4096 && value <= 4095;
+}
+
+// J-type immediates only provide -1MiB to +1MiB range branches.
+[[nodiscard]] constexpr bool IsValidJTypeImm(ptrdiff_t value) {
+    return value >= -0x80000 && value <= 0x7FFFF;
+}
+
+// CB-type immediates only provide -256B to +256B range branches.
+[[nodiscard]] constexpr bool IsValidCBTypeImm(ptrdiff_t value) {
+    return value >= -256 && value <= 255;
+}
+
+// CJ-type immediates only provide -2KiB to +2KiB range branches.
+[[nodiscard]] constexpr bool IsValidCJTypeImm(ptrdiff_t value) {
+    return IsValidSigned12BitImm(value);
+}
+
+// Determines whether or not the register fits in 3-bit compressed encoding.
+[[nodiscard]] constexpr bool IsValid3BitCompressedReg(Register reg) {
+    const auto index = reg.Index();
+    return index >= 8 && index <= 15;
+}
+
+// Turns a compressed register into its encoding.
+[[nodiscard]] constexpr uint32_t CompressedRegTo3BitEncoding(Register reg) {
+    return reg.Index() - 8;
+}
+
+// Transforms a regular value into an immediate encoded in a B-type instruction.
+[[nodiscard]] constexpr uint32_t TransformToBTypeImm(uint32_t imm) {
+    // clang-format off
+    return ((imm & 0x07E0) << 20) |
+           ((imm & 0x1000) << 19) |
+           ((imm & 0x001E) << 7) |
+           ((imm & 0x0800) >> 4);
+    // clang-format on
+}
+
+// Transforms a regular value into an immediate encoded in a J-type instruction.
+[[nodiscard]] constexpr uint32_t TransformToJTypeImm(uint32_t imm) {
+    // clang-format off
+    return ((imm & 0x0FF000) >> 0) |
+           ((imm & 0x000800) << 9) |
+           ((imm & 0x0007FE) << 20) |
+           ((imm & 0x100000) << 11);
+    // clang-format on
+}
+
+// Transforms a regular value into an immediate encoded in a CB-type instruction.
+[[nodiscard]] constexpr uint32_t TransformToCBTypeImm(uint32_t imm) {
+    // clang-format off
+    return ((imm & 0x0C0) >> 1) |
+           ((imm & 0x006) << 2) |
+           ((imm & 0x020) >> 3) |
+           ((imm & 0x018) << 7) |
+           ((imm & 0x100) << 4);
+    // clang-format on
+}
+
+// Transforms a regular value into an immediate encoded in a CJ-type instruction.
+[[nodiscard]] constexpr uint32_t TransformToCJTypeImm(uint32_t imm) {
+    // clang-format off
+    return ((imm & 0x800) << 1) |
+           ((imm & 0x010) << 7) |
+           ((imm & 0x300) << 1) |
+           ((imm & 0x400) >> 2) |
+           ((imm & 0x040) << 1) |
+           ((imm & 0x080) >> 1) |
+           ((imm & 0x00E) << 2) |
+           ((imm & 0x020) >> 3);
+    // clang-format on
+}
+
+// Instruction formats
+
+/// Encodes an R-type instruction: funct7 | rs2 | rs1 | funct3 | rd | opcode
+[[nodiscard]] constexpr uint32_t RType(uint32_t funct7, Register rs2, Register rs1,
+                                       uint32_t funct3, Register rd, uint32_t opcode) noexcept {
+    // clang-format off
+    return ((funct7 & 0xFF) << 25) |
+           (rs2.Index() << 20) |
+           (rs1.Index() << 15) |
+           ((funct3 & 0b111) << 12) |
+           (rd.Index() << 7) |
+           (opcode & 0x7F);
+    // clang-format on
+}
+
+/// Encodes an R4-type instruction: rs3 | funct2 | rs2 | rs1 | funct3 | rd | opcode
+[[nodiscard]] constexpr uint32_t R4Type(Register rs3, uint32_t funct2, Register rs2, Register rs1,
+                                        uint32_t funct3, Register rd, uint32_t opcode) noexcept {
+    const auto reg_bits = (rs3.Index() << 27) | (rs2.Index() << 20) | (rs1.Index() << 15) | (rd.Index() << 7);
+    const auto funct_bits = ((funct2 & 0b11) << 25) | ((funct3 & 0b111) << 12);
+    return reg_bits | funct_bits | (opcode & 0x7F);
+}
+
+/// Encodes an I-type instruction: imm[11:0] | rs1 | funct3 | rd | opcode
+[[nodiscard]] constexpr uint32_t IType(uint32_t imm, Register rs1, uint32_t funct3,
+                                       Register rd, uint32_t opcode) noexcept {
+    return ((imm & 0xFFF) << 20) | (rs1.Index() << 15) | ((funct3 & 0b111) << 12) |
+           (rd.Index() << 7) | (opcode & 0x7F);
+}
+
+/// Encodes an S-type instruction: imm[11:5] | rs2 | rs1 | funct3 | imm[4:0] | opcode
+[[nodiscard]] constexpr uint32_t SType(uint32_t imm, Register rs2, Register rs1,
+                                       uint32_t funct3, uint32_t opcode) noexcept {
+    // clang-format off
+    const auto new_imm = ((imm & 0x01F) << 7) |
+                         ((imm & 0xFE0) << 20);
+    // clang-format on
+
+    return new_imm | (rs2.Index() << 20) | (rs1.Index() << 15) |
+           ((funct3 & 0b111) << 12) | (opcode & 0x7F);
+}
+
+/// Encodes a B-type instruction: imm[12|10:5] | rs2 | rs1 | funct3 | imm[4:1] | imm[11] | opcode
+[[nodiscard]] constexpr uint32_t BType(uint32_t imm, Register rs2, Register rs1,
+                                       uint32_t funct3, uint32_t opcode) noexcept {
+    return TransformToBTypeImm(imm & 0x1FFE) | (rs2.Index() << 20) | (rs1.Index() << 15) |
+           ((funct3 & 0b111) << 12) | (opcode & 0x7F);
+}
+
+/// Encodes a U-type instruction: imm[31:12] | rd | opcode
+[[nodiscard]] constexpr uint32_t UType(uint32_t imm, Register rd, uint32_t opcode) noexcept {
+    return (imm & 0x000FFFFF) << 12 | rd.Index() << 7 | (opcode & 0x7F);
+}
+
+/// Encodes a J-type instruction: imm[20|10:1|11|19:12] | rd | opcode
+[[nodiscard]] constexpr uint32_t JType(uint32_t imm, Register rd, uint32_t opcode) noexcept {
+    return TransformToJTypeImm(imm & 0x1FFFFE) | rd.Index() << 7 | (opcode & 0x7F);
+}
+
+/// Encodes a CI-type instruction: funct3 | imm[5] | rd | imm[4:0] | op
+[[nodiscard]] constexpr uint16_t CIType(uint32_t funct3, uint32_t imm, Register rd, uint32_t op) noexcept {
+    const auto new_imm = ((imm & 0b11111) << 2) | ((imm & 0b100000) << 7);
+    return static_cast<uint16_t>(((funct3 & 0b111) << 13) | new_imm | (rd.Index() << 7) | (op & 0b11));
+}
+
+/// Encodes a CIW-type instruction: funct3 | imm | rd' | op
+[[nodiscard]] constexpr uint16_t CIWType(uint32_t funct3, uint32_t imm, Register rd, uint32_t op) noexcept {
+    BISCUIT_ASSERT(IsValid3BitCompressedReg(rd));
+    return static_cast<uint16_t>(((funct3 & 0b111) << 13) | ((imm & 0xFF) << 5) |
+                                 (CompressedRegTo3BitEncoding(rd) << 2) | (op & 0b11));
+}
+
+/**
+ * Encodes a CL-type instruction: funct3 | imm | rs1' | imm | rd' | op
+ *
+ * CS-type instructions share this layout, with rs2' taking the place of rd'.
+ * `imm` holds the already-arranged immediate bits 7 to 3.
+ */
+[[nodiscard]] constexpr uint16_t CLType(uint32_t funct3, uint32_t imm, Register rs1, Register rd,
+                                        uint32_t op) noexcept {
+    BISCUIT_ASSERT(IsValid3BitCompressedReg(rs1));
+    BISCUIT_ASSERT(IsValid3BitCompressedReg(rd));
+
+    imm &= 0xF8;
+
+    const auto imm_enc = ((imm & 0x38) << 7) | ((imm & 0xC0) >> 1);
+    return static_cast<uint16_t>(((funct3 & 0b111) << 13) | imm_enc |
+                                 (CompressedRegTo3BitEncoding(rs1) << 7) |
+                                 (CompressedRegTo3BitEncoding(rd) << 2) | (op & 0b11));
+}
+
+/// Encodes a CA-type instruction: funct6 | rd' | funct2 | rs2' | op
+[[nodiscard]] constexpr uint16_t CAType(uint32_t funct6, Register rd, uint32_t funct2, Register rs2,
+                                        uint32_t op) noexcept {
+    BISCUIT_ASSERT(IsValid3BitCompressedReg(rs2));
+    BISCUIT_ASSERT(IsValid3BitCompressedReg(rd));
+
+    return static_cast<uint16_t>(((funct6 & 0b111111) << 10) | (CompressedRegTo3BitEncoding(rd) << 7) |
+                                 ((funct2 & 0b11) << 5) | (CompressedRegTo3BitEncoding(rs2) << 2) |
+                                 (op & 0b11));
+}
+
+/// Encodes a CB-type branch: funct3 | imm[8|4:3] | rs1' | imm[7:6|2:1|5] | op
+[[nodiscard]] constexpr uint16_t CBType(uint32_t funct3, int32_t offset, Register rs1, uint32_t op) noexcept {
+    BISCUIT_ASSERT(IsValidCBTypeImm(offset));
+    BISCUIT_ASSERT((offset % 2) == 0);
+    BISCUIT_ASSERT(IsValid3BitCompressedReg(rs1));
+
+    return static_cast<uint16_t>(((funct3 & 0b111) << 13) | TransformToCBTypeImm(static_cast<uint32_t>(offset)) |
+                                 (CompressedRegTo3BitEncoding(rs1) << 7) | (op & 0b11));
+}
+
+/// Encodes a CJ-type jump: funct3 | imm[11|4|9:8|10|6|7|3:1|5] | op
+[[nodiscard]] constexpr uint16_t CJType(uint32_t funct3, int32_t offset, uint32_t op) noexcept {
+    BISCUIT_ASSERT(IsValidCJTypeImm(offset));
+    BISCUIT_ASSERT((offset % 2) == 0);
+
+    return static_cast<uint16_t>(TransformToCJTypeImm(static_cast<uint32_t>(offset)) |
+                                 ((funct3 & 0b111) << 13) | (op & 0b11));
+}
+
+/**
+ * Encodes a vector load or store: nf | mew | mop | vm | umop/rs2/vs2 | rs1 | width | vd/vs3 | opcode
+ *
+ * @param nf The number of fields, from 1 to 8. 0 is treated like 1.
+ */
+[[nodiscard]] constexpr uint32_t VectorMemory(uint32_t nf, bool mew, uint32_t mop, VecMask vm,
+                                              uint32_t umop, Register rs1, uint32_t width,
+                                              Register vd, uint32_t opcode) noexcept {
+    BISCUIT_ASSERT(nf <= 8);
+
+    // Fit to encoding space. Allows for being more explicit about the size in calling functions
+    // (e.g. using 8 for 8 elements instead of 7).
+    if (nf != 0) {
+        nf -= 1;
+    }
+
+    // clang-format off
+    return (nf << 29) |
+           (static_cast<uint32_t>(mew) << 28) |
+           ((mop & 0b11) << 26) |
+           (static_cast<uint32_t>(vm) << 25) |
+           ((umop & 0b11111) << 20) |
+           (rs1.Index() << 15) |
+           ((width & 0b111) << 12) |
+           (vd.Index() << 7) |
+           (opcode & 0x7F);
+    // clang-format on
+}
+
+/**
+ * Encodes a vector arithmetic instruction: funct6 | vm | vs2 | vs1/rs1/imm5 | funct3 | vd | opcode
+ *
+ * @param src1 The raw 5-bit value of the first source field, e.g. a register index or immediate.
+ */
+[[nodiscard]] constexpr uint32_t VectorArith(uint32_t funct6, VecMask vm, Register vs2, uint32_t src1,
+                                             uint32_t funct3, Register vd, uint32_t opcode) noexcept {
+    // clang-format off
+    return ((funct6 & 0b111111) << 26) |
+           (static_cast<uint32_t>(vm) << 25) |
+           (vs2.Index() << 20) |
+           ((src1 & 0b11111) << 15) |
+           ((funct3 & 0b111) << 12) |
+           (vd.Index() << 7) |
+           (opcode & 0x7F);
+    // clang-format on
+}
+
+// RV32I/RV64I base instructions
+
+[[nodiscard]] constexpr uint32_t LUI(GPR rd, uint32_t imm) noexcept {
+    return UType(imm, rd, 0b0110111);
+}
+[[nodiscard]] constexpr uint32_t AUIPC(GPR rd, int32_t imm) noexcept {
+    return UType(static_cast<uint32_t>(imm), rd, 0b0010111);
+}
+
+[[nodiscard]] constexpr uint32_t JAL(GPR rd, int32_t imm) noexcept {
+    BISCUIT_ASSERT(IsValidJTypeImm(imm));
+    return JType(static_cast<uint32_t>(imm), rd, 0b1101111);
+}
+[[nodiscard]] constexpr uint32_t JALR(GPR rd, int32_t imm, GPR rs1) noexcept {
+    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
+    return IType(static_cast<uint32_t>(imm), rs1, 0b000, rd, 0b1100111);
+}
+
+namespace detail {
+[[nodiscard]] constexpr uint32_t Branch(GPR rs1, GPR rs2, int32_t imm, uint32_t funct3) noexcept {
+    BISCUIT_ASSERT(IsValidBTypeImm(imm));
+    return BType(static_cast<uint32_t>(imm), rs2, rs1, funct3, 0b1100011);
+}
+[[nodiscard]] constexpr uint32_t Load(GPR rd, int32_t imm, GPR rs1, uint32_t funct3) noexcept {
+    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
+    return IType(static_cast<uint32_t>(imm), rs1, funct3, rd, 0b0000011);
+}
+[[nodiscard]] constexpr uint32_t Store(GPR rs2, int32_t imm, GPR rs1, uint32_t funct3) noexcept {
+    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
+    return SType(static_cast<uint32_t>(imm), rs2, rs1, funct3, 0b0100011);
+}
+// Like the assembler, immediates of up to 4095 are taken as raw 12-bit patterns.
+[[nodiscard]] constexpr uint32_t OpImm(GPR rd, GPR rs1, int32_t imm, uint32_t funct3, uint32_t opcode) noexcept {
+    BISCUIT_ASSERT(imm >= -2048 && imm <= 4095);
+    return IType(static_cast<uint32_t>(imm), rs1, funct3, rd, opcode);
+}
+[[nodiscard]] constexpr uint32_t Shift(GPR rd, GPR rs1, uint32_t shift, uint32_t max_shift,
+                                       uint32_t funct6, uint32_t funct3, uint32_t opcode) noexcept {
+    BISCUIT_ASSERT(shift <= max_shift);
+    return IType((funct6 << 6) | shift, rs1, funct3, rd, opcode);
+}
+} // namespace detail
+
+[[nodiscard]] constexpr uint32_t BEQ(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    return detail::Branch(rs1, rs2, imm, 0b000);
+}
+[[nodiscard]] constexpr uint32_t BNE(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    return detail::Branch(rs1, rs2, imm, 0b001);
+}
+[[nodiscard]] constexpr uint32_t BLT(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    return detail::Branch(rs1, rs2, imm, 0b100);
+}
+[[nodiscard]] constexpr uint32_t BGE(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    return detail::Branch(rs1, rs2, imm, 0b101);
+}
+[[nodiscard]] constexpr uint32_t BLTU(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    return detail::Branch(rs1, rs2, imm, 0b110);
+}
+[[nodiscard]] constexpr uint32_t BGEU(GPR rs1, GPR rs2, int32_t imm) noexcept {
+    return detail::Branch(rs1, rs2, imm, 0b111);
+}
+
+[[nodiscard]] constexpr uint32_t LB(GPR rd, int32_t imm, GPR rs1) noexcept {
+    return detail::Load(rd, imm, rs1, 0b000);
+}
+[[nodiscard]] constexpr uint32_t LH(GPR rd, int32_t imm, GPR rs1) noexcept {
+    return detail::Load(rd, imm, rs1, 0b001);
+}
+[[nodiscard]] constexpr uint32_t LW(GPR rd, int32_t imm, GPR rs1) noexcept {
+    return detail::Load(rd, imm, rs1, 0b010);
+}
+[[nodiscard]] constexpr uint32_t LD(GPR rd, int32_t imm, GPR rs1) noexcept {
+    return detail::Load(rd, imm, rs1, 0b011);
+}
+[[nodiscard]] constexpr uint32_t LBU(GPR rd, int32_t imm, GPR rs1) noexcept {
+    return detail::Load(rd, imm, rs1, 0b100);
+}
+[[nodiscard]] constexpr uint32_t LHU(GPR rd, int32_t imm, GPR rs1) noexcept {
+    return detail::Load(rd, imm, rs1, 0b101);
+}
+[[nodiscard]] constexpr uint32_t LWU(GPR rd, int32_t imm, GPR rs1) noexcept {
+    return detail::Load(rd, imm, rs1, 0b110);
+}
+
+[[nodiscard]] constexpr uint32_t SB(GPR rs2, int32_t imm, GPR rs1) noexcept {
+    return detail::Store(rs2, imm, rs1, 0b000);
+}
+[[nodiscard]] constexpr uint32_t SH(GPR rs2, int32_t imm, GPR rs1) noexcept {
+    return detail::Store(rs2, imm, rs1, 0b001);
+}
+[[nodiscard]] constexpr uint32_t SW(GPR rs2, int32_t imm, GPR rs1) noexcept {
+    return detail::Store(rs2, imm, rs1, 0b010);
+}
+[[nodiscard]] constexpr uint32_t SD(GPR rs2, int32_t imm, GPR rs1) noexcept {
+    return detail::Store(rs2, imm, rs1, 0b011);
+}
+
+[[nodiscard]] constexpr uint32_t ADDI(GPR rd, GPR rs1, int32_t imm) noexcept {
+    return detail::OpImm(rd, rs1, imm, 0b000, 0b0010011);
+}
+[[nodiscard]] constexpr uint32_t SLTI(GPR rd, GPR rs1, int32_t imm) noexcept {
+    return detail::OpImm(rd, rs1, imm, 0b010, 0b0010011);
+}
+[[nodiscard]] constexpr uint32_t SLTIU(GPR rd, GPR rs1, int32_t imm) noexcept {
+    return detail::OpImm(rd, rs1, imm, 0b011, 0b0010011);
+}
+[[nodiscard]] constexpr uint32_t XORI(GPR rd, GPR rs1, int32_t imm) noexcept {
+    return detail::OpImm(rd, rs1, imm, 0b100, 0b0010011);
+}
+[[nodiscard]] constexpr uint32_t ORI(GPR rd, GPR rs1, int32_t imm) noexcept {
+    return detail::OpImm(rd, rs1, imm, 0b110, 0b0010011);
+}
+[[nodiscard]] constexpr uint32_t ANDI(GPR rd, GPR rs1, int32_t imm) noexcept {
+    return detail::OpImm(rd, rs1, imm, 0b111, 0b0010011);
+}
+[[nodiscard]] constexpr uint32_t ADDIW(GPR rd, GPR rs1, int32_t imm) noexcept {
+    return detail::OpImm(rd, rs1, imm, 0b000, 0b0011011);
+}
+
+// Shift amounts of up to 63 are accepted, since encoders don't know the XLEN.
+// RV32 only allows shift amounts of up to 31.
+[[nodiscard]] constexpr uint32_t SLLI(GPR rd, GPR rs1, uint32_t shift) noexcept {
+    return detail::Shift(rd, rs1, shift, 63, 0b000000, 0b001, 0b0010011);
+}
+[[nodiscard]] constexpr uint32_t SRLI(GPR rd, GPR rs1, uint32_t shift) noexcept {
+    return detail::Shift(rd, rs1, shift, 63, 0b000000, 0b101, 0b0010011);
+}
+[[nodiscard]] constexpr uint32_t SRAI(GPR rd, GPR rs1, uint32_t shift) noexcept {
+    return detail::Shift(rd, rs1, shift, 63, 0b010000, 0b101, 0b0010011);
+}
+[[nodiscard]] constexpr uint32_t SLLIW(GPR rd, GPR rs1, uint32_t shift) noexcept {
+    return detail::Shift(rd, rs1, shift, 31, 0b000000, 0b001, 0b0011011);
+}
+[[nodiscard]] constexpr uint32_t SRLIW(GPR rd, GPR rs1, uint32_t shift) noexcept {
+    return detail::Shift(rd, rs1, shift, 31, 0b000000, 0b101, 0b0011011);
+}
+[[nodiscard]] constexpr uint32_t SRAIW(GPR rd, GPR rs1, uint32_t shift) noexcept {
+    return detail::Shift(rd, rs1, shift, 31, 0b010000, 0b101, 0b0011011);
+}
+
+[[nodiscard]] constexpr uint32_t ADD(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b000, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t SUB(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0100000, rs2, rs1, 0b000, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t SLL(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b001, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t SLT(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b010, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t SLTU(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b011, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t XOR(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b100, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t SRL(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b101, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t SRA(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0100000, rs2, rs1, 0b101, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t OR(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b110, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t AND(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b111, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t ADDW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b000, rd, 0b0111011);
+}
+[[nodiscard]] constexpr uint32_t SUBW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0100000, rs2, rs1, 0b000, rd, 0b0111011);
+}
+[[nodiscard]] constexpr uint32_t SLLW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b001, rd, 0b0111011);
+}
+[[nodiscard]] constexpr uint32_t SRLW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000000, rs2, rs1, 0b101, rd, 0b0111011);
+}
+[[nodiscard]] constexpr uint32_t SRAW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0100000, rs2, rs1, 0b101, rd, 0b0111011);
+}
+
+[[nodiscard]] constexpr uint32_t ECALL() noexcept {
+    return 0x00000073;
+}
+[[nodiscard]] constexpr uint32_t EBREAK() noexcept {
+    return 0x00100073;
+}
+
+[[nodiscard]] constexpr uint32_t NOP() noexcept {
+    return ADDI(x0, x0, 0);
+}
+[[nodiscard]] constexpr uint32_t MV(GPR rd, GPR rs) noexcept {
+    return ADDI(rd, rs, 0);
+}
+[[nodiscard]] constexpr uint32_t J(int32_t imm) noexcept {
+    return JAL(x0, imm);
+}
+[[nodiscard]] constexpr uint32_t RET() noexcept {
+    return JALR(x0, 0, x1);
+}
+
+// RVM Extension Instructions
+
+[[nodiscard]] constexpr uint32_t MUL(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b000, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t MULH(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b001, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t MULHSU(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b010, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t MULHU(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b011, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t DIV(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b100, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t DIVU(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b101, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t REM(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b110, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t REMU(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b111, rd, 0b0110011);
+}
+[[nodiscard]] constexpr uint32_t MULW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b000, rd, 0b0111011);
+}
+[[nodiscard]] constexpr uint32_t DIVW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b100, rd, 0b0111011);
+}
+[[nodiscard]] constexpr uint32_t DIVUW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b101, rd, 0b0111011);
+}
+[[nodiscard]] constexpr uint32_t REMW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b110, rd, 0b0111011);
+}
+[[nodiscard]] constexpr uint32_t REMUW(GPR rd, GPR rs1, GPR rs2) noexcept {
+    return RType(0b0000001, rs2, rs1, 0b111, rd, 0b0111011);
+}
+
+} // namespace biscuit::encode
@@ -2,8 +2,8 @@
 
 #include <cstddef>
 #include <optional>
-#include <set>
 #include <biscuit/assert.hpp>
+#include <biscuit/small_vector.hpp>
 
 namespace biscuit {
 
@@ -153,7 +153,13 @@ private:
         BISCUIT_ASSERT(!IsBound());
         BISCUIT_ASSERT(IsNewOffset(offset));
 
-        m_offsets.insert(offset);
+        m_offsets.push_back(offset);
+    }
+
+    // Stops tracking an offset previously added with AddOffset().
+    void RemoveOffset(LocationOffset offset) noexcept {
+        const bool removed = m_offsets.erase(offset);
+        BISCUIT_ASSERT(removed);
     }
 
     // Clears all the underlying offsets for this label.
@@ -161,12 +167,17 @@ private:
         m_offsets.clear();
     }
 
-    // Determines whether or not this address has already been added before.
+    // Determines whether or not this address hasn't been added before. Offsets are
+    // added in emission order, so it only has to lie past the most recent one.
     [[nodiscard]] bool IsNewOffset(LocationOffset offset) const noexcept {
-        return m_offsets.find(offset) == m_offsets.cend();
+        return m_offsets.empty() || m_offsets.back() < offset;
     }
 
-    std::set<LocationOffset> m_offsets;
+    // Most labels are only referenced a handful of times, so keep those
+    // offsets inline and only spill to a pooled buffer beyond that.
+    using OffsetList = SmallVector<LocationOffset, 4>;
+
+    OffsetList m_offsets;
     Location m_location;
 };
 
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <biscuit/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace biscuit {
+
+/**
+ * A compact handle to a label that is owned by an assembler's label pool.
+ *
+ * Unlike Label, a handle carries no state of its own. It is trivially
+ * copyable, may be freely duplicated, and doesn't need to be destroyed.
+ * All of the tracking data lives inside the assembler that created it.
+ *
+ * @note A handle is only meaningful to the assembler that created it, and
+ *       only until that assembler's labels are reset via ResetLabels().
+ *
+ * @par
+ * An example of using pooled labels:
+ *
+ * @code{.cpp}
+ * Assembler as{...};
+ * const auto label = as.NewLabel();
+ *
+ * as.BNE(x2, x3, label); // Use the label
+ * as.ADD(x7, x8, x9);
+ * as.Bind(label);        // Bind the label to a location
+ *
+ * // ... later, once the block is finished
+ * as.ResetLabels();
+ * @endcode
+ */
+class LabelHandle {
+public:
+    constexpr LabelHandle() noexcept = default;
+    constexpr explicit LabelHandle(uint32_t index) noexcept : m_index{index} {}
+
+    /// Gets the index of this label within the label pool.
+    [[nodiscard]] constexpr uint32_t Index() const noexcept {
+        return m_index;
+    }
+
+    friend constexpr bool operator==(LabelHandle, LabelHandle) = default;
+
+private:
+    uint32_t m_index = UINT32_MAX;
+};
+
+/**
+ * Storage for labels handed out as LabelHandles.
+ *
+ * Label locations and fixup list heads are kept in struct-of-arrays form.
+ * Each label's pending fixups form an intrusive singly-linked list
+ * threaded through one shared fixup array, so linking a label never
+ * allocates once the pool has warmed up, and resetting the pool
+ * is just a matter of resetting the array sizes.
+ */
+class LabelPool {
+public:
+    using Location = std::optional<ptrdiff_t>;
+    using LocationOffset = Location::value_type;
+
+    /// Creates a new unbound label.
+    [[nodiscard]] LabelHandle Create() {
+        const auto index = static_cast<uint32_t>(m_locations.size());
+        m_locations.push_back(unbound_location);
+        m_fixup_heads.push_back(no_fixup);
+        return LabelHandle{index};
+    }
+
+    /// Retrieves the number of labels that have been created since the last reset.
+    [[nodiscard]] size_t Size() const noexcept {
+        return m_locations.size();
+    }
+
+    /// Determines whether or not the given label has a location assigned to it.
+    [[nodiscard]] bool IsBound(LabelHandle label) const noexcept {
+        return GetLocationRaw(label) != unbound_location;
+    }
+
+    /// Retrieves the location of the given label, if it has one.
+    [[nodiscard]] Location GetLocation(LabelHandle label) const noexcept {
+        const auto location = GetLocationRaw(label);
+        if (location == unbound_location) {
+            return std::nullopt;
+        }
+        return location;
+    }
+
+    /// Determines whether or not any label still has fixups waiting on a location.
+    [[nodiscard]] bool HasPendingFixups() const noexcept {
+        return m_num_pending != 0;
+    }
+
+    /**
+     * Binds a label to the given location.
+     *
+     * @pre The label must not already be bound.
+     */
+    void Bind(LabelHandle label, LocationOffset offset) noexcept {
+        BISCUIT_ASSERT(offset >= 0);
+        BISCUIT_ASSERT(!IsBound(label));
+        m_locations[label.Index()] = offset;
+    }
+
+    /**
+     * Marks the given offset as dependent on the given label.
+     *
+     * @pre The label must not already be bound.
+     */
+    void AddFixup(LabelHandle label, LocationOffset offset) {
+        BISCUIT_ASSERT(!IsBound(label));
+
+        auto& head = m_fixup_heads[label.Index()];
+        m_fixups.push_back({offset, head});
+        head = static_cast<uint32_t>(m_fixups.size() - 1);
+        m_num_pending++;
+    }
+
+    /**
+     * Removes a fixup previously added with AddFixup().
+     *
+     * @pre The label must have a pending fixup at the given offset.
+     */
+    void RemoveFixup(LabelHandle label, LocationOffset offset) noexcept {
+        auto* link = &m_fixup_heads[label.Index()];
+        while (*link != no_fixup && m_fixups[*link].offset != offset) {
+            link = &m_fixups[*link].next;
+        }
+        BISCUIT_ASSERT(*link != no_fixup);
+
+        // The entry itself is left behind unlinked, until the next Reset().
+        *link = m_fixups[*link].next;
+        m_num_pending--;
+    }
+
+    /**
+     * Invokes `func` for every pending fixup of the given label and then
+     * clears them from the label.
+     */
+    template <typename Func>
+    void ConsumeFixups(LabelHandle label, Func&& func) {
+        auto& head = m_fixup_heads[label.Index()];
+        for (auto index = head; index != no_fixup; index = m_fixups[index].next) {
+            func(m_fixups[index].offset);
+            m_num_pending--;
+        }
+        head = no_fixup;
+    }
+
+    /**
+     * Replaces every bound location and pending fixup offset in the pool
+     * with the result of invoking `remap` on it. Used when code is moved.
+     */
+    template <typename Func>
+    void RemapOffsets(Func&& remap) {
+        for (auto& location : m_locations) {
+            if (location != unbound_location) {
+                location = remap(location);
+            }
+        }
+        for (auto& fixup : m_fixups) {
+            fixup.offset = remap(fixup.offset);
+        }
+    }
+
+    /**
+     * Releases every label in the pool at once.
+     *
+     * Any previously handed out handles become invalid.
+     *
+     * @pre No label may have pending fixups, as that would mean a
+     *      branch was left referencing a label that was never bound.
+     */
+    void Reset() noexcept {
+        BISCUIT_ASSERT(!HasPendingFixups());
+
+        // All of these hold trivial types, so clearing them doesn't
+        // touch the elements and the capacity is retained for reuse.
+        m_locations.clear();
+        m_fixup_heads.clear();
+        m_fixups.clear();
+    }
+
+private:
+    static constexpr ptrdiff_t unbound_location = -1;
+    static constexpr uint32_t no_fixup = UINT32_MAX;
+
+    [[nodiscard]] ptrdiff_t GetLocationRaw(LabelHandle label) const noexcept {
+        BISCUIT_ASSERT(label.Index() < m_locations.size());
+        return m_locations[label.Index()];
+    }
+
+    // A single pending fixup, linked to the next older fixup of the same label.
+    struct Fixup {
+        ptrdiff_t offset;
+        uint32_t next;
+    };
+
+    // Per-label data.
+    std::vector<ptrdiff_t> m_locations;
+    std::vector<uint32_t> m_fixup_heads;
+
+    // Per-fixup data, shared between all labels.
+    std::vector<Fixup> m_fixups;
+
+    size_t m_num_pending = 0;
+};
+
+} // namespace biscuit
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+#include <biscuit/code_buffer.hpp>
+#include <biscuit/relocation.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace biscuit {
+
+/**
+ * Reasons for linking to fail.
+ */
+enum class LinkError : uint32_t {
+    None,
+
+    /// A relocation refers to a symbol that was never defined (see Linker::GetUndefinedSymbols()).
+    UndefinedSymbol,
+
+    /// The code buffer doesn't have enough space left for the linked code.
+    OutOfSpace,
+
+    /**
+     * A reference that is out of range of its target can't reach its veneer either,
+     * which happens when it is made from a section larger than its range,
+     * e.g. a J more than 1MB away from the end of its section.
+     */
+    VeneerOutOfRange,
+};
+
+/**
+ * Links functions that were assembled independently of each other into a single code region.
+ *
+ * Each function is assembled into its own assembler, referring to other functions by
+ * symbols whose addresses aren't known yet (see Linker::Reference()), and then added as
+ * a section. Linking lays all sections out back to back and resolves the references.
+ *
+ * References that end up out of range of the instructions that make them are routed
+ * through veneers placed right after the section they are made from, which load
+ * the full 64-bit target address and jump to it through x6 (t1).
+ *
+ * @par
+ * An example of assembling functions on multiple threads:
+ * @code{.cpp}
+ * Linker linker;
+ * linker.DefineSymbol("print", reinterpret_cast<uint64_t>(&Print));
+ *
+ * // On each compilation thread:
+ * Assembler as{4096};
+ * as.CALL(linker.Reference("print"));
+ * as.J(linker.Reference("next_function"));
+ * linker.AddSection("function", as);
+ *
+ * // Once all functions are assembled:
+ * if (linker.Link(code_buffer) == LinkError::None) {
+ *     code_buffer.FlushICache();
+ *     entry = linker.GetSymbolAddress("function");
+ * }
+ * @endcode
+ *
+ * @note GetSymbol(), Reference(), DefineSymbol() and AddSection() may be called from
+ *       multiple threads at once. Linking must not happen concurrently with them.
+ */
+class Linker {
+public:
+    // The size of a veneer in bytes.
+    static constexpr size_t veneer_size = 24;
+
+    /**
+     * Retrieves the identifier of a named symbol, creating it if it doesn't exist yet.
+     */
+    [[nodiscard]] uint32_t GetSymbol(std::string_view name);
+
+    /**
+     * Creates a reference to a named symbol to pass to the assembler's symbol-based
+     * emitters, e.g. Assembler::CALL(const SymbolReference&).
+     */
+    [[nodiscard]] SymbolReference Reference(std::string_view name, int64_t addend = 0) {
+        return SymbolReference::Unresolved(GetSymbol(name), addend);
+    }
+
+    /**
+     * Defines a symbol as being located at a fixed address outside of the linked code,
+     * e.g. a host function.
+     */
+    void DefineSymbol(std::string_view name, uint64_t address);
+
+    /**
+     * Adds the code emitted by an assembler as a section, defining the given name
+     * as a symbol for the start of the section.
+     *
+     * The code and its relocations are copied, so the assembler may be reused
+     * or destroyed right afterwards.
+     *
+     * @param name      The name of the symbol to define for the section.
+     * @param as        The assembler holding the code of the section.
+     * @param alignment The alignment of the section. Must be a power of two,
+     *                  and at least 4.
+     *
+     * @pre All labels must be bound and no literal pool constants may be pending.
+     */
+    void AddSection(std::string_view name, Assembler& as, size_t alignment = 16);
+
+    /**
+     * Lays all sections out at the cursor of a code buffer and resolves all references
+     * between them, advancing the cursor past the linked code.
+     *
+     * @returns LinkError::None on success, in which case the instruction
+     *          cache still has to be synchronized (see CodeBuffer::FlushICache()).
+     *          On failure, the code buffer is left untouched.
+     *
+     * @note The code buffer is never grown, even if auto-growth is enabled,
+     *       since growing it would move the code that was just laid out.
+     */
+    [[nodiscard]] LinkError Link(CodeBuffer& buffer);
+
+    /**
+     * Retrieves the address of a symbol.
+     *
+     * @pre The symbol must be defined, and if it names a section, linking must have succeeded.
+     */
+    [[nodiscard]] uint64_t GetSymbolAddress(std::string_view name) const;
+
+    /// Retrieves the names of all symbols that are referred to, but not defined.
+    [[nodiscard]] std::vector<std::string_view> GetUndefinedSymbols() const;
+
+    /// Retrieves the number of veneers inserted by the most recent successful link.
+    [[nodiscard]] size_t GetNumVeneers() const noexcept {
+        return m_num_veneers;
+    }
+
+private:
+    struct Symbol {
+        std::string name;
+        bool is_defined = false;
+        bool is_referenced = false;
+
+        // Absolute symbols hold their address, section symbols hold the
+        // index of their section until linking resolves their address.
+        bool is_section = false;
+        uint32_t section = 0;
+        uint64_t address = 0;
+    };
+
+    struct Section {
+        uint32_t symbol;
+        size_t alignment;
+        std::vector<uint8_t> code;
+        std::vector<Relocation> relocations;
+
+        // Which relocations are routed through a veneer, and the offset of
+        // each one's veneer relative to the start of the linked code.
+        std::vector<bool> needs_veneer;
+        std::vector<size_t> veneer_offsets;
+
+        // Set by the layout.
+        size_t offset = 0;
+        size_t num_veneers = 0;
+    };
+
+    [[nodiscard]] uint32_t GetSymbolLocked(std::string_view name);
+
+    // Lays out the sections at the given address, assigning veneer
+    // slots to the current set of veneer-requiring relocations.
+    [[nodiscard]] size_t Layout(uint64_t base);
+
+    [[nodiscard]] uint64_t GetTargetAddress(const Section& section, const Relocation& relocation,
+                                            uint64_t base) const noexcept;
+
+    mutable std::mutex m_mutex;
+    std::vector<Symbol> m_symbols;
+    std::unordered_map<std::string, uint32_t> m_symbol_indices;
+    std::vector<Section> m_sections;
+    size_t m_num_veneers = 0;
+};
+
+} // namespace biscuit
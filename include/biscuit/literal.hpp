@@ -1,10 +1,10 @@
 #pragma once
 
 #include <biscuit/assert.hpp>
+#include <biscuit/small_vector.hpp>
 
 #include <cstddef>
 #include <optional>
-#include <set>
 #include <type_traits>
 
 namespace biscuit {
@@ -146,7 +146,7 @@ private:
         BISCUIT_ASSERT(!IsPlaced());
         BISCUIT_ASSERT(IsNewOffset(offset));
 
-        m_offsets.insert(offset);
+        m_offsets.push_back(offset);
     }
 
     // Clears all the underlying offsets for this literal.
@@ -154,20 +154,25 @@ private:
         m_offsets.clear();
     }
 
-    // Determines whether or not this address has already been added before.
+    // Determines whether or not this address hasn't been added before. Offsets are
+    // added in emission order, so it only has to lie past the most recent one.
     [[nodiscard]] bool IsNewOffset(LocationOffset offset) const noexcept {
-        return m_offsets.find(offset) == m_offsets.cend();
+        return m_offsets.empty() || m_offsets.back() < offset;
     }
 
-    std::set<LocationOffset> m_offsets;
+    // Most literals are only referenced a handful of times, so keep those
+    // offsets inline and only spill to a pooled buffer beyond that.
+    using OffsetList = SmallVector<LocationOffset, 4>;
+
+    OffsetList m_offsets;
     Location m_location;
     const T m_value;
 
     // Literals are provided as a way to avoid long instruction sequences for loading
-    // immediates to registers. As such, the Literal type is not useful for
-    // types <= uint32_t, as those can be loaded directly with at most a couple instructions.
-    // (e.g. via the LI() function in the assembler)
-    static_assert(sizeof(T) >= 8, "Literal type must be at least 64 bits wide.");
+    // immediates to registers. Narrower literals are still useful for floating-point
+    // registers (e.g. FLW and FLH), which can't be loaded with immediates directly,
+    // but single bytes would never be a better choice than an immediate.
+    static_assert(sizeof(T) >= 2, "Literal type must be at least 16 bits wide.");
 
     // For the assembler to be able to emit the literal value, it must be trivially copyable.
     static_assert(std::is_trivially_copyable_v<T>, "Literal type must be trivially copyable.");
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <biscuit/assert.hpp>
+#include <biscuit/literal.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace biscuit {
+
+/**
+ * Storage for constants that are loaded via the assembler's literal pool.
+ *
+ * Constants are interned by value, so loading the same constant multiple
+ * times only places a single copy of it in the code buffer. Only 64-bit
+ * constants are pooled, as that is all LoadConstant() needs.
+ * Constants that have been referenced but not yet placed are tracked as
+ * pending until the assembler emits them as part of a pool island.
+ *
+ * @note This is internal machinery used by the assembler to implement
+ *       LoadConstant() and the related functions, and is not to be directly
+ *       relied upon in projects consuming this library.
+ */
+class LiteralPool {
+public:
+    /// Determines whether or not any interned constant is waiting to be placed.
+    [[nodiscard]] bool HasPending() const noexcept {
+        return !m_pending.empty();
+    }
+
+    /// Retrieves the number of bytes that all pending constants occupy, excluding padding.
+    [[nodiscard]] size_t GetPendingSize() const noexcept {
+        return m_pending.size() * sizeof(uint64_t);
+    }
+
+    /// Retrieves the offset of the oldest instruction that references a pending constant.
+    [[nodiscard]] std::optional<ptrdiff_t> GetOldestReference() const noexcept {
+        return m_oldest_reference;
+    }
+
+    /// Retrieves the maximum distance between a load and the constant it refers to.
+    [[nodiscard]] ptrdiff_t GetMaxDistance() const noexcept {
+        return m_max_distance;
+    }
+
+    /// Sets the maximum distance between a load and the constant it refers to.
+    void SetMaxDistance(ptrdiff_t distance) noexcept {
+        BISCUIT_ASSERT(distance >= 64 && distance <= default_max_distance);
+        m_max_distance = distance;
+    }
+
+    /**
+     * Retrieves the most recently interned literal with the given value.
+     *
+     * @returns nullptr if the value hasn't been interned yet.
+     */
+    [[nodiscard]] Literal<uint64_t>* Find(uint64_t value) const noexcept {
+        const auto iter = m_index.find(value);
+        if (iter == m_index.end()) {
+            return nullptr;
+        }
+        return iter->second;
+    }
+
+    /**
+     * Interns a new literal with the given value, which replaces any existing literal
+     * with the same value for future lookups (e.g. if the existing literal is out of range).
+     */
+    [[nodiscard]] Literal<uint64_t>* Add(uint64_t value) {
+        auto* literal = &m_literals.emplace_back(value);
+        m_index.insert_or_assign(value, literal);
+        m_pending.push_back(literal);
+        return literal;
+    }
+
+    /**
+     * Notes that the instruction at the given offset references a literal in the pool.
+     * If the literal is pending, the offset will be considered for GetOldestReference().
+     */
+    void NoteReference(const Literal<uint64_t>* literal, ptrdiff_t offset) noexcept {
+        if (!literal->IsPlaced() && !m_oldest_reference) {
+            m_oldest_reference = offset;
+        }
+    }
+
+    /**
+     * Invokes `place` for every pending literal in the order they were
+     * added and then marks the pool as having nothing pending.
+     */
+    template <typename Func>
+    void TakePending(Func&& place) {
+        for (auto* literal : m_pending) {
+            place(literal);
+        }
+        m_pending.clear();
+        m_oldest_reference.reset();
+    }
+
+    /**
+     * Releases every literal in the pool at once.
+     *
+     * @pre No literal may be pending, as that would mean a load
+     *      was left referencing a constant that was never placed.
+     */
+    void Reset() noexcept {
+        BISCUIT_ASSERT(!HasPending());
+        m_pending.clear();
+        m_index.clear();
+        m_literals.clear();
+    }
+
+private:
+    // The largest distance an AUIPC-based load can reach in both directions,
+    // rounded down to keep things simple.
+    static constexpr ptrdiff_t default_max_distance = 0x7FFFF000;
+
+    // Deque, so that literal addresses remain stable as the pool grows.
+    std::deque<Literal<uint64_t>> m_literals;
+    std::unordered_map<uint64_t, Literal<uint64_t>*> m_index;
+    std::vector<Literal<uint64_t>*> m_pending;
+    std::optional<ptrdiff_t> m_oldest_reference;
+    ptrdiff_t m_max_distance = default_max_distance;
+};
+
+} // namespace biscuit
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace biscuit {
+
+/**
+ * The symbol that relocations use to refer to the start of the code they belong to,
+ * e.g. for absolute addresses of locations within the code itself.
+ */
+inline constexpr uint32_t code_base_symbol = UINT32_MAX;
+
+/**
+ * The symbol that relocations use to refer to a fixed address, which is held entirely
+ * in the addend. Used for references to host functions and data that aren't given
+ * a symbol of their own (see SymbolReference::Absolute()).
+ */
+inline constexpr uint32_t absolute_symbol = UINT32_MAX - 1;
+
+/**
+ * The kinds of references to addresses that can be fixed up after code has been emitted.
+ */
+enum class RelocationKind : uint32_t {
+    /// A 64-bit little-endian data word holding an absolute address.
+    Absolute64,
+
+    /**
+     * An absolute address materialized into a register with a fixed-length LI sequence
+     * of 8 instructions (LUI, ADDIW, SLLI, ADDI, SLLI, ADDI, SLLI, ADDI), which is able
+     * to hold any 64-bit value. See Assembler::LI(GPR, const SymbolReference&).
+     */
+    AbsoluteLI,
+
+    /**
+     * A PC-relative address formed by an AUIPC followed by an I-type instruction that
+     * adds the lower 12 bits, e.g. AUIPC+JALR for calls or AUIPC+ADDI for addresses.
+     * See Assembler::CALL(const SymbolReference&).
+     */
+    PCRelativePair,
+
+    /**
+     * A PC-relative jump formed by a single JAL instruction, which only reaches +/-1MB.
+     * See Assembler::J(const SymbolReference&).
+     */
+    Jump,
+};
+
+/// The number of bytes taken up by the code that each relocation kind refers to.
+[[nodiscard]] constexpr size_t GetRelocationSize(RelocationKind kind) noexcept {
+    switch (kind) {
+    case RelocationKind::Absolute64:
+        return 8;
+    case RelocationKind::AbsoluteLI:
+        return 32;
+    case RelocationKind::PCRelativePair:
+        return 8;
+    case RelocationKind::Jump:
+        return 4;
+    }
+    return 0;
+}
+
+/// Whether or not a relocation kind refers to its target relative to its own location.
+[[nodiscard]] constexpr bool IsPCRelative(RelocationKind kind) noexcept {
+    return kind == RelocationKind::PCRelativePair || kind == RelocationKind::Jump;
+}
+
+/**
+ * A record of a reference to `symbol` + `addend` at a given offset within some code.
+ *
+ * Symbols are plain identifiers chosen by the user, e.g. indices into a table of
+ * runtime helper functions, that map to different addresses in different processes.
+ * code_base_symbol is reserved for the start of the code that contains the relocation,
+ * and absolute_symbol for fixed addresses.
+ */
+struct Relocation {
+    ptrdiff_t offset;
+    RelocationKind kind;
+    uint32_t symbol;
+    int64_t addend;
+};
+
+/**
+ * A reference to a symbol, along with where the symbol is located at the moment.
+ *
+ * Code that refers to a symbol is emitted for its current address, but the symbol
+ * and addend are recorded as a Relocation, so the code can later be fixed up for
+ * the symbol being located at a different address.
+ */
+struct SymbolReference {
+    /**
+     * Creates a reference to a fixed address, e.g. a host function.
+     *
+     * Code that is moved or cached can end up arbitrarily far away from the address,
+     * so host functions should be called with Assembler::CALL(const SymbolReference&, GPR),
+     * which can reach any address, rather than with a PC-relative CALL.
+     */
+    [[nodiscard]] static constexpr SymbolReference Absolute(uint64_t address) noexcept {
+        return {absolute_symbol, 0, static_cast<int64_t>(address)};
+    }
+
+    /**
+     * Creates a reference to a symbol whose address isn't known yet, e.g. a function
+     * that is still being assembled elsewhere. The reference is emitted with empty
+     * immediates and has to be patched later on, e.g. by a Linker.
+     */
+    [[nodiscard]] static constexpr SymbolReference Unresolved(uint32_t symbol, int64_t addend = 0) noexcept {
+        return {symbol, 0, addend, false};
+    }
+
+    /// Retrieves the address being referred to.
+    [[nodiscard]] constexpr uint64_t GetTarget() const noexcept {
+        return address + static_cast<uint64_t>(addend);
+    }
+
+    uint32_t symbol;
+    uint64_t address;
+    int64_t addend = 0;
+
+    /// Whether or not `address` holds the current address of the symbol.
+    bool is_resolved = true;
+};
+
+/**
+ * Retrieves the address that a relocated reference currently refers to.
+ *
+ * @param code         A pointer to the start of the code containing the relocation.
+ * @param code_address The address that the code is executed at.
+ * @param relocation   The relocation to read.
+ */
+[[nodiscard]] uint64_t ReadRelocationTarget(const uint8_t* code, uint64_t code_address,
+                                            const Relocation& relocation) noexcept;
+
+/**
+ * Whether or not a relocated reference is able to refer to the given target address.
+ *
+ * Absolute references can refer to any address, while PC-relative ones are limited
+ * to the +/-2GB range of AUIPC-based addressing for RelocationKind::PCRelativePair,
+ * and to the range of JAL for RelocationKind::Jump.
+ *
+ * @param code_address The address that the code containing the relocation is executed at.
+ * @param relocation   The relocation to check.
+ * @param target       The address to refer to, i.e. the symbol's address plus the addend.
+ */
+[[nodiscard]] bool IsRelocationInRange(uint64_t code_address, const Relocation& relocation,
+                                       uint64_t target) noexcept;
+
+/**
+ * Patches a relocated reference to refer to the given target address.
+ *
+ * @param code         A writable pointer to the start of the code containing the relocation.
+ * @param code_address The address that the code is executed at.
+ * @param relocation   The relocation to patch.
+ * @param target       The address to refer to, i.e. the symbol's address plus the addend.
+ *
+ * @pre The target must be in range of the relocation, see IsRelocationInRange().
+ */
+void ApplyRelocation(uint8_t* code, uint64_t code_address,
+                     const Relocation& relocation, uint64_t target) noexcept;
+
+/**
+ * Copies relocatable code to a new location and fixes it up to be executed
+ * `delta` bytes away from where it was, in a single pass over the code.
+ *
+ * References within the code itself stay valid: absolute references to code_base_symbol
+ * are adjusted by `delta`, while PC-relative ones are copied as-is. PC-relative references
+ * to any other symbol are re-patched to keep referring to the same address, and absolute
+ * references to other symbols are copied as-is.
+ *
+ * @param dst         A writable pointer to the location to copy the code to.
+ * @param src         A pointer to the code to copy.
+ * @param size        The size of the code in bytes.
+ * @param src_address The address that the code is currently executed at.
+ * @param delta       The distance between the new and the current execution address.
+ * @param relocations All relocations within the code, ordered by offset, with
+ *                    offsets relative to `src`.
+ *
+ * @returns Whether or not the code could be relocated. If a PC-relative reference to
+ *          another symbol can't reach its target from the new location (see
+ *          IsRelocationInRange()), nothing is copied and false is returned.
+ *
+ * @pre The source and destination may only overlap if `dst` lies before `src`,
+ *      as is the case when compacting code towards the start of a region.
+ */
+[[nodiscard]] bool Relocate(uint8_t* dst, const uint8_t* src, size_t size, uint64_t src_address,
+              ptrdiff_t delta, std::span<const Relocation> relocations) noexcept;
+
+} // namespace biscuit
@@ -0,0 +1,499 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+#include <biscuit/base_emitters.hpp>
+#include <biscuit/code_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace biscuit {
+
+/**
+ * Emits base integer, load/store and branch instructions of an assembler into a
+ * reservation on its code buffer (see CodeBuffer::Reservation), so that the capacity
+ * of the code buffer is checked once for a whole run of instructions instead of
+ * once per instruction.
+ *
+ * Instructions are encoded exactly as the assembler itself would encode them,
+ * including compression, and a BasicAssembler keeps its compile-time configuration.
+ * Compressed instructions are emitted through the code buffer at the cursor of the
+ * reservation, since only their uncompressed counterparts have unchecked forms.
+ *
+ * @par
+ * An example of emitting a fixed-size run of instructions:
+ * @code{.cpp}
+ * {
+ *     ReservedEmitter reserved{as, 4};
+ *     reserved.ADD(a0, a1, a2);
+ *     reserved.ADDI(a0, a0, 1);
+ *     reserved.LD(a0, 8, s1);
+ *     reserved.SD(a0, 8, s1);
+ * }
+ * @endcode
+ *
+ * @tparam AssemblerType Assembler, or a BasicAssembler.
+ *
+ * @note The assembler may not be used while a ReservedEmitter for it is alive.
+ */
+template <typename AssemblerType>
+class ReservedEmitter {
+public:
+    /**
+     * Constructor
+     *
+     * @param as               The assembler to emit instructions for.
+     * @param num_instructions The maximum number of instructions that will be emitted.
+     */
+    [[nodiscard]] explicit ReservedEmitter(AssemblerType& as, size_t num_instructions)
+        : m_as{as}
+        , m_buffer{as.GetCodeBuffer().Reserve(num_instructions * sizeof(uint32_t))} {}
+
+    ReservedEmitter(const ReservedEmitter&) = delete;
+    ReservedEmitter& operator=(const ReservedEmitter&) = delete;
+    ReservedEmitter(ReservedEmitter&&) = delete;
+    ReservedEmitter& operator=(ReservedEmitter&&) = delete;
+
+    /// Retrieves the offset within the code buffer that the next instruction goes to.
+    [[nodiscard]] ptrdiff_t GetCursorOffset() const noexcept {
+        return m_buffer.GetCursorOffset();
+    }
+
+    // RV32I Instructions
+
+    void ADD(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::ADD(*this, rd, lhs, rhs);
+    }
+
+    void ADDI(GPR rd, GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::ADDI(*this, rd, rs, imm);
+    }
+
+    void AND(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::AND(*this, rd, lhs, rhs);
+    }
+
+    void ANDI(GPR rd, GPR rs, uint32_t imm) noexcept {
+        detail::BaseEmitters::ANDI(*this, rd, rs, imm);
+    }
+
+    void AUIPC(GPR rd, int32_t imm) noexcept {
+        detail::BaseEmitters::AUIPC(*this, rd, imm);
+    }
+
+    void BEQ(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BEQ(*this, rs1, rs2, imm);
+    }
+
+    void BEQZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BEQZ(*this, rs, imm);
+    }
+
+    void BGE(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BGE(*this, rs1, rs2, imm);
+    }
+
+    void BGEU(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BGEU(*this, rs1, rs2, imm);
+    }
+
+    void BGEZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BGEZ(*this, rs, imm);
+    }
+
+    void BGT(GPR rs, GPR rt, int32_t imm) noexcept {
+        detail::BaseEmitters::BGT(*this, rs, rt, imm);
+    }
+
+    void BGTU(GPR rs, GPR rt, int32_t imm) noexcept {
+        detail::BaseEmitters::BGTU(*this, rs, rt, imm);
+    }
+
+    void BGTZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BGTZ(*this, rs, imm);
+    }
+
+    void BLE(GPR rs, GPR rt, int32_t imm) noexcept {
+        detail::BaseEmitters::BLE(*this, rs, rt, imm);
+    }
+
+    void BLEU(GPR rs, GPR rt, int32_t imm) noexcept {
+        detail::BaseEmitters::BLEU(*this, rs, rt, imm);
+    }
+
+    void BLEZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BLEZ(*this, rs, imm);
+    }
+
+    void BLT(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BLT(*this, rs1, rs2, imm);
+    }
+
+    void BLTU(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BLTU(*this, rs1, rs2, imm);
+    }
+
+    void BLTZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BLTZ(*this, rs, imm);
+    }
+
+    void BNE(GPR rs1, GPR rs2, int32_t imm) noexcept {
+        detail::BaseEmitters::BNE(*this, rs1, rs2, imm);
+    }
+
+    void BNEZ(GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::BNEZ(*this, rs, imm);
+    }
+
+    void LB(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LB(*this, rd, imm, rs);
+    }
+
+    void LBU(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LBU(*this, rd, imm, rs);
+    }
+
+    void LH(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LH(*this, rd, imm, rs);
+    }
+
+    void LHU(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LHU(*this, rd, imm, rs);
+    }
+
+    void LUI(GPR rd, uint32_t imm) noexcept {
+        detail::BaseEmitters::LUI(*this, rd, imm);
+    }
+
+    void LW(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LW(*this, rd, imm, rs);
+    }
+
+    void MV(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::MV(*this, rd, rs);
+    }
+
+    void NEG(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::NEG(*this, rd, rs);
+    }
+
+    void NOP() noexcept {
+        detail::BaseEmitters::NOP(*this);
+    }
+
+    void NOT(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::NOT(*this, rd, rs);
+    }
+
+    void OR(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::OR(*this, rd, lhs, rhs);
+    }
+
+    void ORI(GPR rd, GPR rs, uint32_t imm) noexcept {
+        detail::BaseEmitters::ORI(*this, rd, rs, imm);
+    }
+
+    void SB(GPR rs2, int32_t imm, GPR rs1) noexcept {
+        detail::BaseEmitters::SB(*this, rs2, imm, rs1);
+    }
+
+    void SEQZ(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::SEQZ(*this, rd, rs);
+    }
+
+    void SGT(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SGT(*this, rd, lhs, rhs);
+    }
+
+    void SGTU(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SGTU(*this, rd, lhs, rhs);
+    }
+
+    void SGTZ(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::SGTZ(*this, rd, rs);
+    }
+
+    void SH(GPR rs2, int32_t imm, GPR rs1) noexcept {
+        detail::BaseEmitters::SH(*this, rs2, imm, rs1);
+    }
+
+    void SLL(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SLL(*this, rd, lhs, rhs);
+    }
+
+    void SLLI(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SLLI(*this, rd, rs, shift);
+    }
+
+    void SLT(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SLT(*this, rd, lhs, rhs);
+    }
+
+    void SLTI(GPR rd, GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::SLTI(*this, rd, rs, imm);
+    }
+
+    void SLTIU(GPR rd, GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::SLTIU(*this, rd, rs, imm);
+    }
+
+    void SLTU(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SLTU(*this, rd, lhs, rhs);
+    }
+
+    void SLTZ(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::SLTZ(*this, rd, rs);
+    }
+
+    void SNEZ(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::SNEZ(*this, rd, rs);
+    }
+
+    void SRA(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SRA(*this, rd, lhs, rhs);
+    }
+
+    void SRAI(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SRAI(*this, rd, rs, shift);
+    }
+
+    void SRL(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SRL(*this, rd, lhs, rhs);
+    }
+
+    void SRLI(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SRLI(*this, rd, rs, shift);
+    }
+
+    void SUB(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SUB(*this, rd, lhs, rhs);
+    }
+
+    void SW(GPR rs2, int32_t imm, GPR rs1) noexcept {
+        detail::BaseEmitters::SW(*this, rs2, imm, rs1);
+    }
+
+    void XOR(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::XOR(*this, rd, lhs, rhs);
+    }
+
+    void XORI(GPR rd, GPR rs, uint32_t imm) noexcept {
+        detail::BaseEmitters::XORI(*this, rd, rs, imm);
+    }
+
+    // RV64I Instructions
+
+    void ADDIW(GPR rd, GPR rs, int32_t imm) noexcept {
+        detail::BaseEmitters::ADDIW(*this, rd, rs, imm);
+    }
+
+    void ADDW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::ADDW(*this, rd, lhs, rhs);
+    }
+
+    void LD(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LD(*this, rd, imm, rs);
+    }
+
+    void LWU(GPR rd, int32_t imm, GPR rs) noexcept {
+        detail::BaseEmitters::LWU(*this, rd, imm, rs);
+    }
+
+    void NEGW(GPR rd, GPR rs) noexcept {
+        detail::BaseEmitters::NEGW(*this, rd, rs);
+    }
+
+    void SD(GPR rs2, int32_t imm, GPR rs1) noexcept {
+        detail::BaseEmitters::SD(*this, rs2, imm, rs1);
+    }
+
+    void SLLIW(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SLLIW(*this, rd, rs, shift);
+    }
+
+    void SRAIW(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SRAIW(*this, rd, rs, shift);
+    }
+
+    void SRLIW(GPR rd, GPR rs, uint32_t shift) noexcept {
+        detail::BaseEmitters::SRLIW(*this, rd, rs, shift);
+    }
+
+    void SLLW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SLLW(*this, rd, lhs, rhs);
+    }
+
+    void SRAW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SRAW(*this, rd, lhs, rhs);
+    }
+
+    void SRLW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SRLW(*this, rd, lhs, rhs);
+    }
+
+    void SUBW(GPR rd, GPR lhs, GPR rhs) noexcept {
+        detail::BaseEmitters::SUBW(*this, rd, lhs, rhs);
+    }
+
+private:
+    friend struct detail::BaseEmitters;
+
+    [[nodiscard]] ArchFeature GetArchFeatures() const noexcept {
+        return m_as.GetArchFeatures();
+    }
+
+    [[nodiscard]] bool CanCompress(Extension ext) const noexcept {
+        return m_as.CanCompress(ext);
+    }
+
+    // The compressed instructions that the base emitters may turn instructions into.
+
+    void C_ADD(GPR rd, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_ADD(rd, rs); });
+    }
+
+    void C_ADDI(GPR rd, int32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_ADDI(rd, imm); });
+    }
+
+    void C_ADDI16SP(int32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_ADDI16SP(imm); });
+    }
+
+    void C_ADDI4SPN(GPR rd, uint32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_ADDI4SPN(rd, imm); });
+    }
+
+    void C_ADDIW(GPR rd, int32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_ADDIW(rd, imm); });
+    }
+
+    void C_ADDW(GPR rd, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_ADDW(rd, rs); });
+    }
+
+    void C_AND(GPR rd, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_AND(rd, rs); });
+    }
+
+    void C_ANDI(GPR rd, uint32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_ANDI(rd, imm); });
+    }
+
+    void C_BEQZ(GPR rs, int32_t offset) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_BEQZ(rs, offset); });
+    }
+
+    void C_BNEZ(GPR rs, int32_t offset) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_BNEZ(rs, offset); });
+    }
+
+    void C_LBU(GPR rd, uint32_t uimm, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_LBU(rd, uimm, rs); });
+    }
+
+    void C_LD(GPR rd, uint32_t imm, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_LD(rd, imm, rs); });
+    }
+
+    void C_LDSP(GPR rd, uint32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_LDSP(rd, imm); });
+    }
+
+    void C_LH(GPR rd, uint32_t uimm, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_LH(rd, uimm, rs); });
+    }
+
+    void C_LHU(GPR rd, uint32_t uimm, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_LHU(rd, uimm, rs); });
+    }
+
+    void C_LI(GPR rd, int32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_LI(rd, imm); });
+    }
+
+    void C_LUI(GPR rd, uint32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_LUI(rd, imm); });
+    }
+
+    void C_LW(GPR rd, uint32_t imm, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_LW(rd, imm, rs); });
+    }
+
+    void C_LWSP(GPR rd, uint32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_LWSP(rd, imm); });
+    }
+
+    void C_MV(GPR rd, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_MV(rd, rs); });
+    }
+
+    void C_NOP() noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_NOP(); });
+    }
+
+    void C_NOT(GPR rd) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_NOT(rd); });
+    }
+
+    void C_OR(GPR rd, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_OR(rd, rs); });
+    }
+
+    void C_SB(GPR rs2, uint32_t uimm, GPR rs1) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SB(rs2, uimm, rs1); });
+    }
+
+    void C_SD(GPR rs2, uint32_t imm, GPR rs1) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SD(rs2, imm, rs1); });
+    }
+
+    void C_SDSP(GPR rs, uint32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SDSP(rs, imm); });
+    }
+
+    void C_SH(GPR rs2, uint32_t uimm, GPR rs1) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SH(rs2, uimm, rs1); });
+    }
+
+    void C_SLLI(GPR rd, uint32_t shift) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SLLI(rd, shift); });
+    }
+
+    void C_SRAI(GPR rd, uint32_t shift) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SRAI(rd, shift); });
+    }
+
+    void C_SRLI(GPR rd, uint32_t shift) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SRLI(rd, shift); });
+    }
+
+    void C_SUB(GPR rd, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SUB(rd, rs); });
+    }
+
+    void C_SUBW(GPR rd, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SUBW(rd, rs); });
+    }
+
+    void C_SW(GPR rs2, uint32_t imm, GPR rs1) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SW(rs2, imm, rs1); });
+    }
+
+    void C_SWSP(GPR rs, uint32_t imm) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_SWSP(rs, imm); });
+    }
+
+    void C_XOR(GPR rd, GPR rs) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_XOR(rd, rs); });
+    }
+
+    void C_ZEXT_B(GPR rd) noexcept {
+        m_buffer.EmitThroughBuffer([&] { m_as.C_ZEXT_B(rd); });
+    }
+
+    AssemblerType& m_as;
+    CodeBuffer::Reservation m_buffer;
+};
+
+} // namespace biscuit
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <biscuit/assert.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Source file for a small, allocation-avoiding vector type.
+// Note that this is internal machinery used by labels and
+// literals and is not to be directly relied upon in projects
+// consuming this library.
+
+namespace biscuit {
+
+namespace detail {
+
+/**
+ * A per-thread pool of spill buffers used by SmallVector.
+ *
+ * Buffers are bucketed by power-of-two capacity, so a SmallVector
+ * that outgrows its inline storage will generally reuse a buffer
+ * released by a previous SmallVector instead of hitting the heap.
+ *
+ * SmallVectors with static or thread storage duration may outlive the pool
+ * of their thread. Once the pool is destroyed, buffers are allocated from and
+ * released to the heap directly instead (see AcquireBuffer() and ReleaseBuffer()).
+ */
+class SpillPool {
+public:
+    ~SpillPool() noexcept {
+        for (auto* head : m_free_lists) {
+            while (head != nullptr) {
+                auto* next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+        is_destroyed = true;
+    }
+
+    SpillPool(const SpillPool&) = delete;
+    SpillPool& operator=(const SpillPool&) = delete;
+    SpillPool(SpillPool&&) = delete;
+    SpillPool& operator=(SpillPool&&) = delete;
+
+    /**
+     * Retrieves the spill pool for the calling thread.
+     *
+     * @pre The pool of the calling thread must not have been destroyed yet.
+     */
+    [[nodiscard]] static SpillPool& Get() noexcept {
+        BISCUIT_ASSERT(!is_destroyed);
+        thread_local SpillPool pool;
+        return pool;
+    }
+
+    /**
+     * Acquires a buffer through the pool of the calling thread, or from the heap
+     * if it has already been destroyed. Returns the actual size in `num_bytes`.
+     */
+    [[nodiscard]] static void* AcquireBuffer(size_t& num_bytes) {
+        if (is_destroyed) [[unlikely]] {
+            num_bytes = BucketSize(BucketFor(num_bytes));
+            return ::operator new(num_bytes);
+        }
+        return Get().Acquire(num_bytes);
+    }
+
+    /**
+     * Releases a buffer acquired with AcquireBuffer() to the pool of the calling
+     * thread, or to the heap if it has already been destroyed.
+     */
+    static void ReleaseBuffer(void* buffer, size_t num_bytes) noexcept {
+        if (is_destroyed) [[unlikely]] {
+            ::operator delete(buffer);
+            return;
+        }
+        Get().Release(buffer, num_bytes);
+    }
+
+    /// Acquires a buffer of at least `num_bytes` bytes. Returns the actual size in `num_bytes`.
+    [[nodiscard]] void* Acquire(size_t& num_bytes) {
+        const auto bucket = BucketFor(num_bytes);
+        num_bytes = BucketSize(bucket);
+
+        if (auto* head = m_free_lists[bucket]; head != nullptr) {
+            m_free_lists[bucket] = head->next;
+            return head;
+        }
+        return ::operator new(num_bytes);
+    }
+
+    /// Returns a buffer previously retrieved with Acquire back to the pool.
+    void Release(void* buffer, size_t num_bytes) noexcept {
+        const auto bucket = BucketFor(num_bytes);
+        auto* node = static_cast<FreeNode*>(buffer);
+        node->next = m_free_lists[bucket];
+        m_free_lists[bucket] = node;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static constexpr size_t min_bucket_shift = 6;
+    static constexpr size_t num_buckets = 26;
+
+    [[nodiscard]] static constexpr size_t BucketSize(size_t bucket) noexcept {
+        return size_t{1} << (bucket + min_bucket_shift);
+    }
+
+    [[nodiscard]] static size_t BucketFor(size_t num_bytes) noexcept {
+        const auto rounded = std::bit_ceil(num_bytes < BucketSize(0) ? BucketSize(0) : num_bytes);
+        const auto bucket = static_cast<size_t>(std::countr_zero(rounded)) - min_bucket_shift;
+        BISCUIT_ASSERT(bucket < num_buckets);
+        return bucket;
+    }
+
+    SpillPool() = default;
+
+    // Set once the pool of the calling thread is destroyed. Being trivially destructible,
+    // this stays usable while the remaining thread_local and static objects are destroyed.
+    static inline thread_local bool is_destroyed = false;
+
+    std::array<FreeNode*, num_buckets> m_free_lists{};
+};
+
+} // namespace detail
+
+/**
+ * A contiguous container that stores up to `N` elements inline and
+ * only spills to a pooled buffer once that amount is exceeded.
+ *
+ * @tparam T A trivially-copyable element type.
+ * @tparam N The number of elements stored inline.
+ */
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector element type must be trivially copyable.");
+    static_assert(N > 0, "SmallVector must have at least one inline element.");
+
+public:
+    SmallVector() noexcept = default;
+
+    ~SmallVector() noexcept {
+        ReleaseSpill();
+    }
+
+    SmallVector(const SmallVector&) = delete;
+    SmallVector& operator=(const SmallVector&) = delete;
+
+    SmallVector(SmallVector&& other) noexcept {
+        TakeFrom(other);
+    }
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            ReleaseSpill();
+            TakeFrom(other);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+    /// Whether or not the elements currently live in the inline storage.
+    [[nodiscard]] bool IsInline() const noexcept { return m_data == m_inline.data(); }
+
+    [[nodiscard]] T* data() noexcept { return m_data; }
+    [[nodiscard]] const T* data() const noexcept { return m_data; }
+
+    [[nodiscard]] T* begin() noexcept { return m_data; }
+    [[nodiscard]] T* end() noexcept { return m_data + m_size; }
+    [[nodiscard]] const T* begin() const noexcept { return m_data; }
+    [[nodiscard]] const T* end() const noexcept { return m_data + m_size; }
+
+    [[nodiscard]] T& operator[](size_t index) noexcept { return m_data[index]; }
+    [[nodiscard]] const T& operator[](size_t index) const noexcept { return m_data[index]; }
+
+    [[nodiscard]] T& back() noexcept { return m_data[m_size - 1]; }
+    [[nodiscard]] const T& back() const noexcept { return m_data[m_size - 1]; }
+
+    void push_back(const T& value) {
+        if (m_size == m_capacity) [[unlikely]] {
+            Spill();
+        }
+        m_data[m_size++] = value;
+    }
+
+    /// Removes all elements. Any spilled storage is kept around for reuse.
+    void clear() noexcept {
+        m_size = 0;
+    }
+
+    /// Removes the first element equal to `value`, keeping the order of the rest.
+    /// @returns Whether or not an element was removed.
+    bool erase(const T& value) noexcept {
+        for (size_t i = 0; i < m_size; i++) {
+            if (m_data[i] == value) {
+                std::memmove(m_data + i, m_data + i + 1, (m_size - i - 1) * sizeof(T));
+                m_size--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    void Spill() {
+        size_t num_bytes = m_capacity * 2 * sizeof(T);
+        auto* new_data = static_cast<T*>(detail::SpillPool::AcquireBuffer(num_bytes));
+        std::memcpy(new_data, m_data, m_size * sizeof(T));
+
+        ReleaseSpill();
+        m_data = new_data;
+        m_capacity = num_bytes / sizeof(T);
+    }
+
+    void ReleaseSpill() noexcept {
+        if (!IsInline()) {
+            detail::SpillPool::ReleaseBuffer(m_data, m_capacity * sizeof(T));
+            m_data = m_inline.data();
+            m_capacity = N;
+        }
+    }
+
+    void TakeFrom(SmallVector& other) noexcept {
+        if (other.IsInline()) {
+            m_inline = other.m_inline;
+            m_data = m_inline.data();
+            m_capacity = N;
+        } else {
+            m_data = std::exchange(other.m_data, other.m_inline.data());
+            m_capacity = std::exchange(other.m_capacity, N);
+        }
+        m_size = std::exchange(other.m_size, size_t{0});
+    }
+
+    T* m_data = m_inline.data();
+    size_t m_size = 0;
+    size_t m_capacity = N;
+    std::array<T, N> m_inline;
+};
+
+} // namespace biscuit
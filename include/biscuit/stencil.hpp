@@ -0,0 +1,240 @@
+#pragma once
+
+#include <biscuit/assembler.hpp>
+#include <biscuit/code_buffer.hpp>
+#include <biscuit/registers.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace biscuit {
+
+/**
+ * The instruction fields that a stencil hole can fill in.
+ */
+enum class StencilField : uint32_t {
+    /// The destination register, bits [11:7].
+    Rd,
+
+    /// The first source register, bits [19:15].
+    Rs1,
+
+    /// The second source register, bits [24:20].
+    Rs2,
+
+    /// The third source register of R4-type instructions, bits [31:27].
+    Rs3,
+
+    /// A signed 12-bit I-type immediate.
+    IImm,
+
+    /// A signed 12-bit S-type immediate.
+    SImm,
+
+    /// A B-type branch offset.
+    BImm,
+
+    /// A J-type jump offset.
+    JImm,
+
+    /// The 20-bit immediate of a U-type instruction (e.g. LUI).
+    UImm,
+
+    /// An absolute branch target, encoded as a B-type offset from the instruction.
+    BTarget,
+
+    /// An absolute jump target, encoded as a J-type offset from the instruction.
+    JTarget,
+
+    /**
+     * An absolute target, encoded as a PC-relative offset split across an AUIPC
+     * and the I-type instruction following it (e.g. AUIPC+JALR for calls).
+     */
+    PCRelativePair,
+};
+
+/**
+ * A value to fill a stencil hole with. Either a register, an immediate,
+ * or an absolute target address, depending on the fields of the hole.
+ */
+struct StencilValue {
+    constexpr StencilValue(int64_t value_) noexcept : value{value_} {}
+    constexpr StencilValue(Register reg) noexcept : value{reg.Index()} {}
+
+    int64_t value;
+};
+
+/**
+ * A precompiled sequence of instructions with named holes, which is
+ * emitted by copying it and patching the holes in.
+ *
+ * Stamping out a stencil skips everything the assembler does per instruction,
+ * like feature checks and compression, which makes it a good fit for
+ * sequences that are emitted over and over with different operands,
+ * such as the handlers for individual guest instructions in a recompiler.
+ *
+ * Stencils are created with a StencilBuilder.
+ *
+ * @par
+ * An example of stamping out a stencil:
+ * @code{.cpp}
+ * // Looked up once, up front.
+ * const auto dst = stencil.GetHole("dst");
+ *
+ * // Holes are filled in by index, in the order they were first added.
+ * stencil.Stamp(as.GetCodeBuffer(), {a0, a1, 16});
+ * @endcode
+ */
+class Stencil {
+public:
+    /**
+     * Retrieves the index of a named hole.
+     *
+     * @pre The stencil must have a hole with the given name.
+     */
+    [[nodiscard]] uint32_t GetHole(std::string_view name) const;
+
+    /// Retrieves the number of distinct holes in the stencil.
+    [[nodiscard]] size_t GetNumHoles() const noexcept {
+        return m_holes.size();
+    }
+
+    /// Retrieves the size of the stencil in bytes.
+    [[nodiscard]] size_t GetSizeInBytes() const noexcept {
+        return m_code.size();
+    }
+
+    /// Retrieves the template code of the stencil, with all holes left unfilled.
+    [[nodiscard]] std::span<const uint8_t> GetCode() const noexcept {
+        return m_code;
+    }
+
+    /**
+     * Emits a copy of the stencil at the cursor of a code buffer,
+     * filling in its holes with the given values.
+     *
+     * @param buffer The code buffer to emit into.
+     * @param values The value of each hole, indexed by hole index.
+     *
+     * @returns The offset within the code buffer that the copy was emitted at.
+     *
+     * @pre There must be exactly one value per hole, and each value must fit
+     *      into every field of its hole. Values aren't checked, since stamping
+     *      is meant to be as cheap as copying, and out of range values are
+     *      truncated to the bits of their fields.
+     */
+    ptrdiff_t Stamp(CodeBuffer& buffer, std::span<const StencilValue> values) const;
+
+    /// @copydoc Stamp(CodeBuffer&, std::span<const StencilValue>) const
+    ptrdiff_t Stamp(CodeBuffer& buffer, std::initializer_list<StencilValue> values) const {
+        return Stamp(buffer, std::span<const StencilValue>{values.begin(), values.size()});
+    }
+
+private:
+    friend class StencilBuilder;
+
+    // A run of bits moved from a value into an instruction, i.e. `(value >> src_shift) & mask`
+    // ends up at `dst_shift`. Scattered immediates, like B-type offsets, take several pieces.
+    struct Piece {
+        uint32_t mask;
+        uint8_t src_shift;
+        uint8_t dst_shift;
+    };
+
+    // A field of an instruction that is filled in with the value of a hole, precomputed when
+    // the stencil is built. PC-relative values are made relative to the address of `pc_offset`
+    // within the stencil, and `addend` is added before splitting the value into pieces.
+    struct Patch {
+        uint32_t offset;
+        uint32_t hole;
+        uint32_t pc_offset;
+        uint32_t addend;
+        bool is_pc_relative;
+        uint8_t num_pieces;
+        std::array<Piece, 4> pieces;
+    };
+
+    std::vector<uint8_t> m_code;
+    std::vector<Patch> m_patches;
+    std::vector<std::string> m_holes;
+};
+
+/**
+ * Records a stencil from the code emitted by an assembler.
+ *
+ * Instructions are emitted as usual, with placeholder operands where a hole
+ * is supposed to go, and each hole is added right after the instruction
+ * it is part of. A hole may be added to multiple fields, which are all
+ * filled in with the same value.
+ *
+ * @par
+ * An example of building a stencil:
+ * @code{.cpp}
+ * Assembler as{4096};
+ * as.DisableOptimization(Optimization::AutoCompress);
+ *
+ * StencilBuilder builder{as};
+ * as.ADDI(x0, x0, 0);
+ * builder.Hole("dst", StencilField::Rd);
+ * builder.Hole("src", StencilField::Rs1);
+ * builder.Hole("imm", StencilField::IImm);
+ * as.SD(x0, 0, s1);
+ * builder.Hole("dst", StencilField::Rs2);
+ *
+ * const Stencil stencil = builder.Build();
+ * @endcode
+ *
+ * @note Instructions with holes must be emitted uncompressed, so
+ *       Optimization::AutoCompress may not be enabled while building.
+ */
+class StencilBuilder {
+public:
+    /**
+     * Starts recording a stencil at the current cursor of an assembler.
+     *
+     * @param as The assembler the stencil is emitted with.
+     */
+    explicit StencilBuilder(Assembler& as);
+
+    /**
+     * Adds a field of the most recently emitted instruction to a named hole,
+     * creating the hole if it doesn't exist yet.
+     *
+     * For StencilField::PCRelativePair, the most recently emitted instruction is the
+     * I-type half of the pair and the AUIPC directly precedes it.
+     *
+     * The placeholder bits of the field are cleared when the stencil is built.
+     *
+     * @returns The index of the hole.
+     */
+    uint32_t Hole(std::string_view name, StencilField field);
+
+    /**
+     * Builds the stencil from everything emitted since the builder was created.
+     *
+     * @pre Everything emitted must be position-independent, so all labels used must be
+     *      bound within the stencil and no literal pool constants may be pending.
+     */
+    [[nodiscard]] Stencil Build() const;
+
+private:
+    // A field of an emitted instruction that was added to a hole.
+    struct HoleField {
+        uint32_t offset;
+        StencilField field;
+        uint32_t hole;
+    };
+
+    Assembler& m_assembler;
+    ptrdiff_t m_start;
+    std::vector<HoleField> m_fields;
+    std::vector<std::string> m_holes;
+};
+
+} // namespace biscuit
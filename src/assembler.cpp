@@ -1,6 +1,8 @@
 #include <biscuit/assert.hpp>
 #include <biscuit/assembler.hpp>
+#include <biscuit/assembler_inline.hpp>
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cstring>
@@ -16,6 +18,9 @@ Assembler::Assembler(size_t capacity)
 Assembler::Assembler(uint8_t* buffer, size_t capacity, ArchFeature features)
     : m_buffer(buffer, capacity), m_features{features} {}
 
+Assembler::Assembler(CodeBuffer&& buffer, ArchFeature features)
+    : m_buffer(std::move(buffer)), m_features{features} {}
+
 Assembler::~Assembler() = default;
 
 CodeBuffer& Assembler::GetCodeBuffer() {
@@ -26,79 +31,89 @@ CodeBuffer Assembler::SwapCodeBuffer(CodeBuffer&& buffer) noexcept {
     return std::exchange(m_buffer, std::move(buffer));
 }
 
-void Assembler::Bind(Label* label) {
-    BindToOffset(label, m_buffer.GetCursorOffset());
+void Assembler::Finalize() {
+    EmitJumpVeneers(0, true);
+    EmitLiteralPool();
+    RelaxBranches();
+    ApplyDeferredFixups();
 }
 
-void Assembler::ADD(GPR rd, GPR lhs, GPR rhs) noexcept {
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(lhs) && IsValid3BitCompressedReg(rhs)) {
-            if (rd == lhs) {
-                C_ADD(rd, rhs);
-                return;
-            } else if (rd == rhs) {
-                C_ADD(rd, lhs);
-                return;
-            }
-        }
-    }
+void Assembler::LoadConstant(GPR rd, uint64_t value) {
+    BISCUIT_ASSERT(IsRV64(m_features));
+    BISCUIT_ASSERT(rd != x0);
+    LD(rd, GetPooledConstant(value));
+}
 
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b000, rd, 0b0110011);
+void Assembler::LoadConstant(FPR rd, double value, GPR scratch) {
+    BISCUIT_ASSERT(scratch != x0);
+    FLD(rd, GetPooledConstant(std::bit_cast<uint64_t>(value)), scratch);
 }
 
-void Assembler::ADDI(GPR rd, GPR rs, int32_t imm) noexcept {
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (imm == 0 && rd != x0 && rs != x0) {
-            C_MV(rd, rs);
-            return;
-        } else if (rd != x0 && rs == x0 && IsValidSigned6BitImm(imm)) {
-            C_LI(rd, imm);
-            return;
-        } else if (rd == x2 && rd == rs && imm != 0 && (imm & 0b1111) == 0 && imm >= -512 && imm <= 496) {
-            C_ADDI16SP(imm);
-            return;
-        } else if (IsValid3BitCompressedReg(rd) && rs == x2 && (imm & 0b11) == 0 && imm > 0 && imm <= 1020) {
-            C_ADDI4SPN(rd, static_cast<uint32_t>(imm));
-            return;
-        } else if (rd != x0 && rd == rs && imm != 0 && IsValidSigned6BitImm(imm)) {
-            C_ADDI(rd, imm);
-            return;
-        }
+Literal<uint64_t>* Assembler::GetPooledConstant(uint64_t value) {
+    // Constants can't be placed once code may still be moved by relaxation.
+    BISCUIT_ASSERT(m_relaxation_sites.empty());
+
+    const auto max_distance = m_literal_pool.GetMaxDistance();
+
+    // If the island could end up out of range of the oldest pending load once this load
+    // and potentially a new constant are added, then emit it now with a jump around it.
+    if (IsLiteralPoolDue(0)) {
+        EmitLiteralPoolWithJump();
+    }
+
+    // Placed constants always lie behind the cursor, so they may have fallen out of range.
+    const auto cursor = m_buffer.GetCursorOffset();
+    auto* literal = m_literal_pool.Find(value);
+    if (literal == nullptr || (literal->IsPlaced() && cursor - *literal->GetLocation() > max_distance)) {
+        literal = m_literal_pool.Add(value);
     }
 
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b000, rd, 0b0010011);
+    m_literal_pool.NoteReference(literal, cursor);
+    return literal;
 }
 
-void Assembler::AND(GPR rd, GPR lhs, GPR rhs) noexcept {
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(lhs) && IsValid3BitCompressedReg(rhs)) {
-            if (rd == lhs) {
-                C_AND(rd, rhs);
-                return;
-            } else if (rd == rhs) {
-                C_AND(rd, lhs);
-                return;
-            }
-        }
+bool Assembler::IsLiteralPoolDue(ptrdiff_t margin) const noexcept {
+    const auto oldest = m_literal_pool.GetOldestReference();
+    if (!oldest) {
+        return false;
     }
 
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b111, rd, 0b0110011);
+    // The worst case accounts for another load and constant, the jump
+    // around the island and alignment padding.
+    constexpr ptrdiff_t worst_case_overhead = 8 + 4 + 7 + sizeof(uint64_t);
+    const auto island_end = m_buffer.GetCursorOffset() + worst_case_overhead + margin +
+                            static_cast<ptrdiff_t>(m_literal_pool.GetPendingSize());
+    return island_end - *oldest > m_literal_pool.GetMaxDistance();
 }
 
-void Assembler::ANDI(GPR rd, GPR rs, uint32_t imm) noexcept {
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        uint32_t sign_extended = static_cast<uint32_t>(static_cast<int32_t>(imm << 26) >> 26);
-        if (rd == rs  && IsValid3BitCompressedReg(rd) && (imm & 0xFFF) == (sign_extended & 0xFFF)) {
-            C_ANDI(rd, imm);
-            return;
-        }
+void Assembler::EmitLiteralPool() {
+    if (!m_literal_pool.HasPending()) {
+        return;
     }
 
-    EmitIType(m_buffer, imm, rs, 0b111, rd, 0b0010011);
+    // Keep constants naturally aligned. The padding is never executed.
+    while ((m_buffer.GetCursorAddress() % sizeof(uint64_t)) != 0) {
+        m_buffer.Emit(uint8_t{0});
+    }
+
+    m_literal_pool.TakePending([this](Literal<uint64_t>* literal) {
+        Place(literal);
+    });
+}
+
+void Assembler::EmitLiteralPoolWithJump() {
+    const auto jump_offset = m_buffer.GetCursorOffset();
+    EmitJType(m_buffer, 0, x0, 0b1101111);
+    EmitLiteralPool();
+    ResolveFixup(DeferredFixup::Kind::Branch, m_buffer.GetCursorOffset(), jump_offset);
+}
+
+void Assembler::Bind(Label* label) {
+    BindToOffset(label, m_buffer.GetCursorOffset());
 }
 
-void Assembler::AUIPC(GPR rd, int32_t imm) noexcept {
-    EmitUType(m_buffer, static_cast<uint32_t>(imm), rd, 0b0010111);
+void Assembler::Bind(LabelHandle label) {
+    BindToOffset(label, m_buffer.GetCursorOffset());
 }
 
 void Assembler::BEQ(GPR rs1, GPR rs2, Label* label) noexcept {
@@ -181,100 +196,104 @@ void Assembler::BNEZ(GPR rs, Label* label) noexcept {
     BNEZ(rs, static_cast<int32_t>(address));
 }
 
-void Assembler::BEQ(GPR rs1, GPR rs2, int32_t imm) noexcept {
-    BISCUIT_ASSERT(IsValidBTypeImm(imm));
-
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (IsValidCBTypeImm(imm) && (imm & 0b1) == 0) {
-            if (rs1 == x0 && IsValid3BitCompressedReg(rs2)) {
-                C_BEQZ(rs2, imm);
-                return;
-            } else if (rs2 == x0 && IsValid3BitCompressedReg(rs1)) {
-                C_BEQZ(rs1, imm);
-                return;
-            }
-        }
+void Assembler::BEQ(GPR rs1, GPR rs2, LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableBranch(0b000, rs1, rs2, label, CanCompress(Extension::Zca));
+        return;
     }
 
-    EmitBType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b000, 0b1100011);
+    const auto address = LinkAndGetOffset(label);
+    BEQ(rs1, rs2, static_cast<int32_t>(address));
 }
 
-void Assembler::BEQZ(GPR rs, int32_t imm) noexcept {
-    BEQ(rs, x0, imm);
+void Assembler::BEQZ(GPR rs, LabelHandle label) noexcept {
+    BEQ(rs, x0, label);
 }
 
-void Assembler::BGE(GPR rs1, GPR rs2, int32_t imm) noexcept {
-    BISCUIT_ASSERT(IsValidBTypeImm(imm));
-    EmitBType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b101, 0b1100011);
-}
+void Assembler::BGE(GPR rs1, GPR rs2, LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableBranch(0b101, rs1, rs2, label, CanCompress(Extension::Zca));
+        return;
+    }
 
-void Assembler::BGEU(GPR rs1, GPR rs2, int32_t imm) noexcept {
-    BISCUIT_ASSERT(IsValidBTypeImm(imm));
-    EmitBType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b111, 0b1100011);
+    const auto address = LinkAndGetOffset(label);
+    BGE(rs1, rs2, static_cast<int32_t>(address));
 }
 
-void Assembler::BGEZ(GPR rs, int32_t imm) noexcept {
-    BGE(rs, x0, imm);
+void Assembler::BGEU(GPR rs1, GPR rs2, LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableBranch(0b111, rs1, rs2, label, CanCompress(Extension::Zca));
+        return;
+    }
+
+    const auto address = LinkAndGetOffset(label);
+    BGEU(rs1, rs2, static_cast<int32_t>(address));
 }
 
-void Assembler::BGT(GPR rs, GPR rt, int32_t imm) noexcept {
-    BLT(rt, rs, imm);
+void Assembler::BGEZ(GPR rs, LabelHandle label) noexcept {
+    BGE(rs, x0, label);
 }
 
-void Assembler::BGTU(GPR rs, GPR rt, int32_t imm) noexcept {
-    BLTU(rt, rs, imm);
+void Assembler::BGT(GPR rs, GPR rt, LabelHandle label) noexcept {
+    BLT(rt, rs, label);
 }
 
-void Assembler::BGTZ(GPR rs, int32_t imm) noexcept {
-    BLT(x0, rs, imm);
+void Assembler::BGTU(GPR rs, GPR rt, LabelHandle label) noexcept {
+    BLTU(rt, rs, label);
 }
 
-void Assembler::BLE(GPR rs, GPR rt, int32_t imm) noexcept {
-    BGE(rt, rs, imm);
+void Assembler::BGTZ(GPR rs, LabelHandle label) noexcept {
+    BLT(x0, rs, label);
 }
 
-void Assembler::BLEU(GPR rs, GPR rt, int32_t imm) noexcept {
-    BGEU(rt, rs, imm);
+void Assembler::BLE(GPR rs, GPR rt, LabelHandle label) noexcept {
+    BGE(rt, rs, label);
 }
 
-void Assembler::BLEZ(GPR rs, int32_t imm) noexcept {
-    BGE(x0, rs, imm);
+void Assembler::BLEU(GPR rs, GPR rt, LabelHandle label) noexcept {
+    BGEU(rt, rs, label);
 }
 
-void Assembler::BLT(GPR rs1, GPR rs2, int32_t imm) noexcept {
-    BISCUIT_ASSERT(IsValidBTypeImm(imm));
-    EmitBType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b100, 0b1100011);
+void Assembler::BLEZ(GPR rs, LabelHandle label) noexcept {
+    BGE(x0, rs, label);
 }
 
-void Assembler::BLTU(GPR rs1, GPR rs2, int32_t imm) noexcept {
-    BISCUIT_ASSERT(IsValidBTypeImm(imm));
-    EmitBType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b110, 0b1100011);
+void Assembler::BLT(GPR rs1, GPR rs2, LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableBranch(0b100, rs1, rs2, label, CanCompress(Extension::Zca));
+        return;
+    }
+
+    const auto address = LinkAndGetOffset(label);
+    BLT(rs1, rs2, static_cast<int32_t>(address));
 }
 
-void Assembler::BLTZ(GPR rs, int32_t imm) noexcept {
-    BLT(rs, x0, imm);
+void Assembler::BLTU(GPR rs1, GPR rs2, LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableBranch(0b110, rs1, rs2, label, CanCompress(Extension::Zca));
+        return;
+    }
+
+    const auto address = LinkAndGetOffset(label);
+    BLTU(rs1, rs2, static_cast<int32_t>(address));
 }
 
-void Assembler::BNE(GPR rs1, GPR rs2, int32_t imm) noexcept {
-    BISCUIT_ASSERT(IsValidBTypeImm(imm));
+void Assembler::BLTZ(GPR rs, LabelHandle label) noexcept {
+    BLT(rs, x0, label);
+}
 
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (IsValidCBTypeImm(imm) && (imm & 0b1) == 0) {
-            if (rs1 == x0 && IsValid3BitCompressedReg(rs2)) {
-                C_BNEZ(rs2, imm);
-                return;
-            } else if (rs2 == x0 && IsValid3BitCompressedReg(rs1)) {
-                C_BNEZ(rs1, imm);
-                return;
-            }
-        }
+void Assembler::BNE(GPR rs1, GPR rs2, LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableBranch(0b001, rs1, rs2, label, CanCompress(Extension::Zca));
+        return;
     }
 
-    EmitBType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b001, 0b1100011);
+    const auto address = LinkAndGetOffset(label);
+    BNE(rs1, rs2, static_cast<int32_t>(address));
 }
 
-void Assembler::BNEZ(GPR rs, int32_t imm) noexcept {
-    BNE(x0, rs, imm);
+void Assembler::BNEZ(GPR rs, LabelHandle label) noexcept {
+    BNE(x0, rs, label);
 }
 
 void Assembler::CALL(int32_t offset) noexcept {
@@ -293,6 +312,11 @@ void Assembler::CALL(int32_t offset) noexcept {
 }
 
 void Assembler::EBREAK() noexcept {
+    if (CanCompress(Extension::Zca)) {
+        C_EBREAK();
+        return;
+    }
+
     m_buffer.Emit32(0x00100073);
 }
 
@@ -317,18 +341,44 @@ void Assembler::FENCETSO() noexcept {
 }
 
 void Assembler::J(Label* label) noexcept {
-    const auto address = LinkAndGetOffset(label);
-    BISCUIT_ASSERT(IsValidJTypeImm(address));
-    J(static_cast<int32_t>(address));
+    JAL(x0, label);
 }
 
 void Assembler::JAL(Label* label) noexcept {
+    JAL(x1, label);
+}
+
+void Assembler::JAL(GPR rd, Label* label) noexcept {
+    if (IsOptimizationEnabled(Optimization::JumpVeneers)) {
+        BISCUIT_ASSERT(label != nullptr);
+        BISCUIT_ASSERT(m_relaxation_sites.empty());
+        EmitVeneerableJump(rd, label->GetLocation(), label, LabelHandle{});
+        return;
+    }
+
     const auto address = LinkAndGetOffset(label);
     BISCUIT_ASSERT(IsValidJTypeImm(address));
-    JAL(static_cast<int32_t>(address));
+    JAL(rd, static_cast<int32_t>(address));
 }
 
-void Assembler::JAL(GPR rd, Label* label) noexcept {
+void Assembler::J(LabelHandle label) noexcept {
+    JAL(x0, label);
+}
+
+void Assembler::JAL(LabelHandle label) noexcept {
+    JAL(x1, label);
+}
+
+void Assembler::JAL(GPR rd, LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableJump(rd, label, CanCompress(Extension::Zca));
+        return;
+    }
+    if (IsOptimizationEnabled(Optimization::JumpVeneers)) {
+        EmitVeneerableJump(rd, m_label_pool.GetLocation(label), nullptr, label);
+        return;
+    }
+
     const auto address = LinkAndGetOffset(label);
     BISCUIT_ASSERT(IsValidJTypeImm(address));
     JAL(rd, static_cast<int32_t>(address));
@@ -347,7 +397,7 @@ void Assembler::JAL(int32_t imm) noexcept {
 void Assembler::JAL(GPR rd, int32_t imm) noexcept {
     BISCUIT_ASSERT(IsValidJTypeImm(imm));
 
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
+    if (CanCompress(Extension::Zca)) {
         if (IsValidCJTypeImm(imm) && (imm & 0b1) == 0) {
             if (rd == x0) {
                 C_J(imm);
@@ -359,7 +409,10 @@ void Assembler::JAL(GPR rd, int32_t imm) noexcept {
         }
     }
 
-    EmitJType(m_buffer, static_cast<uint32_t>(imm), rd, 0b1101111);
+    m_buffer.Emit32(encode::JAL(rd, imm));
+    if (rd == x0) {
+        OnUnconditionalTransfer();
+    }
 }
 
 void Assembler::JALR(GPR rs) noexcept {
@@ -369,7 +422,7 @@ void Assembler::JALR(GPR rs) noexcept {
 void Assembler::JALR(GPR rd, int32_t imm, GPR rs1) noexcept {
     BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
 
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
+    if (CanCompress(Extension::Zca)) {
         if (imm == 0 && rs1 != x0) {
             if (rd == x0) {
                 C_JR(rs1);
@@ -381,7 +434,10 @@ void Assembler::JALR(GPR rd, int32_t imm, GPR rs1) noexcept {
         }
     }
 
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs1, 0b000, rd, 0b1100111);
+    m_buffer.Emit32(encode::JALR(rd, imm, rs1));
+    if (rd == x0) {
+        OnUnconditionalTransfer();
+    }
 }
 
 void Assembler::JR(GPR rs) noexcept {
@@ -392,26 +448,6 @@ void Assembler::JR(GPR rs, int32_t imm) noexcept {
     JALR(x0, imm, rs);
 }
 
-void Assembler::LB(GPR rd, int32_t imm, GPR rs) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b000, rd, 0b0000011);
-}
-
-void Assembler::LBU(GPR rd, int32_t imm, GPR rs) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b100, rd, 0b0000011);
-}
-
-void Assembler::LH(GPR rd, int32_t imm, GPR rs) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b001, rd, 0b0000011);
-}
-
-void Assembler::LHU(GPR rd, int32_t imm, GPR rs) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b101, rd, 0b0000011);
-}
-
 void Assembler::LI(GPR rd, uint64_t imm) noexcept {
     if (IsRV32(m_features)) {
         // Depending on imm, the following instructions are emitted.
@@ -434,6 +470,13 @@ void Assembler::LI(GPR rd, uint64_t imm) noexcept {
             ADDI(rd, rs1, lo12);
         }
     } else {
+        if (IsExtensionEnabled(Extension::Zba) || IsExtensionEnabled(Extension::Zbb) ||
+            IsExtensionEnabled(Extension::Zbs) ||
+            IsOptimizationEnabled(Optimization::LIFromLiteralPool)) {
+            LIWithCostModel(rd, imm);
+            return;
+        }
+
         // For 64-bit imm, a sequence of up to 8 instructions (i.e. LUI+ADDIW+SLLI+
         // ADDI+SLLI+ADDI+SLLI+ADDI) is emitted.
         // In the following, imm is processed from LSB to MSB while instruction emission
@@ -477,73 +520,6 @@ void Assembler::LI(GPR rd, uint64_t imm) noexcept {
     }
 }
 
-void Assembler::LUI(GPR rd, uint32_t imm) noexcept {
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        // Sign-extend the bottom 6 bits to check if the 20 bits we are using LUI on are 6 sign-extended bits
-        uint32_t sign_extended = static_cast<uint32_t>(static_cast<int32_t>(imm << 26) >> 26);
-        if ((sign_extended & 0x000FFFFF) == (imm & 0x000FFFFF)) {
-            if (rd != x0 && rd != x2 && imm != 0) {
-                C_LUI(rd, imm & 0x3F);
-                return;
-            }
-        }
-    }
-
-    EmitUType(m_buffer, imm, rd, 0b0110111);
-}
-
-void Assembler::LW(GPR rd, int32_t imm, GPR rs) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (rs == sp && rd != x0 && imm >= 0 && imm <= 252 && (imm & 0b11) == 0) {
-            C_LWSP(rd, static_cast<uint32_t>(imm));
-            return;
-        } else if (imm >= 0 && imm <= 124 && (imm & 0b11) == 0 && IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(rs)) {
-            C_LW(rd, static_cast<uint32_t>(imm), rs);
-            return;
-        }
-    }
-
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b010, rd, 0b0000011);
-}
-
-void Assembler::MV(GPR rd, GPR rs) noexcept {
-    ADDI(rd, rs, 0);
-}
-
-void Assembler::NEG(GPR rd, GPR rs) noexcept {
-    SUB(rd, x0, rs);
-}
-
-void Assembler::NOP() noexcept {
-    ADDI(x0, x0, 0);
-}
-
-void Assembler::NOT(GPR rd, GPR rs) noexcept {
-    XORI(rd, rs, UINT32_MAX);
-}
-
-void Assembler::OR(GPR rd, GPR lhs, GPR rhs) noexcept {
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(lhs) && IsValid3BitCompressedReg(rhs)) {
-            if (rd == lhs) {
-                C_OR(rd, rhs);
-                return;
-            } else if (rd == rhs) {
-                C_OR(rd, lhs);
-                return;
-            }
-        }
-    }
-
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b110, rd, 0b0110011);
-}
-
-void Assembler::ORI(GPR rd, GPR rs, uint32_t imm) noexcept {
-    EmitIType(m_buffer, imm, rs, 0b110, rd, 0b0010011);
-}
-
 void Assembler::PAUSE() noexcept {
     m_buffer.Emit32(0x0100000F);
 }
@@ -552,318 +528,6 @@ void Assembler::RET() noexcept {
     JALR(x0, 0, x1);
 }
 
-void Assembler::SB(GPR rs2, int32_t imm, GPR rs1) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-    EmitSType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b000, 0b0100011);
-}
-
-void Assembler::SEQZ(GPR rd, GPR rs) noexcept {
-    SLTIU(rd, rs, 1);
-}
-
-void Assembler::SGT(GPR rd, GPR lhs, GPR rhs) noexcept {
-    SLT(rd, rhs, lhs);
-}
-
-void Assembler::SGTU(GPR rd, GPR lhs, GPR rhs) noexcept {
-    SLTU(rd, rhs, lhs);
-}
-
-void Assembler::SGTZ(GPR rd, GPR rs) noexcept {
-    SLT(rd, x0, rs);
-}
-
-void Assembler::SH(GPR rs2, int32_t imm, GPR rs1) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-    EmitSType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b001, 0b0100011);
-}
-
-void Assembler::SLL(GPR rd, GPR lhs, GPR rhs) noexcept {
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b001, rd, 0b0110011);
-}
-
-void Assembler::SLLI(GPR rd, GPR rs, uint32_t shift) noexcept {
-    if (IsRV32(m_features)) {
-        BISCUIT_ASSERT(shift <= 31);
-
-        if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-            if (rd != x0 && rd == rs && shift != 0) {
-                C_SLLI(rd, shift);
-                return;
-            }
-        }
-
-        EmitIType(m_buffer, shift & 0x1F, rs, 0b001, rd, 0b0010011);
-    } else {
-        BISCUIT_ASSERT(shift <= 63);
-
-        if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-            if (rd != x0 && rd == rs && shift != 0) {
-                C_SLLI(rd, shift);
-                return;
-            }
-        }
-
-        EmitIType(m_buffer, shift & 0x3F, rs, 0b001, rd, 0b0010011);
-    }
-}
-
-void Assembler::SLT(GPR rd, GPR lhs, GPR rhs) noexcept {
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b010, rd, 0b0110011);
-}
-
-void Assembler::SLTI(GPR rd, GPR rs, int32_t imm) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b010, rd, 0b0010011);
-}
-
-void Assembler::SLTIU(GPR rd, GPR rs, int32_t imm) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b011, rd, 0b0010011);
-}
-
-void Assembler::SLTU(GPR rd, GPR lhs, GPR rhs) noexcept {
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b011, rd, 0b0110011);
-}
-
-void Assembler::SLTZ(GPR rd, GPR rs) noexcept {
-    SLT(rd, rs, x0);
-}
-
-void Assembler::SNEZ(GPR rd, GPR rs) noexcept {
-    SLTU(rd, x0, rs);
-}
-
-void Assembler::SRA(GPR rd, GPR lhs, GPR rhs) noexcept {
-    EmitRType(m_buffer, 0b0100000, rhs, lhs, 0b101, rd, 0b0110011);
-}
-
-void Assembler::SRAI(GPR rd, GPR rs, uint32_t shift) noexcept {
-    if (IsRV32(m_features)) {
-        BISCUIT_ASSERT(shift <= 31);
-
-        if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-            if (rd != x0 && rd == rs && IsValid3BitCompressedReg(rd) && shift != 0) {
-                C_SRAI(rd, shift);
-                return;
-            }
-        }
-
-        EmitIType(m_buffer, (0b0100000 << 5) | (shift & 0x1F), rs, 0b101, rd, 0b0010011);
-    } else {
-        BISCUIT_ASSERT(shift <= 63);
-
-        if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-            if (IsRV64(m_features) && rd != x0 && rd == rs && IsValid3BitCompressedReg(rd) && shift != 0) {
-                C_SRAI(rd, shift);
-                return;
-            }
-        }
-
-        EmitIType(m_buffer, (0b0100000 << 5) | (shift & 0x3F), rs, 0b101, rd, 0b0010011);
-    }
-}
-
-void Assembler::SRL(GPR rd, GPR lhs, GPR rhs) noexcept {
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b101, rd, 0b0110011);
-}
-
-void Assembler::SRLI(GPR rd, GPR rs, uint32_t shift) noexcept {
-    if (IsRV32(m_features)) {
-        BISCUIT_ASSERT(shift <= 31);
-
-        if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-            if (rd != x0 && rd == rs && IsValid3BitCompressedReg(rd) && shift != 0) {
-                C_SRLI(rd, shift);
-                return;
-            }
-        }
-
-        EmitIType(m_buffer, shift & 0x1F, rs, 0b101, rd, 0b0010011);
-    } else {
-        BISCUIT_ASSERT(shift <= 63);
-
-        if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-            if (IsRV64(m_features) && rd != x0 && rd == rs && IsValid3BitCompressedReg(rd) && shift != 0) {
-                C_SRLI(rd, shift);
-                return;
-            }
-        }
-
-        EmitIType(m_buffer, shift & 0x3F, rs, 0b101, rd, 0b0010011);
-    }
-}
-
-void Assembler::SUB(GPR rd, GPR lhs, GPR rhs) noexcept {
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(rhs)) {
-            if (rd == lhs) {
-                C_SUB(rd, rhs);
-                return;
-            }
-        }
-    }
-
-    EmitRType(m_buffer, 0b0100000, rhs, lhs, 0b000, rd, 0b0110011);
-}
-
-void Assembler::SW(GPR rs2, int32_t imm, GPR rs1) noexcept {
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (rs1 == sp && imm >= 0 && imm <= 252 && (imm & 0b11) == 0) {
-            C_SWSP(rs2, static_cast<uint32_t>(imm));
-            return;
-        } else if (imm >= 0 && imm <= 124 && (imm & 0b11) == 0 && IsValid3BitCompressedReg(rs2) && IsValid3BitCompressedReg(rs1)) {
-            C_SW(rs2, static_cast<uint32_t>(imm), rs1);
-            return;
-        }
-    }
-
-    EmitSType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b010, 0b0100011);
-}
-
-void Assembler::XOR(GPR rd, GPR lhs, GPR rhs) noexcept {
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(lhs) && IsValid3BitCompressedReg(rhs)) {
-            if (rd == lhs) {
-                C_XOR(rd, rhs);
-                return;
-            } else if (rd == rhs) {
-                C_XOR(rd, lhs);
-                return;
-            }
-        }
-    }
-
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b100, rd, 0b0110011);
-}
-
-void Assembler::XORI(GPR rd, GPR rs, uint32_t imm) noexcept {
-    EmitIType(m_buffer, imm, rs, 0b100, rd, 0b0010011);
-}
-
-// RV64I Instructions
-
-void Assembler::ADDIW(GPR rd, GPR rs, int32_t imm) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (rd != x0 && rd == rs && IsValidSigned6BitImm(imm)) {
-            C_ADDIW(rd, imm);
-            return;
-        }
-    }
-
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b000, rd, 0b0011011);
-}
-
-void Assembler::ADDW(GPR rd, GPR lhs, GPR rhs) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(lhs) && IsValid3BitCompressedReg(rhs)) {
-            if (rd == lhs) {
-                C_ADDW(rd, rhs);
-                return;
-            } else if (rd == rhs) {
-                C_ADDW(rd, lhs);
-                return;
-            }
-        }
-    }
-
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b000, rd, 0b0111011);
-}
-
-void Assembler::LD(GPR rd, int32_t imm, GPR rs) noexcept {
-    BISCUIT_ASSERT(IsRV32OrRV64(m_features));
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (rs == sp && rd != x0 && imm >= 0 && imm <= 504 && (imm & 0b111) == 0) {
-            C_LDSP(rd, static_cast<uint32_t>(imm));
-            return;
-        } else if (imm >= 0 && imm <= 248 && (imm & 0b111) == 0 && IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(rs)) {
-            C_LD(rd, static_cast<uint32_t>(imm), rs);
-            return;
-        }
-    }
-
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b011, rd, 0b0000011);
-}
-
-void Assembler::LWU(GPR rd, int32_t imm, GPR rs) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-    EmitIType(m_buffer, static_cast<uint32_t>(imm), rs, 0b110, rd, 0b0000011);
-}
-
-void Assembler::NEGW(GPR rd, GPR rs) noexcept {
-    SUBW(rd, x0, rs);
-}
-
-void Assembler::SD(GPR rs2, int32_t imm, GPR rs1) noexcept {
-    BISCUIT_ASSERT(IsRV32OrRV64(m_features));
-    BISCUIT_ASSERT(IsValidSigned12BitImm(imm));
-
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (rs1 == sp && imm >= 0 && imm <= 504 && (imm & 0b111) == 0) {
-            C_SDSP(rs2, static_cast<uint32_t>(imm));
-            return;
-        } else if (imm >= 0 && imm <= 248 && (imm & 0b111) == 0 && IsValid3BitCompressedReg(rs2) && IsValid3BitCompressedReg(rs1)) {
-            C_SD(rs2, static_cast<uint32_t>(imm), rs1);
-            return;
-        }
-    }
-
-    EmitSType(m_buffer, static_cast<uint32_t>(imm), rs2, rs1, 0b011, 0b0100011);
-}
-
-void Assembler::SLLIW(GPR rd, GPR rs, uint32_t shift) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-    BISCUIT_ASSERT(shift <= 31);
-    EmitIType(m_buffer, shift & 0x1F, rs, 0b001, rd, 0b0011011);
-}
-void Assembler::SRAIW(GPR rd, GPR rs, uint32_t shift) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-    BISCUIT_ASSERT(shift <= 31);
-    EmitIType(m_buffer, (0b0100000 << 5) | (shift & 0x1F), rs, 0b101, rd, 0b0011011);
-}
-void Assembler::SRLIW(GPR rd, GPR rs, uint32_t shift) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-    BISCUIT_ASSERT(shift <= 31);
-    EmitIType(m_buffer, shift & 0x1F, rs, 0b101, rd, 0b0011011);
-}
-
-void Assembler::SLLW(GPR rd, GPR lhs, GPR rhs) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b001, rd, 0b0111011);
-}
-void Assembler::SRAW(GPR rd, GPR lhs, GPR rhs) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-    EmitRType(m_buffer, 0b0100000, rhs, lhs, 0b101, rd, 0b0111011);
-}
-void Assembler::SRLW(GPR rd, GPR lhs, GPR rhs) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-    EmitRType(m_buffer, 0b0000000, rhs, lhs, 0b101, rd, 0b0111011);
-}
-
-void Assembler::SUBW(GPR rd, GPR lhs, GPR rhs) noexcept {
-    BISCUIT_ASSERT(IsRV64(m_features));
-
-    if (IsOptimizationEnabled(Optimization::AutoCompress)) {
-        if (IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(rhs)) {
-            if (rd == lhs) {
-                C_SUBW(rd, rhs);
-                return;
-            }
-        }
-    }
-
-    EmitRType(m_buffer, 0b0100000, rhs, lhs, 0b000, rd, 0b0111011);
-}
-
 // Zawrs Extension Instructions
 
 void Assembler::WRS_NTO() noexcept {
@@ -1127,46 +791,58 @@ void Assembler::NTL_PALL() noexcept {
 // RV32M Extension Instructions
 
 void Assembler::DIV(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b100, rd, 0b0110011);
+    m_buffer.Emit32(encode::DIV(rd, rs1, rs2));
 }
 void Assembler::DIVU(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b101, rd, 0b0110011);
+    m_buffer.Emit32(encode::DIVU(rd, rs1, rs2));
 }
 void Assembler::MUL(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b000, rd, 0b0110011);
+    if (CanCompress(Extension::Zcb)) {
+        if (IsValid3BitCompressedReg(rd) && IsValid3BitCompressedReg(rs1) && IsValid3BitCompressedReg(rs2)) {
+            if (rd == rs1) {
+                C_MUL(rd, rs2);
+                return;
+            } else if (rd == rs2) {
+                C_MUL(rd, rs1);
+                return;
+            }
+        }
+    }
+
+    m_buffer.Emit32(encode::MUL(rd, rs1, rs2));
 }
 void Assembler::MULH(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b001, rd, 0b0110011);
+    m_buffer.Emit32(encode::MULH(rd, rs1, rs2));
 }
 void Assembler::MULHSU(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b010, rd, 0b0110011);
+    m_buffer.Emit32(encode::MULHSU(rd, rs1, rs2));
 }
 void Assembler::MULHU(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b011, rd, 0b0110011);
+    m_buffer.Emit32(encode::MULHU(rd, rs1, rs2));
 }
 void Assembler::REM(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b110, rd, 0b0110011);
+    m_buffer.Emit32(encode::REM(rd, rs1, rs2));
 }
 void Assembler::REMU(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b111, rd, 0b0110011);
+    m_buffer.Emit32(encode::REMU(rd, rs1, rs2));
 }
 
 // RV64M Extension Instructions
 
 void Assembler::DIVW(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b100, rd, 0b0111011);
+    m_buffer.Emit32(encode::DIVW(rd, rs1, rs2));
 }
 void Assembler::DIVUW(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b101, rd, 0b0111011);
+    m_buffer.Emit32(encode::DIVUW(rd, rs1, rs2));
 }
 void Assembler::MULW(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b000, rd, 0b0111011);
+    m_buffer.Emit32(encode::MULW(rd, rs1, rs2));
 }
 void Assembler::REMW(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b110, rd, 0b0111011);
+    m_buffer.Emit32(encode::REMW(rd, rs1, rs2));
 }
 void Assembler::REMUW(GPR rd, GPR rs1, GPR rs2) noexcept {
-    EmitRType(m_buffer, 0b0000001, rs2, rs1, 0b111, rd, 0b0111011);
+    m_buffer.Emit32(encode::REMUW(rd, rs1, rs2));
 }
 
 // RV32A Extension Instructions
@@ -1256,6 +932,14 @@ void Assembler::SC_D(Ordering ordering, GPR rd, GPR rs2, GPR rs1) noexcept {
 
 void Assembler::ADDUW(GPR rd, GPR rs1, GPR rs2) noexcept {
     BISCUIT_ASSERT(IsRV64(m_features));
+
+    if (CanCompress(Extension::Zcb)) {
+        if (rd == rs1 && rs2 == x0 && IsValid3BitCompressedReg(rd)) {
+            C_ZEXT_W(rd);
+            return;
+        }
+    }
+
     EmitRType(m_buffer, 0b0000100, rs2, rs1, 0b000, rd, 0b0111011);
 }
 
@@ -1324,7 +1008,7 @@ void Assembler::BSETI(GPR rd, GPR rs, uint32_t bit) noexcept {
     }
 
     const auto imm = (0b001010U << 6) | bit;
-    EmitIType(m_buffer, imm, rs, 0b001, rd, 0b0110011);
+    EmitIType(m_buffer, imm, rs, 0b001, rd, 0b0010011);
 }
 
 void Assembler::CLMUL(GPR rd, GPR rs1, GPR rs2) noexcept {
@@ -1443,10 +1127,18 @@ void Assembler::RORW(GPR rd, GPR rs1, GPR rs2) noexcept {
 }
 
 void Assembler::SEXTB(GPR rd, GPR rs) noexcept {
+    if (CanCompress(Extension::Zcb) && rd == rs && IsValid3BitCompressedReg(rd)) {
+        C_SEXT_B(rd);
+        return;
+    }
     EmitIType(m_buffer, 0b011000000100, rs, 0b001, rd, 0b0010011);
 }
 
 void Assembler::SEXTH(GPR rd, GPR rs) noexcept {
+    if (CanCompress(Extension::Zcb) && rd == rs && IsValid3BitCompressedReg(rd)) {
+        C_SEXT_H(rd);
+        return;
+    }
     EmitIType(m_buffer, 0b011000000101, rs, 0b001, rd, 0b0010011);
 }
 
@@ -1502,6 +1194,11 @@ void Assembler::XPERM8(GPR rd, GPR rs1, GPR rs2) noexcept {
 }
 
 void Assembler::ZEXTH(GPR rd, GPR rs) noexcept {
+    if (CanCompress(Extension::Zcb) && rd == rs && IsValid3BitCompressedReg(rd)) {
+        C_ZEXT_H(rd);
+        return;
+    }
+
     if (IsRV32(m_features)) {
         EmitIType(m_buffer, 0b000010000000, rs, 0b100, rd, 0b0110011);
     } else {
@@ -1696,8 +1393,12 @@ void Assembler::WFI() noexcept {
 
 void Assembler::BindToOffset(Label* label, Label::LocationOffset offset) {
     BISCUIT_ASSERT(label != nullptr);
+    // Label objects aren't tracked by the assembler, so they can't be
+    // adjusted if pending relaxed branches end up moving code.
+    BISCUIT_ASSERT(m_relaxation_sites.empty());
     BISCUIT_ASSERT(offset >= 0 && offset <= m_buffer.GetCursorOffset());
 
+    DropPendingVeneers(label, LabelHandle{}, offset);
     label->Bind(offset);
     ResolveLabelOffsets(label);
     label->ClearOffsets();
@@ -1705,6 +1406,7 @@ void Assembler::BindToOffset(Label* label, Label::LocationOffset offset) {
 
 ptrdiff_t Assembler::LinkAndGetOffset(Label* label) {
     BISCUIT_ASSERT(label != nullptr);
+    BISCUIT_ASSERT(m_relaxation_sites.empty());
 
     // If we have a bound label, then it's straightforward to calculate
     // the offsets.
@@ -1723,6 +1425,73 @@ ptrdiff_t Assembler::LinkAndGetOffset(Label* label) {
 }
 
 void Assembler::ResolveLabelOffsets(Label* label) {
+    const auto label_location = *label->GetLocation();
+
+    for (const auto offset : label->m_offsets) {
+        ResolveFixup(DeferredFixup::Kind::Branch, label_location, offset);
+    }
+}
+
+void Assembler::BindToOffset(LabelHandle label, LabelPool::LocationOffset offset) {
+    BISCUIT_ASSERT(offset >= 0 && offset <= m_buffer.GetCursorOffset());
+
+    DropPendingVeneers(nullptr, label, offset);
+    m_label_pool.Bind(label, offset);
+    m_label_pool.ConsumeFixups(label, [this, offset](ptrdiff_t fixup) {
+        ResolveFixup(DeferredFixup::Kind::Branch, offset, fixup);
+    });
+}
+
+ptrdiff_t Assembler::LinkAndGetOffset(LabelHandle label) {
+    // Same as with regular labels, bound labels can be calculated right away,
+    // while unbound labels get an offset of zero that's patched over on binding.
+    if (const auto location = m_label_pool.GetLocation(label)) {
+        const auto cursor_address = m_buffer.GetCursorAddress();
+        const auto label_offset = m_buffer.GetOffsetAddress(*location);
+        return static_cast<ptrdiff_t>(label_offset - cursor_address);
+    }
+
+    m_label_pool.AddFixup(label, m_buffer.GetCursorOffset());
+    return 0;
+}
+
+void Assembler::ResolveFixup(DeferredFixup::Kind kind, ptrdiff_t target, ptrdiff_t offset) {
+    if (IsOptimizationEnabled(Optimization::DeferFixups)) {
+        m_deferred_fixups.push_back({offset, target, kind});
+        return;
+    }
+
+    if (kind == DeferredFixup::Kind::Branch) {
+        PatchLabelOffset(target, offset);
+    } else {
+        PatchLiteralOffset(target, offset);
+    }
+}
+
+void Assembler::ApplyDeferredFixups() {
+    if (m_deferred_fixups.empty()) {
+        return;
+    }
+
+    // Fixups are recorded in binding order, which jumps all over the buffer.
+    // Sorting them lets us patch everything in one forward sweep.
+    std::sort(m_deferred_fixups.begin(), m_deferred_fixups.end(),
+              [](const DeferredFixup& lhs, const DeferredFixup& rhs) {
+                  return lhs.offset < rhs.offset;
+              });
+
+    for (const auto& fixup : m_deferred_fixups) {
+        if (fixup.kind == DeferredFixup::Kind::Branch) {
+            PatchLabelOffset(fixup.target, fixup.offset);
+        } else {
+            PatchLiteralOffset(fixup.target, fixup.offset);
+        }
+    }
+
+    m_deferred_fixups.clear();
+}
+
+void Assembler::PatchLabelOffset(ptrdiff_t label_location, ptrdiff_t offset) {
     // Conditional branch instructions make use of the B-type immediate encoding for offsets.
     const auto is_b_type = [](uint32_t instruction) {
         return (instruction & 0x7F) == 0b1100011;
@@ -1753,88 +1522,122 @@ void Assembler::ResolveLabelOffsets(Label* label) {
         }
     };
 
-    const auto label_location = *label->GetLocation();
+    // Jump veneers (see Optimization::JumpVeneers) use an AUIPC+JALR pair.
+    const auto is_auipc = [](uint32_t instruction) {
+        return (instruction & 0x7F) == 0b0010111;
+    };
 
-    for (const auto offset : label->m_offsets) {
-        const auto address = m_buffer.GetOffsetAddress(offset);
-        auto* const ptr = reinterpret_cast<uint8_t*>(address);
-        const auto inst_size = determine_inst_size(uint32_t{*ptr} | (uint32_t{*(ptr + 1)} << 8));
-
-        uint32_t instruction = 0;
-        std::memcpy(&instruction, ptr, inst_size);
-
-        // Given all branch instructions we need to patch have 0 encoded as
-        // their branch offset, we don't need to worry about any masking work.
-        //
-        // It's enough to verify that the immediate is going to be valid
-        // and then OR it into the instruction.
-
-        const auto encoded_offset = label_location - offset;
-
-        if (inst_size == sizeof(uint32_t)) {
-            if (is_b_type(instruction)) {
-                BISCUIT_ASSERT(IsValidBTypeImm(encoded_offset));
-                instruction |= TransformToBTypeImm(static_cast<uint32_t>(encoded_offset));
-            } else if (is_j_type(instruction)) {
-                BISCUIT_ASSERT(IsValidJTypeImm(encoded_offset));
-                instruction |= TransformToJTypeImm(static_cast<uint32_t>(encoded_offset));
-            }
-        } else {
-            if (is_cb_type(instruction)) {
-                BISCUIT_ASSERT(IsValidCBTypeImm(encoded_offset));
-                instruction |= TransformToCBTypeImm(static_cast<uint32_t>(encoded_offset));
-            } else if (is_cj_type(instruction)) {
-                BISCUIT_ASSERT(IsValidCJTypeImm(encoded_offset));
-                instruction |= TransformToCJTypeImm(static_cast<uint32_t>(encoded_offset));
-            }
+    auto* const ptr = m_buffer.GetOffsetPointer(offset);
+    const auto inst_size = determine_inst_size(uint32_t{*ptr} | (uint32_t{*(ptr + 1)} << 8));
+
+    uint32_t instruction = 0;
+    std::memcpy(&instruction, ptr, inst_size);
+
+    if (inst_size == sizeof(uint32_t) && is_auipc(instruction)) {
+        const auto pair_offset = label_location - offset;
+        BISCUIT_ASSERT(IsValidAUIPCPairImm(pair_offset));
+
+        uint32_t jalr = 0;
+        std::memcpy(&jalr, ptr + sizeof(uint32_t), sizeof(jalr));
+        instruction |= GetAUIPCPairHi20(pair_offset) << 12;
+        jalr |= (static_cast<uint32_t>(GetAUIPCPairLo12(pair_offset)) & 0xFFF) << 20;
+
+        std::memcpy(ptr, &instruction, sizeof(instruction));
+        std::memcpy(ptr + sizeof(uint32_t), &jalr, sizeof(jalr));
+        m_buffer.MarkDirty(offset, 2 * sizeof(uint32_t));
+        return;
+    }
+
+    // Given all branch instructions we need to patch have 0 encoded as
+    // their branch offset, we don't need to worry about any masking work.
+    //
+    // It's enough to verify that the immediate is going to be valid
+    // and then OR it into the instruction.
+
+    const auto encoded_offset = label_location - offset;
+
+    if (inst_size == sizeof(uint32_t)) {
+        if (is_b_type(instruction)) {
+            BISCUIT_ASSERT(IsValidBTypeImm(encoded_offset));
+            instruction |= TransformToBTypeImm(static_cast<uint32_t>(encoded_offset));
+        } else if (is_j_type(instruction)) {
+            BISCUIT_ASSERT(IsValidJTypeImm(encoded_offset));
+            instruction |= TransformToJTypeImm(static_cast<uint32_t>(encoded_offset));
+        }
+    } else {
+        if (is_cb_type(instruction)) {
+            BISCUIT_ASSERT(IsValidCBTypeImm(encoded_offset));
+            instruction |= TransformToCBTypeImm(static_cast<uint32_t>(encoded_offset));
+        } else if (is_cj_type(instruction)) {
+            BISCUIT_ASSERT(IsValidCJTypeImm(encoded_offset));
+            instruction |= TransformToCJTypeImm(static_cast<uint32_t>(encoded_offset));
         }
+    }
 
-        std::memcpy(ptr, &instruction, inst_size);
+    std::memcpy(ptr, &instruction, inst_size);
+    m_buffer.MarkDirty(offset, inst_size);
+}
+
+void Assembler::ResolveLiteralOffsetsRaw(ptrdiff_t location, std::span<const ptrdiff_t> offsets) {
+    for (const auto offset : offsets) {
+        ResolveFixup(DeferredFixup::Kind::LiteralLoad, location, offset);
     }
 }
 
-void Assembler::ResolveLiteralOffsetsRaw(ptrdiff_t location, const std::set<ptrdiff_t>& offsets) {
+void Assembler::EmitLiteralLoad(Register rd, GPR base, ptrdiff_t offset, uint32_t funct3, uint32_t opcode) {
+    BISCUIT_ASSERT(IsValidAUIPCPairImm(offset));
+
+    // Both instructions are always emitted uncompressed, since
+    // literal fixups expect an AUIPC followed by a 32-bit load.
+    auto reservation = m_buffer.Reserve(2 * sizeof(uint32_t));
+    EmitUType(reservation, GetAUIPCPairHi20(offset), base, 0b0010111);
+    EmitIType(reservation, static_cast<uint32_t>(GetAUIPCPairLo12(offset)), base, funct3, rd, opcode);
+}
+
+void Assembler::PatchLiteralOffset(ptrdiff_t location, ptrdiff_t offset) {
     [[maybe_unused]] const auto is_auipc_type = [](uint32_t instruction) {
         return (instruction & 0x7F) == 0b0010111;
     };
 
-    const auto is_gpr_load_type = [](uint32_t instruction) {
-        return (instruction & 0x7F) == 0b0000011;
+    // All of the instructions that can follow the AUIPC use the I-type encoding.
+    const auto is_i_type = [](uint32_t instruction) {
+        const auto opcode = instruction & 0x7F;
+        return opcode == 0b0000011 || // GPR loads
+               opcode == 0b0000111 || // FP loads
+               opcode == 0b0010011;   // ADDI (address calculation)
     };
 
-    for (const auto offset : offsets) {
-        const auto address = m_buffer.GetOffsetAddress(offset);
-        auto* const ptr = reinterpret_cast<uint8_t*>(address);
+    auto* const ptr = m_buffer.GetOffsetPointer(offset);
 
-        std::array<uint32_t, 2> instructions{};
-        std::memcpy(&instructions[0], ptr, sizeof(uint32_t));
-        std::memcpy(&instructions[1], ptr + sizeof(uint32_t), sizeof(uint32_t));
+    std::array<uint32_t, 2> instructions{};
+    std::memcpy(&instructions[0], ptr, sizeof(uint32_t));
+    std::memcpy(&instructions[1], ptr + sizeof(uint32_t), sizeof(uint32_t));
 
-        // Given all load instructions we need to patch have 0 encoded as
-        // their load offset, we don't need to worry about any masking work.
-        //
-        // It's enough to verify that the immediate is going to be valid
-        // and then OR it into the instruction.
+    // Given all load instructions we need to patch have 0 encoded as
+    // their load offset, we don't need to worry about any masking work.
+    //
+    // It's enough to verify that the immediate is going to be valid
+    // and then OR it into the instruction.
 
-        const auto encoded_offset = location - offset;
+    const auto encoded_offset = location - offset;
 
-        BISCUIT_ASSERT(is_auipc_type(instructions[0]));
+    BISCUIT_ASSERT(is_auipc_type(instructions[0]));
 
-        // Make sure the distance is within the bounds of a 32-bit signed integer.
-        BISCUIT_ASSERT((static_cast<int64_t>(encoded_offset << 32) >> 32) == encoded_offset);
+    // Make sure the distance is reachable by AUIPC and the sign-extended load offset.
+    BISCUIT_ASSERT(IsValidAUIPCPairImm(encoded_offset));
 
-        if (is_gpr_load_type(instructions[1])) {
-            const auto high20 = static_cast<uint32_t>(encoded_offset & 0xFFFFF000);
-            const auto low12 = static_cast<uint32_t>(encoded_offset & 0xFFF);
-            instructions[0] |= high20;
-            instructions[1] |= low12 << 20;
-        } else {
-            BISCUIT_ASSERT(false);
-        }
-
-        std::memcpy(ptr, &instructions[0], sizeof(uint32_t));
-        std::memcpy(ptr + sizeof(uint32_t), &instructions[1], sizeof(uint32_t));
+    if (is_i_type(instructions[1])) {
+        const auto high20 = GetAUIPCPairHi20(encoded_offset);
+        const auto low12 = static_cast<uint32_t>(GetAUIPCPairLo12(encoded_offset)) & 0xFFF;
+        instructions[0] |= high20 << 12;
+        instructions[1] |= low12 << 20;
+    } else {
+        BISCUIT_ASSERT(false);
     }
+
+    std::memcpy(ptr, &instructions[0], sizeof(uint32_t));
+    std::memcpy(ptr + sizeof(uint32_t), &instructions[1], sizeof(uint32_t));
+    m_buffer.MarkDirty(offset, sizeof(instructions));
 }
 
 } // namespace biscuit
@@ -13,60 +13,34 @@ namespace {
 // Emits a compressed branch instruction. These consist of:
 // funct3 | imm[8|4:3] | rs | imm[7:6|2:1|5] | op
 void EmitCompressedBranch(CodeBuffer& buffer, uint32_t funct3, int32_t offset, GPR rs, uint32_t op) {
-    BISCUIT_ASSERT(IsValidCBTypeImm(offset));
-    BISCUIT_ASSERT((offset % 2) == 0);
-    BISCUIT_ASSERT(IsValid3BitCompressedReg(rs));
-
-    const auto transformed_imm = TransformToCBTypeImm(static_cast<uint32_t>(offset));
-    const auto rs_san = CompressedRegTo3BitEncoding(rs);
-    buffer.Emit16(((funct3 & 0b111) << 13) | transformed_imm | (rs_san << 7) | (op & 0b11));
+    buffer.Emit16(encode::CBType(funct3, offset, rs, op));
 }
 
 // Emits a compressed jump instruction. These consist of:
 // funct3 | imm | op
 void EmitCompressedJump(CodeBuffer& buffer, uint32_t funct3, int32_t offset, uint32_t op) {
-    BISCUIT_ASSERT(IsValidCJTypeImm(offset));
-    BISCUIT_ASSERT((offset % 2) == 0);
-
-    buffer.Emit16(TransformToCJTypeImm(static_cast<uint32_t>(offset)) |
-                  ((funct3 & 0b111) << 13) | (op & 0b11));
+    buffer.Emit16(encode::CJType(funct3, offset, op));
 }
 
 // Emits a compress immediate instruction. These consist of:
 // funct3 | imm | rd | imm | op
 void EmitCompressedImmediate(CodeBuffer& buffer, uint32_t funct3, uint32_t imm, GPR rd, uint32_t op) {
     BISCUIT_ASSERT(rd != x0);
-
-    const auto new_imm = ((imm & 0b11111) << 2) | ((imm & 0b100000) << 7);
-    buffer.Emit16(((funct3 & 0b111) << 13) | new_imm | (rd.Index() << 7) | (op & 0b11));
+    buffer.Emit16(encode::CIType(funct3, imm, rd, op));
 }
 
 // Emits a compressed load instruction. These consist of:
 // funct3 | imm | rs1 | imm | rd | op
 void EmitCompressedLoad(CodeBuffer& buffer, uint32_t funct3, uint32_t imm, GPR rs,
                         Register rd, uint32_t op) {
-    BISCUIT_ASSERT(IsValid3BitCompressedReg(rs));
-    BISCUIT_ASSERT(IsValid3BitCompressedReg(rd));
-
-    imm &= 0xF8;
-
-    const auto imm_enc = ((imm & 0x38) << 7) | ((imm & 0xC0) >> 1);
-    const auto rd_san = CompressedRegTo3BitEncoding(rd);
-    const auto rs_san = CompressedRegTo3BitEncoding(rs);
-    buffer.Emit16(((funct3 & 0b111) << 13) | imm_enc | (rs_san << 7) | (rd_san << 2) | (op & 0b11));
+    buffer.Emit16(encode::CLType(funct3, imm, rs, rd, op));
 }
 
 // Emits a compressed register arithmetic instruction. These consist of:
 // funct6 | rd | funct2 | rs | op
 void EmitCompressedRegArith(CodeBuffer& buffer, uint32_t funct6, GPR rd, uint32_t funct2,
                             GPR rs, uint32_t op) {
-    BISCUIT_ASSERT(IsValid3BitCompressedReg(rs));
-    BISCUIT_ASSERT(IsValid3BitCompressedReg(rd));
-
-    const auto rd_san = CompressedRegTo3BitEncoding(rd);
-    const auto rs_san = CompressedRegTo3BitEncoding(rs);
-    buffer.Emit16(((funct6 & 0b111111) << 10) | (rd_san << 7) | ((funct2 & 0b11) << 5) |
-                  (rs_san << 2) | (op & 0b11));
+    buffer.Emit16(encode::CAType(funct6, rd, funct2, rs, op));
 }
 
 // Emits a compressed store instruction. These consist of:
@@ -82,11 +56,7 @@ void EmitCompressedStore(CodeBuffer& buffer, uint32_t funct3, uint32_t imm, GPR
 // funct3 | imm | rd | opcode
 void EmitCompressedWideImmediate(CodeBuffer& buffer, uint32_t funct3, uint32_t imm,
                                  GPR rd, uint32_t op) {
-    BISCUIT_ASSERT(IsValid3BitCompressedReg(rd));
-
-    const auto rd_sanitized = CompressedRegTo3BitEncoding(rd);
-    buffer.Emit16(((funct3 & 0b111) << 13) | ((imm & 0xFF) << 5) |
-                  (rd_sanitized << 2) | (op & 0b11));
+    buffer.Emit16(encode::CIWType(funct3, imm, rd, op));
 }
 
 void EmitCLBType(CodeBuffer& buffer, uint32_t funct6, GPR rs, uint32_t uimm, GPR rd,
@@ -253,6 +223,16 @@ void Assembler::C_BEQZ(GPR rs, Label* label) noexcept {
     C_BEQZ(rs, static_cast<int32_t>(address));
 }
 
+void Assembler::C_BEQZ(GPR rs, LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableBranch(0b000, rs, x0, label, true);
+        return;
+    }
+
+    const auto address = LinkAndGetOffset(label);
+    C_BEQZ(rs, static_cast<int32_t>(address));
+}
+
 void Assembler::C_BNEZ(GPR rs, int32_t offset) noexcept {
     EmitCompressedBranch(m_buffer, 0b111, offset, rs, 0b01);
 }
@@ -262,6 +242,16 @@ void Assembler::C_BNEZ(GPR rs, Label* label) noexcept {
     C_BNEZ(rs, static_cast<int32_t>(address));
 }
 
+void Assembler::C_BNEZ(GPR rs, LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableBranch(0b001, rs, x0, label, true);
+        return;
+    }
+
+    const auto address = LinkAndGetOffset(label);
+    C_BNEZ(rs, static_cast<int32_t>(address));
+}
+
 void Assembler::C_EBREAK() noexcept {
     m_buffer.Emit16(0x9002);
 }
@@ -338,8 +328,19 @@ void Assembler::C_J(Label* label) noexcept {
     C_J(static_cast<int32_t>(address));
 }
 
+void Assembler::C_J(LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableJump(x0, label, true);
+        return;
+    }
+
+    const auto address = LinkAndGetOffset(label);
+    C_J(static_cast<int32_t>(address));
+}
+
 void Assembler::C_J(int32_t offset) noexcept {
     EmitCompressedJump(m_buffer, 0b101, offset, 0b01);
+    OnUnconditionalTransfer();
 }
 
 void Assembler::C_JAL(Label* label) noexcept {
@@ -347,6 +348,16 @@ void Assembler::C_JAL(Label* label) noexcept {
     C_JAL(static_cast<int32_t>(address));
 }
 
+void Assembler::C_JAL(LabelHandle label) noexcept {
+    if (IsOptimizationEnabled(Optimization::RelaxBranches)) {
+        EmitRelaxableJump(x1, label, true);
+        return;
+    }
+
+    const auto address = LinkAndGetOffset(label);
+    C_JAL(static_cast<int32_t>(address));
+}
+
 void Assembler::C_JAL(int32_t offset) noexcept {
     BISCUIT_ASSERT(IsRV32(m_features));
     EmitCompressedJump(m_buffer, 0b001, offset, 0b01);
@@ -383,6 +394,7 @@ void Assembler::C_JALR(GPR rs) noexcept {
 void Assembler::C_JR(GPR rs) noexcept {
     BISCUIT_ASSERT(rs != x0);
     m_buffer.Emit16(0x8002 | (rs.Index() << 7));
+    OnUnconditionalTransfer();
 }
 
 void Assembler::C_LD(GPR rd, uint32_t imm, GPR rs) noexcept {
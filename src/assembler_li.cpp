@@ -0,0 +1,297 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/assembler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "assembler_util.hpp"
+
+// Cost-model-driven constant materialization for LI.
+//
+// Candidate instruction sequences are built up as small lists of steps,
+// all of which operate on the destination register alone, and the cheapest
+// one according to the assembler's cost model gets emitted.
+
+namespace biscuit {
+namespace {
+
+enum class LIOp : uint8_t {
+    LUI,    // rd = imm << 12
+    ADDI,   // rd = src + imm
+    ADDIW,  // rd = sext32(src + imm)
+    SLLI,   // rd = rd << imm
+    SRLI,   // rd = rd >> imm
+    BSETI,  // rd = rd | (1 << imm)
+    BCLRI,  // rd = rd & ~(1 << imm)
+    RORI,   // rd = rotr(rd, imm)
+    ADDUW,  // rd = zext32(rd)
+    SHNADD, // rd = (rd << imm) + rd
+};
+
+struct LIStep {
+    LIOp op;
+    int32_t imm;
+};
+
+// Longest sequence is the 8-instruction base sequence with the single extra
+// instruction that candidates append to a base sequence.
+struct LISequence {
+    void Push(LIOp op, int64_t imm) noexcept {
+        BISCUIT_ASSERT(size < steps.size());
+        steps[size++] = {op, static_cast<int32_t>(imm)};
+    }
+
+    std::array<LIStep, 9> steps{};
+    uint32_t size = 0;
+};
+
+[[nodiscard]] constexpr bool FitsInSigned32(uint64_t imm) noexcept {
+    return static_cast<uint64_t>(static_cast<int64_t>(imm << 32) >> 32) == imm;
+}
+
+[[nodiscard]] constexpr uint64_t SignExtend32(uint32_t value) noexcept {
+    return static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(value)));
+}
+
+// Same as the regular RV64 LI sequence (LUI+ADDIW+SLLI+ADDI+SLLI+ADDI+SLLI+ADDI),
+// just recorded as steps instead of being emitted.
+void GenerateBaseSequence(uint64_t imm, LISequence& seq) noexcept {
+    if (FitsInSigned32(imm)) {
+        const auto hi20 = (static_cast<uint32_t>(imm) + 0x800) >> 12 & 0xFFFFF;
+        const auto lo12 = static_cast<int32_t>(static_cast<uint32_t>(imm) << 20) >> 20;
+
+        if (hi20 != 0) {
+            seq.Push(LIOp::LUI, hi20);
+        }
+        if (lo12 != 0 || hi20 == 0) {
+            seq.Push(LIOp::ADDIW, lo12);
+        }
+        return;
+    }
+
+    const auto lo12 = static_cast<int32_t>(static_cast<int64_t>(imm << 52) >> 52);
+    uint64_t hi52 = (imm + 0x800) >> 12;
+    const uint32_t shift = 12 + static_cast<uint32_t>(std::countr_zero(hi52));
+    hi52 = static_cast<uint64_t>((static_cast<int64_t>(hi52 >> (shift - 12)) << shift) >> shift);
+
+    GenerateBaseSequence(hi52, seq);
+    seq.Push(LIOp::SLLI, shift);
+    if (lo12 != 0) {
+        seq.Push(LIOp::ADDI, lo12);
+    }
+}
+
+// Generates the base sequence for `imm` followed by `op`,
+// if that is cheaper than the current best sequence.
+void TryCandidate(uint64_t imm, LIOp op, uint32_t op_imm, LISequence& best) noexcept {
+    LISequence seq;
+    GenerateBaseSequence(imm, seq);
+    if (seq.size + 1 >= best.size) {
+        return;
+    }
+    seq.Push(op, op_imm);
+    best = seq;
+}
+
+// Finds the shortest sequence out of all candidates for the given extensions.
+// Every step is dependent on the previous one, so this is the one with the
+// lowest latency as well.
+LISequence FindShortestSequence(uint64_t imm, bool has_zba, bool has_zbb, bool has_zbs) noexcept {
+    LISequence best;
+    GenerateBaseSequence(imm, best);
+    if (best.size <= 2) {
+        return best;
+    }
+
+    // Values with leading zeros can be built from the value shifted to the top,
+    // e.g. 0x00000FFFFFFFFFFF is -1 shifted right by 20 bits. The bits shifted
+    // in at the bottom are free to choose, so try both all zeros and all ones.
+    if (const auto lz = static_cast<uint32_t>(std::countl_zero(imm)); lz != 0 && lz != 64) {
+        const auto shifted = imm << lz;
+        TryCandidate(shifted, LIOp::SRLI, lz, best);
+        TryCandidate(shifted | ((uint64_t{1} << lz) - 1), LIOp::SRLI, lz, best);
+    }
+
+    if (has_zbs) {
+        // Set or clear a single bit that the base sequence has a hard time with,
+        // e.g. 0x8000000000000123 is 0x123 with bit 63 set, while 0x7FFFFFFFFFFFFFFF
+        // is -1 with bit 63 cleared. The most significant set or cleared bit is the
+        // one that makes the rest of the value the simplest to build.
+        if (imm != 0) {
+            const auto bit = 63U - static_cast<uint32_t>(std::countl_zero(imm));
+            TryCandidate(imm & ~(uint64_t{1} << bit), LIOp::BSETI, bit, best);
+        }
+        if (imm != ~uint64_t{0}) {
+            const auto bit = 63U - static_cast<uint32_t>(std::countl_one(imm));
+            TryCandidate(imm | (uint64_t{1} << bit), LIOp::BCLRI, bit, best);
+        }
+
+        // Values that are a single bit away from a sign-extended 32-bit value.
+        const auto low = SignExtend32(static_cast<uint32_t>(imm));
+        if (const auto diff = imm ^ low; std::has_single_bit(diff)) {
+            const auto bit = static_cast<uint32_t>(std::countr_zero(diff));
+            TryCandidate(low, (imm & diff) != 0 ? LIOp::BSETI : LIOp::BCLRI, bit, best);
+        }
+    }
+
+    if (has_zbb) {
+        // Rotated values, e.g. 0xF00000000000000F is 0xFF rotated right by 4.
+        for (uint32_t amount = 1; amount < 64; amount++) {
+            const auto rotated = std::rotl(imm, static_cast<int>(amount));
+            if (FitsInSigned32(rotated)) {
+                TryCandidate(rotated, LIOp::RORI, amount, best);
+            }
+        }
+    }
+
+    if (has_zba) {
+        // Zero-extended 32-bit values, e.g. 0x00000000FFFFF800, via ZEXT.W.
+        if ((imm >> 32) == 0) {
+            TryCandidate(SignExtend32(static_cast<uint32_t>(imm)), LIOp::ADDUW, 0, best);
+        }
+
+        // Multiples of 3, 5 and 9 via SH1ADD, SH2ADD and SH3ADD.
+        for (uint32_t shift = 1; shift <= 3; shift++) {
+            const auto factor = static_cast<int64_t>((1U << shift) + 1);
+            const auto value = static_cast<int64_t>(imm);
+            if (value % factor == 0) {
+                TryCandidate(static_cast<uint64_t>(value / factor), LIOp::SHNADD, shift, best);
+            }
+        }
+    }
+
+    return best;
+}
+
+// Emits a single step of a sequence with `rd` as the destination.
+// Only the first step of a sequence may read the zero register.
+void EmitLIStep(Assembler& as, GPR rd, const LIStep& step, bool is_first) noexcept {
+    const auto src = is_first ? zero : rd;
+    const auto imm_u = static_cast<uint32_t>(step.imm);
+
+    switch (step.op) {
+    case LIOp::LUI:
+        as.LUI(rd, imm_u);
+        break;
+    case LIOp::ADDI:
+        as.ADDI(rd, src, step.imm);
+        break;
+    case LIOp::ADDIW:
+        as.ADDIW(rd, src, step.imm);
+        break;
+    case LIOp::SLLI:
+        as.SLLI(rd, rd, imm_u);
+        break;
+    case LIOp::SRLI:
+        as.SRLI(rd, rd, imm_u);
+        break;
+    case LIOp::BSETI:
+        as.BSETI(rd, rd, imm_u);
+        break;
+    case LIOp::BCLRI:
+        as.BCLRI(rd, rd, imm_u);
+        break;
+    case LIOp::RORI:
+        as.RORI(rd, rd, imm_u);
+        break;
+    case LIOp::ADDUW:
+        as.ADDUW(rd, rd, zero);
+        break;
+    case LIOp::SHNADD:
+        if (imm_u == 1) {
+            as.SH1ADD(rd, rd, rd);
+        } else if (imm_u == 2) {
+            as.SH2ADD(rd, rd, rd);
+        } else {
+            as.SH3ADD(rd, rd, rd);
+        }
+        break;
+    }
+}
+
+} // Anonymous namespace
+
+void Assembler::LIWithCostModel(GPR rd, uint64_t imm) {
+    const auto seq = FindShortestSequence(imm,
+                                          IsExtensionEnabled(Extension::Zba),
+                                          IsExtensionEnabled(Extension::Zbb),
+                                          IsExtensionEnabled(Extension::Zbs));
+
+    // Literal loads can't be placed while branches are still waiting to be relaxed
+    // (see LoadConstant()), so those LIs are emitted as a sequence instead.
+    if (IsOptimizationEnabled(Optimization::LIFromLiteralPool) && rd != x0 &&
+        m_relaxation_sites.empty()) {
+        // AUIPC+LD costs two instructions and, unless the constant is already
+        // in the pool, another 8 bytes of data. Latency-wise it's AUIPC followed
+        // by a load, which is assumed to take three cycles.
+        constexpr uint32_t load_latency = 3;
+        const auto pooled_cost = m_li_cost_model == LICostModel::Latency
+                                     ? 1 + load_latency
+                                     : (m_literal_pool.Find(imm) != nullptr ? 2 : 4);
+
+        if (pooled_cost < seq.size) {
+            LoadConstant(rd, imm);
+            return;
+        }
+    }
+
+    for (uint32_t i = 0; i < seq.size; i++) {
+        EmitLIStep(*this, rd, seq.steps[i], i == 0);
+    }
+}
+
+void Assembler::LI(GPR rd, uint64_t imm, GPR scratch) noexcept {
+    BISCUIT_ASSERT(scratch != x0);
+    BISCUIT_ASSERT(scratch != rd);
+
+    if (!IsRV64(m_features)) {
+        LI(rd, imm);
+        return;
+    }
+
+    const auto serial_length = FindShortestSequence(imm,
+                                                    IsExtensionEnabled(Extension::Zba),
+                                                    IsExtensionEnabled(Extension::Zbb),
+                                                    IsExtensionEnabled(Extension::Zbs)).size;
+
+    // Build the two 32-bit halves independently of one another. Without PACK, the halves
+    // are merged with an ADD, which means the sign-extension of the low half has to be
+    // cancelled out by adding one to the high half.
+    const bool use_pack = IsExtensionEnabled(Extension::Zbkb);
+    const auto lo32 = static_cast<uint32_t>(imm);
+    const auto hi32 = static_cast<uint32_t>(imm >> 32) + (use_pack ? 0 : lo32 >> 31);
+
+    LISequence lo;
+    LISequence hi;
+    GenerateBaseSequence(SignExtend32(lo32), lo);
+    GenerateBaseSequence(SignExtend32(hi32), hi);
+
+    // The high half additionally needs to be shifted into place without PACK.
+    const auto hi_length = hi.size + (use_pack ? 0 : 1);
+    const auto critical_path = std::max(hi_length, lo.size) + 1;
+    if (critical_path >= serial_length) {
+        LI(rd, imm);
+        return;
+    }
+
+    // Interleave both halves, so that in-order cores can issue them in pairs.
+    for (uint32_t i = 0; i < std::max(hi.size, lo.size); i++) {
+        if (i < hi.size) {
+            EmitLIStep(*this, scratch, hi.steps[i], i == 0);
+        }
+        if (i < lo.size) {
+            EmitLIStep(*this, rd, lo.steps[i], i == 0);
+        }
+    }
+
+    if (use_pack) {
+        PACK(rd, rd, scratch);
+    } else {
+        SLLI(scratch, scratch, 32);
+        ADD(rd, rd, scratch);
+    }
+}
+
+} // namespace biscuit
@@ -0,0 +1,279 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/assembler.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "assembler_util.hpp"
+
+// Branch relaxation for branches and jumps to pooled labels.
+
+namespace biscuit {
+namespace {
+// Every relaxation site starts out as a regular 4-byte branch or jump,
+// which acts as a placeholder until the final form is emitted.
+constexpr uint8_t placeholder_size = 4;
+
+constexpr uint32_t branch_opcode = 0b1100011;
+constexpr uint32_t jal_opcode = 0b1101111;
+constexpr uint32_t jalr_opcode = 0b1100111;
+constexpr uint32_t auipc_opcode = 0b0010111;
+
+// Flips a branch condition, e.g. BEQ <-> BNE, BLT <-> BGE, BLTU <-> BGEU.
+constexpr uint32_t InvertBranchCondition(uint32_t funct3) {
+    return funct3 ^ 0b001;
+}
+} // Anonymous namespace
+
+void Assembler::PlacePendingLiteralsBeforeRelaxation() {
+    // Literals can't be placed once code may be moved by relaxation, so pending
+    // constants are placed behind a jump right before the first site.
+    if (m_relaxation_sites.empty() && m_literal_pool.HasPending()) [[unlikely]] {
+        EmitLiteralPoolWithJump();
+    }
+}
+
+void Assembler::EmitRelaxableBranch(uint32_t funct3, GPR rs1, GPR rs2, LabelHandle label,
+                                    bool allow_compressed) {
+    PlacePendingLiteralsBeforeRelaxation();
+
+    const auto offset = m_buffer.GetCursorOffset();
+    BISCUIT_ASSERT(m_relaxation_sites.empty() || m_relaxation_sites.back().offset < offset);
+    BISCUIT_ASSERT(label.Index() < m_label_pool.Size());
+
+    m_relaxation_sites.push_back({
+        .offset = offset,
+        .label = label,
+        .rs1 = rs1,
+        .rs2 = rs2,
+        .kind = RelaxationSite::Kind::Branch,
+        .funct3 = static_cast<uint8_t>(funct3),
+        .size = placeholder_size,
+        .allow_compressed = allow_compressed,
+    });
+    EmitBType(m_buffer, 0, rs2, rs1, funct3, branch_opcode);
+}
+
+void Assembler::EmitRelaxableJump(GPR rd, LabelHandle label, bool allow_compressed) {
+    PlacePendingLiteralsBeforeRelaxation();
+
+    const auto offset = m_buffer.GetCursorOffset();
+    BISCUIT_ASSERT(m_relaxation_sites.empty() || m_relaxation_sites.back().offset < offset);
+    BISCUIT_ASSERT(label.Index() < m_label_pool.Size());
+
+    m_relaxation_sites.push_back({
+        .offset = offset,
+        .label = label,
+        .rs1 = rd,
+        .rs2 = x0,
+        .kind = RelaxationSite::Kind::Jump,
+        .funct3 = 0,
+        .size = placeholder_size,
+        .allow_compressed = allow_compressed,
+    });
+    EmitJType(m_buffer, 0, rd, jal_opcode);
+}
+
+uint8_t Assembler::GetRelaxedSize(const RelaxationSite& site, ptrdiff_t distance) const {
+    if (site.kind == RelaxationSite::Kind::Branch) {
+        const bool is_compressible = site.allow_compressed && site.funct3 <= 0b001 &&
+                                     ((site.rs2 == x0 && IsValid3BitCompressedReg(site.rs1)) ||
+                                      (site.rs1 == x0 && IsValid3BitCompressedReg(site.rs2)));
+        if (is_compressible && IsValidCBTypeImm(distance)) {
+            return 2;
+        }
+        if (IsValidBTypeImm(distance)) {
+            return 4;
+        }
+
+        // Long forms place the jump right after the inverted branch.
+        if (IsValidJTypeImm(distance - 4)) {
+            return 8;
+        }
+        BISCUIT_ASSERT(IsValidAUIPCPairImm(distance - 4));
+        return 12;
+    }
+
+    const auto rd = site.rs1;
+    const bool is_compressible = site.allow_compressed &&
+                                 (rd == x0 || (IsRV32(m_features) && rd == x1));
+    if (is_compressible && IsValidCJTypeImm(distance)) {
+        return 2;
+    }
+    if (IsValidJTypeImm(distance)) {
+        return 4;
+    }
+    BISCUIT_ASSERT(IsValidAUIPCPairImm(distance));
+    return 8;
+}
+
+void Assembler::EmitRelaxedSite(const RelaxationSite& site, ptrdiff_t distance) {
+    // Emits AUIPC+JALR to reach the given distance from the AUIPC.
+    const auto emit_far_jump = [this](GPR rd, GPR scratch, ptrdiff_t far_distance) {
+        auto reservation = m_buffer.Reserve(2 * sizeof(uint32_t));
+        EmitUType(reservation, GetAUIPCPairHi20(far_distance), scratch, auipc_opcode);
+        EmitIType(reservation, static_cast<uint32_t>(GetAUIPCPairLo12(far_distance)), scratch,
+                  0b000, rd, jalr_opcode);
+    };
+
+    if (site.kind == RelaxationSite::Kind::Branch) {
+        const auto funct3 = uint32_t{site.funct3};
+        const auto inverted = InvertBranchCondition(funct3);
+
+        switch (site.size) {
+        case 2: {
+            const auto rs = site.rs1 == x0 ? site.rs2 : site.rs1;
+            if (funct3 == 0b000) {
+                C_BEQZ(rs, static_cast<int32_t>(distance));
+            } else {
+                C_BNEZ(rs, static_cast<int32_t>(distance));
+            }
+            break;
+        }
+        case 4:
+            EmitBType(m_buffer, static_cast<uint32_t>(distance), site.rs2, site.rs1, funct3, branch_opcode);
+            break;
+        case 8:
+            EmitBType(m_buffer, 8, site.rs2, site.rs1, inverted, branch_opcode);
+            EmitJType(m_buffer, static_cast<uint32_t>(distance - 4), x0, jal_opcode);
+            break;
+        default:
+            BISCUIT_ASSERT(site.size == 12);
+            EmitBType(m_buffer, 12, site.rs2, site.rs1, inverted, branch_opcode);
+            emit_far_jump(x0, m_relaxation_scratch, distance - 4);
+            break;
+        }
+        return;
+    }
+
+    const auto rd = site.rs1;
+    switch (site.size) {
+    case 2:
+        if (rd == x0) {
+            C_J(static_cast<int32_t>(distance));
+        } else {
+            C_JAL(static_cast<int32_t>(distance));
+        }
+        break;
+    case 4:
+        EmitJType(m_buffer, static_cast<uint32_t>(distance), rd, jal_opcode);
+        break;
+    default:
+        BISCUIT_ASSERT(site.size == 8);
+        // Linking jumps can use the link register itself to hold the target address.
+        emit_far_jump(rd, rd == x0 ? m_relaxation_scratch : rd, distance);
+        break;
+    }
+}
+
+void Assembler::RelaxBranches() {
+    auto& sites = m_relaxation_sites;
+    if (sites.empty()) {
+        return;
+    }
+
+    const auto num_sites = sites.size();
+    const auto end_offset = m_buffer.GetCursorOffset();
+    BISCUIT_ASSERT(sites.back().offset + placeholder_size <= end_offset);
+
+    // growth[i] is the number of bytes that all sites before site i have
+    // grown (or shrunk) by relative to their placeholders.
+    std::vector<ptrdiff_t> growth(num_sites + 1);
+    const auto update_growth = [&] {
+        for (size_t i = 0; i < num_sites; i++) {
+            growth[i + 1] = growth[i] + sites[i].size - placeholder_size;
+        }
+    };
+
+    // Maps an offset in the current code to its offset in the relaxed code.
+    const auto remap = [&](ptrdiff_t offset) {
+        const auto iter = std::lower_bound(sites.begin(), sites.end(), offset,
+                                           [](const RelaxationSite& site, ptrdiff_t value) {
+                                               return site.offset < value;
+                                           });
+        return offset + growth[static_cast<size_t>(iter - sites.begin())];
+    };
+
+    const auto get_target = [&](const RelaxationSite& site) {
+        const auto location = m_label_pool.GetLocation(site.label);
+        BISCUIT_ASSERT(location.has_value());
+        return *location;
+    };
+
+    // Start every site out at its smallest form and only ever grow sites from there.
+    // Growing a site can only push other sites further away from their targets, so
+    // sizes increase monotonically and this is guaranteed to reach a fix-point.
+    for (auto& site : sites) {
+        site.size = GetRelaxedSize(site, 0);
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        update_growth();
+
+        for (size_t i = 0; i < num_sites; i++) {
+            auto& site = sites[i];
+            const auto distance = remap(get_target(site)) - (site.offset + growth[i]);
+            const auto needed = GetRelaxedSize(site, distance);
+            if (needed > site.size) {
+                site.size = needed;
+                changed = true;
+            }
+        }
+    }
+
+    // Now rewrite the code from the first site onwards with the final layout.
+    const auto start_offset = sites.front().offset;
+    const auto* start_ptr = m_buffer.GetOffsetPointer(start_offset);
+    const std::vector<uint8_t> original(start_ptr, start_ptr + (end_offset - start_offset));
+
+    const auto total_growth = growth[num_sites];
+    BISCUIT_ASSERT(total_growth <= 0 || m_buffer.IsAutoGrowEnabled() ||
+                   m_buffer.HasSpaceFor(static_cast<size_t>(total_growth)));
+
+    m_buffer.RewindCursor(start_offset);
+
+    ptrdiff_t read_offset = start_offset;
+    for (const auto& site : sites) {
+        m_buffer.EmitBytes(original.data() + (read_offset - start_offset),
+                           static_cast<size_t>(site.offset - read_offset));
+
+        const auto distance = remap(get_target(site)) - m_buffer.GetCursorOffset();
+        EmitRelaxedSite(site, distance);
+
+        read_offset = site.offset + placeholder_size;
+    }
+    m_buffer.EmitBytes(original.data() + (read_offset - start_offset),
+                       static_cast<size_t>(end_offset - read_offset));
+
+    BISCUIT_ASSERT(m_buffer.GetCursorOffset() == end_offset + total_growth);
+
+    // Relocations keep their targets, which PC-relative ones have to be re-patched for
+    // at their new location. The code still holds the old encoding at this point,
+    // which refers to the target relative to the old location.
+    auto* const code = m_buffer.GetOffsetPointer(0);
+    const auto code_address = m_buffer.GetOffsetAddress(0);
+    for (auto& relocation : m_relocations) {
+        const auto old_offset = relocation.offset;
+        relocation.offset = remap(old_offset);
+        if (!IsPCRelative(relocation.kind) || relocation.offset == old_offset) {
+            continue;
+        }
+
+        const auto target = ReadRelocationTarget(code, code_address, relocation) -
+                            static_cast<uint64_t>(relocation.offset - old_offset);
+        ApplyRelocation(code, code_address, relocation, target);
+        m_buffer.MarkDirty(relocation.offset, GetRelocationSize(relocation.kind));
+    }
+
+    m_label_pool.RemapOffsets(remap);
+    for (auto& fixup : m_deferred_fixups) {
+        fixup.offset = remap(fixup.offset);
+        fixup.target = remap(fixup.target);
+    }
+    sites.clear();
+}
+
+} // namespace biscuit
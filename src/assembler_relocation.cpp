@@ -0,0 +1,68 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/assembler.hpp>
+
+#include "assembler_util.hpp"
+
+namespace biscuit {
+
+void Assembler::LI(GPR rd, const SymbolReference& symbol) {
+    BISCUIT_ASSERT(IsRV64(m_features));
+    BISCUIT_ASSERT(rd != x0);
+
+    // Emit the sequence with empty immediates and let the relocation fill them in,
+    // so that there's only a single place that knows how the sequence is laid out.
+    const auto offset = m_buffer.GetCursorOffset();
+    {
+        auto reservation = m_buffer.Reserve(GetRelocationSize(RelocationKind::AbsoluteLI));
+        EmitUType(reservation, 0, rd, 0b0110111);
+        EmitIType(reservation, 0, rd, 0b000, rd, 0b0011011);
+        for (int i = 0; i < 3; i++) {
+            EmitIType(reservation, 0, rd, 0b001, rd, 0b0010011);
+            EmitIType(reservation, 0, rd, 0b000, rd, 0b0010011);
+        }
+    }
+
+    AddRelocation(offset, RelocationKind::AbsoluteLI, symbol);
+}
+
+void Assembler::CALL(const SymbolReference& symbol) {
+    const auto offset = m_buffer.GetCursorOffset();
+    {
+        auto reservation = m_buffer.Reserve(GetRelocationSize(RelocationKind::PCRelativePair));
+        EmitUType(reservation, 0, ra, 0b0010111);
+        EmitIType(reservation, 0, ra, 0b000, ra, 0b1100111);
+    }
+
+    AddRelocation(offset, RelocationKind::PCRelativePair, symbol);
+}
+
+void Assembler::CALL(const SymbolReference& symbol, GPR scratch) {
+    LI(scratch, symbol);
+    JALR(ra, 0, scratch);
+}
+
+void Assembler::J(const SymbolReference& symbol) {
+    const auto offset = m_buffer.GetCursorOffset();
+    EmitJType(m_buffer, 0, x0, 0b1101111);
+
+    AddRelocation(offset, RelocationKind::Jump, symbol);
+    OnUnconditionalTransfer();
+}
+
+void Assembler::EmitAddress(const SymbolReference& symbol) {
+    const auto offset = m_buffer.GetCursorOffset();
+    m_buffer.Emit(uint64_t{0});
+
+    AddRelocation(offset, RelocationKind::Absolute64, symbol);
+}
+
+void Assembler::AddRelocation(ptrdiff_t offset, RelocationKind kind, const SymbolReference& symbol) {
+    const Relocation relocation{offset, kind, symbol.symbol, symbol.addend};
+    if (symbol.is_resolved) {
+        ApplyRelocation(m_buffer.GetOffsetPointer(0), m_buffer.GetOffsetAddress(0),
+                        relocation, symbol.GetTarget());
+    }
+    m_relocations.push_back(relocation);
+}
+
+} // namespace biscuit
@@ -1,5 +1,6 @@
 #include <biscuit/assert.hpp>
 #include <biscuit/assembler.hpp>
+#include <biscuit/encode.hpp>
 
 namespace biscuit {
 namespace {
@@ -39,26 +40,8 @@ enum class WidthEncoding : uint32_t {
 
 void EmitVectorLoadImpl(CodeBuffer& buffer, uint32_t nf, bool mew, AddressingMode mop,
                         VecMask vm, uint32_t lumop, GPR rs, WidthEncoding width, Vec vd) noexcept {
-    BISCUIT_ASSERT(nf <= 8);
-
-    // Fit to encoding space. Allows for being more explicit about the size in calling functions
-    // (e.g. using 8 for 8 elements instead of 7).
-    if (nf != 0) {
-        nf -= 1;
-    }
-
-    // clang-format off
-    const auto value = (nf << 29) |
-                       (static_cast<uint32_t>(mew) << 28) |
-                       (static_cast<uint32_t>(mop) << 26) |
-                       (static_cast<uint32_t>(vm) << 25) |
-                       (lumop << 20) |
-                       (rs.Index() << 15) |
-                       (static_cast<uint32_t>(width) << 12) |
-                       (vd.Index() << 7);
-    // clang-format on
-
-    buffer.Emit32(value | 0b111);
+    buffer.Emit32(encode::VectorMemory(nf, mew, static_cast<uint32_t>(mop), vm, lumop, rs,
+                                       static_cast<uint32_t>(width), vd, 0b0000111));
 }
 
 void EmitVectorLoad(CodeBuffer& buffer, uint32_t nf, bool mew, AddressingMode mop,
@@ -88,26 +71,8 @@ void EmitVectorLoadWholeReg(CodeBuffer& buffer, uint32_t nf, bool mew, GPR rs,
 
 void EmitVectorStoreImpl(CodeBuffer& buffer, uint32_t nf, bool mew, AddressingMode mop,
                          VecMask vm, uint32_t sumop, GPR rs, WidthEncoding width, Vec vd) noexcept {
-    BISCUIT_ASSERT(nf <= 8);
-
-    // Fit to encoding space. Allows for being more explicit about the size in calling functions
-    // (e.g. using 8 for 8 elements instead of 7).
-    if (nf != 0) {
-        nf -= 1;
-    }
-
-    // clang-format off
-    const auto value = (nf << 29) |
-                       (static_cast<uint32_t>(mew) << 28) |
-                       (static_cast<uint32_t>(mop) << 26) |
-                       (static_cast<uint32_t>(vm) << 25) |
-                       (sumop << 20) |
-                       (rs.Index() << 15) |
-                       (static_cast<uint32_t>(width) << 12) |
-                       (vd.Index() << 7);
-    // clang-format on
-
-    buffer.Emit32(value | 0b100111);
+    buffer.Emit32(encode::VectorMemory(nf, mew, static_cast<uint32_t>(mop), vm, sumop, rs,
+                                       static_cast<uint32_t>(width), vd, 0b0100111));
 }
 
 void EmitVectorStore(CodeBuffer& buffer, uint32_t nf, bool mew, AddressingMode mop,
@@ -135,16 +100,7 @@ void EmitVectorStoreWholeReg(CodeBuffer& buffer, uint32_t nf, GPR rs, Vec vs) no
 }
 
 void EmitVectorOPIVIImpl(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2, uint32_t imm5, Vec vd) noexcept {
-    // clang-format off
-    const auto value = (funct6 << 26) |
-                       (static_cast<uint32_t>(vm) << 25) |
-                       (vs2.Index() << 20) |
-                       ((imm5 & 0b11111) << 15) |
-                       (0b011U << 12) |
-                       (vd.Index() << 7);
-    // clang-format on
-
-    buffer.Emit32(value | 0b1010111);
+    buffer.Emit32(encode::VectorArith(funct6, vm, vs2, imm5, 0b011, vd, 0b1010111));
 }
 
 void EmitVectorOPIVI(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2, int32_t simm5, Vec vd) noexcept {
@@ -158,42 +114,16 @@ void EmitVectorOPIVUI(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2,
 }
 
 void EmitVectorOPIVV(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2, Vec vs1, Vec vd) noexcept {
-    // clang-format off
-    const auto value = (funct6 << 26) |
-                       (static_cast<uint32_t>(vm) << 25) |
-                       (vs2.Index() << 20) |
-                       (vs1.Index() << 15) |
-                       (vd.Index() << 7);
-    // clang-format on
-
-    buffer.Emit32(value | 0b1010111);
+    buffer.Emit32(encode::VectorArith(funct6, vm, vs2, vs1.Index(), 0b000, vd, 0b1010111));
 }
 
 void EmitVectorOPIVX(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2, GPR rs1, Vec vd) noexcept {
-    // clang-format off
-    const auto value = (funct6 << 26) |
-                       (static_cast<uint32_t>(vm) << 25) |
-                       (vs2.Index() << 20) |
-                       (rs1.Index() << 15) |
-                       (0b100U << 12) |
-                       (vd.Index() << 7);
-    // clang-format on
-
-    buffer.Emit32(value | 0b1010111);
+    buffer.Emit32(encode::VectorArith(funct6, vm, vs2, rs1.Index(), 0b100, vd, 0b1010111));
 }
 
 void EmitVectorOPMVVImpl(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2, Vec vs1, Vec vd,
                          uint32_t op) noexcept {
-    // clang-format off
-    const auto value = (funct6 << 26) |
-                       (static_cast<uint32_t>(vm) << 25) |
-                       (vs2.Index() << 20) |
-                       (vs1.Index() << 15) |
-                       (0b010U << 12) |
-                       (vd.Index() << 7);
-    // clang-format on
-
-    buffer.Emit32(value | op);
+    buffer.Emit32(encode::VectorArith(funct6, vm, vs2, vs1.Index(), 0b010, vd, op));
 }
 
 void EmitVectorOPMVV(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2, Vec vs1, Vec vd) noexcept {
@@ -205,42 +135,15 @@ void EmitVectorOPMVVP(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2,
 }
 
 void EmitVectorOPMVX(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2, GPR rs1, Vec vd) noexcept {
-    // clang-format off
-    const auto value = (funct6 << 26) |
-                       (static_cast<uint32_t>(vm) << 25) |
-                       (vs2.Index() << 20) |
-                       (rs1.Index() << 15) |
-                       (0b110U << 12) |
-                       (vd.Index() << 7);
-    // clang-format on
-
-    buffer.Emit32(value | 0b1010111);
+    buffer.Emit32(encode::VectorArith(funct6, vm, vs2, rs1.Index(), 0b110, vd, 0b1010111));
 }
 
 void EmitVectorOPFVV(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2, Vec vs1, Vec vd) noexcept {
-    // clang-format off
-    const auto value = (funct6 << 26) |
-                       (static_cast<uint32_t>(vm) << 25) |
-                       (vs2.Index() << 20) |
-                       (vs1.Index() << 15) |
-                       (0b001U << 12) |
-                       (vd.Index() << 7);
-    // clang-format on
-
-    buffer.Emit32(value | 0b1010111);
+    buffer.Emit32(encode::VectorArith(funct6, vm, vs2, vs1.Index(), 0b001, vd, 0b1010111));
 }
 
 void EmitVectorOPFVF(CodeBuffer& buffer, uint32_t funct6, VecMask vm, Vec vs2, FPR rs1, Vec vd) noexcept {
-    // clang-format off
-    const auto value = (funct6 << 26) |
-                       (static_cast<uint32_t>(vm) << 25) |
-                       (vs2.Index() << 20) |
-                       (rs1.Index() << 15) |
-                       (0b101U << 12) |
-                       (vd.Index() << 7);
-    // clang-format on
-
-    buffer.Emit32(value | 0b1010111);
+    buffer.Emit32(encode::VectorArith(funct6, vm, vs2, rs1.Index(), 0b101, vd, 0b1010111));
 }
 } // Anonymous namespace
 
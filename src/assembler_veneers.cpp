@@ -0,0 +1,168 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/assembler.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "assembler_util.hpp"
+
+// Veneer islands for jumps to labels beyond the range of JAL.
+
+namespace biscuit {
+namespace {
+constexpr uint32_t jal_opcode = 0b1101111;
+constexpr uint32_t jalr_opcode = 0b1100111;
+constexpr uint32_t auipc_opcode = 0b0010111;
+
+// Jumps are always a single uncompressed JAL while their veneer is pending.
+constexpr ptrdiff_t jump_size = 4;
+
+// Each veneer is an AUIPC+JALR pair.
+constexpr ptrdiff_t veneer_size = 8;
+} // Anonymous namespace
+
+void Assembler::EmitVeneerableJump(GPR rd, std::optional<ptrdiff_t> location, Label* label,
+                                   LabelHandle handle) {
+    if (location) {
+        const auto distance = *location - m_buffer.GetCursorOffset();
+        if (IsValidJTypeImm(distance)) {
+            JAL(rd, static_cast<int32_t>(distance));
+            return;
+        }
+    }
+
+    // The veneer overwrites the scratch register after the jump has linked.
+    BISCUIT_ASSERT(rd != m_relaxation_scratch);
+
+    // Place an island first if one is about to be due anyway, accounting for
+    // this jump and its potential veneer.
+    (void)EmitIslandIfNeeded(jump_size + veneer_size);
+
+    const auto offset = m_buffer.GetCursorOffset();
+    if (!location) {
+        if (label != nullptr) {
+            label->AddOffset(offset);
+        } else {
+            m_label_pool.AddFixup(handle, offset);
+        }
+    }
+
+    m_pending_veneers.push_back({
+        .jump_offset = offset,
+        .target = location,
+        .label = label,
+        .handle = handle,
+        .rd = rd,
+    });
+    EmitJType(m_buffer, 0, rd, jal_opcode);
+    if (rd == x0) {
+        OnUnconditionalTransfer();
+    }
+}
+
+bool Assembler::IsJumpVeneerIslandDue(ptrdiff_t margin) const noexcept {
+    if (m_pending_veneers.empty()) {
+        return false;
+    }
+
+    // Pending jumps are kept in emission order, so the first one is the furthest away.
+    const auto island_end = m_buffer.GetCursorOffset() + jump_size + margin +
+                            static_cast<ptrdiff_t>(m_pending_veneers.size()) * veneer_size;
+    return island_end - m_pending_veneers.front().jump_offset > m_jump_veneer_max_distance;
+}
+
+void Assembler::EmitJumpVeneers(ptrdiff_t margin, bool all) {
+    const auto island_end = m_buffer.GetCursorOffset() + margin +
+                            static_cast<ptrdiff_t>(m_pending_veneers.size()) * veneer_size;
+
+    std::erase_if(m_pending_veneers, [&](const PendingVeneer& pending) {
+        const bool is_due = island_end - pending.jump_offset > m_jump_veneer_max_distance;
+        if (!all && !is_due && !pending.target) {
+            return false;
+        }
+
+        // The island would be moved by relaxation, which doesn't track veneers.
+        BISCUIT_ASSERT(m_relaxation_sites.empty());
+
+        const auto veneer_offset = m_buffer.GetCursorOffset();
+        BISCUIT_ASSERT(IsValidJTypeImm(veneer_offset - pending.jump_offset));
+
+        // For unbound labels, the veneer takes over the jump's fixup, so that binding
+        // the label patches the veneer and leaves the redirected jump alone.
+        ptrdiff_t distance = 0;
+        if (pending.target) {
+            distance = *pending.target - veneer_offset;
+            BISCUIT_ASSERT(IsValidAUIPCPairImm(distance));
+        } else if (pending.label != nullptr) {
+            pending.label->RemoveOffset(pending.jump_offset);
+            pending.label->AddOffset(veneer_offset);
+        } else {
+            m_label_pool.RemoveFixup(pending.handle, pending.jump_offset);
+            m_label_pool.AddFixup(pending.handle, veneer_offset);
+        }
+
+        {
+            auto reservation = m_buffer.Reserve(veneer_size);
+            EmitUType(reservation, GetAUIPCPairHi20(distance), m_relaxation_scratch, auipc_opcode);
+            EmitIType(reservation, static_cast<uint32_t>(GetAUIPCPairLo12(distance)),
+                      m_relaxation_scratch, 0b000, x0, jalr_opcode);
+        }
+
+        // Redirect the jump right away, even if fixups are deferred, since
+        // it no longer has a fixup of its own.
+        PatchLabelOffset(veneer_offset, pending.jump_offset);
+        return true;
+    });
+}
+
+void Assembler::DropPendingVeneers(Label* label, LabelHandle handle, ptrdiff_t location) {
+    if (m_pending_veneers.empty()) {
+        return;
+    }
+
+    const auto refers_to_label = [&](const PendingVeneer& pending) {
+        if (pending.target) {
+            return false;
+        }
+        return label != nullptr ? pending.label == label
+                                : pending.label == nullptr && pending.handle == handle;
+    };
+
+    // A label can end up bound out of range of a jump to it, e.g. when a lot of code was
+    // emitted without passing by an island. Such jumps are left to the next island,
+    // and their fixups are taken out of the label so that binding doesn't patch them.
+    for (auto& pending : m_pending_veneers) {
+        if (!refers_to_label(pending) || IsValidJTypeImm(location - pending.jump_offset)) {
+            continue;
+        }
+
+        if (pending.label != nullptr) {
+            pending.label->RemoveOffset(pending.jump_offset);
+        } else {
+            m_label_pool.RemoveFixup(pending.handle, pending.jump_offset);
+        }
+        pending.target = location;
+        pending.label = nullptr;
+    }
+
+    // The rest are in range by now.
+    std::erase_if(m_pending_veneers, refers_to_label);
+}
+
+bool Assembler::EmitIslandIfNeeded(ptrdiff_t margin) {
+    BISCUIT_ASSERT(margin >= 0);
+
+    if (!IsJumpVeneerIslandDue(margin) && !IsLiteralPoolDue(margin)) {
+        return false;
+    }
+
+    // Pending constants are placed as well, while a jump around the island is needed anyway.
+    const auto jump_offset = m_buffer.GetCursorOffset();
+    EmitJType(m_buffer, 0, x0, jal_opcode);
+    EmitJumpVeneers(margin, false);
+    EmitLiteralPool();
+    ResolveFixup(DeferredFixup::Kind::Branch, m_buffer.GetCursorOffset(), jump_offset);
+    return true;
+}
+
+} // namespace biscuit
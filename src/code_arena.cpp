@@ -0,0 +1,72 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/code_arena.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace biscuit {
+
+CodeArena::CodeArena(size_t capacity, CodeBufferBacking backing, size_t chunk_size)
+    : m_region{capacity + 64, backing, capacity + 64}, m_chunk_size{chunk_size} {
+    BISCUIT_ASSERT(chunk_size != 0);
+    BISCUIT_ASSERT(chunk_size % 64 == 0);
+
+    // Cache line align the first chunk, so that no two chunks share a line.
+    const auto base = reinterpret_cast<uintptr_t>(m_region.GetOffsetPointer(0));
+    m_base_offset = static_cast<size_t>(-base & 63);
+    m_capacity = capacity & ~size_t{63};
+}
+
+std::optional<CodeBuffer> CodeArena::ClaimChunk(size_t size) noexcept {
+    const auto claim_size = std::max((size + m_chunk_size - 1) / m_chunk_size, size_t{1}) * m_chunk_size;
+
+    // Once the arena is exhausted, the offset keeps going past the capacity
+    // on every attempt, which is harmless as it can't realistically wrap.
+    const auto offset = m_next_offset.fetch_add(claim_size, std::memory_order_relaxed);
+    if (offset + claim_size > m_capacity) {
+        return std::nullopt;
+    }
+
+    const auto region_offset = static_cast<ptrdiff_t>(m_base_offset + offset);
+    return CodeBuffer{m_region.GetOffsetPointer(region_offset),
+                      reinterpret_cast<uint8_t*>(m_region.GetOffsetAddress(region_offset)),
+                      claim_size};
+}
+
+CodeArena::Worker::Worker(CodeArena& arena, ArchFeature features)
+    : m_arena{&arena}, m_assembler{CodeBuffer{0}, features} {}
+
+Assembler* CodeArena::Worker::Begin(size_t max_size) {
+    BISCUIT_ASSERT(max_size != 0);
+    auto& buffer = m_assembler.GetCodeBuffer();
+
+    if (!buffer.HasSpaceFor(max_size)) {
+        // Code already finished in the current chunk still has to be
+        // synchronized, but doesn't need to be published just yet.
+        buffer.FlushICache();
+
+        auto chunk = m_arena->ClaimChunk(max_size);
+        if (!chunk) {
+            return nullptr;
+        }
+
+        (void)m_assembler.SwapCodeBuffer(std::move(*chunk));
+    }
+
+    m_run_start = buffer.GetCursorAddress();
+    return &m_assembler;
+}
+
+uintptr_t CodeArena::Worker::End() {
+    // The next run may be placed in another chunk, which anything still
+    // pending (e.g. pool constants or deferred fixups) must not end up in.
+    m_assembler.Finalize();
+    return m_run_start;
+}
+
+void CodeArena::Worker::Publish() {
+    m_assembler.GetCodeBuffer().FlushICache();
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+} // namespace biscuit
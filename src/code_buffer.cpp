@@ -1,17 +1,57 @@
 #include <biscuit/assert.hpp>
 #include <biscuit/code_buffer.hpp>
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <utility>
 
-#ifdef BISCUIT_CODE_BUFFER_MMAP
+#include "icache.hpp"
+
+#if defined(BISCUIT_CODE_BUFFER_MMAP) || defined(__linux__)
 #include <sys/mman.h>
 #endif
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
 namespace biscuit {
+namespace {
+
+[[nodiscard]] constexpr size_t AlignUp(size_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]] size_t GetHostPageSize() noexcept {
+#ifdef __linux__
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 4096;
+#endif
+}
+
+#ifdef __linux__
+// Transparent huge pages are only used for regions marked with MADV_HUGEPAGE
+// when the mode is either "always" or "madvise", e.g. "always [madvise] never".
+[[nodiscard]] bool AreTransparentHugePagesEnabled() noexcept {
+    auto* const file = std::fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (file == nullptr) {
+        return false;
+    }
+
+    char mode[64]{};
+    const auto* const result = std::fgets(mode, sizeof(mode), file);
+    std::fclose(file);
+
+    return result != nullptr && std::strstr(mode, "[never]") == nullptr;
+}
+#endif
+
+} // Anonymous namespace
 
 CodeBuffer::CodeBuffer(size_t capacity)
-    : m_capacity{capacity}, m_is_managed{true} {
+    : m_capacity{capacity}, m_requested_page_size{GetHostPageSize()}, m_is_managed{true} {
     if (capacity == 0) {
         return;
     }
@@ -27,18 +67,50 @@ CodeBuffer::CodeBuffer(size_t capacity)
 #endif
 
     m_cursor = m_buffer;
+    m_exec_buffer = m_buffer;
+}
+
+CodeBuffer::CodeBuffer(size_t capacity, CodeBufferBacking backing, size_t reserve_size)
+    : CodeBuffer(backing == CodeBufferBacking::Default ? capacity : 0) {
+    if (backing == CodeBufferBacking::Default) {
+        return;
+    }
+
+    BISCUIT_ASSERT(IsBackingSupported(backing));
+    BISCUIT_ASSERT(capacity != 0);
+
+    m_backing = backing;
+    m_reserve_size = std::max(reserve_size, capacity);
+    MapReservation();
+    CommitReservation(capacity);
+    m_cursor = m_buffer;
 }
 
 CodeBuffer::CodeBuffer(uint8_t* buffer, size_t capacity)
-    : m_buffer{buffer}, m_cursor{buffer}, m_capacity{capacity} {
+    : m_buffer{buffer}, m_cursor{buffer}, m_exec_buffer{buffer}, m_capacity{capacity} {
+    BISCUIT_ASSERT(buffer != nullptr);
+}
+
+CodeBuffer::CodeBuffer(uint8_t* buffer, uint8_t* exec_buffer, size_t capacity)
+    : m_buffer{buffer}, m_cursor{buffer}, m_exec_buffer{exec_buffer}, m_capacity{capacity} {
     BISCUIT_ASSERT(buffer != nullptr);
+    BISCUIT_ASSERT(exec_buffer != nullptr);
 }
 
 CodeBuffer::CodeBuffer(CodeBuffer&& other) noexcept
     : m_buffer{std::exchange(other.m_buffer, nullptr)}
     , m_cursor{std::exchange(other.m_cursor, nullptr)}
+    , m_exec_buffer{std::exchange(other.m_exec_buffer, nullptr)}
     , m_capacity{std::exchange(other.m_capacity, size_t{0})}
-    , m_is_managed{std::exchange(other.m_is_managed, false)} {}
+    , m_reserve_size{std::exchange(other.m_reserve_size, size_t{0})}
+    , m_fd{std::exchange(other.m_fd, -1)}
+    , m_emit_start{std::exchange(other.m_emit_start, ptrdiff_t{0})}
+    , m_dirty_ranges{std::exchange(other.m_dirty_ranges, {})}
+    , m_requested_page_size{other.m_requested_page_size}
+    , m_backing{std::exchange(other.m_backing, CodeBufferBacking::Default)}
+    , m_is_managed{std::exchange(other.m_is_managed, false)}
+    , m_auto_grow{std::exchange(other.m_auto_grow, false)}
+    , m_is_hugetlb{std::exchange(other.m_is_hugetlb, false)} {}
 
 CodeBuffer& CodeBuffer::operator=(CodeBuffer&& other) noexcept {
     if (this == &other) {
@@ -47,8 +119,17 @@ CodeBuffer& CodeBuffer::operator=(CodeBuffer&& other) noexcept {
 
     std::swap(m_buffer, other.m_buffer);
     std::swap(m_cursor, other.m_cursor);
+    std::swap(m_exec_buffer, other.m_exec_buffer);
     std::swap(m_capacity, other.m_capacity);
+    std::swap(m_reserve_size, other.m_reserve_size);
+    std::swap(m_fd, other.m_fd);
+    std::swap(m_emit_start, other.m_emit_start);
+    std::swap(m_dirty_ranges, other.m_dirty_ranges);
+    std::swap(m_requested_page_size, other.m_requested_page_size);
+    std::swap(m_backing, other.m_backing);
     std::swap(m_is_managed, other.m_is_managed);
+    std::swap(m_auto_grow, other.m_auto_grow);
+    std::swap(m_is_hugetlb, other.m_is_hugetlb);
     return *this;
 }
 
@@ -57,6 +138,17 @@ CodeBuffer::~CodeBuffer() noexcept {
         return;
     }
 
+    if (m_backing != CodeBufferBacking::Default) {
+#ifdef __linux__
+        munmap(m_buffer, m_reserve_size);
+        if (IsDualMapped()) {
+            munmap(m_exec_buffer, m_reserve_size);
+            close(m_fd);
+        }
+#endif
+        return;
+    }
+
 #ifdef BISCUIT_CODE_BUFFER_MMAP
     munmap(m_buffer, m_capacity);
 #else
@@ -64,6 +156,116 @@ CodeBuffer::~CodeBuffer() noexcept {
 #endif
 }
 
+bool CodeBuffer::IsBackingSupported(CodeBufferBacking backing) noexcept {
+    if (backing == CodeBufferBacking::Default) {
+        return true;
+    }
+
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CodeBuffer::MapReservation() {
+#ifdef __linux__
+    // Address space is only reserved here. Pages past the committed
+    // capacity fault when accessed, rather than silently being usable.
+    if (IsDualMapped()) {
+        m_fd = memfd_create("biscuit-code", MFD_CLOEXEC);
+        BISCUIT_ASSERT(m_fd != -1);
+
+        auto* const writable = mmap(nullptr, m_reserve_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        BISCUIT_ASSERT(writable != MAP_FAILED);
+        auto* const executable = mmap(nullptr, m_reserve_size, PROT_READ | PROT_EXEC, MAP_SHARED, m_fd, 0);
+        BISCUIT_ASSERT(executable != MAP_FAILED);
+
+        m_buffer = static_cast<uint8_t*>(writable);
+        m_exec_buffer = static_cast<uint8_t*>(executable);
+    } else if (m_backing == CodeBufferBacking::HugePages) {
+        MapHugePageReservation();
+    } else {
+        auto* const reserved = mmap(nullptr, m_reserve_size, PROT_NONE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        BISCUIT_ASSERT(reserved != MAP_FAILED);
+
+        m_buffer = static_cast<uint8_t*>(reserved);
+        m_exec_buffer = m_buffer;
+    }
+#else
+    BISCUIT_ASSERT(false);
+#endif
+}
+
+void CodeBuffer::MapHugePageReservation() {
+#ifdef __linux__
+    m_reserve_size = AlignUp(m_reserve_size, huge_page_size);
+
+#ifdef MAP_HUGETLB
+    // Explicit huge pages are taken out of the pool when mapping, not when first
+    // touched. So unlike everywhere else, MAP_NORESERVE is deliberately left out,
+    // making a pool that's too small fail right here instead of faulting later.
+    auto* const hugetlb = mmap(nullptr, m_reserve_size, PROT_NONE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (hugetlb != MAP_FAILED) {
+        m_buffer = static_cast<uint8_t*>(hugetlb);
+        m_exec_buffer = m_buffer;
+        m_requested_page_size = huge_page_size;
+        m_is_hugetlb = true;
+        return;
+    }
+#endif
+
+    // Otherwise reserve an extra huge page worth of address space, so that
+    // the reservation can be trimmed down to start on a huge page boundary.
+    auto* const reserved = mmap(nullptr, m_reserve_size + huge_page_size, PROT_NONE,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    BISCUIT_ASSERT(reserved != MAP_FAILED);
+
+    auto* const start = static_cast<uint8_t*>(reserved);
+    const auto head = AlignUp(reinterpret_cast<uintptr_t>(start), huge_page_size) -
+                      reinterpret_cast<uintptr_t>(start);
+    if (head != 0) {
+        munmap(start, head);
+    }
+    munmap(start + head + m_reserve_size, huge_page_size - head);
+
+    m_buffer = start + head;
+    m_exec_buffer = m_buffer;
+
+#ifdef MADV_HUGEPAGE
+    if (madvise(m_buffer, m_reserve_size, MADV_HUGEPAGE) == 0 && AreTransparentHugePagesEnabled()) {
+        m_requested_page_size = huge_page_size;
+    }
+#endif
+#else
+    BISCUIT_ASSERT(false);
+#endif
+}
+
+void CodeBuffer::CommitReservation(size_t capacity) {
+    // Committing whole huge pages at a time allows all of them to actually be huge.
+    if (m_backing == CodeBufferBacking::HugePages) {
+        capacity = std::min(AlignUp(capacity, huge_page_size), m_reserve_size);
+    }
+
+    BISCUIT_ASSERT(capacity <= m_reserve_size);
+
+#ifdef __linux__
+    // Both views of a dual-mapped buffer become usable by extending the file they map.
+    if (IsDualMapped()) {
+        const auto result = ftruncate(m_fd, static_cast<off_t>(capacity));
+        BISCUIT_ASSERT(result == 0);
+    } else {
+        const auto result = mprotect(m_buffer, capacity, PROT_READ | PROT_WRITE);
+        BISCUIT_ASSERT(result == 0);
+    }
+#endif
+
+    m_capacity = capacity;
+}
+
 void CodeBuffer::Grow(size_t new_capacity) {
     BISCUIT_ASSERT(IsManaged());
 
@@ -72,39 +274,148 @@ void CodeBuffer::Grow(size_t new_capacity) {
         return;
     }
 
+    // Reserving backings never move, so growing only commits more memory.
+    if (m_backing != CodeBufferBacking::Default) {
+        CommitReservation(new_capacity);
+        return;
+    }
+
     const auto cursor_offset = GetCursorOffset();
 
 #ifdef BISCUIT_CODE_BUFFER_MMAP
     auto* new_buffer = static_cast<uint8_t*>(mremap(m_buffer, m_capacity, new_capacity, MREMAP_MAYMOVE));
     BISCUIT_ASSERT(new_buffer != nullptr);
 #else
-    auto* new_buffer = new uint8_t[new_capacity]();
+    // Only the old contents need to be carried over. Everything past them
+    // is going to be written before being read, so skip zero-filling it.
+    auto* new_buffer = new uint8_t[new_capacity];
     std::memcpy(new_buffer, m_buffer, m_capacity);
     delete[] m_buffer;
 #endif
 
     m_buffer = new_buffer;
+    m_exec_buffer = new_buffer;
     m_capacity = new_capacity;
     m_cursor = m_buffer + cursor_offset;
 }
 
+void CodeBuffer::GrowFor(size_t num_bytes) {
+    BISCUIT_ASSERT(m_auto_grow);
+
+    const auto required = GetSizeInBytes() + num_bytes;
+    auto new_capacity = std::max({required, m_capacity * 2, default_capacity});
+    if (m_backing != CodeBufferBacking::Default) {
+        new_capacity = std::min(new_capacity, m_reserve_size);
+        BISCUIT_ASSERT(required <= new_capacity);
+    }
+
+    Grow(new_capacity);
+}
+
+void CodeBuffer::NoteEmittedRange() {
+    const auto cursor_offset = GetCursorOffset();
+    if (cursor_offset > m_emit_start) {
+        AddDirtyRange({m_emit_start, static_cast<size_t>(cursor_offset - m_emit_start)});
+    }
+    m_emit_start = cursor_offset;
+}
+
+void CodeBuffer::AddDirtyRange(Range range) {
+    if (range.size == 0) {
+        return;
+    }
+
+    // Repeatedly rewinding and re-emitting the same code is common,
+    // so try to extend the most recent range before adding another.
+    if (!m_dirty_ranges.empty()) {
+        auto& last = m_dirty_ranges.back();
+        const auto last_end = last.offset + static_cast<ptrdiff_t>(last.size);
+        const auto range_end = range.offset + static_cast<ptrdiff_t>(range.size);
+        if (range.offset <= last_end && range_end >= last.offset) {
+            last.offset = std::min(last.offset, range.offset);
+            last.size = static_cast<size_t>(std::max(last_end, range_end) - last.offset);
+            return;
+        }
+    }
+
+    // Keep the list from growing without bounds when flushes are rare.
+    constexpr size_t max_uncoalesced_ranges = 64;
+    if (m_dirty_ranges.size() >= max_uncoalesced_ranges) {
+        CoalesceDirtyRanges();
+    }
+
+    m_dirty_ranges.push_back(range);
+}
+
+void CodeBuffer::CoalesceDirtyRanges() {
+    std::sort(m_dirty_ranges.begin(), m_dirty_ranges.end(),
+              [](const Range& lhs, const Range& rhs) { return lhs.offset < rhs.offset; });
+
+    size_t num_merged = 0;
+    for (const auto& range : m_dirty_ranges) {
+        if (num_merged != 0) {
+            auto& last = m_dirty_ranges[num_merged - 1];
+            const auto last_end = last.offset + static_cast<ptrdiff_t>(last.size);
+            if (range.offset <= last_end + static_cast<ptrdiff_t>(icache_coalesce_gap)) {
+                const auto range_end = range.offset + static_cast<ptrdiff_t>(range.size);
+                last.size = static_cast<size_t>(std::max(last_end, range_end) - last.offset);
+                continue;
+            }
+        }
+        m_dirty_ranges[num_merged++] = range;
+    }
+    m_dirty_ranges.resize(num_merged);
+}
+
+std::span<const CodeBuffer::Range> CodeBuffer::GetDirtyRanges() {
+    NoteEmittedRange();
+    CoalesceDirtyRanges();
+    return m_dirty_ranges;
+}
+
+size_t CodeBuffer::FlushICache() {
+    const auto ranges = GetDirtyRanges();
+    for (const auto& range : ranges) {
+        const auto begin = GetOffsetAddress(range.offset);
+        SyncInstructionCache(begin, begin + range.size);
+    }
+
+    const auto num_flushed = ranges.size();
+    m_dirty_ranges.clear();
+    return num_flushed;
+}
+
 void CodeBuffer::SetExecutable() {
-#ifdef BISCUIT_CODE_BUFFER_MMAP
+    // Dual-mapped buffers can always be executed through their executable view.
+    if (IsDualMapped()) {
+        return;
+    }
+
+#ifndef BISCUIT_CODE_BUFFER_MMAP
+    // Unimplemented/Unnecessary for new, but reserving backings are always mapped.
+    BISCUIT_ASSERT(m_backing != CodeBufferBacking::Default);
+#endif
+
+#if defined(BISCUIT_CODE_BUFFER_MMAP) || defined(__linux__)
     const auto result = mprotect(m_buffer, m_capacity, PROT_READ | PROT_EXEC);
     BISCUIT_ASSERT(result == 0);
-#else
-    // Unimplemented/Unnecessary for new
-    BISCUIT_ASSERT(false);
 #endif
 }
 
 void CodeBuffer::SetWritable() {
-#ifdef BISCUIT_CODE_BUFFER_MMAP
+    // Dual-mapped buffers can always be written through their writable view.
+    if (IsDualMapped()) {
+        return;
+    }
+
+#ifndef BISCUIT_CODE_BUFFER_MMAP
+    // Unimplemented/Unnecessary for new, but reserving backings are always mapped.
+    BISCUIT_ASSERT(m_backing != CodeBufferBacking::Default);
+#endif
+
+#if defined(BISCUIT_CODE_BUFFER_MMAP) || defined(__linux__)
     const auto result = mprotect(m_buffer, m_capacity, PROT_READ | PROT_WRITE);
     BISCUIT_ASSERT(result == 0);
-#else
-    // Unimplemented/Unnecessary for new
-    BISCUIT_ASSERT(false);
 #endif
 }
 
@@ -0,0 +1,273 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/code_cache.hpp>
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "icache.hpp"
+
+namespace biscuit {
+namespace {
+
+constexpr std::array<char, 8> file_magic = {'B', 'I', 'S', 'C', 'U', 'I', 'T', 'C'};
+constexpr uint32_t format_version = 1;
+constexpr uint32_t library_version = (BISCUIT_VERSION_MAJOR << 20) |
+                                     (BISCUIT_VERSION_MINOR << 10) |
+                                     BISCUIT_VERSION_PATCH;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    uint32_t format_version;
+    uint32_t library_version;
+    uint32_t features;
+    uint32_t extensions;
+    uint64_t user_tag;
+    uint64_t code_size;
+    uint64_t num_relocations;
+    uint64_t checksum;
+    uint64_t reserved;
+};
+static_assert(sizeof(FileHeader) == 64);
+
+struct FileRelocation {
+    uint64_t offset;
+    uint32_t kind;
+    uint32_t symbol;
+    int64_t addend;
+};
+static_assert(sizeof(FileRelocation) == 24);
+
+// Relocation records are kept 8-byte aligned after the code.
+[[nodiscard]] constexpr size_t GetRelocationsOffset(size_t code_size) noexcept {
+    return sizeof(FileHeader) + ((code_size + 7) & ~size_t{7});
+}
+
+// 64-bit FNV-1a, which is plenty for catching truncated or corrupted files.
+[[nodiscard]] uint64_t Checksum(const uint8_t* data, size_t size) noexcept {
+    uint64_t hash = 0xCBF29CE484222325;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 0x100000001B3;
+    }
+    return hash;
+}
+
+[[nodiscard]] bool IsValidRelocation(const FileRelocation& relocation, size_t code_size) noexcept {
+    if (relocation.kind > static_cast<uint32_t>(RelocationKind::Jump)) {
+        return false;
+    }
+    const auto size = GetRelocationSize(static_cast<RelocationKind>(relocation.kind));
+    return relocation.offset <= code_size && size <= code_size - relocation.offset;
+}
+
+void SetError(CodeCacheError* error, CodeCacheError value) noexcept {
+    if (error != nullptr) {
+        *error = value;
+    }
+}
+
+} // Anonymous namespace
+
+std::vector<uint8_t> SerializeCodeCache(Assembler& as, const CodeCacheKey& key) {
+    const auto& buffer = as.GetCodeBuffer();
+    const auto code_size = buffer.GetSizeInBytes();
+    const auto relocations = as.GetRelocations();
+    const auto relocations_offset = GetRelocationsOffset(code_size);
+
+    std::vector<uint8_t> file(relocations_offset + relocations.size() * sizeof(FileRelocation));
+    if (code_size != 0) {
+        std::memcpy(file.data() + sizeof(FileHeader), buffer.GetOffsetPointer(0), code_size);
+    }
+
+    for (size_t i = 0; i < relocations.size(); i++) {
+        const auto& relocation = relocations[i];
+        const FileRelocation record{
+            .offset = static_cast<uint64_t>(relocation.offset),
+            .kind = static_cast<uint32_t>(relocation.kind),
+            .symbol = relocation.symbol,
+            .addend = relocation.addend,
+        };
+        std::memcpy(file.data() + relocations_offset + i * sizeof(FileRelocation), &record, sizeof(record));
+    }
+
+    const FileHeader header{
+        .magic = file_magic,
+        .format_version = format_version,
+        .library_version = library_version,
+        .features = static_cast<uint32_t>(key.features),
+        .extensions = static_cast<uint32_t>(key.extensions),
+        .user_tag = key.user_tag,
+        .code_size = code_size,
+        .num_relocations = relocations.size(),
+        .checksum = Checksum(file.data() + sizeof(FileHeader), file.size() - sizeof(FileHeader)),
+        .reserved = 0,
+    };
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    return file;
+}
+
+bool WriteCodeCache(const char* path, Assembler& as, const CodeCacheKey& key) {
+    const auto file = SerializeCodeCache(as, key);
+
+    auto* const handle = std::fopen(path, "wb");
+    if (handle == nullptr) {
+        return false;
+    }
+
+    const auto written = std::fwrite(file.data(), 1, file.size(), handle);
+    const auto closed = std::fclose(handle) == 0;
+    return written == file.size() && closed;
+}
+
+std::optional<CodeCache> CodeCache::Load(const char* path, const CodeCacheKey& key,
+                                         std::span<const uint64_t> symbols,
+                                         CodeCacheError* error) {
+#ifdef __linux__
+    const auto fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        SetError(error, CodeCacheError::IOError);
+        return std::nullopt;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        SetError(error, CodeCacheError::IOError);
+        return std::nullopt;
+    }
+    if (static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+        close(fd);
+        SetError(error, CodeCacheError::InvalidFormat);
+        return std::nullopt;
+    }
+
+    // Mapped privately, so relocating in place never modifies the file itself.
+    const auto file_size = static_cast<size_t>(info.st_size);
+    auto* const mapped = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        SetError(error, CodeCacheError::IOError);
+        return std::nullopt;
+    }
+
+    auto* const file = static_cast<uint8_t*>(mapped);
+    const auto reject = [&](CodeCacheError reason) -> std::optional<CodeCache> {
+        munmap(file, file_size);
+        SetError(error, reason);
+        return std::nullopt;
+    };
+
+    FileHeader header;
+    std::memcpy(&header, file, sizeof(header));
+    if (header.magic != file_magic || header.format_version != format_version) {
+        return reject(CodeCacheError::InvalidFormat);
+    }
+    if (header.library_version != library_version) {
+        return reject(CodeCacheError::VersionMismatch);
+    }
+
+    const CodeCacheKey file_key{static_cast<ArchFeature>(header.features),
+                                static_cast<Extension>(header.extensions), header.user_tag};
+    if (file_key != key) {
+        return reject(CodeCacheError::KeyMismatch);
+    }
+
+    const auto code_size = static_cast<size_t>(header.code_size);
+    const auto relocations_offset = GetRelocationsOffset(code_size);
+    if (code_size > file_size || relocations_offset > file_size ||
+        header.num_relocations != (file_size - relocations_offset) / sizeof(FileRelocation) ||
+        (file_size - relocations_offset) % sizeof(FileRelocation) != 0) {
+        return reject(CodeCacheError::InvalidFormat);
+    }
+    if (Checksum(file + sizeof(FileHeader), file_size - sizeof(FileHeader)) != header.checksum) {
+        return reject(CodeCacheError::ChecksumMismatch);
+    }
+
+    auto* const code = file + code_offset;
+    const auto code_address = reinterpret_cast<uint64_t>(code);
+
+    std::vector<Relocation> relocations(static_cast<size_t>(header.num_relocations));
+    for (size_t i = 0; i < relocations.size(); i++) {
+        FileRelocation record;
+        std::memcpy(&record, file + relocations_offset + i * sizeof(FileRelocation), sizeof(record));
+        if (!IsValidRelocation(record, code_size)) {
+            return reject(CodeCacheError::InvalidFormat);
+        }
+
+        const Relocation relocation{static_cast<ptrdiff_t>(record.offset),
+                                    static_cast<RelocationKind>(record.kind),
+                                    record.symbol, record.addend};
+        uint64_t symbol_address = 0;
+        if (relocation.symbol == code_base_symbol) {
+            symbol_address = code_address;
+        } else if (relocation.symbol != absolute_symbol) {
+            if (relocation.symbol >= symbols.size()) {
+                return reject(CodeCacheError::UnresolvedSymbol);
+            }
+            symbol_address = symbols[relocation.symbol];
+        }
+
+        // The file is mapped wherever the system sees fit, so PC-relative references
+        // may not reach their targets from there, or the addend may be bogus.
+        const auto target = symbol_address + static_cast<uint64_t>(relocation.addend);
+        if (!IsRelocationInRange(code_address, relocation, target)) {
+            return reject(CodeCacheError::RelocationOutOfRange);
+        }
+
+        ApplyRelocation(code, code_address, relocation, target);
+        relocations[i] = relocation;
+    }
+
+    if (mprotect(file, file_size, PROT_READ | PROT_EXEC) != 0) {
+        return reject(CodeCacheError::IOError);
+    }
+    SyncInstructionCache(code_address, code_address + code_size);
+
+    SetError(error, CodeCacheError::None);
+    return CodeCache{file, file_size, code_size, std::move(relocations)};
+#else
+    (void)path;
+    (void)key;
+    (void)symbols;
+    SetError(error, CodeCacheError::IOError);
+    return std::nullopt;
+#endif
+}
+
+CodeCache::CodeCache(uint8_t* mapping, size_t mapping_size, size_t code_size,
+                     std::vector<Relocation> relocations) noexcept
+    : m_mapping{mapping}, m_mapping_size{mapping_size}, m_code_size{code_size}
+    , m_relocations{std::move(relocations)} {}
+
+CodeCache::CodeCache(CodeCache&& other) noexcept
+    : m_mapping{std::exchange(other.m_mapping, nullptr)}
+    , m_mapping_size{std::exchange(other.m_mapping_size, size_t{0})}
+    , m_code_size{std::exchange(other.m_code_size, size_t{0})}
+    , m_relocations{std::exchange(other.m_relocations, {})} {}
+
+CodeCache& CodeCache::operator=(CodeCache&& other) noexcept {
+    std::swap(m_mapping, other.m_mapping);
+    std::swap(m_mapping_size, other.m_mapping_size);
+    std::swap(m_code_size, other.m_code_size);
+    std::swap(m_relocations, other.m_relocations);
+    return *this;
+}
+
+CodeCache::~CodeCache() noexcept {
+#ifdef __linux__
+    if (m_mapping != nullptr) {
+        munmap(m_mapping, m_mapping_size);
+    }
+#endif
+}
+
+} // namespace biscuit
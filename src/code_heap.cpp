@@ -0,0 +1,361 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/code_heap.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace biscuit {
+
+CodeHeap::CodeHeap(size_t capacity, CodeBufferBacking backing, size_t alignment)
+    : m_region{capacity + alignment, backing, capacity + alignment}
+    , m_alignment{alignment} {
+    BISCUIT_ASSERT(std::has_single_bit(alignment));
+    BISCUIT_ASSERT(alignment >= 4);
+
+    // Neither heap allocations nor mappings are guaranteed to be aligned to
+    // arbitrary alignments, so make up for that with the extra bytes above.
+    const auto base = reinterpret_cast<uintptr_t>(m_region.GetOffsetPointer(0));
+    m_base_offset = static_cast<size_t>(-base & (alignment - 1));
+    m_capacity = capacity & ~(alignment - 1);
+    BISCUIT_ASSERT(m_capacity != 0);
+
+    m_free_heads.fill(null_index);
+
+    const auto index = NewRecord();
+    m_blocks[index].size = m_capacity;
+    LinkFree(index);
+}
+
+std::optional<CodeBlockHandle> CodeHeap::Allocate(size_t size) {
+    BISCUIT_ASSERT(size != 0);
+    const auto aligned_size = (size + m_alignment - 1) & ~(m_alignment - 1);
+
+    const auto index = FindFreeBlock(aligned_size);
+    if (index == null_index) {
+        return std::nullopt;
+    }
+
+    UnlinkFree(index);
+    if (m_blocks[index].size != aligned_size) {
+        const auto remainder = SplitOff(index, aligned_size);
+        LinkFree(remainder);
+    }
+
+    auto& block = m_blocks[index];
+    block.state = BlockState::Allocated;
+    block.generation = m_generation;
+    block.user_data = 0;
+    LinkAllocated(index);
+
+    m_used_bytes += block.size;
+    m_num_live_blocks++;
+
+    return CodeBlockHandle{index, block.serial};
+}
+
+CodeBlockHandle CodeHeap::AllocateOrEvict(size_t size) {
+    BISCUIT_ASSERT(m_eviction != CodeHeapEviction::None);
+    BISCUIT_ASSERT(size <= m_capacity);
+
+    while (true) {
+        if (const auto block = Allocate(size)) {
+            return *block;
+        }
+
+        // Evicting everything always leaves a single free block spanning the
+        // whole heap, so this can't loop forever given the precondition above.
+        BISCUIT_ASSERT(m_evict_head != null_index);
+        EvictOldest();
+    }
+}
+
+void CodeHeap::Free(CodeBlockHandle block) noexcept {
+    const auto index = block.Index();
+    auto& record = GetLiveBlock(block);
+
+    m_used_bytes -= record.size;
+    m_num_live_blocks--;
+
+    // The record may go on to describe a free block or a future allocation
+    // as is, so make sure that existing handles to it become stale.
+    record.serial++;
+
+    UnlinkAllocated(index);
+    MakeFree(index);
+}
+
+void CodeHeap::Shrink(CodeBlockHandle block, size_t size) {
+    const auto index = block.Index();
+    const auto aligned_size = std::max((size + m_alignment - 1) & ~(m_alignment - 1), m_alignment);
+    const auto old_size = GetLiveBlock(block).size;
+    BISCUIT_ASSERT(aligned_size <= old_size);
+
+    if (aligned_size == old_size) {
+        return;
+    }
+
+    m_used_bytes -= old_size - aligned_size;
+    const auto remainder = SplitOff(index, aligned_size);
+    MakeFree(remainder);
+}
+
+void CodeHeap::Touch(CodeBlockHandle block) noexcept {
+    [[maybe_unused]] const auto& record = GetLiveBlock(block);
+
+    // Generations are evicted in allocation order, so only
+    // least-recently-used eviction reorders blocks on use.
+    if (m_eviction != CodeHeapEviction::LeastRecentlyUsed) {
+        return;
+    }
+
+    UnlinkAllocated(block.Index());
+    LinkAllocated(block.Index());
+}
+
+bool CodeHeap::IsLive(CodeBlockHandle block) const noexcept {
+    if (!block.IsValid() || block.Index() >= m_blocks.size()) {
+        return false;
+    }
+
+    const auto& record = m_blocks[block.Index()];
+    return record.state == BlockState::Allocated && record.serial == block.Serial();
+}
+
+uint8_t* CodeHeap::GetPointer(CodeBlockHandle block) noexcept {
+    const auto offset = GetLiveBlock(block).offset;
+    return m_region.GetOffsetPointer(static_cast<ptrdiff_t>(m_base_offset + offset));
+}
+
+uintptr_t CodeHeap::GetAddress(CodeBlockHandle block) const noexcept {
+    const auto offset = GetLiveBlock(block).offset;
+    return m_region.GetOffsetAddress(static_cast<ptrdiff_t>(m_base_offset + offset));
+}
+
+size_t CodeHeap::GetSize(CodeBlockHandle block) const noexcept {
+    return GetLiveBlock(block).size;
+}
+
+uint32_t CodeHeap::GetGeneration(CodeBlockHandle block) const noexcept {
+    return GetLiveBlock(block).generation;
+}
+
+uint64_t CodeHeap::GetUserData(CodeBlockHandle block) const noexcept {
+    return GetLiveBlock(block).user_data;
+}
+
+void CodeHeap::SetUserData(CodeBlockHandle block, uint64_t data) noexcept {
+    GetLiveBlock(block).user_data = data;
+}
+
+CodeBuffer CodeHeap::GetCodeBuffer(CodeBlockHandle block) noexcept {
+    auto* const pointer = GetPointer(block);
+    auto* const exec_pointer = reinterpret_cast<uint8_t*>(GetAddress(block));
+    return CodeBuffer{pointer, exec_pointer, GetSize(block)};
+}
+
+Assembler CodeHeap::GetAssembler(CodeBlockHandle block, ArchFeature features) {
+    return Assembler{GetCodeBuffer(block), features};
+}
+
+const CodeHeap::Block& CodeHeap::GetLiveBlock(CodeBlockHandle block) const noexcept {
+    BISCUIT_ASSERT(IsLive(block));
+    return m_blocks[block.Index()];
+}
+
+CodeHeap::Block& CodeHeap::GetLiveBlock(CodeBlockHandle block) noexcept {
+    BISCUIT_ASSERT(IsLive(block));
+    return m_blocks[block.Index()];
+}
+
+uint32_t CodeHeap::NewRecord() {
+    if (!m_unused_records.empty()) {
+        const auto index = m_unused_records.back();
+        m_unused_records.pop_back();
+        return index;
+    }
+
+    m_blocks.emplace_back();
+    return static_cast<uint32_t>(m_blocks.size() - 1);
+}
+
+void CodeHeap::ReleaseRecord(uint32_t index) noexcept {
+    auto& block = m_blocks[index];
+
+    // Bumping the serial makes every handle to the old block stale.
+    const auto serial = block.serial + 1;
+    block = Block{};
+    block.serial = serial;
+
+    m_unused_records.push_back(index);
+}
+
+size_t CodeHeap::SizeClassFor(size_t size) const noexcept {
+    const auto num_units = size / m_alignment;
+    return static_cast<size_t>(std::bit_width(num_units)) - 1;
+}
+
+uint32_t CodeHeap::FindFreeBlock(size_t size) const noexcept {
+    // Every block in the class above the one `size` falls into is large enough,
+    // so the first non-empty class from there on out is a guaranteed fit.
+    const auto size_class = SizeClassFor(size);
+    const auto first_fit_class = std::has_single_bit(size / m_alignment) ? size_class : size_class + 1;
+
+    if (first_fit_class < num_size_classes) {
+        const auto candidates = m_free_classes & (~uint64_t{0} << first_fit_class);
+        if (candidates != 0) {
+            return m_free_heads[static_cast<size_t>(std::countr_zero(candidates))];
+        }
+    }
+
+    // Blocks within the same class as `size` may still be large enough.
+    for (auto index = m_free_heads[size_class]; index != null_index; index = m_blocks[index].next_link) {
+        if (m_blocks[index].size >= size) {
+            return index;
+        }
+    }
+
+    return null_index;
+}
+
+void CodeHeap::LinkFree(uint32_t index) noexcept {
+    auto& block = m_blocks[index];
+    const auto size_class = SizeClassFor(block.size);
+    const auto head = m_free_heads[size_class];
+
+    block.state = BlockState::Free;
+    block.prev_link = null_index;
+    block.next_link = head;
+    if (head != null_index) {
+        m_blocks[head].prev_link = index;
+    }
+
+    m_free_heads[size_class] = index;
+    m_free_classes |= uint64_t{1} << size_class;
+}
+
+void CodeHeap::UnlinkFree(uint32_t index) noexcept {
+    auto& block = m_blocks[index];
+    const auto size_class = SizeClassFor(block.size);
+
+    if (block.prev_link != null_index) {
+        m_blocks[block.prev_link].next_link = block.next_link;
+    } else {
+        m_free_heads[size_class] = block.next_link;
+    }
+    if (block.next_link != null_index) {
+        m_blocks[block.next_link].prev_link = block.prev_link;
+    }
+
+    if (m_free_heads[size_class] == null_index) {
+        m_free_classes &= ~(uint64_t{1} << size_class);
+    }
+
+    block.prev_link = null_index;
+    block.next_link = null_index;
+}
+
+void CodeHeap::LinkAllocated(uint32_t index) noexcept {
+    auto& block = m_blocks[index];
+    block.prev_link = m_evict_tail;
+    block.next_link = null_index;
+
+    if (m_evict_tail != null_index) {
+        m_blocks[m_evict_tail].next_link = index;
+    } else {
+        m_evict_head = index;
+    }
+    m_evict_tail = index;
+}
+
+void CodeHeap::UnlinkAllocated(uint32_t index) noexcept {
+    auto& block = m_blocks[index];
+
+    if (block.prev_link != null_index) {
+        m_blocks[block.prev_link].next_link = block.next_link;
+    } else {
+        m_evict_head = block.next_link;
+    }
+    if (block.next_link != null_index) {
+        m_blocks[block.next_link].prev_link = block.prev_link;
+    } else {
+        m_evict_tail = block.prev_link;
+    }
+
+    block.prev_link = null_index;
+    block.next_link = null_index;
+}
+
+uint32_t CodeHeap::SplitOff(uint32_t index, size_t size) {
+    // NewRecord() may reallocate the records, so don't hold onto references across it.
+    const auto remainder = NewRecord();
+
+    auto& block = m_blocks[index];
+    auto& split = m_blocks[remainder];
+    BISCUIT_ASSERT(size < block.size);
+
+    split.offset = block.offset + size;
+    split.size = block.size - size;
+    split.prev_phys = index;
+    split.next_phys = block.next_phys;
+    if (block.next_phys != null_index) {
+        m_blocks[block.next_phys].prev_phys = remainder;
+    }
+
+    block.size = size;
+    block.next_phys = remainder;
+
+    return remainder;
+}
+
+void CodeHeap::MergeWithNext(uint32_t index) noexcept {
+    auto& block = m_blocks[index];
+    const auto next = block.next_phys;
+    const auto& next_block = m_blocks[next];
+
+    block.size += next_block.size;
+    block.next_phys = next_block.next_phys;
+    if (block.next_phys != null_index) {
+        m_blocks[block.next_phys].prev_phys = index;
+    }
+
+    ReleaseRecord(next);
+}
+
+void CodeHeap::MakeFree(uint32_t index) noexcept {
+    const auto next = m_blocks[index].next_phys;
+    if (next != null_index && m_blocks[next].state == BlockState::Free) {
+        UnlinkFree(next);
+        MergeWithNext(index);
+    }
+
+    const auto prev = m_blocks[index].prev_phys;
+    if (prev != null_index && m_blocks[prev].state == BlockState::Free) {
+        UnlinkFree(prev);
+        MergeWithNext(prev);
+        index = prev;
+    }
+
+    LinkFree(index);
+}
+
+void CodeHeap::EvictOldest() {
+    // Allocated blocks are ordered by generation under generational eviction,
+    // so the oldest generation is always a run at the start of the order.
+    const auto generation = m_blocks[m_evict_head].generation;
+
+    do {
+        const auto index = m_evict_head;
+        const CodeBlockHandle block{index, m_blocks[index].serial};
+
+        if (m_eviction_callback) {
+            m_eviction_callback(block);
+        }
+
+        Free(block);
+        m_num_evictions++;
+    } while (m_eviction == CodeHeapEviction::Generation &&
+             m_evict_head != null_index &&
+             m_blocks[m_evict_head].generation == generation);
+}
+
+} // namespace biscuit
@@ -0,0 +1,534 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/decoder.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <functional>
+
+namespace biscuit {
+namespace {
+
+// Which register operands an encoding has, and where they are.
+enum class RegisterField : uint16_t {
+    None = 0,
+
+    // 32-bit instructions
+    Rd = 1U << 0,  // rd in [11:7]
+    Rs1 = 1U << 1, // rs1 in [19:15]
+    Rs2 = 1U << 2, // rs2 in [24:20]
+    Rs3 = 1U << 3, // rs3 in [31:27]
+
+    // Compressed instructions
+    CRd = 1U << 4,       // rd in [11:7]
+    CRs1 = 1U << 5,      // rs1 in [11:7]
+    CRs2 = 1U << 6,      // rs2 in [6:2]
+    CRdLow = 1U << 7,    // rd' in [4:2]
+    CRs2Low = 1U << 8,   // rs2' in [4:2]
+    CRdHigh = 1U << 9,   // rd' in [9:7]
+    CRs1High = 1U << 10, // rs1' in [9:7]
+    CSRegs = 1U << 11,   // Zcmp r1s' in [9:7] as rs1, and r2s' in [4:2] as rs2
+};
+BISCUIT_DEFINE_ENUM_FLAG_OPERATORS(RegisterField);
+
+// How an encoding's immediate is laid out.
+enum class Immediate : uint8_t {
+    None,
+
+    // 32-bit instructions
+    IType,      // Signed [31:20]
+    SType,      // Signed [31:25|11:7]
+    BType,      // Signed branch offset
+    UType,      // Signed [31:12]
+    JType,      // Signed jump offset
+    Prefetch,   // Signed [31:25], scaled by 32
+    Csr,        // Unsigned [31:20]
+    Shamt,      // Unsigned [25:20]
+    Rnum,       // Unsigned [23:20]
+    Uimm5,      // Unsigned [19:15]
+    Simm5,      // Signed [19:15]
+    Uimm6,      // Unsigned [26|19:15]
+    Segments,   // nf in [31:29], plus one
+    ByteSelect, // Unsigned [31:30]
+    AddslShift, // Unsigned [26:25]
+    Fence,      // pred and succ in [27:20]
+    VType,      // Unsigned [27:20]
+
+    // Compressed instructions
+    CI,         // Signed [12|6:2]
+    CShamt,     // Unsigned [12|6:2]
+    CAddi16sp,  // C.ADDI16SP
+    CAddi4spn,  // C.ADDI4SPN
+    CB,         // Compressed branch offset
+    CJ,         // Compressed jump offset
+    CLw,        // Word loads and stores
+    CLd,        // Doubleword loads and stores
+    CLwsp,      // Word stack pointer loads
+    CLdsp,      // Doubleword stack pointer loads
+    CSwsp,      // Word stack pointer stores
+    CSdsp,      // Doubleword stack pointer stores
+    CLbu,       // C.LBU and C.SB
+    CLh,        // C.LH, C.LHU and C.SH
+    CmIndex,    // Unsigned [9:2]
+    CmStackAdj, // Zcmp stack adjustment
+};
+
+// How an encoding's modifier is laid out.
+enum class Modifier : uint8_t {
+    None,
+    RoundingMode, // [14:12]
+    Ordering,     // [26:25]
+    VectorMask,   // [25]
+    RegisterList, // [7:4]
+};
+
+// Which architectures an encoding is decoded for.
+enum class Arch : uint8_t {
+    Any,
+    RV32,
+    RV64,
+};
+
+// Which compressed extension an encoding belongs to.
+enum class CompressedExtension : uint8_t {
+    None,
+    Zca,
+    Zcb,
+    Zcd,
+    Zcf,
+    Zcmp,
+    Zcmt,
+};
+
+struct Encoding {
+    uint32_t mask;
+    uint32_t match;
+    InstructionId id;
+    RegisterField registers;
+    Immediate immediate;
+    Modifier modifier;
+    Arch arch;
+    CompressedExtension extension;
+};
+
+// Expanded with the register fields in scope, so that the table can combine them.
+constexpr auto encodings = [] {
+    using enum RegisterField;
+    return std::array{
+#define BISCUIT_ENCODING(id, mask, match, registers, immediate, modifier, arch, extension) \
+        Encoding{mask, match, InstructionId::id, registers, Immediate::immediate,          \
+                 Modifier::modifier, Arch::arch, CompressedExtension::extension},
+#include "decoder_table.inc"
+#undef BISCUIT_ENCODING
+    };
+}();
+
+constexpr std::array names{
+    std::string_view{"Invalid"},
+#define BISCUIT_INSTRUCTION(id) std::string_view{#id},
+#include <biscuit/decoder_ids.inc>
+#undef BISCUIT_INSTRUCTION
+};
+
+// 32-bit instructions are bucketed by opcode[6:2] and funct3,
+// compressed instructions by op and funct3.
+constexpr size_t num_buckets_32 = 256;
+constexpr size_t num_buckets_16 = 24;
+constexpr size_t num_primary_buckets = num_buckets_32 + num_buckets_16;
+
+// Buckets with more entries than this are split by the funct6/funct7 bits.
+constexpr size_t max_linear_bucket_size = 8;
+
+[[nodiscard]] constexpr bool IsCompressed(uint32_t instruction) noexcept {
+    return (instruction & 0b11) != 0b11;
+}
+
+[[nodiscard]] constexpr size_t GetBucketIndex(uint32_t instruction) noexcept {
+    if (IsCompressed(instruction)) {
+        return num_buckets_32 + (((instruction & 0b11) << 3) | ((instruction >> 13) & 0b111));
+    }
+    return (((instruction >> 2) & 0b11111) << 3) | ((instruction >> 12) & 0b111);
+}
+
+// The bits that make up the key of a primary bucket, and their values.
+[[nodiscard]] constexpr std::pair<uint32_t, uint32_t> GetBucketKey(size_t index) noexcept {
+    const auto key = static_cast<uint32_t>(index);
+    if (index >= num_buckets_32) {
+        const auto op = (key - num_buckets_32) >> 3;
+        const auto funct3 = key & 0b111;
+        return {0xE003, (funct3 << 13) | op};
+    }
+    return {0x707F, ((key & 0b111) << 12) | ((key >> 3) << 2) | 0b11};
+}
+
+[[nodiscard]] bool IsAvailable(const Encoding& encoding, ArchFeature features, Extension extensions) noexcept {
+    switch (encoding.arch) {
+    case Arch::Any:
+        break;
+    case Arch::RV32:
+        if (!IsRV32(features)) {
+            return false;
+        }
+        break;
+    case Arch::RV64:
+        if (!IsRV64OrRV128(features)) {
+            return false;
+        }
+        break;
+    }
+
+    const auto has = [extensions](Extension ext) {
+        return (extensions & ext) != Extension::None;
+    };
+
+    switch (encoding.extension) {
+    case CompressedExtension::None:
+        return true;
+    case CompressedExtension::Zca:
+        return has(Extension::Zca);
+    case CompressedExtension::Zcb:
+        return has(Extension::Zcb);
+    case CompressedExtension::Zcd:
+        return has(Extension::Zcd);
+    case CompressedExtension::Zcf:
+        return has(Extension::Zcf);
+    case CompressedExtension::Zcmp:
+    case CompressedExtension::Zcmt:
+        return has(Extension::Zca) && !has(Extension::Zcd);
+    }
+    return false;
+}
+
+[[nodiscard]] constexpr uint32_t Field(uint32_t instruction, uint32_t lsb, uint32_t width) noexcept {
+    return (instruction >> lsb) & ((1U << width) - 1);
+}
+
+[[nodiscard]] constexpr int32_t SignExtend(uint32_t value, uint32_t width) noexcept {
+    const auto shift = 32 - width;
+    return static_cast<int32_t>(value << shift) >> shift;
+}
+
+[[nodiscard]] constexpr uint8_t RegisterAt(uint32_t instruction, uint32_t lsb) noexcept {
+    return static_cast<uint8_t>(Field(instruction, lsb, 5));
+}
+
+// The 3-bit registers of most compressed instructions map to x8-x15.
+[[nodiscard]] constexpr uint8_t CompressedRegister(uint32_t instruction, uint32_t lsb) noexcept {
+    return static_cast<uint8_t>(8 + Field(instruction, lsb, 3));
+}
+
+// The 3-bit registers of Zcmp moves map to s0-s7.
+[[nodiscard]] constexpr uint8_t CompressedSRegister(uint32_t instruction, uint32_t lsb) noexcept {
+    const auto sreg = Field(instruction, lsb, 3);
+    return static_cast<uint8_t>(sreg < 2 ? 8 + sreg : 16 + sreg);
+}
+
+[[nodiscard]] constexpr int32_t GetCompressedImmediate(Immediate immediate, uint32_t instruction) noexcept {
+    const auto bit = [instruction](uint32_t lsb, uint32_t width = 1) {
+        return Field(instruction, lsb, width);
+    };
+
+    switch (immediate) {
+    case Immediate::CI:
+        return SignExtend((bit(12) << 5) | bit(2, 5), 6);
+    case Immediate::CShamt:
+        return static_cast<int32_t>((bit(12) << 5) | bit(2, 5));
+    case Immediate::CAddi16sp:
+        return SignExtend((bit(12) << 9) | (bit(3, 2) << 7) | (bit(5) << 6) | (bit(2) << 5) | (bit(6) << 4), 10);
+    case Immediate::CAddi4spn:
+        return static_cast<int32_t>((bit(7, 4) << 6) | (bit(11, 2) << 4) | (bit(5) << 3) | (bit(6) << 2));
+    case Immediate::CB:
+        return SignExtend((bit(12) << 8) | (bit(5, 2) << 6) | (bit(2) << 5) | (bit(10, 2) << 3) | (bit(3, 2) << 1), 9);
+    case Immediate::CJ:
+        return SignExtend((bit(12) << 11) | (bit(8) << 10) | (bit(9, 2) << 8) | (bit(6) << 7) | (bit(7) << 6) |
+                              (bit(2) << 5) | (bit(11) << 4) | (bit(3, 3) << 1),
+                          12);
+    case Immediate::CLw:
+        return static_cast<int32_t>((bit(5) << 6) | (bit(10, 3) << 3) | (bit(6) << 2));
+    case Immediate::CLd:
+        return static_cast<int32_t>((bit(5, 2) << 6) | (bit(10, 3) << 3));
+    case Immediate::CLwsp:
+        return static_cast<int32_t>((bit(2, 2) << 6) | (bit(12) << 5) | (bit(4, 3) << 2));
+    case Immediate::CLdsp:
+        return static_cast<int32_t>((bit(2, 3) << 6) | (bit(12) << 5) | (bit(5, 2) << 3));
+    case Immediate::CSwsp:
+        return static_cast<int32_t>((bit(7, 2) << 6) | (bit(9, 4) << 2));
+    case Immediate::CSdsp:
+        return static_cast<int32_t>((bit(7, 3) << 6) | (bit(10, 3) << 3));
+    case Immediate::CLbu:
+        return static_cast<int32_t>((bit(5) << 1) | bit(6));
+    case Immediate::CLh:
+        return static_cast<int32_t>(bit(5) << 1);
+    case Immediate::CmIndex:
+        return static_cast<int32_t>(bit(2, 8));
+    default:
+        return 0;
+    }
+}
+
+[[nodiscard]] constexpr int32_t GetImmediate(Immediate immediate, uint32_t instruction) noexcept {
+    const auto bits = static_cast<int32_t>(instruction);
+
+    switch (immediate) {
+    case Immediate::None:
+        return 0;
+    case Immediate::IType:
+        return bits >> 20;
+    case Immediate::SType:
+        return ((bits >> 25) << 5) | static_cast<int32_t>(Field(instruction, 7, 5));
+    case Immediate::BType:
+        return ((bits >> 31) << 12) |
+               static_cast<int32_t>((Field(instruction, 7, 1) << 11) | (Field(instruction, 25, 6) << 5) |
+                                    (Field(instruction, 8, 4) << 1));
+    case Immediate::UType:
+        return bits >> 12;
+    case Immediate::JType:
+        return ((bits >> 31) << 20) |
+               static_cast<int32_t>((Field(instruction, 12, 8) << 12) | (Field(instruction, 20, 1) << 11) |
+                                    (Field(instruction, 21, 10) << 1));
+    case Immediate::Prefetch:
+        return (bits >> 25) << 5;
+    case Immediate::Csr:
+        return static_cast<int32_t>(Field(instruction, 20, 12));
+    case Immediate::Shamt:
+        return static_cast<int32_t>(Field(instruction, 20, 6));
+    case Immediate::Rnum:
+        return static_cast<int32_t>(Field(instruction, 20, 4));
+    case Immediate::Uimm5:
+        return static_cast<int32_t>(Field(instruction, 15, 5));
+    case Immediate::Simm5:
+        return SignExtend(Field(instruction, 15, 5), 5);
+    case Immediate::Uimm6:
+        return static_cast<int32_t>((Field(instruction, 26, 1) << 5) | Field(instruction, 15, 5));
+    case Immediate::Segments:
+        return static_cast<int32_t>(Field(instruction, 29, 3) + 1);
+    case Immediate::ByteSelect:
+        return static_cast<int32_t>(Field(instruction, 30, 2));
+    case Immediate::AddslShift:
+        return static_cast<int32_t>(Field(instruction, 25, 2));
+    case Immediate::Fence:
+    case Immediate::VType:
+        return static_cast<int32_t>(Field(instruction, 20, 8));
+    default:
+        return GetCompressedImmediate(immediate, instruction);
+    }
+}
+
+} // Anonymous namespace
+
+Decoder::Decoder(ArchFeature features, Extension extensions)
+    : m_features{features}, m_extensions{extensions} {
+    std::vector<Entry> available;
+    for (const auto& encoding : encodings) {
+        if (!IsAvailable(encoding, features, extensions)) {
+            continue;
+        }
+        available.push_back({
+            .mask = encoding.mask,
+            .match = encoding.match,
+            .id = encoding.id,
+            .registers = static_cast<uint16_t>(encoding.registers),
+            .immediate = static_cast<uint8_t>(encoding.immediate),
+            .modifier = static_cast<uint8_t>(encoding.modifier),
+        });
+    }
+
+    // Encodings that are specializations of others (e.g. C.NOP of C.ADDI) fix
+    // more bits than what they specialize, so checking the encodings with the
+    // most fixed bits first always finds the most specific match.
+    std::ranges::stable_sort(available, std::greater{}, [](const Entry& entry) {
+        return std::popcount(entry.mask);
+    });
+
+    const auto add_bucket = [this](std::span<const Entry> entries) {
+        const auto begin = m_entries.size();
+        m_entries.insert(m_entries.end(), entries.begin(), entries.end());
+        BISCUIT_ASSERT(m_entries.size() <= UINT16_MAX);
+        return Bucket{static_cast<uint16_t>(begin), static_cast<uint16_t>(m_entries.size()), 0};
+    };
+
+    m_buckets.resize(num_primary_buckets);
+
+    std::vector<Entry> bucket;
+    std::vector<Entry> sub_bucket;
+    for (size_t index = 0; index < num_primary_buckets; index++) {
+        const auto [key_mask, key_match] = GetBucketKey(index);
+
+        // Entries go into every bucket whose key doesn't contradict their fixed bits.
+        bucket.clear();
+        for (const auto& entry : available) {
+            if (((entry.match ^ key_match) & entry.mask & key_mask) == 0) {
+                bucket.push_back(entry);
+            }
+        }
+
+        // Split large buckets of 32-bit instructions by the upper bits that all of
+        // their entries fix, which are the funct7 or funct6 bits where present.
+        uint32_t shift = 32;
+        if (index < num_buckets_32 && bucket.size() > max_linear_bucket_size) {
+            uint32_t common = UINT32_MAX;
+            for (const auto& entry : bucket) {
+                common &= entry.mask;
+            }
+            while (shift > 25 && (common >> (shift - 1)) & 1) {
+                shift--;
+            }
+        }
+
+        if (shift > 30) {
+            m_buckets[index] = add_bucket(bucket);
+            continue;
+        }
+
+        const auto num_sub_buckets = size_t{1} << (32 - shift);
+        const auto first = m_buckets.size();
+        BISCUIT_ASSERT(first + num_sub_buckets <= UINT16_MAX);
+        m_buckets[index] = {static_cast<uint16_t>(first), static_cast<uint16_t>(first + num_sub_buckets),
+                            static_cast<uint8_t>(shift)};
+        m_buckets.resize(first + num_sub_buckets);
+
+        for (size_t sub = 0; sub < num_sub_buckets; sub++) {
+            sub_bucket.clear();
+            for (const auto& entry : bucket) {
+                if ((entry.match >> shift) == sub) {
+                    sub_bucket.push_back(entry);
+                }
+            }
+            m_buckets[first + sub] = add_bucket(sub_bucket);
+        }
+    }
+}
+
+DecodedInstruction Decoder::Decode(uint32_t instruction) const noexcept {
+    if (IsCompressed(instruction)) {
+        instruction &= 0xFFFF;
+    }
+
+    const auto* bucket = &m_buckets[GetBucketIndex(instruction)];
+    if (bucket->shift != 0) {
+        bucket = &m_buckets[bucket->begin + (instruction >> bucket->shift)];
+    }
+
+    for (uint32_t i = bucket->begin; i < bucket->end; i++) {
+        const auto& entry = m_entries[i];
+        if ((instruction & entry.mask) == entry.match) {
+            return Extract(entry, instruction);
+        }
+    }
+
+    return {};
+}
+
+DecodedInstruction Decoder::Decode(std::span<const uint8_t> code) const noexcept {
+    uint16_t low = 0;
+    if (code.size() < sizeof(low)) {
+        return {};
+    }
+    std::memcpy(&low, code.data(), sizeof(low));
+    if (IsCompressed(low)) {
+        return Decode(uint32_t{low});
+    }
+
+    uint32_t instruction = 0;
+    if (code.size() < sizeof(instruction)) {
+        return {};
+    }
+    std::memcpy(&instruction, code.data(), sizeof(instruction));
+    return Decode(instruction);
+}
+
+std::string_view Decoder::GetName(InstructionId id) noexcept {
+    const auto index = static_cast<size_t>(id);
+    BISCUIT_ASSERT(index < names.size());
+    return names[index];
+}
+
+DecodedInstruction Decoder::Extract(const Entry& entry, uint32_t instruction) const noexcept {
+    DecodedInstruction decoded{
+        .id = entry.id,
+        .length = static_cast<uint8_t>(IsCompressed(instruction) ? 2 : 4),
+    };
+
+    const auto registers = static_cast<RegisterField>(entry.registers);
+    const auto has = [registers](RegisterField field) {
+        return (registers & field) != RegisterField::None;
+    };
+
+    if (has(RegisterField::Rd)) {
+        decoded.rd = RegisterAt(instruction, 7);
+    }
+    if (has(RegisterField::Rs1)) {
+        decoded.rs1 = RegisterAt(instruction, 15);
+    }
+    if (has(RegisterField::Rs2)) {
+        decoded.rs2 = RegisterAt(instruction, 20);
+    }
+    if (has(RegisterField::Rs3)) {
+        decoded.rs3 = RegisterAt(instruction, 27);
+    }
+    if (has(RegisterField::CRd)) {
+        decoded.rd = RegisterAt(instruction, 7);
+    }
+    if (has(RegisterField::CRs1)) {
+        decoded.rs1 = RegisterAt(instruction, 7);
+    }
+    if (has(RegisterField::CRs2)) {
+        decoded.rs2 = RegisterAt(instruction, 2);
+    }
+    if (has(RegisterField::CRdLow)) {
+        decoded.rd = CompressedRegister(instruction, 2);
+    }
+    if (has(RegisterField::CRs2Low)) {
+        decoded.rs2 = CompressedRegister(instruction, 2);
+    }
+    if (has(RegisterField::CRdHigh)) {
+        decoded.rd = CompressedRegister(instruction, 7);
+    }
+    if (has(RegisterField::CRs1High)) {
+        decoded.rs1 = CompressedRegister(instruction, 7);
+    }
+    if (has(RegisterField::CSRegs)) {
+        decoded.rs1 = CompressedSRegister(instruction, 7);
+        decoded.rs2 = CompressedSRegister(instruction, 2);
+    }
+
+    switch (static_cast<Modifier>(entry.modifier)) {
+    case Modifier::None:
+        break;
+    case Modifier::RoundingMode:
+        decoded.modifier = static_cast<uint8_t>(Field(instruction, 12, 3));
+        break;
+    case Modifier::Ordering:
+        decoded.modifier = static_cast<uint8_t>(Field(instruction, 25, 2));
+        break;
+    case Modifier::VectorMask:
+        decoded.modifier = static_cast<uint8_t>(Field(instruction, 25, 1));
+        break;
+    case Modifier::RegisterList:
+        decoded.modifier = static_cast<uint8_t>(Field(instruction, 4, 4));
+        break;
+    }
+
+    const auto immediate = static_cast<Immediate>(entry.immediate);
+    if (immediate != Immediate::CmStackAdj) {
+        decoded.imm = GetImmediate(immediate, instruction);
+        return decoded;
+    }
+
+    // The stack adjustment of Zcmp pushes and pops starts out at the space
+    // needed for the register list, rounded up to 16 bytes.
+    const auto rlist = Field(instruction, 4, 4);
+    if (rlist < 4) {
+        return {};
+    }
+
+    const auto num_registers = rlist == 15 ? 13 : rlist - 3;
+    const auto register_size = IsRV32(m_features) ? 4U : 8U;
+    const auto base = (num_registers * register_size + 15) & ~15U;
+    const auto stack_adj = static_cast<int32_t>(base + Field(instruction, 2, 2) * 16);
+    decoded.imm = entry.id == InstructionId::CM_PUSH ? -stack_adj : stack_adj;
+    return decoded;
+}
+
+} // namespace biscuit
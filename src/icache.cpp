@@ -0,0 +1,23 @@
+#include "icache.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace biscuit {
+
+void SyncInstructionCache(uintptr_t begin, uintptr_t end) noexcept {
+    if (begin >= end) {
+        return;
+    }
+
+#if defined(_WIN32)
+    FlushInstructionCache(GetCurrentProcess(), reinterpret_cast<const void*>(begin), end - begin);
+#elif defined(__GNUC__) || defined(__clang__)
+    // On RISC-V Linux this ends up as a riscv_flush_icache syscall covering all
+    // harts of the process, and is a no-op on hosts with coherent instruction caches.
+    __builtin___clear_cache(reinterpret_cast<char*>(begin), reinterpret_cast<char*>(end));
+#endif
+}
+
+} // namespace biscuit
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Internal helpers for keeping instruction fetch coherent with code written as data.
+
+namespace biscuit {
+
+// Makes the instructions within [begin, end) visible to instruction fetch on every
+// hart of the process. The addresses must be the ones code is executed from.
+void SyncInstructionCache(uintptr_t begin, uintptr_t end) noexcept;
+
+} // namespace biscuit
@@ -0,0 +1,273 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/linker.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "assembler_util.hpp"
+
+namespace biscuit {
+namespace {
+
+// Lets the instruction format emitters write veneers straight into the linked code.
+struct VeneerWriter {
+    void Emit32(uint32_t value) noexcept {
+        std::memcpy(cursor, &value, sizeof(value));
+        cursor += sizeof(value);
+    }
+
+    uint8_t* cursor;
+};
+
+// Veneers are laid out as:
+//
+//   AUIPC t1, 0
+//   LD    t1, 16(t1)
+//   JALR  x0, 0(t1)
+//   NOP
+//   .dword target
+//
+// so that the target address is naturally aligned, given an 8-byte aligned veneer.
+void WriteVeneer(uint8_t* location, uint64_t target) noexcept {
+    VeneerWriter writer{location};
+    EmitUType(writer, 0, t1, 0b0010111);
+    EmitIType(writer, 16, t1, 0b011, t1, 0b0000011);
+    EmitIType(writer, 0, t1, 0b000, x0, 0b1100111);
+    EmitIType(writer, 0, x0, 0b000, x0, 0b0010011);
+    std::memcpy(writer.cursor, &target, sizeof(target));
+}
+
+[[nodiscard]] bool IsInRange(RelocationKind kind, uint64_t pc, uint64_t target) noexcept {
+    const auto offset = static_cast<ptrdiff_t>(target - pc);
+    if (kind == RelocationKind::Jump) {
+        return IsValidJTypeImm(offset);
+    }
+    return IsValidAUIPCPairImm(offset);
+}
+
+[[nodiscard]] size_t GetAlignmentPadding(uint64_t address, size_t alignment) noexcept {
+    return static_cast<size_t>(-address & (alignment - 1));
+}
+
+} // Anonymous namespace
+
+uint32_t Linker::GetSymbol(std::string_view name) {
+    std::scoped_lock lock{m_mutex};
+    return GetSymbolLocked(name);
+}
+
+uint32_t Linker::GetSymbolLocked(std::string_view name) {
+    const auto [iter, inserted] = m_symbol_indices.try_emplace(std::string{name},
+                                                               static_cast<uint32_t>(m_symbols.size()));
+    if (inserted) {
+        BISCUIT_ASSERT(m_symbols.size() < absolute_symbol);
+        m_symbols.push_back({.name = std::string{name}});
+    }
+    return iter->second;
+}
+
+void Linker::DefineSymbol(std::string_view name, uint64_t address) {
+    std::scoped_lock lock{m_mutex};
+
+    auto& symbol = m_symbols[GetSymbolLocked(name)];
+    BISCUIT_ASSERT(!symbol.is_defined);
+    symbol.is_defined = true;
+    symbol.address = address;
+}
+
+void Linker::AddSection(std::string_view name, Assembler& as, size_t alignment) {
+    BISCUIT_ASSERT(alignment >= 4 && (alignment & (alignment - 1)) == 0);
+
+    // Copy everything outside of the lock, so that threads only contend briefly.
+    auto& buffer = as.GetCodeBuffer();
+    const auto relocations = as.GetRelocations();
+    const auto* const code = buffer.GetOffsetPointer(0);
+
+    Section section{
+        .symbol = 0,
+        .alignment = alignment,
+        .code{code, code + buffer.GetSizeInBytes()},
+        .relocations{relocations.begin(), relocations.end()},
+        .needs_veneer = std::vector<bool>(relocations.size()),
+        .veneer_offsets = std::vector<size_t>(relocations.size()),
+    };
+
+    std::scoped_lock lock{m_mutex};
+
+    section.symbol = GetSymbolLocked(name);
+    auto& symbol = m_symbols[section.symbol];
+    BISCUIT_ASSERT(!symbol.is_defined);
+    symbol.is_defined = true;
+    symbol.is_section = true;
+    symbol.section = static_cast<uint32_t>(m_sections.size());
+
+    for (const auto& relocation : section.relocations) {
+        if (relocation.symbol != code_base_symbol && relocation.symbol != absolute_symbol) {
+            BISCUIT_ASSERT(relocation.symbol < m_symbols.size());
+            m_symbols[relocation.symbol].is_referenced = true;
+        }
+    }
+
+    m_sections.push_back(std::move(section));
+}
+
+size_t Linker::Layout(uint64_t base) {
+    size_t offset = 0;
+
+    for (auto& section : m_sections) {
+        offset += GetAlignmentPadding(base + offset, section.alignment);
+        section.offset = offset;
+        offset += section.code.size();
+
+        section.num_veneers = static_cast<size_t>(std::count(section.needs_veneer.begin(), section.needs_veneer.end(), true));
+        if (section.num_veneers == 0) {
+            continue;
+        }
+
+        offset += GetAlignmentPadding(base + offset, 8);
+        for (size_t i = 0; i < section.relocations.size(); i++) {
+            if (section.needs_veneer[i]) {
+                section.veneer_offsets[i] = offset;
+                offset += veneer_size;
+            }
+        }
+    }
+
+    return offset;
+}
+
+uint64_t Linker::GetTargetAddress(const Section& section, const Relocation& relocation,
+                                  uint64_t base) const noexcept {
+    const auto addend = static_cast<uint64_t>(relocation.addend);
+
+    if (relocation.symbol == code_base_symbol) {
+        return base + section.offset + addend;
+    }
+    if (relocation.symbol == absolute_symbol) {
+        return addend;
+    }
+
+    const auto& symbol = m_symbols[relocation.symbol];
+    if (symbol.is_section) {
+        return base + m_sections[symbol.section].offset + addend;
+    }
+    return symbol.address + addend;
+}
+
+LinkError Linker::Link(CodeBuffer& buffer) {
+    std::scoped_lock lock{m_mutex};
+
+    const bool has_undefined = std::ranges::any_of(m_symbols, [](const Symbol& symbol) {
+        return symbol.is_referenced && !symbol.is_defined;
+    });
+    if (has_undefined) {
+        return LinkError::UndefinedSymbol;
+    }
+
+    const auto base = static_cast<uint64_t>(buffer.GetCursorAddress());
+    for (auto& section : m_sections) {
+        section.needs_veneer.assign(section.relocations.size(), false);
+    }
+
+    // Adding veneers only ever moves sections further apart, so keep marking references
+    // that are out of range until there are none left. Marks are never removed,
+    // which guarantees that this terminates.
+    size_t size = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        size = Layout(base);
+
+        for (auto& section : m_sections) {
+            for (size_t i = 0; i < section.relocations.size(); i++) {
+                const auto& relocation = section.relocations[i];
+                if (!IsPCRelative(relocation.kind) || section.needs_veneer[i]) {
+                    continue;
+                }
+
+                const auto pc = base + section.offset + static_cast<uint64_t>(relocation.offset);
+                if (!IsInRange(relocation.kind, pc, GetTargetAddress(section, relocation, base))) {
+                    section.needs_veneer[i] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Veneers directly follow their section, so only sections larger than
+    // the range of a reference can't reach them.
+    for (const auto& section : m_sections) {
+        for (size_t i = 0; i < section.relocations.size(); i++) {
+            if (!section.needs_veneer[i]) {
+                continue;
+            }
+
+            const auto& relocation = section.relocations[i];
+            const auto pc = base + section.offset + static_cast<uint64_t>(relocation.offset);
+            if (!IsInRange(relocation.kind, pc, base + section.veneer_offsets[i])) {
+                return LinkError::VeneerOutOfRange;
+            }
+        }
+    }
+
+    if (!buffer.HasSpaceFor(size)) {
+        return LinkError::OutOfSpace;
+    }
+
+    auto* const code = buffer.GetCursorPointer();
+    std::memset(code, 0, size);
+
+    for (auto& section : m_sections) {
+        auto* const section_code = code + section.offset;
+        const auto section_address = base + section.offset;
+        std::memcpy(section_code, section.code.data(), section.code.size());
+
+        for (size_t i = 0; i < section.relocations.size(); i++) {
+            const auto& relocation = section.relocations[i];
+            auto target = GetTargetAddress(section, relocation, base);
+
+            if (section.needs_veneer[i]) {
+                WriteVeneer(code + section.veneer_offsets[i], target);
+                target = base + section.veneer_offsets[i];
+            }
+
+            ApplyRelocation(section_code, section_address, relocation, target);
+        }
+    }
+
+    m_num_veneers = 0;
+    for (const auto& section : m_sections) {
+        m_symbols[section.symbol].address = base + section.offset;
+        m_num_veneers += section.num_veneers;
+    }
+
+    const auto offset = buffer.GetCursorOffset();
+    buffer.AdvanceCursor(offset + static_cast<ptrdiff_t>(size));
+    buffer.MarkDirty(offset, size);
+    return LinkError::None;
+}
+
+uint64_t Linker::GetSymbolAddress(std::string_view name) const {
+    std::scoped_lock lock{m_mutex};
+
+    const auto iter = m_symbol_indices.find(std::string{name});
+    BISCUIT_ASSERT(iter != m_symbol_indices.end());
+
+    const auto& symbol = m_symbols[iter->second];
+    BISCUIT_ASSERT(symbol.is_defined);
+    return symbol.address;
+}
+
+std::vector<std::string_view> Linker::GetUndefinedSymbols() const {
+    std::scoped_lock lock{m_mutex};
+
+    std::vector<std::string_view> names;
+    for (const auto& symbol : m_symbols) {
+        if (symbol.is_referenced && !symbol.is_defined) {
+            names.emplace_back(symbol.name);
+        }
+    }
+    return names;
+}
+
+} // namespace biscuit
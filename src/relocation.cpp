@@ -0,0 +1,228 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/assembler.hpp>
+#include <biscuit/relocation.hpp>
+
+#include <array>
+#include <cstring>
+
+#include "assembler_util.hpp"
+
+namespace biscuit {
+namespace {
+
+// Lets the instruction format emitters write into already emitted code.
+struct PatchWriter {
+    void Emit32(uint32_t value) noexcept {
+        std::memcpy(cursor, &value, sizeof(value));
+        cursor += sizeof(value);
+    }
+
+    uint8_t* cursor;
+};
+
+[[nodiscard]] uint32_t ReadInstruction(const uint8_t* code) noexcept {
+    uint32_t instruction = 0;
+    std::memcpy(&instruction, code, sizeof(instruction));
+    return instruction;
+}
+
+[[nodiscard]] int64_t GetITypeImm(uint32_t instruction) noexcept {
+    return static_cast<int32_t>(instruction) >> 20;
+}
+
+[[nodiscard]] int64_t GetUTypeImm(uint32_t instruction) noexcept {
+    return static_cast<int32_t>(instruction & 0xFFFFF000);
+}
+
+[[nodiscard]] int64_t GetJTypeImm(uint32_t instruction) noexcept {
+    // clang-format off
+    const auto imm = ((instruction >> 11) & 0x100000) |
+                     ((instruction >> 0)  & 0x0FF000) |
+                     ((instruction >> 9)  & 0x000800) |
+                     ((instruction >> 20) & 0x0007FE);
+    // clang-format on
+    return static_cast<int32_t>(imm << 11) >> 11;
+}
+
+// The chunks that the fixed-length LI sequence adds in after each shift,
+// from the top-most one to the bottom-most one.
+constexpr std::array<uint32_t, 3> absolute_li_shifts = {12, 12, 8};
+
+void WriteAbsoluteLI(uint8_t* code, GPR rd, uint64_t value) noexcept {
+    // Peel the value apart from the bottom up. Each chunk is sign-extended, with the
+    // remainder above it adjusted to compensate, exactly like the regular LI sequence.
+    std::array<int32_t, 3> chunks{};
+    auto remainder = static_cast<int64_t>(value);
+    for (size_t i = chunks.size(); i-- > 0;) {
+        const auto shift = absolute_li_shifts[i];
+        chunks[i] = static_cast<int32_t>(static_cast<uint32_t>(remainder) << (32 - shift)) >> (32 - shift);
+        remainder = static_cast<int64_t>(static_cast<uint64_t>(remainder) - static_cast<uint64_t>(chunks[i])) >> shift;
+    }
+
+    // What remains is a sign-extended 32-bit value, built by LUI+ADDIW.
+    const auto upper = static_cast<uint32_t>(remainder);
+    const auto hi20 = ((upper + 0x800) >> 12) & 0xFFFFF;
+    const auto lo12 = upper & 0xFFF;
+
+    PatchWriter writer{code};
+    EmitUType(writer, hi20, rd, 0b0110111);
+    EmitIType(writer, lo12, rd, 0b000, rd, 0b0011011);
+    for (size_t i = 0; i < chunks.size(); i++) {
+        EmitIType(writer, absolute_li_shifts[i], rd, 0b001, rd, 0b0010011);
+        EmitIType(writer, static_cast<uint32_t>(chunks[i]), rd, 0b000, rd, 0b0010011);
+    }
+}
+
+[[nodiscard]] uint64_t ReadAbsoluteLI(const uint8_t* code) noexcept {
+    const auto lui = ReadInstruction(code);
+    const auto addiw = ReadInstruction(code + 4);
+
+    auto value = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(
+        static_cast<uint32_t>(GetUTypeImm(lui) + GetITypeImm(addiw)))));
+
+    for (size_t i = 0; i < absolute_li_shifts.size(); i++) {
+        const auto addi = ReadInstruction(code + 12 + i * 8);
+        value = (value << absolute_li_shifts[i]) + static_cast<uint64_t>(GetITypeImm(addi));
+    }
+    return value;
+}
+
+} // Anonymous namespace
+
+uint64_t ReadRelocationTarget(const uint8_t* code, uint64_t code_address,
+                              const Relocation& relocation) noexcept {
+    const auto* const location = code + relocation.offset;
+
+    switch (relocation.kind) {
+    case RelocationKind::Absolute64: {
+        uint64_t value = 0;
+        std::memcpy(&value, location, sizeof(value));
+        return value;
+    }
+    case RelocationKind::AbsoluteLI:
+        return ReadAbsoluteLI(location);
+    case RelocationKind::PCRelativePair: {
+        const auto offset = GetUTypeImm(ReadInstruction(location)) +
+                            GetITypeImm(ReadInstruction(location + 4));
+        return code_address + static_cast<uint64_t>(relocation.offset + offset);
+    }
+    case RelocationKind::Jump: {
+        const auto offset = GetJTypeImm(ReadInstruction(location));
+        return code_address + static_cast<uint64_t>(relocation.offset + offset);
+    }
+    }
+
+    BISCUIT_ASSERT(false);
+    return 0;
+}
+
+bool IsRelocationInRange(uint64_t code_address, const Relocation& relocation,
+                         uint64_t target) noexcept {
+    const auto pc = code_address + static_cast<uint64_t>(relocation.offset);
+    const auto offset = static_cast<ptrdiff_t>(target - pc);
+
+    switch (relocation.kind) {
+    case RelocationKind::Absolute64:
+    case RelocationKind::AbsoluteLI:
+        return true;
+    case RelocationKind::PCRelativePair:
+        return IsValidAUIPCPairImm(offset);
+    case RelocationKind::Jump:
+        return IsValidJTypeImm(offset);
+    }
+    return false;
+}
+
+void ApplyRelocation(uint8_t* code, uint64_t code_address,
+                     const Relocation& relocation, uint64_t target) noexcept {
+    auto* const location = code + relocation.offset;
+
+    switch (relocation.kind) {
+    case RelocationKind::Absolute64:
+        std::memcpy(location, &target, sizeof(target));
+        break;
+    case RelocationKind::AbsoluteLI: {
+        const GPR rd{(ReadInstruction(location) >> 7) & 0x1F};
+        WriteAbsoluteLI(location, rd, target);
+        break;
+    }
+    case RelocationKind::PCRelativePair: {
+        const auto pc = code_address + static_cast<uint64_t>(relocation.offset);
+        const auto offset = static_cast<ptrdiff_t>(target - pc);
+        BISCUIT_ASSERT(IsValidAUIPCPairImm(offset));
+
+        // Only the immediates are replaced, keeping the registers and the kind
+        // of instruction that follows the AUIPC intact.
+        const auto auipc = ReadInstruction(location) & 0x00000FFF;
+        const auto itype = ReadInstruction(location + 4) & 0x000FFFFF;
+        const auto lo12 = static_cast<uint32_t>(GetAUIPCPairLo12(offset)) & 0xFFF;
+
+        const auto patched_auipc = auipc | (GetAUIPCPairHi20(offset) << 12);
+        const auto patched_itype = itype | (lo12 << 20);
+        std::memcpy(location, &patched_auipc, sizeof(patched_auipc));
+        std::memcpy(location + 4, &patched_itype, sizeof(patched_itype));
+        break;
+    }
+    case RelocationKind::Jump: {
+        const auto pc = code_address + static_cast<uint64_t>(relocation.offset);
+        const auto offset = static_cast<ptrdiff_t>(target - pc);
+        BISCUIT_ASSERT(IsValidJTypeImm(offset));
+
+        const auto jal = ReadInstruction(location) & 0x00000FFF;
+        const auto patched_jal = jal | TransformToJTypeImm(static_cast<uint32_t>(offset) & 0x1FFFFE);
+        std::memcpy(location, &patched_jal, sizeof(patched_jal));
+        break;
+    }
+    }
+}
+
+bool Relocate(uint8_t* dst, const uint8_t* src, size_t size, uint64_t src_address,
+              ptrdiff_t delta, std::span<const Relocation> relocations) noexcept {
+    BISCUIT_ASSERT(dst <= src || dst >= src + size);
+
+    const auto dst_address = src_address + static_cast<uint64_t>(delta);
+
+    // Check that the external PC-relative references can still reach their targets
+    // before anything is moved, so that a failure leaves both copies intact.
+    for (const auto& relocation : relocations) {
+        if (relocation.symbol == code_base_symbol || !IsPCRelative(relocation.kind)) {
+            continue;
+        }
+
+        const auto target = ReadRelocationTarget(src, src_address, relocation);
+        if (!IsRelocationInRange(dst_address, relocation, target)) {
+            return false;
+        }
+    }
+
+    // Everything between relocations is moved as-is. Since the destination never lies
+    // after the source when they overlap, moving front to back only ever overwrites
+    // source bytes that have already been moved.
+    size_t copied = 0;
+    for (const auto& relocation : relocations) {
+        const auto offset = static_cast<size_t>(relocation.offset);
+        const auto relocation_size = GetRelocationSize(relocation.kind);
+        BISCUIT_ASSERT(relocation.offset >= 0 && offset >= copied);
+        BISCUIT_ASSERT(offset + relocation_size <= size);
+
+        const bool is_internal = relocation.symbol == code_base_symbol;
+        const bool is_pc_relative = IsPCRelative(relocation.kind);
+
+        // Read the target before the move can clobber the source.
+        auto target = ReadRelocationTarget(src, src_address, relocation);
+        std::memmove(dst + copied, src + copied, offset + relocation_size - copied);
+        copied = offset + relocation_size;
+
+        if (is_internal && !is_pc_relative) {
+            target += static_cast<uint64_t>(delta);
+        } else if (is_internal || !is_pc_relative) {
+            continue;
+        }
+        ApplyRelocation(dst, dst_address, relocation, target);
+    }
+
+    std::memmove(dst + copied, src + copied, size - copied);
+    return true;
+}
+
+} // namespace biscuit
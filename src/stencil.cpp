@@ -0,0 +1,204 @@
+#include <biscuit/assert.hpp>
+#include <biscuit/stencil.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace biscuit {
+namespace {
+
+[[nodiscard]] uint32_t ReadInstruction(const uint8_t* location) noexcept {
+    uint32_t instruction;
+    std::memcpy(&instruction, location, sizeof(instruction));
+    return instruction;
+}
+
+void WriteInstruction(uint8_t* location, uint32_t instruction) noexcept {
+    std::memcpy(location, &instruction, sizeof(instruction));
+}
+
+constexpr uint32_t auipc_opcode = 0b0010111;
+
+// The pieces of a value that make up each field, i.e. `(value >> src_shift) & mask`
+// ends up at `dst_shift` within the instruction.
+struct FieldPiece {
+    uint32_t mask;
+    uint8_t src_shift;
+    uint8_t dst_shift;
+};
+
+struct FieldLayout {
+    uint8_t num_pieces;
+    std::array<FieldPiece, 4> pieces;
+};
+
+[[nodiscard]] FieldLayout GetFieldLayout(StencilField field) noexcept {
+    switch (field) {
+    case StencilField::Rd:
+        return {1, {{{0x1F, 0, 7}}}};
+    case StencilField::Rs1:
+        return {1, {{{0x1F, 0, 15}}}};
+    case StencilField::Rs2:
+        return {1, {{{0x1F, 0, 20}}}};
+    case StencilField::Rs3:
+        return {1, {{{0x1F, 0, 27}}}};
+    case StencilField::IImm:
+    case StencilField::PCRelativePair:
+        return {1, {{{0xFFF, 0, 20}}}};
+    case StencilField::SImm:
+        return {2, {{{0x7F, 5, 25}, {0x1F, 0, 7}}}};
+    case StencilField::BImm:
+    case StencilField::BTarget:
+        return {4, {{{0x1, 12, 31}, {0x3F, 5, 25}, {0xF, 1, 8}, {0x1, 11, 7}}}};
+    case StencilField::JImm:
+    case StencilField::JTarget:
+        return {4, {{{0x1, 20, 31}, {0x3FF, 1, 21}, {0x1, 11, 20}, {0xFF, 12, 12}}}};
+    case StencilField::UImm:
+        return {1, {{{0xFFFFF, 0, 12}}}};
+    }
+    return {};
+}
+
+} // Anonymous namespace
+
+uint32_t Stencil::GetHole(std::string_view name) const {
+    const auto iter = std::ranges::find(m_holes, name);
+    BISCUIT_ASSERT(iter != m_holes.end());
+    return static_cast<uint32_t>(iter - m_holes.begin());
+}
+
+ptrdiff_t Stencil::Stamp(CodeBuffer& buffer, std::span<const StencilValue> values) const {
+    BISCUIT_ASSERT(values.size() == m_holes.size());
+
+    // The whole template is copied at once, with a single capacity check, and then
+    // each patched instruction is written over it once, with all of its fields ORed
+    // into the template's copy of it. Everything written lies within the freshly
+    // emitted range, which the buffer already tracks as dirty.
+    const auto offset = buffer.GetCursorOffset();
+    buffer.EmitBytes(m_code.data(), m_code.size());
+
+    auto* const code = buffer.GetOffsetPointer(offset);
+    const auto address = static_cast<uint64_t>(buffer.GetOffsetAddress(offset));
+
+    const auto* patch = m_patches.data();
+    const auto* const patches_end = patch + m_patches.size();
+    while (patch != patches_end) {
+        const auto location = patch->offset;
+        auto instruction = ReadInstruction(m_code.data() + location);
+
+        // Patches are sorted by offset, so all fields of an instruction are next to each other.
+        for (; patch != patches_end && patch->offset == location; patch++) {
+            auto value = static_cast<uint64_t>(values[patch->hole].value) + patch->addend;
+            if (patch->is_pc_relative) {
+                value -= address + patch->pc_offset;
+            }
+
+            for (uint32_t i = 0; i < patch->num_pieces; i++) {
+                const auto& piece = patch->pieces[i];
+                instruction |= (static_cast<uint32_t>(value >> piece.src_shift) & piece.mask) << piece.dst_shift;
+            }
+        }
+
+        WriteInstruction(code + location, instruction);
+    }
+
+    return offset;
+}
+
+StencilBuilder::StencilBuilder(Assembler& as)
+    : m_assembler{as}, m_start{as.GetCodeBuffer().GetCursorOffset()} {}
+
+uint32_t StencilBuilder::Hole(std::string_view name, StencilField field) {
+    BISCUIT_ASSERT(!m_assembler.IsOptimizationEnabled(Optimization::AutoCompress));
+
+    const auto cursor = m_assembler.GetCodeBuffer().GetCursorOffset();
+    const auto size = field == StencilField::PCRelativePair ? 8 : 4;
+    BISCUIT_ASSERT(cursor - m_start >= size);
+
+    auto iter = std::ranges::find(m_holes, name);
+    if (iter == m_holes.end()) {
+        m_holes.emplace_back(name);
+        iter = m_holes.end() - 1;
+    }
+
+    const auto hole = static_cast<uint32_t>(iter - m_holes.begin());
+    m_fields.push_back({
+        .offset = static_cast<uint32_t>(cursor - 4 - m_start),
+        .field = field,
+        .hole = hole,
+    });
+    return hole;
+}
+
+Stencil StencilBuilder::Build() const {
+    const auto& buffer = m_assembler.GetCodeBuffer();
+    const auto size = static_cast<size_t>(buffer.GetCursorOffset() - m_start);
+    BISCUIT_ASSERT(size != 0);
+
+    Stencil stencil;
+    stencil.m_holes = m_holes;
+    const auto* const code = buffer.GetOffsetPointer(m_start);
+    stencil.m_code.assign(code, code + size);
+
+    // Work out how each field is filled in up front, so that stamping only has to
+    // move bits of the values into place. A PC-relative pair is split into a patch
+    // for each of its halves, both being relative to the AUIPC.
+    const auto add_patch = [&](uint32_t offset, StencilField layout_field, uint32_t hole,
+                               bool is_pc_relative, uint32_t pc_offset, uint32_t addend) {
+        const auto layout = GetFieldLayout(layout_field);
+        Stencil::Patch patch{
+            .offset = offset,
+            .hole = hole,
+            .pc_offset = pc_offset,
+            .addend = addend,
+            .is_pc_relative = is_pc_relative,
+            .num_pieces = layout.num_pieces,
+            .pieces = {},
+        };
+        for (uint32_t i = 0; i < layout.num_pieces; i++) {
+            const auto& piece = layout.pieces[i];
+            patch.pieces[i] = {piece.mask, piece.src_shift, piece.dst_shift};
+        }
+        stencil.m_patches.push_back(patch);
+    };
+
+    for (const auto& field : m_fields) {
+        switch (field.field) {
+        case StencilField::BTarget:
+        case StencilField::JTarget:
+            add_patch(field.offset, field.field, field.hole, true, field.offset, 0);
+            break;
+        case StencilField::PCRelativePair: {
+            const auto auipc_offset = field.offset - 4;
+            BISCUIT_ASSERT((ReadInstruction(code + auipc_offset) & 0x7F) == auipc_opcode);
+
+            // The AUIPC takes the upper 20 bits, rounded up whenever the sign-extended
+            // lower half is negative.
+            add_patch(auipc_offset, StencilField::UImm, field.hole, true, auipc_offset, 0x800);
+            stencil.m_patches.back().pieces[0].src_shift = 12;
+            add_patch(field.offset, StencilField::IImm, field.hole, true, auipc_offset, 0);
+            break;
+        }
+        default:
+            add_patch(field.offset, field.field, field.hole, false, 0, 0);
+            break;
+        }
+    }
+
+    // Clear out the placeholder bits, so that stamping only has to OR values in.
+    std::ranges::stable_sort(stencil.m_patches, {}, &Stencil::Patch::offset);
+    for (const auto& patch : stencil.m_patches) {
+        uint32_t mask = 0;
+        for (uint32_t i = 0; i < patch.num_pieces; i++) {
+            mask |= patch.pieces[i].mask << patch.pieces[i].dst_shift;
+        }
+
+        auto* const location = stencil.m_code.data() + patch.offset;
+        WriteInstruction(location, ReadInstruction(location) & ~mask);
+    }
+
+    return stencil;
+}
+
+} // namespace biscuit
@@ -572,4 +572,222 @@ TEST_CASE("XOR to C.XOR", "[autocompress]") {
 
     as.XOR(x15, x8, x15);
     REQUIRE(value == 0x8FA1);
-}
\ No newline at end of file
+}
+TEST_CASE("ADD to C.ADD with full registers", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+
+    as.ADD(x5, x5, x20);
+    REQUIRE(value == 0x92D2);
+
+    as.RewindBuffer();
+
+    as.ADD(x5, x20, x5);
+    REQUIRE(value == 0x92D2);
+}
+
+TEST_CASE("ADD to C.MV", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+
+    as.ADD(x5, x0, x20);
+    REQUIRE(value == 0x82D2);
+
+    as.RewindBuffer();
+
+    as.ADD(x5, x20, x0);
+    REQUIRE(value == 0x82D2);
+}
+
+TEST_CASE("EBREAK to C.EBREAK", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+
+    as.EBREAK();
+    REQUIRE(value == 0x9002);
+}
+
+TEST_CASE("NOP to C.NOP", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+
+    as.NOP();
+    REQUIRE(value == 0x0001);
+}
+
+TEST_CASE("FLD to C.FLD (RV32)", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler32(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+
+    as.FLD(f8, 0, x9);
+    REQUIRE(value == 0x2080);
+}
+
+TEST_CASE("LD and SD are not compressed on RV32", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler32(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+
+    // C.LD and C.SD would be C.FLW and C.FSW on RV32.
+    as.LD(x8, 0, x9);
+    REQUIRE(value == 0x0004B403);
+
+    as.RewindBuffer();
+
+    as.SD(x8, 0, x9);
+    REQUIRE(value == 0x0084B023);
+}
+
+TEST_CASE("AutoCompress respects disabled compressed extensions", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+
+    // Zcd is independent from Zca.
+    as.DisableExtension(Extension::Zca);
+    as.FLD(f8, 0, x9);
+    REQUIRE(value == 0x2080);
+
+    as.RewindBuffer();
+
+    as.ADD(x15, x15, x8);
+    REQUIRE(value == 0x008787B3);
+
+    as.RewindBuffer();
+
+    as.DisableExtension(Extension::Zcd);
+    as.FLD(f8, 0, x9);
+    REQUIRE(value == 0x0004B407);
+
+    as.RewindBuffer();
+
+    // Zcb forms are opt-in.
+    as.EnableExtension(Extension::Zca);
+    as.LBU(x12, 0, x15);
+    REQUIRE(value == 0x0007C603);
+}
+
+TEST_CASE("LBU to C.LBU", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.LBU(x12, 0, x15);
+    REQUIRE(value == 0x8390U);
+
+    as.RewindBuffer();
+
+    as.LBU(x12, 3, x15);
+    REQUIRE(value == 0x83F0U);
+}
+
+TEST_CASE("LH to C.LH", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.LH(x12, 2, x15);
+    REQUIRE(value == 0x87F0U);
+}
+
+TEST_CASE("LHU to C.LHU", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.LHU(x12, 2, x15);
+    REQUIRE(value == 0x87B0U);
+}
+
+TEST_CASE("SB to C.SB", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.SB(x12, 1, x15);
+    REQUIRE(value == 0x8BD0U);
+}
+
+TEST_CASE("SH to C.SH", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.SH(x12, 2, x15);
+    REQUIRE(value == 0x8FB0U);
+}
+
+TEST_CASE("ANDI to C.ZEXT.B", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.ANDI(x12, x12, 0xFF);
+    REQUIRE(value == 0x9E61);
+}
+
+TEST_CASE("SEXTB/SEXTH/ZEXTH to C.SEXT.B/C.SEXT.H/C.ZEXT.H", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.SEXTB(x12, x12);
+    REQUIRE(value == 0x9E65);
+
+    as.RewindBuffer();
+
+    as.SEXTH(x12, x12);
+    REQUIRE(value == 0x9E6D);
+
+    as.RewindBuffer();
+
+    as.ZEXTH(x12, x12);
+    REQUIRE(value == 0x9E69);
+}
+
+TEST_CASE("ZEXTW to C.ZEXT.W", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.ZEXTW(x12, x12);
+    REQUIRE(value == 0x9E71);
+}
+
+TEST_CASE("MUL to C.MUL", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.MUL(x12, x12, x15);
+    REQUIRE(value == 0x9E5D);
+
+    as.RewindBuffer();
+
+    as.MUL(x12, x15, x12);
+    REQUIRE(value == 0x9E5D);
+}
+
+TEST_CASE("NOT to C.NOT", "[autocompress]") {
+    uint32_t value = 0;
+    auto as = MakeAssembler64(value);
+    as.EnableOptimization(Optimization::AutoCompress);
+    as.EnableExtension(Extension::Zcb);
+
+    as.NOT(x12, x12);
+    REQUIRE(value == 0x9E75);
+}
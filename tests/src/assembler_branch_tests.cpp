@@ -1,6 +1,9 @@
 #include <catch/catch.hpp>
 
 #include <array>
+#include <cstring>
+#include <thread>
+#include <vector>
 #include <biscuit/assembler.hpp>
 
 #include "assembler_test_utils.hpp"
@@ -103,3 +106,326 @@ TEST_CASE("Branch with Instructions Between", "[branch]") {
         REQUIRE((data[0] & 0xFFFF) == 0xA029);
     }
 }
+
+TEST_CASE("Branch with Many Referencing Instructions", "[branch]") {
+    // Enough references to spill out of a label's inline offset storage.
+    constexpr size_t num_branches = 16;
+
+    std::array<uint32_t, num_branches> data{};
+    std::array<uint32_t, num_branches> expected{};
+    auto as = MakeAssembler32(data);
+    auto expected_as = MakeAssembler32(expected);
+
+    {
+        Label label;
+        for (size_t i = 0; i < num_branches; i++) {
+            as.J(&label);
+            expected_as.J(static_cast<int32_t>((num_branches - i) * sizeof(uint32_t)));
+        }
+        as.Bind(&label);
+        REQUIRE(label.IsResolved());
+    }
+
+    REQUIRE(data == expected);
+}
+
+TEST_CASE("Branch with Pooled Labels", "[branch]") {
+    std::array<uint32_t, 20> data{};
+    auto as = MakeAssembler32(data);
+
+    // Simple branch backward
+    {
+        const auto label = as.NewLabel();
+        as.Bind(label);
+        as.ADD(x1, x2, x3);
+        as.SUB(x2, x4, x3);
+        as.J(label);
+        REQUIRE(data[2] == 0xFF9FF06F);
+        REQUIRE(as.GetLabelLocation(label) == 0);
+    }
+
+    as.ResetLabels();
+    as.RewindBuffer();
+    data.fill(0);
+
+    // Forward branches to multiple labels, including compressed ones.
+    {
+        const auto label1 = as.NewLabel();
+        const auto label2 = as.NewLabel();
+        as.J(label1);
+        as.BNE(x3, x4, label2);
+        as.C_J(label2);
+        as.C_BNEZ(x15, label1);
+        REQUIRE(!as.GetLabelLocation(label1).has_value());
+        as.Bind(label1);
+        as.Bind(label2);
+
+        REQUIRE(data[0] == 0x00C0006F);
+        REQUIRE(data[1] == 0x00419463);
+        REQUIRE(data[2] == 0xE389A011);
+        REQUIRE(as.GetLabelLocation(label1) == 12);
+    }
+
+    // Handles are reusable after resetting the pool.
+    as.ResetLabels();
+    REQUIRE(as.NewLabel().Index() == 0);
+}
+
+TEST_CASE("Branch Relaxation (short branches)", "[branch]") {
+    std::array<uint32_t, 4> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::RelaxBranches);
+
+    const auto start = as.NewLabel();
+    const auto end = as.NewLabel();
+    as.Bind(start);
+    as.BNE(x3, x4, end);
+    as.ADD(x1, x2, x3);
+    as.J(start);
+    as.Bind(end);
+    as.Finalize();
+
+    REQUIRE(data[0] == 0x00419663);
+    REQUIRE(data[1] == 0x003100B3);
+    REQUIRE(data[2] == 0xFF9FF06F);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 12);
+    REQUIRE(as.GetLabelLocation(end) == 12);
+}
+
+TEST_CASE("Branch Relaxation (compressed branches)", "[branch]") {
+    std::array<uint16_t, 4> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::AutoCompress | Optimization::RelaxBranches);
+
+    const auto label = as.NewLabel();
+    as.BEQZ(x8, label);
+    as.C_NOP();
+    as.Bind(label);
+    as.Finalize();
+
+    REQUIRE(data[0] == 0xC011);
+    REQUIRE(data[1] == 0x0001);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 4);
+    REQUIRE(as.GetLabelLocation(label) == 4);
+}
+
+TEST_CASE("Branch Relaxation (out of range conditional branch)", "[branch]") {
+    std::array<uint32_t, 1260> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::RelaxBranches);
+
+    const auto label = as.NewLabel();
+    as.BEQ(x10, x11, label);
+    for (int i = 0; i < 1250; i++) {
+        as.NOP();
+    }
+    as.Bind(label);
+    as.Finalize();
+
+    // Inverted to BNE x10, x11, +8 followed by J +5004
+    REQUIRE(data[0] == 0x00B51463);
+    REQUIRE(data[1] == 0x38C0106F);
+    REQUIRE(data[2] == 0x00000013);
+    REQUIRE(data[1251] == 0x00000013);
+    REQUIRE(as.GetLabelLocation(label) == 5008);
+}
+
+TEST_CASE("Branch Relaxation (out of range jump)", "[branch]") {
+    constexpr size_t num_nops = 0x40000;
+    Assembler as(num_nops * 4 + 64);
+    as.EnableOptimization(Optimization::RelaxBranches);
+
+    const auto label = as.NewLabel();
+    as.J(label);
+    for (size_t i = 0; i < num_nops; i++) {
+        as.NOP();
+    }
+    as.Bind(label);
+    as.JAL(label);
+    as.Finalize();
+
+    const auto read32 = [&](ptrdiff_t offset) {
+        uint32_t value;
+        std::memcpy(&value, as.GetBufferPointer(offset), sizeof(value));
+        return value;
+    };
+
+    // AUIPC t1, 0x100; JALR x0, 8(t1)
+    REQUIRE(read32(0) == 0x00100317);
+    REQUIRE(read32(4) == 0x00830067);
+    REQUIRE(read32(8) == 0x00000013);
+    REQUIRE(as.GetLabelLocation(label) == 0x100008);
+
+    // Jump to self stays a single JAL x1, 0.
+    REQUIRE(read32(0x100008) == 0x000000EF);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 0x10000C);
+}
+
+TEST_CASE("Deferred Fixups", "[branch]") {
+    std::array<uint32_t, 6> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::DeferFixups);
+
+    Label label;
+    Literal<uint64_t> literal{0x1122334455667788};
+    const auto pooled = as.NewLabel();
+
+    as.BNE(x3, x4, &label);
+    as.J(pooled);
+    as.LD(x5, &literal);
+    as.Bind(&label);
+    as.Bind(pooled);
+    as.Place(&literal);
+
+    // Nothing is patched until finalizing.
+    REQUIRE(data[0] == 0x00419063);
+    REQUIRE(data[1] == 0x0000006F);
+    REQUIRE(data[3] == 0x0002B283);
+
+    as.Finalize();
+
+    REQUIRE(data[0] == 0x00419863);
+    REQUIRE(data[1] == 0x00C0006F);
+    REQUIRE(data[2] == 0x00000297);
+    REQUIRE(data[3] == 0x0082B283);
+    REQUIRE(data[4] == 0x55667788);
+    REQUIRE(data[5] == 0x11223344);
+}
+
+TEST_CASE("Jump Veneers (in range)", "[branch]") {
+    std::array<uint32_t, 4> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::JumpVeneers);
+
+    Label label;
+    as.J(&label);
+    as.NOP();
+    as.Bind(&label);
+    as.Finalize();
+
+    // Jumps bound within range stay a single JAL without a veneer.
+    REQUIRE(data[0] == 0x0080006F);
+    REQUIRE(data[1] == 0x00000013);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 8);
+}
+
+TEST_CASE("Jump Veneers (explicit island)", "[branch]") {
+    std::array<uint32_t, 32> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::JumpVeneers);
+    as.SetJumpVeneerMaxDistance(64);
+
+    Label label;
+    as.JAL(&label);
+    for (int i = 0; i < 20; i++) {
+        as.NOP();
+        (void)as.EmitIslandIfNeeded(4);
+    }
+    as.Bind(&label);
+
+    REQUIRE(data[0] == 0x038000EF);  // JAL ra, +56 (to the veneer)
+    REQUIRE(data[13] == 0x00C0006F); // J +12 (around the island)
+    REQUIRE(data[14] == 0x00000317); // AUIPC t1, 0
+    REQUIRE(data[15] == 0x02830067); // JALR x0, 40(t1)
+    REQUIRE(data[16] == 0x00000013);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 96);
+}
+
+TEST_CASE("Jump Veneers (redirected jump and direct jump to one label)", "[branch]") {
+    std::array<uint32_t, 32> data{};
+    auto as = MakeAssembler64(data);
+    as.SetJumpVeneerMaxDistance(64);
+
+    const auto emit = [&](auto label) {
+        as.JAL(label);
+        for (int i = 0; i < 20; i++) {
+            as.NOP();
+            (void)as.EmitIslandIfNeeded(4);
+        }
+        as.JAL(label);
+        as.Bind(label);
+        as.Finalize();
+    };
+
+    SECTION("Label objects with deferred fixups") {
+        as.EnableOptimization(Optimization::JumpVeneers | Optimization::DeferFixups);
+        Label label;
+        emit(&label);
+    }
+
+    SECTION("Pooled labels") {
+        as.EnableOptimization(Optimization::JumpVeneers);
+        emit(as.NewLabel());
+    }
+
+    // The veneer takes over the redirected jump's fixup, while the other
+    // jump is patched as usual.
+    REQUIRE(data[0] == 0x038000EF);  // JAL ra, +56 (to the veneer)
+    REQUIRE(data[13] == 0x00C0006F); // J +12 (around the island)
+    REQUIRE(data[14] == 0x00000317); // AUIPC t1, 0
+    REQUIRE(data[15] == 0x02C30067); // JALR x0, 44(t1)
+    REQUIRE(data[24] == 0x004000EF); // JAL ra, +4
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 100);
+}
+
+TEST_CASE("Jump Veneers (island before next jump)", "[branch]") {
+    std::array<uint32_t, 16> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::JumpVeneers | Optimization::DeferFixups);
+    as.SetJumpVeneerMaxDistance(64);
+
+    const auto first = as.NewLabel();
+    const auto second = as.NewLabel();
+    as.JAL(first);
+    for (int i = 0; i < 10; i++) {
+        as.NOP();
+    }
+    as.JAL(second);
+    as.Bind(first);
+    as.Bind(second);
+    as.Finalize();
+
+    REQUIRE(data[0] == 0x030000EF);  // JAL ra, +48 (to the veneer)
+    REQUIRE(data[11] == 0x00C0006F); // J +12 (around the island)
+    REQUIRE(data[12] == 0x00000317); // AUIPC t1, 0
+    REQUIRE(data[13] == 0x00C30067); // JALR x0, 12(t1)
+    REQUIRE(data[14] == 0x004000EF); // JAL ra, +4
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 60);
+}
+
+TEST_CASE("Jump Veneers (out of range backward jump)", "[branch]") {
+    std::vector<uint32_t> data(131104);
+    Assembler as{reinterpret_cast<uint8_t*>(data.data()), data.size() * sizeof(uint32_t)};
+    as.EnableOptimization(Optimization::JumpVeneers);
+
+    Label start;
+    as.Bind(&start);
+    for (int i = 0; i < 131100; i++) {
+        as.NOP();
+    }
+    as.J(&start);
+
+    // The veneer directly follows the jump, being an unconditional transfer.
+    REQUIRE(data[131100] == 0x0040006F); // J +4
+    REQUIRE(data[131101] == 0xFFF80317); // AUIPC t1, -0x80
+    REQUIRE(data[131102] == 0xF8C30067); // JALR x0, -0x74(t1)
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 131103 * 4);
+}
+
+TEST_CASE("Label with spilled offsets outliving its thread's spill pool", "[branch]") {
+    constexpr size_t num_branches = 16;
+
+    std::thread thread{[] {
+        // Constructed before the first spill creates the thread's spill pool,
+        // so the label is destroyed after the pool on thread exit.
+        thread_local Label label;
+
+        std::array<uint32_t, num_branches> data{};
+        auto as = MakeAssembler32(data);
+        for (size_t i = 0; i < num_branches; i++) {
+            as.J(&label);
+        }
+        as.Bind(&label);
+    }};
+    thread.join();
+}
@@ -0,0 +1,187 @@
+#include <catch/catch.hpp>
+
+#include <array>
+#include <biscuit/assembler.hpp>
+
+#include "assembler_test_utils.hpp"
+
+using namespace biscuit;
+
+TEST_CASE("Literal with sign-extended load offset", "[literal]") {
+    alignas(8) std::array<uint32_t, 0x204> data{};
+    auto as = MakeAssembler64(data);
+
+    Literal<uint64_t> literal{0x1122334455667788};
+    as.LD(x5, &literal);
+    for (int i = 0; i < 510; i++) {
+        as.NOP();
+    }
+    as.Place(&literal);
+
+    // AUIPC x5, 1; LD x5, -2048(x5)
+    REQUIRE(data[0] == 0x00001297);
+    REQUIRE(data[1] == 0x8002B283);
+    REQUIRE(literal.GetLocation() == 0x800);
+}
+
+TEST_CASE("Literal pool deduplicates constants", "[literal]") {
+    alignas(8) std::array<uint32_t, 16> data{};
+    auto as = MakeAssembler64(data);
+
+    as.LoadConstant(x5, 0x1122334455667788);
+    as.LoadConstant(x6, 0x99AABBCCDDEEFF00);
+    as.LoadConstant(x7, 0x1122334455667788);
+    as.RET();
+
+    // Emitted right after the return, aligned to 8 bytes.
+    REQUIRE(data[0] == 0x00000297);
+    REQUIRE(data[1] == 0x0202B283);
+    REQUIRE(data[2] == 0x00000317);
+    REQUIRE(data[3] == 0x02033303);
+    REQUIRE(data[4] == 0x00000397);
+    REQUIRE(data[5] == 0x0103B383);
+    REQUIRE(data[6] == 0x00008067);
+    REQUIRE(data[7] == 0x00000000);
+    REQUIRE(data[8] == 0x55667788);
+    REQUIRE(data[9] == 0x11223344);
+    REQUIRE(data[10] == 0xDDEEFF00);
+    REQUIRE(data[11] == 0x99AABBCC);
+
+    // Placed constants are reused.
+    as.LoadConstant(x5, 0x1122334455667788);
+    as.Finalize();
+
+    REQUIRE(data[12] == 0x00000297);
+    REQUIRE(data[13] == 0xFF02B283);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 56);
+}
+
+TEST_CASE("Literal pool with branch relaxation", "[literal]") {
+    alignas(8) std::array<uint32_t, 8> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::RelaxBranches);
+
+    // Pending constants are placed before code starts being subject to relaxation.
+    const auto label = as.NewLabel();
+    as.LoadConstant(a0, 0x123456789ABCDEF0);
+    as.BEQ(x1, x2, label);
+    as.Bind(label);
+    as.Finalize();
+
+    // AUIPC a0, 0; LD a0, 16(a0); J +16
+    REQUIRE(data[0] == 0x00000517);
+    REQUIRE(data[1] == 0x01053503);
+    REQUIRE(data[2] == 0x0100006F);
+    REQUIRE(data[4] == 0x9ABCDEF0);
+    REQUIRE(data[5] == 0x12345678);
+
+    // BEQ x1, x2, +4
+    REQUIRE(data[6] == 0x00208263);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 28);
+}
+
+TEST_CASE("Literal pool after a jump to a symbol", "[literal]") {
+    alignas(8) std::array<uint32_t, 8> data{};
+    auto as = MakeAssembler64(data);
+
+    as.LoadConstant(x5, 0x1122334455667788);
+    as.J(SymbolReference::Unresolved(0));
+
+    // AUIPC x5, 0; LD x5, 16(x5); J <symbol>
+    REQUIRE(data[0] == 0x00000297);
+    REQUIRE(data[1] == 0x0102B283);
+    REQUIRE(data[2] == 0x0000006F);
+    REQUIRE(data[4] == 0x55667788);
+    REQUIRE(data[5] == 0x11223344);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 24);
+}
+
+TEST_CASE("Literal pool with compressed jumps", "[literal]") {
+    alignas(8) std::array<uint32_t, 6> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::AutoCompress);
+
+    // The load must never be compressed, despite using compressible registers.
+    as.LoadConstant(x8, 0x1122334455667788);
+    as.J(0);
+
+    REQUIRE(data[0] == 0x00000417);
+    REQUIRE(data[1] == 0x01043403);
+    REQUIRE(data[2] == 0x0000A001);
+    REQUIRE(data[3] == 0x00000000);
+    REQUIRE(data[4] == 0x55667788);
+    REQUIRE(data[5] == 0x11223344);
+}
+
+TEST_CASE("Literal pool island with jump around it", "[literal]") {
+    alignas(8) std::array<uint32_t, 16> data{};
+    auto as = MakeAssembler64(data);
+    as.SetLiteralPoolMaxDistance(64);
+
+    as.LoadConstant(x5, 0x1122334455667788);
+    for (int i = 0; i < 6; i++) {
+        as.NOP();
+    }
+    as.LoadConstant(x6, 0x99AABBCCDDEEFF00);
+    as.Finalize();
+
+    REQUIRE(data[0] == 0x00000297);
+    REQUIRE(data[1] == 0x0282B283);
+    REQUIRE(data[8] == 0x0100006F);
+    REQUIRE(data[9] == 0x00000000);
+    REQUIRE(data[10] == 0x55667788);
+    REQUIRE(data[11] == 0x11223344);
+    REQUIRE(data[12] == 0x00000317);
+    REQUIRE(data[13] == 0x00833303);
+    REQUIRE(data[14] == 0xDDEEFF00);
+    REQUIRE(data[15] == 0x99AABBCC);
+}
+
+TEST_CASE("Literal loads for other destinations", "[literal]") {
+    alignas(8) std::array<uint32_t, 16> data{};
+    auto as = MakeAssembler64(data);
+
+    Literal<uint32_t> word{0x3F800000};
+    Literal<uint64_t> dword{0x3FF0000000000000};
+    Literal<uint16_t> half{0x3C00};
+
+    as.LW(x5, &word);
+    as.FLW(f1, &word, x6);
+    as.FLD(f2, &dword, x6);
+    as.FLH(f3, &half, x6);
+    as.LA(x7, &dword);
+
+    as.Place(&word);
+    as.GetCodeBuffer().Emit32(0);
+    as.Place(&dword);
+    as.Place(&half);
+
+    REQUIRE(data[0] == 0x00000297);
+    REQUIRE(data[1] == 0x0282A283);
+    REQUIRE(data[2] == 0x00000317);
+    REQUIRE(data[3] == 0x02032087);
+    REQUIRE(data[4] == 0x00000317);
+    REQUIRE(data[5] == 0x02033107);
+    REQUIRE(data[6] == 0x00000317);
+    REQUIRE(data[7] == 0x02031187);
+    REQUIRE(data[8] == 0x00000397);
+    REQUIRE(data[9] == 0x01038393);
+    REQUIRE(data[10] == 0x3F800000);
+    REQUIRE(data[12] == 0x00000000);
+    REQUIRE(data[13] == 0x3FF00000);
+    REQUIRE(data[14] == 0x00003C00);
+}
+
+TEST_CASE("Literal pool with floating-point constants", "[literal]") {
+    alignas(8) std::array<uint32_t, 6> data{};
+    auto as = MakeAssembler64(data);
+
+    as.LoadConstant(f1, 1.0, x6);
+    as.RET();
+
+    REQUIRE(data[0] == 0x00000317);
+    REQUIRE(data[1] == 0x01033087);
+    REQUIRE(data[2] == 0x00008067);
+    REQUIRE(data[4] == 0x00000000);
+    REQUIRE(data[5] == 0x3FF00000);
+}
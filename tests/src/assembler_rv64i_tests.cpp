@@ -223,6 +223,139 @@ TEST_CASE("LI (RV64)", "[rv64i]") {
                  0x01009093U, 0x10108093U, 0x00F09093U, 0x0F108093U);
 }
 
+TEST_CASE("LI with extensions (RV64)", "[rv64i]") {
+    std::array<uint32_t, 8> vals{};
+    auto as = MakeAssembler64(vals);
+
+    const auto check = [&](Extension ext, uint64_t imm, std::initializer_list<uint32_t> expected) {
+        as.RewindBuffer();
+        vals = {};
+        as.DisableExtension(Extension::Zba | Extension::Zbb | Extension::Zbs);
+        as.EnableExtension(ext);
+        as.LI(x10, imm);
+
+        REQUIRE(as.GetCodeBuffer().GetCursorOffset() == ptrdiff_t(expected.size() * 4));
+        size_t i = 0;
+        for (const auto inst : expected) {
+            REQUIRE(vals[i] == inst);
+            i++;
+        }
+    };
+
+    // addiw x10, x0, 0x123; bseti x10, x10, 63
+    check(Extension::Zbs, 0x8000000000000123, {0x1230051B, 0x2BF51513});
+
+    // addiw x10, x0, 0xFF; rori x10, x10, 4
+    check(Extension::Zbb, 0xF00000000000000F, {0x0FF0051B, 0x60455513});
+
+    // addiw x10, x0, -2048; add.uw x10, x10, x0
+    check(Extension::Zba, 0x00000000FFFFF800, {0x8000051B, 0x0805053B});
+
+    // lui x10, 0xFFF00; srli x10, x10, 20
+    check(Extension::Zba, 0x00000FFFFFFFFFFF, {0xFFF00537, 0x01455513});
+
+    // Constants that are already cheap stay the same.
+    check(Extension::Zba | Extension::Zbb | Extension::Zbs, 42, {0x02A0051B});
+}
+
+TEST_CASE("LI with extensions is never longer (RV64)", "[rv64i]") {
+    std::array<uint32_t, 8> vals{};
+    auto base = MakeAssembler64(vals);
+    auto as = MakeAssembler64(vals);
+    as.EnableExtension(Extension::Zba | Extension::Zbb | Extension::Zbs);
+
+    uint64_t state = 0x9E3779B97F4A7C15;
+    for (int i = 0; i < 1000; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        // Mix in constants with runs of zeros and ones as well.
+        const auto imm = (i % 2) == 0 ? state : (state >> (state & 63));
+
+        base.RewindBuffer();
+        base.LI(x10, imm);
+        as.RewindBuffer();
+        as.LI(x10, imm);
+
+        REQUIRE(as.GetCodeBuffer().GetCursorOffset() <= base.GetCodeBuffer().GetCursorOffset());
+    }
+}
+
+TEST_CASE("LI from literal pool (RV64)", "[rv64i]") {
+    alignas(8) std::array<uint32_t, 4> vals{};
+    auto as = MakeAssembler64(vals);
+    as.EnableOptimization(Optimization::LIFromLiteralPool);
+    as.SetLICostModel(LICostModel::Latency);
+
+    // auipc x10, 0; ld x10, 8(x10)
+    as.LI(x10, 0x9E3779B97F4A7C15);
+    as.Finalize();
+
+    REQUIRE(vals[0] == 0x00000517);
+    REQUIRE(vals[1] == 0x00853503);
+    REQUIRE(vals[2] == 0x7F4A7C15);
+    REQUIRE(vals[3] == 0x9E3779B9);
+}
+
+TEST_CASE("LI from literal pool with branch relaxation (RV64)", "[rv64i]") {
+    alignas(8) std::array<uint32_t, 16> vals{};
+    auto as = MakeAssembler64(vals);
+    as.EnableOptimization(Optimization::LIFromLiteralPool | Optimization::RelaxBranches);
+    as.SetLICostModel(LICostModel::Latency);
+
+    // While the branch is pending, the constant is built with instructions.
+    const auto label = as.NewLabel();
+    as.BEQ(x10, x11, label);
+    as.LI(x12, 0x123456789ABCDEF1);
+    as.Bind(label);
+    as.Finalize();
+
+    const auto sequence_end = as.GetCodeBuffer().GetCursorOffset();
+    REQUIRE(sequence_end > 12);
+    REQUIRE(as.GetCodeBuffer().GetSizeInBytes() == static_cast<size_t>(sequence_end));
+
+    // Once the branches are resolved, constants come from the pool again.
+    // auipc x10, 0; ld x10, 8(x10)
+    as.RewindBuffer();
+    as.LI(x10, 0x9E3779B97F4A7C15);
+    as.Finalize();
+    REQUIRE(vals[0] == 0x00000517);
+    REQUIRE(vals[1] == 0x00853503);
+}
+
+TEST_CASE("LI with scratch register (RV64)", "[rv64i]") {
+    std::array<uint32_t, 8> vals{};
+    auto as = MakeAssembler64(vals);
+
+    // Short constants don't touch the scratch register.
+    // addiw x10, x0, 42
+    as.LI(x10, 42, x11);
+    REQUIRE(vals[0] == 0x02A0051B);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 4);
+
+    // lui x11, 0x12345; lui x10, 0x9ABCE; addiw x11, x11, 0x679; addiw x10, x10, -272
+    // slli x11, x11, 32; add x10, x10, x11
+    as.RewindBuffer();
+    as.LI(x10, 0x123456789ABCDEF0, x11);
+    REQUIRE(vals[0] == 0x123455B7);
+    REQUIRE(vals[1] == 0x9ABCE537);
+    REQUIRE(vals[2] == 0x6795859B);
+    REQUIRE(vals[3] == 0xEF05051B);
+    REQUIRE(vals[4] == 0x02059593);
+    REQUIRE(vals[5] == 0x00B50533);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 24);
+
+    // lui x11, 0x12345; lui x10, 0x9ABCE; addiw x11, x11, 0x678; addiw x10, x10, -272
+    // pack x10, x10, x11
+    as.RewindBuffer();
+    as.EnableExtension(Extension::Zbkb);
+    as.LI(x10, 0x123456789ABCDEF0, x11);
+    REQUIRE(vals[0] == 0x123455B7);
+    REQUIRE(vals[1] == 0x9ABCE537);
+    REQUIRE(vals[2] == 0x6785859B);
+    REQUIRE(vals[3] == 0xEF05051B);
+    REQUIRE(vals[4] == 0x08B54533);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 20);
+}
+
 TEST_CASE("SD", "[rv64i]") {
     uint32_t value = 0;
     auto as = MakeAssembler64(value);
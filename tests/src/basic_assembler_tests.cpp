@@ -0,0 +1,220 @@
+#include <catch/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <biscuit/assembler.hpp>
+#include <biscuit/basic_assembler.hpp>
+#include <biscuit/reserved_emitter.hpp>
+
+using namespace biscuit;
+
+namespace {
+template <typename AssemblerType>
+void EmitBase(AssemblerType& as) {
+    as.ADD(a0, a0, a1);
+    as.ADD(s1, x0, a2);
+    as.ADDI(a0, a0, 1);
+    as.ADDI(sp, sp, -64);
+    as.ADDI(a0, sp, 16);
+    as.ADDI(a1, x0, 31);
+    as.ADDI(a1, a2, 2047);
+    as.AND(a0, a0, a1);
+    as.ANDI(a0, a0, 0xFF);
+    as.LUI(a0, 3);
+    as.LUI(a0, 0x12345);
+    as.MV(a0, a1);
+    as.NOP();
+    as.NOT(a0, a0);
+    as.OR(a2, a3, a4);
+    as.SEQZ(a0, a1);
+    as.SLLI(a0, a0, 7);
+    as.SRAI(a0, a0, 3);
+    as.SRLI(t0, t1, 1);
+    as.SUB(a0, a0, a1);
+    as.XOR(a0, a1, a0);
+
+    as.LBU(a0, 1, a1);
+    as.LH(a0, 2, a1);
+    as.LW(a0, 4, sp);
+    as.LW(a0, 8, a1);
+    as.LW(t0, -4, t1);
+    as.SB(a0, 3, a1);
+    as.SW(a0, 4, sp);
+    as.SW(a0, 120, a1);
+
+    as.BEQ(a0, x0, 16);
+    as.BEQZ(a1, -8);
+    as.BNE(x0, a0, 8);
+    as.BNEZ(t0, -256);
+    as.BGE(a0, a1, 64);
+    as.BLT(a0, a1, -64);
+    as.BGTU(a0, a1, 2048);
+}
+
+template <typename AssemblerType>
+void EmitRV64(AssemblerType& as) {
+    EmitBase(as);
+
+    as.ADDIW(a0, a0, 1);
+    as.ADDW(a0, a0, a1);
+    as.LD(a0, 8, sp);
+    as.LD(a0, 16, a1);
+    as.LWU(a0, 4, a1);
+    as.SD(a0, 24, sp);
+    as.SD(a0, 248, a1);
+    as.SLLI(a0, a0, 40);
+    as.SRAI(a0, a0, 33);
+    as.SRLIW(a0, a0, 3);
+    as.SUBW(a0, a0, a1);
+}
+
+void RequireSameCode(Assembler& lhs, Assembler& rhs) {
+    const auto& lhs_buffer = lhs.GetCodeBuffer();
+    const auto& rhs_buffer = rhs.GetCodeBuffer();
+    REQUIRE(lhs_buffer.GetSizeInBytes() == rhs_buffer.GetSizeInBytes());
+    REQUIRE(std::memcmp(lhs_buffer.GetOffsetPointer(0), rhs_buffer.GetOffsetPointer(0),
+                        lhs_buffer.GetSizeInBytes()) == 0);
+}
+} // Anonymous namespace
+
+TEST_CASE("BasicAssembler emits the same code as Assembler", "[basic_assembler]") {
+    SECTION("RV64 with compression") {
+        Assembler expected{1024};
+        expected.EnableOptimization(Optimization::AutoCompress);
+        EmitRV64(expected);
+
+        BasicAssembler<Xlen::RV64, CompressPolicy<>> as{1024};
+        EmitRV64(as);
+        RequireSameCode(as, expected);
+    }
+
+    SECTION("RV64 with Zcb") {
+        Assembler expected{1024};
+        expected.EnableOptimization(Optimization::AutoCompress);
+        expected.DisableExtension(Extension::Zcd | Extension::Zcf);
+        expected.EnableExtension(Extension::Zcb);
+        EmitRV64(expected);
+
+        BasicAssembler<Xlen::RV64, CompressPolicy<Extension::Zca | Extension::Zcb>> as{1024};
+        EmitRV64(as);
+        RequireSameCode(as, expected);
+    }
+
+    SECTION("RV64 without compression") {
+        Assembler expected{1024};
+        EmitRV64(expected);
+
+        BasicAssembler<Xlen::RV64, NoCompressPolicy> as{1024};
+        EmitRV64(as);
+        RequireSameCode(as, expected);
+    }
+
+    SECTION("RV32 with compression") {
+        std::array<uint8_t, 1024> expected_code{};
+        Assembler expected{expected_code.data(), expected_code.size(), ArchFeature::RV32};
+        expected.EnableOptimization(Optimization::AutoCompress);
+        EmitBase(expected);
+        expected.SLLI(a0, a0, 31);
+
+        std::array<uint8_t, 1024> code{};
+        BasicAssembler<Xlen::RV32, CompressPolicy<>> as{code.data(), code.size()};
+        EmitBase(as);
+        as.SLLI(a0, a0, 31);
+        RequireSameCode(as, expected);
+    }
+
+    SECTION("Runtime configuration") {
+        Assembler expected{1024};
+        expected.SetArchFeatures(ArchFeature::RV32);
+        expected.EnableOptimization(Optimization::AutoCompress);
+        expected.EnableExtension(Extension::Zcb);
+        EmitBase(expected);
+
+        BasicAssembler<Xlen::Runtime> as{1024};
+        as.SetArchFeatures(ArchFeature::RV32);
+        as.EnableOptimization(Optimization::AutoCompress);
+        as.EnableExtension(Extension::Zcb);
+        EmitBase(as);
+        RequireSameCode(as, expected);
+    }
+}
+
+TEST_CASE("BasicAssembler keeps the runtime configuration in sync", "[basic_assembler]") {
+    BasicAssembler<Xlen::RV32, NoCompressPolicy> as{256};
+    REQUIRE(as.GetArchFeatures() == ArchFeature::RV32);
+    REQUIRE(!as.IsOptimizationEnabled(Optimization::AutoCompress));
+    REQUIRE(as.GetEnabledExtensions() == Extension::None);
+
+    // Emitters reached through the base class and overloads that aren't
+    // specialized agree with the compile-time configuration.
+    Assembler& base = as;
+    REQUIRE(base.GetArchFeatures() == ArchFeature::RV32);
+    base.ADDI(a0, a0, 1);
+
+    Label label;
+    as.BEQ(a0, x0, &label);
+    as.Bind(&label);
+    as.LW(a0, 8, sp);
+
+    REQUIRE(as.GetCodeBuffer().GetSizeInBytes() == 12);
+
+    BasicAssembler<Xlen::RV64, CompressPolicy<>> compressed{256};
+    REQUIRE(compressed.IsOptimizationEnabled(Optimization::AutoCompress));
+    REQUIRE(compressed.GetEnabledExtensions() == (Extension::Zca | Extension::Zcd | Extension::Zcf));
+
+    compressed.EnableExtension(Extension::Zba);
+    compressed.LW(a0, 8, sp);
+    REQUIRE(compressed.GetCodeBuffer().GetSizeInBytes() == 2);
+}
+
+TEST_CASE("ReservedEmitter emits the same code as its assembler", "[basic_assembler]") {
+    // Enough room for every instruction emitted by EmitRV64() being uncompressed.
+    constexpr size_t max_instructions = 64;
+
+    SECTION("Assembler with compression") {
+        Assembler expected{1024};
+        expected.EnableOptimization(Optimization::AutoCompress);
+        expected.EnableExtension(Extension::Zcb);
+        EmitRV64(expected);
+
+        Assembler as{1024};
+        as.EnableOptimization(Optimization::AutoCompress);
+        as.EnableExtension(Extension::Zcb);
+        {
+            ReservedEmitter reserved{as, max_instructions};
+            EmitRV64(reserved);
+            REQUIRE(reserved.GetCursorOffset() == expected.GetCodeBuffer().GetCursorOffset());
+        }
+        RequireSameCode(as, expected);
+
+        // Emission continues after the reserved instructions.
+        expected.ADDI(a0, a0, 1);
+        as.ADDI(a0, a0, 1);
+        RequireSameCode(as, expected);
+    }
+
+    SECTION("Assembler without compression") {
+        Assembler expected{1024};
+        EmitRV64(expected);
+
+        Assembler as{1024};
+        {
+            ReservedEmitter reserved{as, max_instructions};
+            EmitRV64(reserved);
+        }
+        RequireSameCode(as, expected);
+    }
+
+    SECTION("BasicAssembler") {
+        Assembler expected{1024};
+        expected.EnableOptimization(Optimization::AutoCompress);
+        EmitRV64(expected);
+
+        BasicAssembler<Xlen::RV64, CompressPolicy<>> as{1024};
+        {
+            ReservedEmitter reserved{as, max_instructions};
+            EmitRV64(reserved);
+        }
+        RequireSameCode(as, expected);
+    }
+}
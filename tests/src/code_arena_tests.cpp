@@ -0,0 +1,123 @@
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <biscuit/assembler.hpp>
+#include <biscuit/code_arena.hpp>
+
+using namespace biscuit;
+
+TEST_CASE("Code arena chunks", "[code_arena]") {
+    CodeArena arena(4096, CodeBufferBacking::Default, 1024);
+    auto worker = arena.CreateWorker();
+
+    auto* as = worker.Begin(16);
+    REQUIRE(as != nullptr);
+    as->ADDI(a0, a0, 1);
+    as->RET();
+    const auto first = worker.End();
+    REQUIRE(first % 64 == 0);
+    REQUIRE(arena.GetClaimedBytes() == 1024);
+
+    // Runs that fit are placed right after each other within the same chunk.
+    as = worker.Begin(16);
+    REQUIRE(as != nullptr);
+    as->NOP();
+    const auto second = worker.End();
+    REQUIRE(second == first + 8);
+    REQUIRE(arena.GetClaimedBytes() == 1024);
+
+    // Runs that don't fit claim enough whole chunks to fit.
+    as = worker.Begin(2000);
+    REQUIRE(as != nullptr);
+    REQUIRE(worker.End() == first + 1024);
+    REQUIRE(arena.GetClaimedBytes() == 3072);
+    worker.Publish();
+
+    uint32_t value = 0;
+    std::memcpy(&value, reinterpret_cast<const void*>(first), sizeof(value));
+    REQUIRE(value == 0x00150513);
+
+    // Running out of chunks is reported rather than asserted.
+    REQUIRE(worker.Begin(4096) == nullptr);
+    REQUIRE(arena.GetClaimedBytes() == 4096);
+}
+
+TEST_CASE("Code arena runs with pooled constants", "[code_arena]") {
+    CodeArena arena(4096, CodeBufferBacking::Default, 1024);
+    auto worker = arena.CreateWorker();
+
+    auto* as = worker.Begin(64);
+    REQUIRE(as != nullptr);
+    as->LoadConstant(a0, 0x1122334455667788);
+    as->ADDI(a0, a0, 1);
+    const auto first = worker.End();
+
+    // The next run needs a new chunk, which the pending constant must not end up in.
+    as = worker.Begin(1024);
+    REQUIRE(as != nullptr);
+    as->NOP();
+    const auto second = worker.End();
+    REQUIRE(second == first + 1024);
+    worker.Publish();
+
+    std::array<uint32_t, 6> first_code{};
+    std::memcpy(first_code.data(), reinterpret_cast<const void*>(first), sizeof(first_code));
+    REQUIRE(first_code[0] == 0x00000517); // AUIPC a0, 0
+    REQUIRE(first_code[1] == 0x01053503); // LD a0, 16(a0)
+    REQUIRE(first_code[2] == 0x00150513); // ADDI a0, a0, 1
+    REQUIRE(first_code[4] == 0x55667788);
+    REQUIRE(first_code[5] == 0x11223344);
+
+    uint32_t value = 0;
+    std::memcpy(&value, reinterpret_cast<const void*>(second), sizeof(value));
+    REQUIRE(value == 0x00000013);
+}
+
+TEST_CASE("Code arena workers on multiple threads", "[code_arena]") {
+    constexpr size_t num_threads = 4;
+    constexpr size_t runs_per_thread = 256;
+
+    CodeArena arena(num_threads * runs_per_thread * 64, CodeBufferBacking::Default, 256);
+    std::vector<std::vector<uintptr_t>> entries(num_threads);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; i++) {
+        threads.emplace_back([&, i] {
+            auto worker = arena.CreateWorker();
+            for (size_t run = 0; run < runs_per_thread; run++) {
+                // Catch isn't thread-safe, so results are only checked after joining.
+                auto* as = worker.Begin(64);
+                if (as == nullptr) {
+                    break;
+                }
+                as->ADDI(a0, zero, static_cast<int32_t>(i));
+                as->RET();
+                entries[i].push_back(worker.End());
+            }
+            worker.Publish();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every thread has its own chunks, so no two runs may overlap,
+    // and every run has to contain what its own thread emitted.
+    std::vector<uintptr_t> all;
+    for (size_t i = 0; i < num_threads; i++) {
+        REQUIRE(entries[i].size() == runs_per_thread);
+        for (const auto entry : entries[i]) {
+            uint32_t value = 0;
+            std::memcpy(&value, reinterpret_cast<const void*>(entry), sizeof(value));
+            REQUIRE(value == (0x00000513 | (static_cast<uint32_t>(i) << 20)));
+            all.push_back(entry);
+        }
+    }
+
+    std::sort(all.begin(), all.end());
+    REQUIRE(std::adjacent_find(all.begin(), all.end()) == all.end());
+}
@@ -0,0 +1,284 @@
+#include <catch/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <biscuit/assembler.hpp>
+#include <biscuit/code_buffer.hpp>
+
+using namespace biscuit;
+
+TEST_CASE("Dual-mapped code buffer", "[code_buffer]") {
+    if (!CodeBuffer::IsBackingSupported(CodeBufferBacking::DualMapped)) {
+        WARN("Dual-mapped code buffers are not supported on this host");
+        return;
+    }
+
+    CodeBuffer buffer(4096, CodeBufferBacking::DualMapped);
+    REQUIRE(buffer.IsDualMapped());
+    REQUIRE(buffer.IsManaged());
+
+    buffer.Emit32(0x12345678);
+
+    // Writes through the writable view are visible through the executable view.
+    const auto* exec = reinterpret_cast<const uint8_t*>(buffer.GetOffsetAddress(0));
+    REQUIRE(exec != buffer.GetOffsetPointer(0));
+
+    uint32_t value = 0;
+    std::memcpy(&value, exec, sizeof(value));
+    REQUIRE(value == 0x12345678);
+    REQUIRE(buffer.GetCursorAddress() == buffer.GetOffsetAddress(0) + 4);
+
+    // Protection changes aren't necessary and do nothing.
+    buffer.SetExecutable();
+    buffer.SetWritable();
+    buffer.Emit32(0x9ABCDEF0);
+
+    SECTION("Growing keeps contents and addresses") {
+        const auto exec_address = buffer.GetOffsetAddress(0);
+        buffer.Grow(3 * 4096);
+        REQUIRE(buffer.GetOffsetAddress(0) == exec_address);
+        REQUIRE(buffer.GetCursorOffset() == 8);
+        REQUIRE(buffer.GetRemainingBytes() == 3 * 4096 - 8);
+
+        const auto* grown = reinterpret_cast<const uint8_t*>(buffer.GetOffsetAddress(0));
+        std::memcpy(&value, grown + 4, sizeof(value));
+        REQUIRE(value == 0x9ABCDEF0);
+    }
+
+    SECTION("Moving transfers both views") {
+        const auto exec_address = buffer.GetOffsetAddress(0);
+        CodeBuffer moved{std::move(buffer)};
+        REQUIRE(moved.IsDualMapped());
+        REQUIRE(!buffer.IsDualMapped());
+        REQUIRE(moved.GetOffsetAddress(0) == exec_address);
+        REQUIRE(moved.GetCursorOffset() == 8);
+    }
+}
+
+TEST_CASE("Assembler patches through the writable view", "[code_buffer]") {
+    if (!CodeBuffer::IsBackingSupported(CodeBufferBacking::DualMapped)) {
+        WARN("Dual-mapped code buffers are not supported on this host");
+        return;
+    }
+
+    Assembler as;
+    as.SwapCodeBuffer(CodeBuffer(4096, CodeBufferBacking::DualMapped));
+
+    Label label;
+    as.BEQ(x1, x2, &label);
+    as.NOP();
+    as.Bind(&label);
+
+    Literal<uint64_t> literal{0x1122334455667788};
+    as.LD(x5, &literal);
+    as.Place(&literal);
+
+    const auto* exec = reinterpret_cast<const uint8_t*>(as.GetCodeBuffer().GetOffsetAddress(0));
+
+    uint32_t instructions[4]{};
+    std::memcpy(instructions, exec, sizeof(instructions));
+    REQUIRE(instructions[0] == 0x00208463); // BEQ x1, x2, 8
+    REQUIRE(instructions[2] == 0x00000297); // AUIPC x5, 0
+    REQUIRE(instructions[3] == 0x0082B283); // LD x5, 8(x5)
+}
+
+TEST_CASE("Reserved emission", "[code_buffer]") {
+    std::array<uint32_t, 4> data{};
+    CodeBuffer buffer(reinterpret_cast<uint8_t*>(data.data()), sizeof(data));
+    buffer.Emit32(0x11111111);
+
+    {
+        auto reservation = buffer.Reserve(3 * sizeof(uint32_t));
+        REQUIRE(reservation.GetCursorOffset() == 4);
+
+        reservation.Emit32(0x22222222);
+        reservation.Emit16(0x3333);
+        reservation.Emit16(0x4444);
+        REQUIRE(reservation.GetCursorOffset() == 12);
+
+        // The buffer's cursor is only updated once the reservation ends.
+        REQUIRE(buffer.GetCursorOffset() == 4);
+    }
+
+    REQUIRE(buffer.GetCursorOffset() == 12);
+    REQUIRE(data[0] == 0x11111111);
+    REQUIRE(data[1] == 0x22222222);
+    REQUIRE(data[2] == 0x44443333);
+
+    {
+        // Reservations don't need to be used up entirely.
+        auto reservation = buffer.Reserve(sizeof(uint32_t));
+    }
+    REQUIRE(buffer.GetCursorOffset() == 12);
+    REQUIRE(buffer.GetRemainingBytes() == 4);
+}
+
+TEST_CASE("Auto-growing heap code buffer", "[code_buffer]") {
+    Assembler as(16);
+    as.GetCodeBuffer().SetAutoGrow(true);
+
+    // Link a label and a literal before the buffer grows.
+    Label label;
+    Literal<uint64_t> literal{0x1122334455667788};
+    as.BEQ(x1, x2, &label);
+    as.LD(x5, &literal);
+    for (int i = 0; i < 1000; i++) {
+        as.NOP();
+    }
+    as.Bind(&label);
+    as.Place(&literal);
+
+    auto& buffer = as.GetCodeBuffer();
+    REQUIRE(buffer.GetSizeInBytes() == 4 + 8 + 4000 + 8);
+
+    uint32_t instructions[3]{};
+    std::memcpy(instructions, buffer.GetOffsetPointer(0), sizeof(instructions));
+    REQUIRE(instructions[0] == 0x7A2086E3); // BEQ x1, x2, 4012
+    REQUIRE(instructions[1] == 0x00001297); // AUIPC x5, 1
+    REQUIRE(instructions[2] == 0xFA82B283); // LD x5, -88(x5)
+}
+
+TEST_CASE("Auto-growing reserved code buffer", "[code_buffer]") {
+    if (!CodeBuffer::IsBackingSupported(CodeBufferBacking::Reserved)) {
+        WARN("Reserved code buffers are not supported on this host");
+        return;
+    }
+
+    CodeBuffer buffer(4096, CodeBufferBacking::Reserved, 1024 * 1024);
+    buffer.SetAutoGrow(true);
+    REQUIRE(buffer.GetBacking() == CodeBufferBacking::Reserved);
+
+    const auto* start = buffer.GetOffsetPointer(0);
+    for (uint32_t i = 0; i < 16384; i++) {
+        buffer.Emit32(i);
+    }
+
+    // Growing only commits memory, so the buffer never moves.
+    REQUIRE(buffer.GetOffsetPointer(0) == start);
+    REQUIRE(buffer.GetSizeInBytes() == 16384 * 4);
+
+    uint32_t value = 0;
+    std::memcpy(&value, buffer.GetOffsetPointer(4 * 4096), sizeof(value));
+    REQUIRE(value == 4096);
+
+    // Reservations grow the buffer as well.
+    auto reservation = buffer.Reserve(64 * 1024);
+    reservation.Emit32(0xFFFFFFFF);
+}
+
+TEST_CASE("Dirty range tracking", "[code_buffer]") {
+    CodeBuffer buffer(64 * 1024);
+    REQUIRE(!buffer.HasDirtyRanges());
+
+    // Emitted code is dirty up until it gets flushed.
+    buffer.Emit32(0x00000013);
+    buffer.Emit32(0x00000013);
+    REQUIRE(buffer.HasDirtyRanges());
+    {
+        const auto ranges = buffer.GetDirtyRanges();
+        REQUIRE(ranges.size() == 1);
+        REQUIRE(ranges[0].offset == 0);
+        REQUIRE(ranges[0].size == 8);
+    }
+    REQUIRE(buffer.FlushICache() == 1);
+    REQUIRE(!buffer.HasDirtyRanges());
+    REQUIRE(buffer.FlushICache() == 0);
+
+    SECTION("Patches are tracked separately from emission") {
+        buffer.AdvanceCursor(0x8000);
+        buffer.Emit32(0x00000013);
+        buffer.MarkDirty(4, 4);
+
+        const auto ranges = buffer.GetDirtyRanges();
+        REQUIRE(ranges.size() == 2);
+        REQUIRE(ranges[0].offset == 4);
+        REQUIRE(ranges[0].size == 4);
+        REQUIRE(ranges[1].offset == 0x8000);
+        REQUIRE(ranges[1].size == 4);
+        REQUIRE(buffer.FlushICache() == 2);
+    }
+
+    SECTION("Patches within unflushed code are already covered") {
+        buffer.Emit32(0x00000013);
+        buffer.Emit32(0x00000013);
+        buffer.MarkDirty(8, 4);
+
+        const auto ranges = buffer.GetDirtyRanges();
+        REQUIRE(ranges.size() == 1);
+        REQUIRE(ranges[0].offset == 8);
+        REQUIRE(ranges[0].size == 8);
+    }
+
+    SECTION("Nearby ranges are coalesced") {
+        // Blocks emitted out of order with small gaps in between end up as one flush.
+        for (const ptrdiff_t offset : {0x300, 0x100, 0x200, 0x1000}) {
+            buffer.AdvanceCursor(offset);
+            buffer.Emit32(0x00000013);
+            buffer.RewindCursor(0x10);
+        }
+
+        const auto ranges = buffer.GetDirtyRanges();
+        REQUIRE(ranges.size() == 1);
+        REQUIRE(ranges[0].offset == 0x100);
+        REQUIRE(ranges[0].size == 0xF04);
+    }
+
+    SECTION("Re-emitting after rewinding doesn't accumulate ranges") {
+        for (int i = 0; i < 1000; i++) {
+            buffer.RewindCursor();
+            buffer.Emit32(0x00000013);
+            buffer.Emit32(0x00000013);
+        }
+        REQUIRE(buffer.FlushICache() == 1);
+    }
+}
+
+TEST_CASE("Assembler patches are tracked as dirty", "[code_buffer]") {
+    Assembler as(64 * 1024);
+    auto& buffer = as.GetCodeBuffer();
+
+    Label label;
+    as.J(&label);
+    buffer.FlushICache();
+
+    // Binding the label much later patches the flushed jump.
+    as.AdvanceBuffer(0x8000);
+    as.Bind(&label);
+    as.NOP();
+
+    const auto ranges = buffer.GetDirtyRanges();
+    REQUIRE(ranges.size() == 2);
+    REQUIRE(ranges[0].offset == 0);
+    REQUIRE(ranges[0].size == 4);
+    REQUIRE(ranges[1].offset == 0x8000);
+}
+
+TEST_CASE("Huge page backed code buffer", "[code_buffer]") {
+    if (!CodeBuffer::IsBackingSupported(CodeBufferBacking::HugePages)) {
+        WARN("Huge page backed code buffers are not supported on this host");
+        return;
+    }
+
+    CodeBuffer buffer(4096, CodeBufferBacking::HugePages, 8 * CodeBuffer::huge_page_size);
+    const auto address = buffer.GetOffsetAddress(0);
+
+    // Whole huge pages are committed and aligned, regardless of the page size requested.
+    REQUIRE(address % CodeBuffer::huge_page_size == 0);
+    REQUIRE(buffer.GetRemainingBytes() == CodeBuffer::huge_page_size);
+    REQUIRE((buffer.GetRequestedPageSize() == CodeBuffer::huge_page_size ||
+             buffer.GetRequestedPageSize() < CodeBuffer::huge_page_size));
+    REQUIRE((!buffer.IsUsingExplicitHugePages() ||
+             buffer.GetRequestedPageSize() == CodeBuffer::huge_page_size));
+
+    buffer.Emit32(0x12345678);
+    buffer.Grow(3 * CodeBuffer::huge_page_size - 1);
+    REQUIRE(buffer.GetOffsetAddress(0) == address);
+    REQUIRE(buffer.GetRemainingBytes() == 3 * CodeBuffer::huge_page_size - 4);
+
+    buffer.SetExecutable();
+    buffer.SetWritable();
+
+    uint32_t value = 0;
+    std::memcpy(&value, buffer.GetOffsetPointer(0), sizeof(value));
+    REQUIRE(value == 0x12345678);
+}
@@ -0,0 +1,388 @@
+#include <catch/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <biscuit/assembler.hpp>
+#include <biscuit/code_cache.hpp>
+
+#include "assembler_test_utils.hpp"
+
+using namespace biscuit;
+
+namespace {
+std::string GetTempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void WriteFile(const std::string& path, const std::vector<uint8_t>& data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+void HostFunction() {}
+} // Anonymous namespace
+
+TEST_CASE("Relocated LI round-trips any value", "[code_cache]") {
+    std::array<uint32_t, 8> data{};
+    auto as = MakeAssembler64(data);
+
+    std::vector<uint64_t> values = {
+        0,
+        1,
+        0x7FF,
+        0x800,
+        0xFFFFFFFF,
+        0x7FFFFFFF80000000,
+        0x0000FFFFFFFFF800,
+        std::numeric_limits<uint64_t>::max(),
+        static_cast<uint64_t>(std::numeric_limits<int64_t>::min()),
+        static_cast<uint64_t>(std::numeric_limits<int64_t>::max()),
+    };
+
+    std::mt19937_64 rng{1234};
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(rng());
+    }
+
+    as.LI(a0, SymbolReference{0, 0});
+    REQUIRE(as.GetRelocations().size() == 1);
+    REQUIRE(as.GetCodeBuffer().GetCursorOffset() == 32);
+
+    const auto relocation = as.GetRelocations()[0];
+    auto* const code = reinterpret_cast<uint8_t*>(data.data());
+    const auto code_address = reinterpret_cast<uint64_t>(code);
+
+    for (const auto value : values) {
+        ApplyRelocation(code, code_address, relocation, value);
+        REQUIRE(ReadRelocationTarget(code, code_address, relocation) == value);
+    }
+
+    // The destination register is preserved in every instruction of the sequence.
+    for (const auto instruction : data) {
+        REQUIRE(((instruction >> 7) & 0x1F) == 10);
+    }
+}
+
+TEST_CASE("Relocated CALL", "[code_cache]") {
+    std::array<uint32_t, 2> data{};
+    auto as = MakeAssembler64(data);
+
+    const auto code_address = reinterpret_cast<uint64_t>(data.data());
+    as.CALL(SymbolReference{3, code_address, 0x1234});
+
+    REQUIRE(data[0] == 0x00001097); // AUIPC ra, 1
+    REQUIRE(data[1] == 0x234080E7); // JALR ra, 0x234(ra)
+
+    const auto relocation = as.GetRelocations()[0];
+    REQUIRE(relocation.offset == 0);
+    REQUIRE(relocation.kind == RelocationKind::PCRelativePair);
+    REQUIRE(relocation.symbol == 3);
+    REQUIRE(relocation.addend == 0x1234);
+
+    auto* const code = reinterpret_cast<uint8_t*>(data.data());
+    ApplyRelocation(code, code_address, relocation, code_address - 0x800);
+    REQUIRE(data[0] == 0x00000097); // AUIPC ra, 0
+    REQUIRE(data[1] == 0x800080E7); // JALR ra, -2048(ra)
+    REQUIRE(ReadRelocationTarget(code, code_address, relocation) == code_address - 0x800);
+}
+
+TEST_CASE("Relocations survive branch relaxation", "[code_cache]") {
+    std::array<uint32_t, 1300> data{};
+    auto as = MakeAssembler64(data);
+    as.EnableOptimization(Optimization::RelaxBranches);
+
+    const auto target = reinterpret_cast<uint64_t>(data.data()) + 0x10000;
+
+    const auto label = as.NewLabel();
+    as.BEQ(x10, x11, label);
+    as.CALL(SymbolReference{0, target});
+    as.EmitAddress(SymbolReference{1, 0x1122334455667788});
+    for (int i = 0; i < 1250; i++) {
+        as.NOP();
+    }
+    as.Bind(label);
+    as.Finalize();
+
+    // The branch was relaxed into two instructions, moving everything after it.
+    const auto relocations = as.GetRelocations();
+    REQUIRE(relocations.size() == 2);
+    REQUIRE(relocations[0].offset == 8);
+    REQUIRE(relocations[1].offset == 16);
+
+    auto* const code = reinterpret_cast<uint8_t*>(data.data());
+    const auto code_address = reinterpret_cast<uint64_t>(code);
+    REQUIRE(ReadRelocationTarget(code, code_address, relocations[0]) == target);
+    REQUIRE(ReadRelocationTarget(code, code_address, relocations[1]) == 0x1122334455667788);
+}
+
+TEST_CASE("Relocate to a new address", "[code_cache]") {
+    std::array<uint32_t, 32> src{};
+    std::array<uint32_t, 32> dst{};
+    auto as = MakeAssembler64(src);
+
+    const auto src_address = reinterpret_cast<uint64_t>(src.data());
+    const auto dst_address = reinterpret_cast<uint64_t>(dst.data());
+    const auto delta = static_cast<ptrdiff_t>(dst_address - src_address);
+    const auto host_function = src_address + 0x100000;
+
+    const auto label = as.NewLabel();
+    as.CALL(SymbolReference::Absolute(host_function));
+    as.LI(a0, SymbolReference{code_base_symbol, src_address, 64});
+    as.J(label);
+    as.ADDI(a0, a0, 1);
+    as.Bind(label);
+    as.RET();
+    as.EmitAddress(SymbolReference{code_base_symbol, src_address});
+    as.EmitAddress(SymbolReference{0, 0x1000});
+
+    const auto size = as.GetCodeBuffer().GetSizeInBytes();
+    const auto relocations = as.GetRelocations();
+    REQUIRE(relocations.size() == 4);
+
+    auto* const dst_code = reinterpret_cast<uint8_t*>(dst.data());
+    REQUIRE(Relocate(dst_code, reinterpret_cast<const uint8_t*>(src.data()), size, src_address, delta, relocations));
+
+    // External references keep their targets, internal ones move along with the code.
+    REQUIRE(ReadRelocationTarget(dst_code, dst_address, relocations[0]) == host_function);
+    REQUIRE(ReadRelocationTarget(dst_code, dst_address, relocations[1]) == dst_address + 64);
+    REQUIRE(ReadRelocationTarget(dst_code, dst_address, relocations[2]) == dst_address);
+    REQUIRE(ReadRelocationTarget(dst_code, dst_address, relocations[3]) == 0x1000);
+
+    // Position-independent code is copied verbatim.
+    REQUIRE(dst[10] == src[10]);
+    REQUIRE(dst[11] == src[11]);
+    REQUIRE(dst[12] == src[12]);
+}
+
+TEST_CASE("Relocate within overlapping memory", "[code_cache]") {
+    std::array<uint32_t, 64> data{};
+    auto* const code = reinterpret_cast<uint8_t*>(data.data());
+    const auto code_address = reinterpret_cast<uint64_t>(code);
+
+    // Emit into the back half, then slide it down by only a few bytes,
+    // so that every relocated sequence overlaps its own destination.
+    auto as = Assembler{code + 12, 128, ArchFeature::RV64};
+    const auto src_address = code_address + 12;
+    const auto host_function = code_address - 0x4000;
+
+    as.CALL(SymbolReference::Absolute(host_function));
+    as.LI(a1, SymbolReference{code_base_symbol, src_address, 8});
+    as.CALL(SymbolReference::Absolute(host_function));
+    as.EmitAddress(SymbolReference{code_base_symbol, src_address, 4});
+    as.RET();
+
+    const auto size = as.GetCodeBuffer().GetSizeInBytes();
+    const std::vector<Relocation> relocations(as.GetRelocations().begin(), as.GetRelocations().end());
+
+    REQUIRE(Relocate(code, code + 12, size, src_address, -12, relocations));
+
+    REQUIRE(ReadRelocationTarget(code, code_address, relocations[0]) == host_function);
+    REQUIRE(ReadRelocationTarget(code, code_address, relocations[1]) == code_address + 8);
+    REQUIRE(ReadRelocationTarget(code, code_address, relocations[2]) == host_function);
+    REQUIRE(ReadRelocationTarget(code, code_address, relocations[3]) == code_address + 4);
+    REQUIRE(data[size / 4 - 1] == 0x00008067);
+}
+
+TEST_CASE("Relocate rejects references that go out of range", "[code_cache]") {
+    std::array<uint32_t, 16> src{};
+    std::array<uint32_t, 16> dst{};
+    auto as = MakeAssembler64(src);
+
+    const auto src_address = reinterpret_cast<uint64_t>(src.data());
+    const auto host_function = src_address + 0x1000;
+    const auto far_away = ptrdiff_t{1} << 40;
+
+    as.CALL(SymbolReference::Absolute(host_function));
+    as.RET();
+    auto relocations = as.GetRelocations();
+    auto* const dst_code = reinterpret_cast<uint8_t*>(dst.data());
+    const auto* const src_code = reinterpret_cast<const uint8_t*>(src.data());
+
+    // The AUIPC+JALR pair can't reach the host function from 1TB away.
+    REQUIRE(!Relocate(dst_code, src_code, as.GetCodeBuffer().GetSizeInBytes(), src_address, far_away, relocations));
+    REQUIRE(dst == std::array<uint32_t, 16>{});
+
+    // Calling through a register reaches it from anywhere.
+    as.RewindBuffer();
+    as.ClearRelocations();
+    as.CALL(SymbolReference::Absolute(host_function), t0);
+    as.RET();
+    relocations = as.GetRelocations();
+    REQUIRE(relocations.size() == 1);
+    REQUIRE(relocations[0].kind == RelocationKind::AbsoluteLI);
+
+    REQUIRE(Relocate(dst_code, src_code, as.GetCodeBuffer().GetSizeInBytes(), src_address, far_away, relocations));
+    REQUIRE(ReadRelocationTarget(dst_code, src_address + static_cast<uint64_t>(far_away), relocations[0]) ==
+            host_function);
+    REQUIRE(dst[8] == 0x000280E7); // JALR ra, 0(t0)
+}
+
+TEST_CASE("Code cache round-trip", "[code_cache]") {
+    const auto path = GetTempPath("biscuit_code_cache_round_trip.bin");
+
+    std::array<uint32_t, 32> data{};
+    auto as = MakeAssembler64(data);
+    const auto key = CodeCacheKey::For(as, 42);
+
+    const auto start = as.GetCodeBuffer().GetCursorAddress();
+    as.LI(a0, SymbolReference{0, 0xDEADBEEF, 8});
+    as.LI(a1, SymbolReference{code_base_symbol, start, 4});
+    as.RET();
+    as.EmitAddress(SymbolReference{1, 0x1000});
+    REQUIRE(WriteCodeCache(path.c_str(), as, key));
+
+    // Symbols end up at different addresses in the loading process.
+    const std::array<uint64_t, 2> symbols = {0x123456789A, 0x2000};
+
+    CodeCacheError error = CodeCacheError::IOError;
+    auto cache = CodeCache::Load(path.c_str(), key, symbols, &error);
+    REQUIRE(error == CodeCacheError::None);
+    REQUIRE(cache.has_value());
+    REQUIRE(cache->GetSizeInBytes() == 76);
+    REQUIRE(cache->GetRelocations().size() == 3);
+
+    const auto* const code = reinterpret_cast<const uint8_t*>(cache->GetOffsetAddress(0));
+    const auto code_address = cache->GetOffsetAddress(0);
+    const auto relocations = cache->GetRelocations();
+    REQUIRE(ReadRelocationTarget(code, code_address, relocations[0]) == 0x123456789A + 8);
+    REQUIRE(ReadRelocationTarget(code, code_address, relocations[1]) == code_address + 4);
+    REQUIRE(ReadRelocationTarget(code, code_address, relocations[2]) == 0x2000);
+
+    // Unrelocated code is loaded as-is.
+    uint32_t ret = 0;
+    std::memcpy(&ret, code + 64, sizeof(ret));
+    REQUIRE(ret == 0x00008067);
+
+    // A missing symbol is reported instead of being silently left alone.
+    REQUIRE(!CodeCache::Load(path.c_str(), key, std::span(symbols).first(1), &error).has_value());
+    REQUIRE(error == CodeCacheError::UnresolvedSymbol);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Code cache round-trip with a host call", "[code_cache]") {
+    const auto path = GetTempPath("biscuit_code_cache_host_call.bin");
+
+    std::array<uint32_t, 16> data{};
+    auto as = MakeAssembler64(data);
+    const auto key = CodeCacheKey::For(as, 7);
+
+    as.CALL(SymbolReference::Unresolved(0));
+    as.RET();
+    REQUIRE(WriteCodeCache(path.c_str(), as, key));
+
+    // Whether the host function is within 2GB of the mapping depends on where the
+    // system places it, but either way the file is loaded or rejected, never aborted on.
+    const auto host_function = reinterpret_cast<uint64_t>(&HostFunction);
+    CodeCacheError error = CodeCacheError::IOError;
+    auto cache = CodeCache::Load(path.c_str(), key, std::array{host_function}, &error);
+    if (cache.has_value()) {
+        REQUIRE(error == CodeCacheError::None);
+
+        const auto* const code = reinterpret_cast<const uint8_t*>(cache->GetOffsetAddress(0));
+        const auto code_address = cache->GetOffsetAddress(0);
+        REQUIRE(ReadRelocationTarget(code, code_address, cache->GetRelocations()[0]) == host_function);
+    } else {
+        REQUIRE(error == CodeCacheError::RelocationOutOfRange);
+    }
+
+    // Addresses that no user space mapping is within 2GB of are always rejected.
+    const auto unreachable = uint64_t{1} << 63;
+    REQUIRE(!CodeCache::Load(path.c_str(), key, std::array{unreachable}, &error).has_value());
+    REQUIRE(error == CodeCacheError::RelocationOutOfRange);
+
+    // Calling through a register reaches the host function from wherever the file is mapped.
+    as.RewindBuffer();
+    as.ClearRelocations();
+    as.CALL(SymbolReference::Absolute(host_function), t0);
+    as.RET();
+    REQUIRE(WriteCodeCache(path.c_str(), as, key));
+
+    cache = CodeCache::Load(path.c_str(), key, {}, &error);
+    REQUIRE(error == CodeCacheError::None);
+    REQUIRE(cache.has_value());
+
+    const auto* const code = reinterpret_cast<const uint8_t*>(cache->GetOffsetAddress(0));
+    REQUIRE(ReadRelocationTarget(code, cache->GetOffsetAddress(0), cache->GetRelocations()[0]) == host_function);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Code cache rejects mismatching files", "[code_cache]") {
+    const auto path = GetTempPath("biscuit_code_cache_reject.bin");
+
+    std::array<uint32_t, 8> data{};
+    auto as = MakeAssembler64(data);
+    const auto key = CodeCacheKey::For(as, 1);
+
+    as.ADDI(a0, a0, 1);
+    as.RET();
+    const auto file = SerializeCodeCache(as, key);
+    REQUIRE(file.size() == 72);
+
+    CodeCacheError error = CodeCacheError::None;
+
+    SECTION("Missing file") {
+        REQUIRE(!CodeCache::Load(GetTempPath("biscuit_no_such_file.bin").c_str(), key, {}, &error).has_value());
+        REQUIRE(error == CodeCacheError::IOError);
+    }
+
+    SECTION("Different key") {
+        WriteFile(path, file);
+
+        auto other_key = key;
+        other_key.user_tag = 2;
+        REQUIRE(!CodeCache::Load(path.c_str(), other_key, {}, &error).has_value());
+        REQUIRE(error == CodeCacheError::KeyMismatch);
+
+        other_key = key;
+        other_key.extensions = Extension::Zba;
+        REQUIRE(!CodeCache::Load(path.c_str(), other_key, {}, &error).has_value());
+        REQUIRE(error == CodeCacheError::KeyMismatch);
+
+        REQUIRE(CodeCache::Load(path.c_str(), key, {}, &error).has_value());
+        REQUIRE(error == CodeCacheError::None);
+    }
+
+    SECTION("Corrupted code") {
+        auto corrupted = file;
+        corrupted[64] ^= 1;
+        WriteFile(path, corrupted);
+
+        REQUIRE(!CodeCache::Load(path.c_str(), key, {}, &error).has_value());
+        REQUIRE(error == CodeCacheError::ChecksumMismatch);
+    }
+
+    SECTION("Different version") {
+        auto outdated = file;
+        outdated[12] ^= 1;
+        WriteFile(path, outdated);
+
+        REQUIRE(!CodeCache::Load(path.c_str(), key, {}, &error).has_value());
+        REQUIRE(error == CodeCacheError::VersionMismatch);
+    }
+
+    SECTION("Truncated file") {
+        auto truncated = file;
+        truncated.resize(68);
+        WriteFile(path, truncated);
+
+        REQUIRE(!CodeCache::Load(path.c_str(), key, {}, &error).has_value());
+        REQUIRE(error == CodeCacheError::InvalidFormat);
+    }
+
+    SECTION("Not a code cache") {
+        WriteFile(path, std::vector<uint8_t>(128, 0xAB));
+
+        REQUIRE(!CodeCache::Load(path.c_str(), key, {}, &error).has_value());
+        REQUIRE(error == CodeCacheError::InvalidFormat);
+    }
+
+    std::filesystem::remove(path);
+}
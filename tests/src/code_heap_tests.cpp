@@ -0,0 +1,180 @@
+#include <catch/catch.hpp>
+
+#include <cstring>
+#include <vector>
+#include <biscuit/assembler.hpp>
+#include <biscuit/code_heap.hpp>
+
+using namespace biscuit;
+
+TEST_CASE("Code heap allocation", "[code_heap]") {
+    CodeHeap heap(4096);
+
+    const auto a = heap.Allocate(10);
+    const auto b = heap.Allocate(100);
+    REQUIRE(a.has_value());
+    REQUIRE(b.has_value());
+
+    // Sizes are rounded up to the alignment and blocks are aligned.
+    REQUIRE(heap.GetSize(*a) == 64);
+    REQUIRE(heap.GetSize(*b) == 128);
+    REQUIRE(heap.GetAddress(*a) % CodeHeap::default_alignment == 0);
+    REQUIRE(heap.GetAddress(*b) % CodeHeap::default_alignment == 0);
+    REQUIRE(heap.GetUsedBytes() == 192);
+    REQUIRE(heap.GetNumLiveBlocks() == 2);
+
+    // Nothing is evicted when there's no room left.
+    REQUIRE(!heap.Allocate(4096).has_value());
+    REQUIRE(heap.IsLive(*a));
+    REQUIRE(heap.IsLive(*b));
+}
+
+TEST_CASE("Code heap coalescing", "[code_heap]") {
+    CodeHeap heap(4096);
+
+    const auto a = *heap.Allocate(1024);
+    const auto b = *heap.Allocate(1024);
+    const auto c = *heap.Allocate(1024);
+    const auto d = *heap.Allocate(1024);
+    REQUIRE(!heap.Allocate(64).has_value());
+
+    // Freeing the middle blocks in either order has to yield one free range
+    // that a block of the combined size can be allocated from.
+    heap.Free(b);
+    heap.Free(c);
+    REQUIRE(!heap.IsLive(b));
+    REQUIRE(!heap.IsLive(c));
+
+    const auto bc = heap.Allocate(2048);
+    REQUIRE(bc.has_value());
+    heap.Free(*bc);
+
+    heap.Free(a);
+    heap.Free(d);
+    REQUIRE(heap.GetUsedBytes() == 0);
+
+    const auto all = heap.Allocate(4096);
+    REQUIRE(all.has_value());
+
+    // Handles to freed blocks stay stale even when the same memory is handed out again.
+    REQUIRE(!heap.IsLive(a));
+    REQUIRE(!heap.IsLive(*bc));
+}
+
+TEST_CASE("Code heap shrinking", "[code_heap]") {
+    CodeHeap heap(4096);
+
+    const auto block = *heap.Allocate(4096);
+    heap.Shrink(block, 100);
+    REQUIRE(heap.GetSize(block) == 128);
+    REQUIRE(heap.GetUsedBytes() == 128);
+
+    const auto rest = heap.Allocate(4096 - 128);
+    REQUIRE(rest.has_value());
+    REQUIRE(heap.GetAddress(*rest) == heap.GetAddress(block) + 128);
+}
+
+TEST_CASE("Code heap LRU eviction", "[code_heap]") {
+    CodeHeap heap(4096);
+    heap.SetEvictionPolicy(CodeHeapEviction::LeastRecentlyUsed);
+
+    std::vector<CodeBlockHandle> evicted;
+    heap.SetEvictionCallback([&](CodeBlockHandle block) {
+        REQUIRE(heap.IsLive(block));
+        evicted.push_back(block);
+    });
+
+    const auto a = heap.AllocateOrEvict(1024);
+    const auto b = heap.AllocateOrEvict(1024);
+    const auto c = heap.AllocateOrEvict(1024);
+    const auto d = heap.AllocateOrEvict(1024);
+    REQUIRE(evicted.empty());
+
+    // a is now the most recently used block, leaving b as the first to go.
+    heap.Touch(a);
+    const auto e = heap.AllocateOrEvict(1024);
+    REQUIRE(evicted == std::vector{b});
+    REQUIRE(heap.IsLive(a));
+    REQUIRE(heap.IsLive(e));
+
+    // Needing two adjacent blocks evicts until they become free, c and d being next in line.
+    evicted.clear();
+    const auto f = heap.AllocateOrEvict(2048);
+    REQUIRE(evicted == std::vector{c, d});
+    REQUIRE(heap.IsLive(f));
+    REQUIRE(heap.GetNumEvictions() == 3);
+}
+
+TEST_CASE("Code heap generational eviction", "[code_heap]") {
+    CodeHeap heap(4096);
+    heap.SetEvictionPolicy(CodeHeapEviction::Generation);
+
+    const auto a = heap.AllocateOrEvict(1024);
+    const auto b = heap.AllocateOrEvict(1024);
+    REQUIRE(heap.NextGeneration() == 1);
+    const auto c = heap.AllocateOrEvict(1024);
+    const auto d = heap.AllocateOrEvict(1024);
+    REQUIRE(heap.GetGeneration(a) == 0);
+    REQUIRE(heap.GetGeneration(d) == 1);
+
+    // Touching doesn't affect the eviction order of generations.
+    heap.Touch(a);
+
+    // The whole oldest generation is flushed at once, even if a single block would do.
+    const auto e = heap.AllocateOrEvict(64);
+    REQUIRE(!heap.IsLive(a));
+    REQUIRE(!heap.IsLive(b));
+    REQUIRE(heap.IsLive(c));
+    REQUIRE(heap.IsLive(d));
+    REQUIRE(heap.IsLive(e));
+    REQUIRE(heap.GetNumEvictions() == 2);
+}
+
+TEST_CASE("Code heap block views", "[code_heap]") {
+    CodeHeap heap(4096);
+
+    const auto a = *heap.Allocate(64);
+    const auto b = *heap.Allocate(64);
+    heap.SetUserData(b, 0x1000);
+    REQUIRE(heap.GetUserData(a) == 0);
+    REQUIRE(heap.GetUserData(b) == 0x1000);
+
+    auto as = heap.GetAssembler(b);
+    as.ADDI(a0, a0, 1);
+    as.RET();
+
+    auto& buffer = as.GetCodeBuffer();
+    REQUIRE(!buffer.IsManaged());
+    REQUIRE(buffer.GetRemainingBytes() == 56);
+    REQUIRE(buffer.GetOffsetAddress(0) == heap.GetAddress(b));
+
+    uint32_t value = 0;
+    std::memcpy(&value, heap.GetPointer(b), sizeof(value));
+    REQUIRE(value == 0x00150513);
+
+    // Emitting into one block leaves its neighbour untouched.
+    std::memcpy(&value, heap.GetPointer(a), sizeof(value));
+    REQUIRE(value != 0x00150513);
+}
+
+TEST_CASE("Dual-mapped code heap", "[code_heap]") {
+    if (!CodeBuffer::IsBackingSupported(CodeBufferBacking::DualMapped)) {
+        WARN("Dual-mapped code buffers are not supported on this host");
+        return;
+    }
+
+    CodeHeap heap(64 * 1024, CodeBufferBacking::DualMapped);
+    const auto block = *heap.Allocate(256);
+
+    auto buffer = heap.GetCodeBuffer(block);
+    buffer.Emit32(0x12345678);
+
+    // Blocks are written through the writable view and addressed through the executable one.
+    const auto* exec = reinterpret_cast<const uint8_t*>(heap.GetAddress(block));
+    REQUIRE(exec != heap.GetPointer(block));
+    REQUIRE(buffer.GetCursorAddress() == heap.GetAddress(block) + 4);
+
+    uint32_t value = 0;
+    std::memcpy(&value, exec, sizeof(value));
+    REQUIRE(value == 0x12345678);
+}
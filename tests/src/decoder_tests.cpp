@@ -0,0 +1,2051 @@
+#include <catch/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <span>
+#include <sstream>
+#include <string>
+#include <biscuit/assembler.hpp>
+#include <biscuit/decoder.hpp>
+
+using namespace biscuit;
+
+// Prints decoded instructions in failed assertions.
+namespace Catch {
+template <>
+struct StringMaker<DecodedInstruction> {
+    static std::string convert(const DecodedInstruction& insn) {
+        std::ostringstream stream;
+        stream << Decoder::GetName(insn.id) << " length=" << int{insn.length}
+               << " rd=" << int{insn.rd} << " rs1=" << int{insn.rs1}
+               << " rs2=" << int{insn.rs2} << " rs3=" << int{insn.rs3}
+               << " modifier=" << int{insn.modifier} << " imm=" << insn.imm;
+        return stream.str();
+    }
+};
+} // namespace Catch
+
+namespace {
+struct DecodeCase {
+    void (*emit)(Assembler&);
+    DecodedInstruction expected;
+};
+
+// Every entry of the decoder table, emitted through the Assembler with operands
+// that exercise as many bits of each field as possible.
+constexpr std::array<DecodeCase, 904> rv64_cases{{
+    {[](Assembler& as) { as.ADD(x21, x14, x27); },
+     {InstructionId::ADD, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.ADDI(x21, x14, -1); },
+     {InstructionId::ADDI, 4, 21, 14, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.ADDIW(x21, x14, -1); },
+     {InstructionId::ADDIW, 4, 21, 14, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.ADDUW(x21, x14, x27); },
+     {InstructionId::ADDUW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.ADDW(x21, x14, x27); },
+     {InstructionId::ADDW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.AES64DS(x21, x14, x27); },
+     {InstructionId::AES64DS, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.AES64DSM(x21, x14, x27); },
+     {InstructionId::AES64DSM, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.AES64ES(x21, x14, x27); },
+     {InstructionId::AES64ES, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.AES64ESM(x21, x14, x27); },
+     {InstructionId::AES64ESM, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.AES64IM(x21, x14); },
+     {InstructionId::AES64IM, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.AES64KS1I(x21, x14, 7); },
+     {InstructionId::AES64KS1I, 4, 21, 14, 0, 0, 0, 7}},
+    {[](Assembler& as) { as.AES64KS2(x21, x14, x27); },
+     {InstructionId::AES64KS2, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.AMOADD_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOADD_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOADD_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOADD_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOADD_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOADD_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOADD_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOADD_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOAND_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOAND_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOAND_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOAND_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOAND_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOAND_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOAND_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOAND_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOCAS_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOCAS_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOCAS_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOCAS_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOCAS_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOCAS_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOCAS_Q(Ordering::AQRL, x14, x12, x5); },
+     {InstructionId::AMOCAS_Q, 4, 14, 5, 12, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOCAS_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOCAS_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMAXU_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMAXU_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMAXU_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMAXU_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMAXU_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMAXU_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMAXU_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMAXU_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMAX_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMAX_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMAX_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMAX_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMAX_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMAX_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMAX_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMAX_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMINU_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMINU_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMINU_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMINU_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMINU_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMINU_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMINU_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMINU_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMIN_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMIN_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMIN_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMIN_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMIN_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMIN_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOMIN_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOMIN_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOOR_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOOR_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOOR_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOOR_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOOR_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOOR_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOOR_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOOR_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOSWAP_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOSWAP_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOSWAP_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOSWAP_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOSWAP_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOSWAP_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOSWAP_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOSWAP_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOXOR_B(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOXOR_B, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOXOR_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOXOR_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOXOR_H(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOXOR_H, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AMOXOR_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::AMOXOR_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.AND(x21, x14, x27); },
+     {InstructionId::AND, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.ANDI(x21, x14, 0xFFF); },
+     {InstructionId::ANDI, 4, 21, 14, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.ANDN(x21, x14, x27); },
+     {InstructionId::ANDN, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.AUIPC(x21, -1); },
+     {InstructionId::AUIPC, 4, 21, 0, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.BCLR(x21, x14, x27); },
+     {InstructionId::BCLR, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.BCLRI(x21, x14, 63); },
+     {InstructionId::BCLRI, 4, 21, 14, 0, 0, 0, 63}},
+    {[](Assembler& as) { as.BEQ(x21, x14, -2); },
+     {InstructionId::BEQ, 4, 0, 21, 14, 0, 0, -2}},
+    {[](Assembler& as) { as.BEXT(x21, x14, x27); },
+     {InstructionId::BEXT, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.BEXTI(x21, x14, 63); },
+     {InstructionId::BEXTI, 4, 21, 14, 0, 0, 0, 63}},
+    {[](Assembler& as) { as.BGE(x21, x14, -2); },
+     {InstructionId::BGE, 4, 0, 21, 14, 0, 0, -2}},
+    {[](Assembler& as) { as.BGEU(x21, x14, -2); },
+     {InstructionId::BGEU, 4, 0, 21, 14, 0, 0, -2}},
+    {[](Assembler& as) { as.BINV(x21, x14, x27); },
+     {InstructionId::BINV, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.BINVI(x21, x14, 63); },
+     {InstructionId::BINVI, 4, 21, 14, 0, 0, 0, 63}},
+    {[](Assembler& as) { as.BLT(x21, x14, -2); },
+     {InstructionId::BLT, 4, 0, 21, 14, 0, 0, -2}},
+    {[](Assembler& as) { as.BLTU(x21, x14, -2); },
+     {InstructionId::BLTU, 4, 0, 21, 14, 0, 0, -2}},
+    {[](Assembler& as) { as.BNE(x21, x14, -2); },
+     {InstructionId::BNE, 4, 0, 21, 14, 0, 0, -2}},
+    {[](Assembler& as) { as.BREV8(x21, x14); },
+     {InstructionId::BREV8, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.BSET(x21, x14, x27); },
+     {InstructionId::BSET, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.BSETI(x21, x14, 63); },
+     {InstructionId::BSETI, 4, 21, 14, 0, 0, 0, 63}},
+    {[](Assembler& as) { as.CBO_CLEAN(x21); },
+     {InstructionId::CBO_CLEAN, 4, 0, 21, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CBO_FLUSH(x21); },
+     {InstructionId::CBO_FLUSH, 4, 0, 21, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CBO_INVAL(x21); },
+     {InstructionId::CBO_INVAL, 4, 0, 21, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CBO_ZERO(x21); },
+     {InstructionId::CBO_ZERO, 4, 0, 21, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CLMUL(x21, x14, x27); },
+     {InstructionId::CLMUL, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.CLMULH(x21, x14, x27); },
+     {InstructionId::CLMULH, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.CLMULR(x21, x14, x27); },
+     {InstructionId::CLMULR, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.CLZ(x21, x14); },
+     {InstructionId::CLZ, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CLZW(x21, x14); },
+     {InstructionId::CLZW, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CPOP(x21, x14); },
+     {InstructionId::CPOP, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CPOPW(x21, x14); },
+     {InstructionId::CPOPW, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CSRRC(x21, static_cast<CSR>(0xFFF), x27); },
+     {InstructionId::CSRRC, 4, 21, 27, 0, 0, 0, 4095}},
+    {[](Assembler& as) { as.CSRRCI(x21, static_cast<CSR>(0xFFF), 31); },
+     {InstructionId::CSRRCI, 4, 21, 31, 0, 0, 0, 4095}},
+    {[](Assembler& as) { as.CSRRS(x21, static_cast<CSR>(0xFFF), x27); },
+     {InstructionId::CSRRS, 4, 21, 27, 0, 0, 0, 4095}},
+    {[](Assembler& as) { as.CSRRSI(x21, static_cast<CSR>(0xFFF), 31); },
+     {InstructionId::CSRRSI, 4, 21, 31, 0, 0, 0, 4095}},
+    {[](Assembler& as) { as.CSRRW(x21, static_cast<CSR>(0xFFF), x27); },
+     {InstructionId::CSRRW, 4, 21, 27, 0, 0, 0, 4095}},
+    {[](Assembler& as) { as.CSRRWI(x21, static_cast<CSR>(0xFFF), 31); },
+     {InstructionId::CSRRWI, 4, 21, 31, 0, 0, 0, 4095}},
+    {[](Assembler& as) { as.CTZ(x21, x14); },
+     {InstructionId::CTZ, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CTZW(x21, x14); },
+     {InstructionId::CTZW, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.CZERO_EQZ(x21, x14, x27); },
+     {InstructionId::CZERO_EQZ, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.CZERO_NEZ(x21, x14, x27); },
+     {InstructionId::CZERO_NEZ, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.C_ADD(x21, x14); },
+     {InstructionId::C_ADD, 2, 21, 21, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.C_ADDI(x21, -1); },
+     {InstructionId::C_ADDI, 2, 21, 21, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.C_ADDI16SP(-32); },
+     {InstructionId::C_ADDI16SP, 2, 0, 0, 0, 0, 0, -32}},
+    {[](Assembler& as) { as.C_ADDI4SPN(x14, 12); },
+     {InstructionId::C_ADDI4SPN, 2, 14, 0, 0, 0, 0, 12}},
+    {[](Assembler& as) { as.C_ADDIW(x21, -1); },
+     {InstructionId::C_ADDIW, 2, 21, 21, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.C_ADDW(x14, x14); },
+     {InstructionId::C_ADDW, 2, 14, 14, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.C_AND(x14, x14); },
+     {InstructionId::C_AND, 2, 14, 14, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.C_ANDI(x14, 63); },
+     {InstructionId::C_ANDI, 2, 14, 14, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.C_BEQZ(x14, -2); },
+     {InstructionId::C_BEQZ, 2, 0, 14, 0, 0, 0, -2}},
+    {[](Assembler& as) { as.C_BNEZ(x14, -2); },
+     {InstructionId::C_BNEZ, 2, 0, 14, 0, 0, 0, -2}},
+    {[](Assembler& as) { as.C_EBREAK(); },
+     {InstructionId::C_EBREAK, 2, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_FLD(f14, 24, x12); },
+     {InstructionId::C_FLD, 2, 14, 12, 0, 0, 0, 24}},
+    {[](Assembler& as) { as.C_FLDSP(f21, 24); },
+     {InstructionId::C_FLDSP, 2, 21, 0, 0, 0, 0, 24}},
+    {[](Assembler& as) { as.C_FSD(f14, 24, x12); },
+     {InstructionId::C_FSD, 2, 0, 12, 14, 0, 0, 24}},
+    {[](Assembler& as) { as.C_FSDSP(f21, 24); },
+     {InstructionId::C_FSDSP, 2, 0, 0, 21, 0, 0, 24}},
+    {[](Assembler& as) { as.C_J(-2); },
+     {InstructionId::C_J, 2, 0, 0, 0, 0, 0, -2}},
+    {[](Assembler& as) { as.C_JALR(x21); },
+     {InstructionId::C_JALR, 2, 0, 21, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_JR(x21); },
+     {InstructionId::C_JR, 2, 0, 21, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_LBU(x14, 3, x12); },
+     {InstructionId::C_LBU, 2, 14, 12, 0, 0, 0, 3}},
+    {[](Assembler& as) { as.C_LD(x14, 24, x12); },
+     {InstructionId::C_LD, 2, 14, 12, 0, 0, 0, 24}},
+    {[](Assembler& as) { as.C_LDSP(x21, 24); },
+     {InstructionId::C_LDSP, 2, 21, 0, 0, 0, 0, 24}},
+    {[](Assembler& as) { as.C_LH(x14, 2, x12); },
+     {InstructionId::C_LH, 2, 14, 12, 0, 0, 0, 2}},
+    {[](Assembler& as) { as.C_LHU(x14, 2, x12); },
+     {InstructionId::C_LHU, 2, 14, 12, 0, 0, 0, 2}},
+    {[](Assembler& as) { as.C_LI(x21, -1); },
+     {InstructionId::C_LI, 2, 21, 0, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.C_LUI(x21, 15); },
+     {InstructionId::C_LUI, 2, 21, 0, 0, 0, 0, 15}},
+    {[](Assembler& as) { as.C_LW(x14, 12, x12); },
+     {InstructionId::C_LW, 2, 14, 12, 0, 0, 0, 12}},
+    {[](Assembler& as) { as.C_LWSP(x21, 12); },
+     {InstructionId::C_LWSP, 2, 21, 0, 0, 0, 0, 12}},
+    {[](Assembler& as) { as.C_MUL(x14, x14); },
+     {InstructionId::C_MUL, 2, 14, 14, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.C_MV(x21, x14); },
+     {InstructionId::C_MV, 2, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.C_NOP(); },
+     {InstructionId::C_NOP, 2, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_NOT(x14); },
+     {InstructionId::C_NOT, 2, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_NTL_ALL(); },
+     {InstructionId::C_NTL_ALL, 2, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_NTL_P1(); },
+     {InstructionId::C_NTL_P1, 2, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_NTL_PALL(); },
+     {InstructionId::C_NTL_PALL, 2, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_NTL_S1(); },
+     {InstructionId::C_NTL_S1, 2, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_OR(x14, x14); },
+     {InstructionId::C_OR, 2, 14, 14, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.C_SB(x14, 3, x12); },
+     {InstructionId::C_SB, 2, 0, 12, 14, 0, 0, 3}},
+    {[](Assembler& as) { as.C_SD(x14, 24, x12); },
+     {InstructionId::C_SD, 2, 0, 12, 14, 0, 0, 24}},
+    {[](Assembler& as) { as.C_SDSP(x21, 24); },
+     {InstructionId::C_SDSP, 2, 0, 0, 21, 0, 0, 24}},
+    {[](Assembler& as) { as.C_SEXT_B(x14); },
+     {InstructionId::C_SEXT_B, 2, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_SEXT_H(x14); },
+     {InstructionId::C_SEXT_H, 2, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_SH(x14, 2, x12); },
+     {InstructionId::C_SH, 2, 0, 12, 14, 0, 0, 2}},
+    {[](Assembler& as) { as.C_SLLI(x21, 15); },
+     {InstructionId::C_SLLI, 2, 21, 21, 0, 0, 0, 15}},
+    {[](Assembler& as) { as.C_SRAI(x14, 15); },
+     {InstructionId::C_SRAI, 2, 14, 14, 0, 0, 0, 15}},
+    {[](Assembler& as) { as.C_SRLI(x14, 15); },
+     {InstructionId::C_SRLI, 2, 14, 14, 0, 0, 0, 15}},
+    {[](Assembler& as) { as.C_SSPOPCHK(); },
+     {InstructionId::C_SSPOPCHK, 2, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_SSPUSH(); },
+     {InstructionId::C_SSPUSH, 2, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_SUB(x14, x14); },
+     {InstructionId::C_SUB, 2, 14, 14, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.C_SUBW(x14, x14); },
+     {InstructionId::C_SUBW, 2, 14, 14, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.C_SW(x14, 12, x12); },
+     {InstructionId::C_SW, 2, 0, 12, 14, 0, 0, 12}},
+    {[](Assembler& as) { as.C_SWSP(x21, 12); },
+     {InstructionId::C_SWSP, 2, 0, 0, 21, 0, 0, 12}},
+    {[](Assembler& as) { as.C_UNDEF(); },
+     {InstructionId::C_UNDEF, 2, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_XOR(x14, x14); },
+     {InstructionId::C_XOR, 2, 14, 14, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.C_ZEXT_B(x14); },
+     {InstructionId::C_ZEXT_B, 2, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_ZEXT_H(x14); },
+     {InstructionId::C_ZEXT_H, 2, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.C_ZEXT_W(x14); },
+     {InstructionId::C_ZEXT_W, 2, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.DIV(x21, x14, x27); },
+     {InstructionId::DIV, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.DIVU(x21, x14, x27); },
+     {InstructionId::DIVU, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.DIVUW(x21, x14, x27); },
+     {InstructionId::DIVUW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.DIVW(x21, x14, x27); },
+     {InstructionId::DIVW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.EBREAK(); },
+     {InstructionId::EBREAK, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.ECALL(); },
+     {InstructionId::ECALL, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FADD_D(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FADD_D, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FADD_H(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FADD_H, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FADD_Q(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FADD_Q, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FADD_S(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FADD_S, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FCLASS_D(x21, f14); },
+     {InstructionId::FCLASS_D, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FCLASS_H(x21, f14); },
+     {InstructionId::FCLASS_H, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FCLASS_Q(x21, f14); },
+     {InstructionId::FCLASS_Q, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FCLASS_S(x21, f14); },
+     {InstructionId::FCLASS_S, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FCVTMOD_W_D(x21, f14); },
+     {InstructionId::FCVTMOD_W_D, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FCVT_BF16_S(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_BF16_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_D_H(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_D_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_D_L(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_D_L, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_D_LU(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_D_LU, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_D_Q(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_D_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_D_S(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_D_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_D_W(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_D_W, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_D_WU(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_D_WU, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_H_D(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_H_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_H_L(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_H_L, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_H_LU(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_H_LU, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_H_Q(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_H_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_H_S(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_H_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_H_W(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_H_W, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_H_WU(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_H_WU, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_LU_D(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_LU_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_LU_H(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_LU_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_LU_Q(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_LU_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_LU_S(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_LU_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_L_D(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_L_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_L_H(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_L_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_L_Q(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_L_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_L_S(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_L_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_Q_D(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_Q_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_Q_H(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_Q_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_Q_L(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_Q_L, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_Q_LU(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_Q_LU, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_Q_S(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_Q_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_Q_W(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_Q_W, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_Q_WU(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_Q_WU, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_S_BF16(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_S_BF16, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_S_D(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_S_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_S_H(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_S_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_S_L(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_S_L, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_S_LU(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_S_LU, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_S_Q(f21, f14, RMode::DYN); },
+     {InstructionId::FCVT_S_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_S_W(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_S_W, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_S_WU(f21, x14, RMode::DYN); },
+     {InstructionId::FCVT_S_WU, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_WU_D(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_WU_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_WU_H(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_WU_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_WU_Q(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_WU_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_WU_S(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_WU_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_W_D(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_W_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_W_H(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_W_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_W_Q(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_W_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FCVT_W_S(x21, f14, RMode::DYN); },
+     {InstructionId::FCVT_W_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FDIV_D(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FDIV_D, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FDIV_H(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FDIV_H, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FDIV_Q(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FDIV_Q, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FDIV_S(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FDIV_S, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FENCE(FenceOrder::IORW, FenceOrder::IORW); },
+     {InstructionId::FENCE, 4, 0, 0, 0, 0, 0, 255}},
+    {[](Assembler& as) { as.FENCEI(x21, x14, 0xFFF); },
+     {InstructionId::FENCEI, 4, 21, 14, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.FENCETSO(); },
+     {InstructionId::FENCETSO, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FEQ_D(x21, f14, f27); },
+     {InstructionId::FEQ_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FEQ_H(x21, f14, f27); },
+     {InstructionId::FEQ_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FEQ_Q(x21, f14, f27); },
+     {InstructionId::FEQ_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FEQ_S(x21, f14, f27); },
+     {InstructionId::FEQ_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLD(f21, -1, x27); },
+     {InstructionId::FLD, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.FLEQ_D(x21, f14, f27); },
+     {InstructionId::FLEQ_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLEQ_H(x21, f14, f27); },
+     {InstructionId::FLEQ_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLEQ_Q(x21, f14, f27); },
+     {InstructionId::FLEQ_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLEQ_S(x21, f14, f27); },
+     {InstructionId::FLEQ_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLE_D(x21, f14, f27); },
+     {InstructionId::FLE_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLE_H(x21, f14, f27); },
+     {InstructionId::FLE_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLE_Q(x21, f14, f27); },
+     {InstructionId::FLE_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLE_S(x21, f14, f27); },
+     {InstructionId::FLE_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLH(f21, -1, x27); },
+     {InstructionId::FLH, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.FLI_D(f21, 0.875); },
+     {InstructionId::FLI_D, 4, 21, 0, 0, 0, 0, 15}},
+    {[](Assembler& as) { as.FLI_H(f21, 0.875); },
+     {InstructionId::FLI_H, 4, 21, 0, 0, 0, 0, 15}},
+    {[](Assembler& as) { as.FLI_S(f21, 0.875); },
+     {InstructionId::FLI_S, 4, 21, 0, 0, 0, 0, 15}},
+    {[](Assembler& as) { as.FLQ(f21, -1, x27); },
+     {InstructionId::FLQ, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.FLTQ_D(x21, f14, f27); },
+     {InstructionId::FLTQ_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLTQ_H(x21, f14, f27); },
+     {InstructionId::FLTQ_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLTQ_Q(x21, f14, f27); },
+     {InstructionId::FLTQ_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLTQ_S(x21, f14, f27); },
+     {InstructionId::FLTQ_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLT_D(x21, f14, f27); },
+     {InstructionId::FLT_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLT_H(x21, f14, f27); },
+     {InstructionId::FLT_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLT_Q(x21, f14, f27); },
+     {InstructionId::FLT_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLT_S(x21, f14, f27); },
+     {InstructionId::FLT_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FLW(f21, -1, x27); },
+     {InstructionId::FLW, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.FMADD_D(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FMADD_D, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FMADD_H(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FMADD_H, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FMADD_Q(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FMADD_Q, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FMADD_S(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FMADD_S, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FMAXM_D(f21, f14, f27); },
+     {InstructionId::FMAXM_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMAXM_H(f21, f14, f27); },
+     {InstructionId::FMAXM_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMAXM_Q(f21, f14, f27); },
+     {InstructionId::FMAXM_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMAXM_S(f21, f14, f27); },
+     {InstructionId::FMAXM_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMAX_D(f21, f14, f27); },
+     {InstructionId::FMAX_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMAX_H(f21, f14, f27); },
+     {InstructionId::FMAX_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMAX_Q(f21, f14, f27); },
+     {InstructionId::FMAX_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMAX_S(f21, f14, f27); },
+     {InstructionId::FMAX_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMINM_D(f21, f14, f27); },
+     {InstructionId::FMINM_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMINM_H(f21, f14, f27); },
+     {InstructionId::FMINM_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMINM_Q(f21, f14, f27); },
+     {InstructionId::FMINM_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMINM_S(f21, f14, f27); },
+     {InstructionId::FMINM_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMIN_D(f21, f14, f27); },
+     {InstructionId::FMIN_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMIN_H(f21, f14, f27); },
+     {InstructionId::FMIN_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMIN_Q(f21, f14, f27); },
+     {InstructionId::FMIN_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMIN_S(f21, f14, f27); },
+     {InstructionId::FMIN_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMSUB_D(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FMSUB_D, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FMSUB_H(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FMSUB_H, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FMSUB_Q(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FMSUB_Q, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FMSUB_S(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FMSUB_S, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FMUL_D(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FMUL_D, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FMUL_H(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FMUL_H, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FMUL_Q(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FMUL_Q, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FMUL_S(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FMUL_S, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FMVH_X_D(x21, f14); },
+     {InstructionId::FMVH_X_D, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FMVH_X_Q(x21, f14); },
+     {InstructionId::FMVH_X_Q, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FMVP_D_X(f21, x14, x27); },
+     {InstructionId::FMVP_D_X, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMVP_Q_X(f21, x14, x27); },
+     {InstructionId::FMVP_Q_X, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FMV_D_X(f21, x14); },
+     {InstructionId::FMV_D_X, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FMV_H_X(f21, x14); },
+     {InstructionId::FMV_H_X, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FMV_W_X(f21, x14); },
+     {InstructionId::FMV_W_X, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FMV_X_D(x21, f14); },
+     {InstructionId::FMV_X_D, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FMV_X_H(x21, f14); },
+     {InstructionId::FMV_X_H, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FMV_X_W(x21, f14); },
+     {InstructionId::FMV_X_W, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.FNMADD_D(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FNMADD_D, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FNMADD_H(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FNMADD_H, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FNMADD_Q(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FNMADD_Q, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FNMADD_S(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FNMADD_S, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FNMSUB_D(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FNMSUB_D, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FNMSUB_H(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FNMSUB_H, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FNMSUB_Q(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FNMSUB_Q, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FNMSUB_S(f21, f14, f27, f5, RMode::DYN); },
+     {InstructionId::FNMSUB_S, 4, 21, 14, 27, 5, 7, 0}},
+    {[](Assembler& as) { as.FROUNDNX_D(f21, f14, RMode::DYN); },
+     {InstructionId::FROUNDNX_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FROUNDNX_H(f21, f14, RMode::DYN); },
+     {InstructionId::FROUNDNX_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FROUNDNX_Q(f21, f14, RMode::DYN); },
+     {InstructionId::FROUNDNX_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FROUNDNX_S(f21, f14, RMode::DYN); },
+     {InstructionId::FROUNDNX_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FROUND_D(f21, f14, RMode::DYN); },
+     {InstructionId::FROUND_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FROUND_H(f21, f14, RMode::DYN); },
+     {InstructionId::FROUND_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FROUND_Q(f21, f14, RMode::DYN); },
+     {InstructionId::FROUND_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FROUND_S(f21, f14, RMode::DYN); },
+     {InstructionId::FROUND_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FSD(f21, -1, x27); },
+     {InstructionId::FSD, 4, 0, 27, 21, 0, 0, -1}},
+    {[](Assembler& as) { as.FSGNJN_D(f21, f14, f27); },
+     {InstructionId::FSGNJN_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJN_H(f21, f14, f27); },
+     {InstructionId::FSGNJN_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJN_Q(f21, f14, f27); },
+     {InstructionId::FSGNJN_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJN_S(f21, f14, f27); },
+     {InstructionId::FSGNJN_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJX_D(f21, f14, f27); },
+     {InstructionId::FSGNJX_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJX_H(f21, f14, f27); },
+     {InstructionId::FSGNJX_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJX_Q(f21, f14, f27); },
+     {InstructionId::FSGNJX_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJX_S(f21, f14, f27); },
+     {InstructionId::FSGNJX_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJ_D(f21, f14, f27); },
+     {InstructionId::FSGNJ_D, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJ_H(f21, f14, f27); },
+     {InstructionId::FSGNJ_H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJ_Q(f21, f14, f27); },
+     {InstructionId::FSGNJ_Q, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSGNJ_S(f21, f14, f27); },
+     {InstructionId::FSGNJ_S, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.FSH(f21, -1, x27); },
+     {InstructionId::FSH, 4, 0, 27, 21, 0, 0, -1}},
+    {[](Assembler& as) { as.FSQ(f21, -1, x27); },
+     {InstructionId::FSQ, 4, 0, 27, 21, 0, 0, -1}},
+    {[](Assembler& as) { as.FSQRT_D(f21, f14, RMode::DYN); },
+     {InstructionId::FSQRT_D, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FSQRT_H(f21, f14, RMode::DYN); },
+     {InstructionId::FSQRT_H, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FSQRT_Q(f21, f14, RMode::DYN); },
+     {InstructionId::FSQRT_Q, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FSQRT_S(f21, f14, RMode::DYN); },
+     {InstructionId::FSQRT_S, 4, 21, 14, 0, 0, 7, 0}},
+    {[](Assembler& as) { as.FSUB_D(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FSUB_D, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FSUB_H(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FSUB_H, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FSUB_Q(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FSUB_Q, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FSUB_S(f21, f14, f27, RMode::DYN); },
+     {InstructionId::FSUB_S, 4, 21, 14, 27, 0, 7, 0}},
+    {[](Assembler& as) { as.FSW(f21, -1, x27); },
+     {InstructionId::FSW, 4, 0, 27, 21, 0, 0, -1}},
+    {[](Assembler& as) { as.HFENCE_GVMA(x21, x14); },
+     {InstructionId::HFENCE_GVMA, 4, 0, 21, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.HFENCE_VVMA(x21, x14); },
+     {InstructionId::HFENCE_VVMA, 4, 0, 21, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.HINVAL_GVMA(x21, x14); },
+     {InstructionId::HINVAL_GVMA, 4, 0, 21, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.HINVAL_VVMA(x21, x14); },
+     {InstructionId::HINVAL_VVMA, 4, 0, 21, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.HLVX_HU(x21, x14); },
+     {InstructionId::HLVX_HU, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.HLVX_WU(x21, x14); },
+     {InstructionId::HLVX_WU, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.HLV_B(x21, x14); },
+     {InstructionId::HLV_B, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.HLV_BU(x21, x14); },
+     {InstructionId::HLV_BU, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.HLV_D(x21, x14); },
+     {InstructionId::HLV_D, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.HLV_H(x21, x14); },
+     {InstructionId::HLV_H, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.HLV_HU(x21, x14); },
+     {InstructionId::HLV_HU, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.HLV_W(x21, x14); },
+     {InstructionId::HLV_W, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.HLV_WU(x21, x14); },
+     {InstructionId::HLV_WU, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.HSV_B(x21, x14); },
+     {InstructionId::HSV_B, 4, 0, 14, 21, 0, 0, 0}},
+    {[](Assembler& as) { as.HSV_D(x21, x14); },
+     {InstructionId::HSV_D, 4, 0, 14, 21, 0, 0, 0}},
+    {[](Assembler& as) { as.HSV_H(x21, x14); },
+     {InstructionId::HSV_H, 4, 0, 14, 21, 0, 0, 0}},
+    {[](Assembler& as) { as.HSV_W(x21, x14); },
+     {InstructionId::HSV_W, 4, 0, 14, 21, 0, 0, 0}},
+    {[](Assembler& as) { as.JAL(x21, -2); },
+     {InstructionId::JAL, 4, 21, 0, 0, 0, 0, -2}},
+    {[](Assembler& as) { as.JALR(x21, -1, x27); },
+     {InstructionId::JALR, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.LB(x21, -1, x27); },
+     {InstructionId::LB, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.LBU(x21, -1, x27); },
+     {InstructionId::LBU, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.LD(x21, -1, x27); },
+     {InstructionId::LD, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.LH(x21, -1, x27); },
+     {InstructionId::LH, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.LHU(x21, -1, x27); },
+     {InstructionId::LHU, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.LPAD(-1); },
+     {InstructionId::LPAD, 4, 0, 0, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.LR_D(Ordering::AQRL, x14, x27); },
+     {InstructionId::LR_D, 4, 14, 27, 0, 0, 3, 0}},
+    {[](Assembler& as) { as.LR_W(Ordering::AQRL, x14, x27); },
+     {InstructionId::LR_W, 4, 14, 27, 0, 0, 3, 0}},
+    {[](Assembler& as) { as.LUI(x21, 0xFFFFF); },
+     {InstructionId::LUI, 4, 21, 0, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.LW(x21, -1, x27); },
+     {InstructionId::LW, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.LWU(x21, -1, x27); },
+     {InstructionId::LWU, 4, 21, 27, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.MAX(x21, x14, x27); },
+     {InstructionId::MAX, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.MAXU(x21, x14, x27); },
+     {InstructionId::MAXU, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.MIN(x21, x14, x27); },
+     {InstructionId::MIN, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.MINU(x21, x14, x27); },
+     {InstructionId::MINU, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.MRET(); },
+     {InstructionId::MRET, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.MUL(x21, x14, x27); },
+     {InstructionId::MUL, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.MULH(x21, x14, x27); },
+     {InstructionId::MULH, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.MULHSU(x21, x14, x27); },
+     {InstructionId::MULHSU, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.MULHU(x21, x14, x27); },
+     {InstructionId::MULHU, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.MULW(x21, x14, x27); },
+     {InstructionId::MULW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.NTL_ALL(); },
+     {InstructionId::NTL_ALL, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.NTL_P1(); },
+     {InstructionId::NTL_P1, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.NTL_PALL(); },
+     {InstructionId::NTL_PALL, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.NTL_S1(); },
+     {InstructionId::NTL_S1, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.OR(x21, x14, x27); },
+     {InstructionId::OR, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.ORCB(x21, x14); },
+     {InstructionId::ORCB, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.ORI(x21, x14, 0xFFF); },
+     {InstructionId::ORI, 4, 21, 14, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.ORN(x21, x14, x27); },
+     {InstructionId::ORN, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.PACK(x21, x14, x27); },
+     {InstructionId::PACK, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.PACKH(x21, x14, x27); },
+     {InstructionId::PACKH, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.PACKW(x21, x14, x27); },
+     {InstructionId::PACKW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.PAUSE(); },
+     {InstructionId::PAUSE, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.PREFETCH_I(x21, -32); },
+     {InstructionId::PREFETCH_I, 4, 0, 21, 0, 0, 0, -32}},
+    {[](Assembler& as) { as.PREFETCH_R(x21, -32); },
+     {InstructionId::PREFETCH_R, 4, 0, 21, 0, 0, 0, -32}},
+    {[](Assembler& as) { as.PREFETCH_W(x21, -32); },
+     {InstructionId::PREFETCH_W, 4, 0, 21, 0, 0, 0, -32}},
+    {[](Assembler& as) { as.REM(x21, x14, x27); },
+     {InstructionId::REM, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.REMU(x21, x14, x27); },
+     {InstructionId::REMU, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.REMUW(x21, x14, x27); },
+     {InstructionId::REMUW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.REMW(x21, x14, x27); },
+     {InstructionId::REMW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.REV8(x21, x14); },
+     {InstructionId::REV8, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.ROL(x21, x14, x27); },
+     {InstructionId::ROL, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.ROLW(x21, x14, x27); },
+     {InstructionId::ROLW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.ROR(x21, x14, x27); },
+     {InstructionId::ROR, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.RORI(x21, x14, 63); },
+     {InstructionId::RORI, 4, 21, 14, 0, 0, 0, 63}},
+    {[](Assembler& as) { as.RORIW(x21, x14, 31); },
+     {InstructionId::RORIW, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.RORW(x21, x14, x27); },
+     {InstructionId::RORW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SB(x21, -1, x27); },
+     {InstructionId::SB, 4, 0, 27, 21, 0, 0, -1}},
+    {[](Assembler& as) { as.SCTRCLR(); },
+     {InstructionId::SCTRCLR, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SC_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::SC_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.SC_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::SC_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.SD(x21, -1, x27); },
+     {InstructionId::SD, 4, 0, 27, 21, 0, 0, -1}},
+    {[](Assembler& as) { as.SEXTB(x21, x14); },
+     {InstructionId::SEXTB, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SEXTH(x21, x14); },
+     {InstructionId::SEXTH, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SFENCE_INVAL_IR(); },
+     {InstructionId::SFENCE_INVAL_IR, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SFENCE_VMA(x21, x14); },
+     {InstructionId::SFENCE_VMA, 4, 0, 21, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.SFENCE_W_INVAL(); },
+     {InstructionId::SFENCE_W_INVAL, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SH(x21, -1, x27); },
+     {InstructionId::SH, 4, 0, 27, 21, 0, 0, -1}},
+    {[](Assembler& as) { as.SH1ADD(x21, x14, x27); },
+     {InstructionId::SH1ADD, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SH1ADDUW(x21, x14, x27); },
+     {InstructionId::SH1ADDUW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SH2ADD(x21, x14, x27); },
+     {InstructionId::SH2ADD, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SH2ADDUW(x21, x14, x27); },
+     {InstructionId::SH2ADDUW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SH3ADD(x21, x14, x27); },
+     {InstructionId::SH3ADD, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SH3ADDUW(x21, x14, x27); },
+     {InstructionId::SH3ADDUW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA256SIG0(x21, x14); },
+     {InstructionId::SHA256SIG0, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA256SIG1(x21, x14); },
+     {InstructionId::SHA256SIG1, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA256SUM0(x21, x14); },
+     {InstructionId::SHA256SUM0, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA256SUM1(x21, x14); },
+     {InstructionId::SHA256SUM1, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SIG0(x21, x14); },
+     {InstructionId::SHA512SIG0, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SIG1(x21, x14); },
+     {InstructionId::SHA512SIG1, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SUM0(x21, x14); },
+     {InstructionId::SHA512SUM0, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SUM1(x21, x14); },
+     {InstructionId::SHA512SUM1, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SINVAL_VMA(x21, x14); },
+     {InstructionId::SINVAL_VMA, 4, 0, 21, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.SLL(x21, x14, x27); },
+     {InstructionId::SLL, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SLLI(x21, x14, 63); },
+     {InstructionId::SLLI, 4, 21, 14, 0, 0, 0, 63}},
+    {[](Assembler& as) { as.SLLIUW(x21, x14, 63); },
+     {InstructionId::SLLIUW, 4, 21, 14, 0, 0, 0, 63}},
+    {[](Assembler& as) { as.SLLIW(x21, x14, 31); },
+     {InstructionId::SLLIW, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.SLLW(x21, x14, x27); },
+     {InstructionId::SLLW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SLT(x21, x14, x27); },
+     {InstructionId::SLT, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SLTI(x21, x14, -1); },
+     {InstructionId::SLTI, 4, 21, 14, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.SLTIU(x21, x14, -1); },
+     {InstructionId::SLTIU, 4, 21, 14, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.SLTU(x21, x14, x27); },
+     {InstructionId::SLTU, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SM3P0(x21, x14); },
+     {InstructionId::SM3P0, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SM3P1(x21, x14); },
+     {InstructionId::SM3P1, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SM4ED(x21, x14, x27, 3); },
+     {InstructionId::SM4ED, 4, 21, 14, 27, 0, 0, 3}},
+    {[](Assembler& as) { as.SM4KS(x21, x14, x27, 3); },
+     {InstructionId::SM4KS, 4, 21, 14, 27, 0, 0, 3}},
+    {[](Assembler& as) { as.SRA(x21, x14, x27); },
+     {InstructionId::SRA, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SRAI(x21, x14, 63); },
+     {InstructionId::SRAI, 4, 21, 14, 0, 0, 0, 63}},
+    {[](Assembler& as) { as.SRAIW(x21, x14, 31); },
+     {InstructionId::SRAIW, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.SRAW(x21, x14, x27); },
+     {InstructionId::SRAW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SRET(); },
+     {InstructionId::SRET, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SRL(x21, x14, x27); },
+     {InstructionId::SRL, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SRLI(x21, x14, 63); },
+     {InstructionId::SRLI, 4, 21, 14, 0, 0, 0, 63}},
+    {[](Assembler& as) { as.SRLIW(x21, x14, 31); },
+     {InstructionId::SRLIW, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.SRLW(x21, x14, x27); },
+     {InstructionId::SRLW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SSAMOSWAP_D(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::SSAMOSWAP_D, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.SSAMOSWAP_W(Ordering::AQRL, x14, x27, x5); },
+     {InstructionId::SSAMOSWAP_W, 4, 14, 5, 27, 0, 3, 0}},
+    {[](Assembler& as) { as.SSPOPCHK(x5); },
+     {InstructionId::SSPOPCHK, 4, 0, 5, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SSPUSH(x5); },
+     {InstructionId::SSPUSH, 4, 0, 0, 5, 0, 0, 0}},
+    {[](Assembler& as) { as.SSRDP(x21); },
+     {InstructionId::SSRDP, 4, 21, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SUB(x21, x14, x27); },
+     {InstructionId::SUB, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SUBW(x21, x14, x27); },
+     {InstructionId::SUBW, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SW(x21, -1, x27); },
+     {InstructionId::SW, 4, 0, 27, 21, 0, 0, -1}},
+    {[](Assembler& as) { as.TH_ADDSL(x21, x14, x27, 3); },
+     {InstructionId::TH_ADDSL, 4, 21, 14, 27, 0, 0, 3}},
+    {[](Assembler& as) { as.TH_MVEQZ(x21, x14, x27); },
+     {InstructionId::TH_MVEQZ, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.TH_MVNEZ(x21, x14, x27); },
+     {InstructionId::TH_MVNEZ, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.URET(); },
+     {InstructionId::URET, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VAADDU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VAADDU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VAADDU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VAADDU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VAADD(v21, v14, v27, VecMask::No); },
+     {InstructionId::VAADD_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VAADD(v21, v14, x27, VecMask::No); },
+     {InstructionId::VAADD_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VADC(v21, v14, -1); },
+     {InstructionId::VADC_VI, 4, 21, 0, 14, 0, 0, -1}},
+    {[](Assembler& as) { as.VADC(v21, v14, v27); },
+     {InstructionId::VADC_VV, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VADC(v21, v14, x27); },
+     {InstructionId::VADC_VX, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VADD(v21, v14, -1, VecMask::No); },
+     {InstructionId::VADD_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VADD(v21, v14, v27, VecMask::No); },
+     {InstructionId::VADD_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VADD(v21, v14, x27, VecMask::No); },
+     {InstructionId::VADD_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VAESDF_VS(v21, v14); },
+     {InstructionId::VAESDF_VS, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VAESDF_VV(v21, v14); },
+     {InstructionId::VAESDF_VV, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VAESDM_VS(v21, v14); },
+     {InstructionId::VAESDM_VS, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VAESDM_VV(v21, v14); },
+     {InstructionId::VAESDM_VV, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VAESEF_VS(v21, v14); },
+     {InstructionId::VAESEF_VS, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VAESEF_VV(v21, v14); },
+     {InstructionId::VAESEF_VV, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VAESEM_VS(v21, v14); },
+     {InstructionId::VAESEM_VS, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VAESEM_VV(v21, v14); },
+     {InstructionId::VAESEM_VV, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VAESKF1(v21, v14, 7); },
+     {InstructionId::VAESKF1, 4, 21, 0, 14, 0, 0, 7}},
+    {[](Assembler& as) { as.VAESKF2(v21, v14, 7); },
+     {InstructionId::VAESKF2, 4, 21, 0, 14, 0, 0, 7}},
+    {[](Assembler& as) { as.VAESZ(v21, v14); },
+     {InstructionId::VAESZ, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VANDN(v21, v14, v27, VecMask::No); },
+     {InstructionId::VANDN_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VANDN(v21, v14, x27, VecMask::No); },
+     {InstructionId::VANDN_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VAND(v21, v14, -1, VecMask::No); },
+     {InstructionId::VAND_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VAND(v21, v14, v27, VecMask::No); },
+     {InstructionId::VAND_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VAND(v21, v14, x27, VecMask::No); },
+     {InstructionId::VAND_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VASUBU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VASUBU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VASUBU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VASUBU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VASUB(v21, v14, v27, VecMask::No); },
+     {InstructionId::VASUB_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VASUB(v21, v14, x27, VecMask::No); },
+     {InstructionId::VASUB_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VBREV(v21, v14, VecMask::No); },
+     {InstructionId::VBREV, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VBREV8(v21, v14, VecMask::No); },
+     {InstructionId::VBREV8, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VCLMULH(v21, v14, v27, VecMask::No); },
+     {InstructionId::VCLMULH_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VCLMULH(v21, v14, x27, VecMask::No); },
+     {InstructionId::VCLMULH_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VCLMUL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VCLMUL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VCLMUL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VCLMUL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VCLZ(v21, v14, VecMask::No); },
+     {InstructionId::VCLZ, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VCOMPRESS(v21, v14, v27); },
+     {InstructionId::VCOMPRESS, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VCPOP(v21, v14, VecMask::No); },
+     {InstructionId::VCPOP, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VCTZ(v21, v14, VecMask::No); },
+     {InstructionId::VCTZ, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VDIVU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VDIVU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VDIVU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VDIVU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VDIV(v21, v14, v27, VecMask::No); },
+     {InstructionId::VDIV_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VDIV(v21, v14, x27, VecMask::No); },
+     {InstructionId::VDIV_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFADD(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFADD_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFADD(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFADD_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFCLASS(v21, v14, VecMask::No); },
+     {InstructionId::VFCLASS, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFCVT_F_X(v21, v14, VecMask::No); },
+     {InstructionId::VFCVT_F_X, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFCVT_F_XU(v21, v14, VecMask::No); },
+     {InstructionId::VFCVT_F_XU, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFCVT_RTZ_XU_F(v21, v14, VecMask::No); },
+     {InstructionId::VFCVT_RTZ_XU_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFCVT_RTZ_X_F(v21, v14, VecMask::No); },
+     {InstructionId::VFCVT_RTZ_X_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFCVT_XU_F(v21, v14, VecMask::No); },
+     {InstructionId::VFCVT_XU_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFCVT_X_F(v21, v14, VecMask::No); },
+     {InstructionId::VFCVT_X_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFDIV(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFDIV_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFDIV(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFDIV_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFIRST(x21, v14, VecMask::No); },
+     {InstructionId::VFIRST, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMACC(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFMACC_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMACC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFMACC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMADD(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFMADD_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMADD(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFMADD_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMAX(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFMAX_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMAX(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFMAX_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMERGE(v21, v14, f27); },
+     {InstructionId::VFMERGE, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VFMIN(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFMIN_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMIN(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFMIN_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMSAC(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFMSAC_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMSAC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFMSAC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMSUB(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFMSUB_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMSUB(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFMSUB_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMUL(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFMUL_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMUL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFMUL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFMV(v21, f14); },
+     {InstructionId::VFMV, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VFMV_FS(f21, v14); },
+     {InstructionId::VFMV_FS, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VFMV_SF(v21, f14); },
+     {InstructionId::VFMV_SF, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VFNCVTBF16_F_F_W(v21, v14, VecMask::No); },
+     {InstructionId::VFNCVTBF16_F_F_W, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNCVT_F_F(v21, v14, VecMask::No); },
+     {InstructionId::VFNCVT_F_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNCVT_F_X(v21, v14, VecMask::No); },
+     {InstructionId::VFNCVT_F_X, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNCVT_F_XU(v21, v14, VecMask::No); },
+     {InstructionId::VFNCVT_F_XU, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNCVT_ROD_F_F(v21, v14, VecMask::No); },
+     {InstructionId::VFNCVT_ROD_F_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNCVT_RTZ_XU_F(v21, v14, VecMask::No); },
+     {InstructionId::VFNCVT_RTZ_XU_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNCVT_RTZ_X_F(v21, v14, VecMask::No); },
+     {InstructionId::VFNCVT_RTZ_X_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNCVT_XU_F(v21, v14, VecMask::No); },
+     {InstructionId::VFNCVT_XU_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNCVT_X_F(v21, v14, VecMask::No); },
+     {InstructionId::VFNCVT_X_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNMACC(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFNMACC_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNMACC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFNMACC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNMADD(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFNMADD_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNMADD(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFNMADD_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNMSAC(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFNMSAC_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNMSAC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFNMSAC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNMSUB(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFNMSUB_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFNMSUB(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFNMSUB_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFRDIV(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFRDIV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFREC7(v21, v14, VecMask::No); },
+     {InstructionId::VFREC7, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFREDMAX(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFREDMAX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFREDMIN(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFREDMIN, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFREDOSUM(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFREDOSUM, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFREDUSUM(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFREDUSUM, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFRSQRT7(v21, v14, VecMask::No); },
+     {InstructionId::VFRSQRT7, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFRSUB(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFRSUB, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSGNJN(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFSGNJN_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSGNJN(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFSGNJN_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSGNJX(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFSGNJX_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSGNJX(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFSGNJX_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSGNJ(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFSGNJ_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSGNJ(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFSGNJ_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSLIDE1DOWN(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFSLIDE1DOWN, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSLIDE1UP(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFSLIDE1UP, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSQRT(v21, v14, VecMask::No); },
+     {InstructionId::VFSQRT, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSUB(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFSUB_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFSUB(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFSUB_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWADDW(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFWADDW_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWADDW(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWADDW_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWADD(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFWADD_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWADD(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWADD_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWCVTBF16_F_F_V(v21, v14, VecMask::No); },
+     {InstructionId::VFWCVTBF16_F_F_V, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWCVT_F_F(v21, v14, VecMask::No); },
+     {InstructionId::VFWCVT_F_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWCVT_F_X(v21, v14, VecMask::No); },
+     {InstructionId::VFWCVT_F_X, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWCVT_F_XU(v21, v14, VecMask::No); },
+     {InstructionId::VFWCVT_F_XU, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWCVT_RTZ_XU_F(v21, v14, VecMask::No); },
+     {InstructionId::VFWCVT_RTZ_XU_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWCVT_RTZ_X_F(v21, v14, VecMask::No); },
+     {InstructionId::VFWCVT_RTZ_X_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWCVT_XU_F(v21, v14, VecMask::No); },
+     {InstructionId::VFWCVT_XU_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWCVT_X_F(v21, v14, VecMask::No); },
+     {InstructionId::VFWCVT_X_F, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWMACCBF16(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFWMACCBF16_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWMACCBF16(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWMACCBF16_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWMACC(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFWMACC_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWMACC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWMACC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWMSAC(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFWMSAC_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWMSAC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWMSAC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWMUL(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFWMUL_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWMUL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWMUL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWNMACC(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFWNMACC_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWNMACC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWNMACC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWNMSAC(v21, f14, v27, VecMask::No); },
+     {InstructionId::VFWNMSAC_VF, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWNMSAC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWNMSAC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWREDOSUM(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWREDOSUM, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWREDUSUM(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWREDUSUM, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWSUBW(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFWSUBW_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWSUBW(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWSUBW_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWSUB(v21, v14, f27, VecMask::No); },
+     {InstructionId::VFWSUB_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VFWSUB(v21, v14, v27, VecMask::No); },
+     {InstructionId::VFWSUB_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VGHSH(v21, v14, v27); },
+     {InstructionId::VGHSH, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VGMUL(v21, v14); },
+     {InstructionId::VGMUL, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VID(v21, VecMask::No); },
+     {InstructionId::VID, 4, 21, 0, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VIOTA(v21, v14, VecMask::No); },
+     {InstructionId::VIOTA, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VL1RE16(v21, x14); },
+     {InstructionId::VL1RE16, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL1RE32(v21, x14); },
+     {InstructionId::VL1RE32, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL1RE64(v21, x14); },
+     {InstructionId::VL1RE64, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL1RE8(v21, x14); },
+     {InstructionId::VL1RE8, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL2RE16(v14, x14); },
+     {InstructionId::VL2RE16, 4, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL2RE32(v14, x14); },
+     {InstructionId::VL2RE32, 4, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL2RE64(v14, x14); },
+     {InstructionId::VL2RE64, 4, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL2RE8(v14, x14); },
+     {InstructionId::VL2RE8, 4, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL4RE16(v12, x14); },
+     {InstructionId::VL4RE16, 4, 12, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL4RE32(v12, x14); },
+     {InstructionId::VL4RE32, 4, 12, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL4RE64(v12, x14); },
+     {InstructionId::VL4RE64, 4, 12, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL4RE8(v12, x14); },
+     {InstructionId::VL4RE8, 4, 12, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL8RE16(v24, x14); },
+     {InstructionId::VL8RE16, 4, 24, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL8RE32(v24, x14); },
+     {InstructionId::VL8RE32, 4, 24, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL8RE64(v24, x14); },
+     {InstructionId::VL8RE64, 4, 24, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VL8RE8(v24, x14); },
+     {InstructionId::VL8RE8, 4, 24, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VLE16(v21, x14, VecMask::No); },
+     {InstructionId::VLE16, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VLE16FF(v21, x14, VecMask::No); },
+     {InstructionId::VLE16FF, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VLE32(v21, x14, VecMask::No); },
+     {InstructionId::VLE32, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VLE32FF(v21, x14, VecMask::No); },
+     {InstructionId::VLE32FF, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VLE64(v21, x14, VecMask::No); },
+     {InstructionId::VLE64, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VLE64FF(v21, x14, VecMask::No); },
+     {InstructionId::VLE64FF, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VLE8(v21, x14, VecMask::No); },
+     {InstructionId::VLE8, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VLE8FF(v21, x14, VecMask::No); },
+     {InstructionId::VLE8FF, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VLM(v21, x14); },
+     {InstructionId::VLM, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VLOXEI16(v21, x14, v27, VecMask::No); },
+     {InstructionId::VLOXEI16, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLOXEI32(v21, x14, v27, VecMask::No); },
+     {InstructionId::VLOXEI32, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLOXEI64(v21, x14, v27, VecMask::No); },
+     {InstructionId::VLOXEI64, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLOXEI8(v21, x14, v27, VecMask::No); },
+     {InstructionId::VLOXEI8, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLOXSEGEI16(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VLOXSEGEI16, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLOXSEGEI32(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VLOXSEGEI32, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLOXSEGEI64(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VLOXSEGEI64, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLOXSEGEI8(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VLOXSEGEI8, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLSE16(v21, x14, x27, VecMask::No); },
+     {InstructionId::VLSE16, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLSE32(v21, x14, x27, VecMask::No); },
+     {InstructionId::VLSE32, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLSE64(v21, x14, x27, VecMask::No); },
+     {InstructionId::VLSE64, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLSE8(v21, x14, x27, VecMask::No); },
+     {InstructionId::VLSE8, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLSEGE16(8, v14, x27, VecMask::No); },
+     {InstructionId::VLSEGE16, 4, 14, 27, 0, 0, 1, 8}},
+    {[](Assembler& as) { as.VLSEGE32(8, v14, x27, VecMask::No); },
+     {InstructionId::VLSEGE32, 4, 14, 27, 0, 0, 1, 8}},
+    {[](Assembler& as) { as.VLSEGE64(8, v14, x27, VecMask::No); },
+     {InstructionId::VLSEGE64, 4, 14, 27, 0, 0, 1, 8}},
+    {[](Assembler& as) { as.VLSEGE8(8, v14, x27, VecMask::No); },
+     {InstructionId::VLSEGE8, 4, 14, 27, 0, 0, 1, 8}},
+    {[](Assembler& as) { as.VLSSEGE16(8, v14, x27, x5, VecMask::No); },
+     {InstructionId::VLSSEGE16, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLSSEGE32(8, v14, x27, x5, VecMask::No); },
+     {InstructionId::VLSSEGE32, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLSSEGE64(8, v14, x27, x5, VecMask::No); },
+     {InstructionId::VLSSEGE64, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLSSEGE8(8, v14, x27, x5, VecMask::No); },
+     {InstructionId::VLSSEGE8, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLUXEI16(v21, x14, v27, VecMask::No); },
+     {InstructionId::VLUXEI16, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLUXEI32(v21, x14, v27, VecMask::No); },
+     {InstructionId::VLUXEI32, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLUXEI64(v21, x14, v27, VecMask::No); },
+     {InstructionId::VLUXEI64, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLUXEI8(v21, x14, v27, VecMask::No); },
+     {InstructionId::VLUXEI8, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VLUXSEGEI16(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VLUXSEGEI16, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLUXSEGEI32(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VLUXSEGEI32, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLUXSEGEI64(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VLUXSEGEI64, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VLUXSEGEI8(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VLUXSEGEI8, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VMACC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMACC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VMACC(v21, x14, v27, VecMask::No); },
+     {InstructionId::VMACC_VX, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VMADC(v21, v14, -1, VecMask::No); },
+     {InstructionId::VMADC_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VMADC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMADC_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMADC(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMADC_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMADD(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMADD_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VMADD(v21, x14, v27, VecMask::No); },
+     {InstructionId::VMADD_VX, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VMAND(v21, v14, v27); },
+     {InstructionId::VMAND, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMANDNOT(v21, v14, v27); },
+     {InstructionId::VMANDNOT, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMAXU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMAXU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMAXU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMAXU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMAX(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMAX_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMAX(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMAX_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMERGE(v21, v14, -1); },
+     {InstructionId::VMERGE_VI, 4, 21, 0, 14, 0, 0, -1}},
+    {[](Assembler& as) { as.VMERGE(v21, v14, v27); },
+     {InstructionId::VMERGE_VV, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMERGE(v21, v14, x27); },
+     {InstructionId::VMERGE_VX, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMFEQ(v21, v14, f27, VecMask::No); },
+     {InstructionId::VMFEQ_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMFEQ(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMFEQ_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMFGE(v21, v14, f27, VecMask::No); },
+     {InstructionId::VMFGE, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMFGT(v21, v14, f27, VecMask::No); },
+     {InstructionId::VMFGT, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMFLE(v21, v14, f27, VecMask::No); },
+     {InstructionId::VMFLE_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMFLE(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMFLE_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMFLT(v21, v14, f27, VecMask::No); },
+     {InstructionId::VMFLT_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMFLT(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMFLT_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMFNE(v21, v14, f27, VecMask::No); },
+     {InstructionId::VMFNE_VF, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMFNE(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMFNE_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMINU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMINU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMINU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMINU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMIN(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMIN_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMIN(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMIN_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMNAND(v21, v14, v27); },
+     {InstructionId::VMNAND, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMNOR(v21, v14, v27); },
+     {InstructionId::VMNOR, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMOR(v21, v14, v27); },
+     {InstructionId::VMOR, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMORNOT(v21, v14, v27); },
+     {InstructionId::VMORNOT, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMSBC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMSBC_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSBC(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMSBC_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSBF(v21, v14, VecMask::No); },
+     {InstructionId::VMSBF, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSEQ(v21, v14, -1, VecMask::No); },
+     {InstructionId::VMSEQ_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VMSEQ(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMSEQ_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSEQ(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMSEQ_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSGTU(v21, v14, -1, VecMask::No); },
+     {InstructionId::VMSGTU_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VMSGTU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMSGTU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSGT(v21, v14, -1, VecMask::No); },
+     {InstructionId::VMSGT_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VMSGT(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMSGT_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSIF(v21, v14, VecMask::No); },
+     {InstructionId::VMSIF, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSLEU(v21, v14, -1, VecMask::No); },
+     {InstructionId::VMSLEU_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VMSLEU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMSLEU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSLEU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMSLEU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSLE(v21, v14, -1, VecMask::No); },
+     {InstructionId::VMSLE_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VMSLE(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMSLE_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSLE(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMSLE_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSLTU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMSLTU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSLTU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMSLTU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSLT(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMSLT_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSLT(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMSLT_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSNE(v21, v14, -1, VecMask::No); },
+     {InstructionId::VMSNE_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VMSNE(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMSNE_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSNE(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMSNE_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMSOF(v21, v14, VecMask::No); },
+     {InstructionId::VMSOF, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMULHSU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMULHSU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMULHSU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMULHSU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMULHU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMULHU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMULHU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMULHU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMULH(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMULH_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMULH(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMULH_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMUL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VMUL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMUL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VMUL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VMV1R(v21, v14); },
+     {InstructionId::VMV1R, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMV2R(v14, v14); },
+     {InstructionId::VMV2R, 4, 14, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMV4R(v12, v12); },
+     {InstructionId::VMV4R, 4, 12, 0, 12, 0, 0, 0}},
+    {[](Assembler& as) { as.VMV8R(v24, v24); },
+     {InstructionId::VMV8R, 4, 24, 0, 24, 0, 0, 0}},
+    {[](Assembler& as) { as.VMV_SX(v21, x14); },
+     {InstructionId::VMV_SX, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VMV(v21, -1); },
+     {InstructionId::VMV_VI, 4, 21, 0, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.VMV(v21, v14); },
+     {InstructionId::VMV_VV, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VMV(v21, x14); },
+     {InstructionId::VMV_VX, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VMV_XS(x21, v14); },
+     {InstructionId::VMV_XS, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMXNOR(v21, v14, v27); },
+     {InstructionId::VMXNOR, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VMXOR(v21, v14, v27); },
+     {InstructionId::VMXOR, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VNCLIPU(v21, v14, 31, VecMask::No); },
+     {InstructionId::VNCLIPU_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VNCLIPU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VNCLIPU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VNCLIPU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VNCLIPU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VNCLIP(v21, v14, 31, VecMask::No); },
+     {InstructionId::VNCLIP_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VNCLIP(v21, v14, v27, VecMask::No); },
+     {InstructionId::VNCLIP_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VNCLIP(v21, v14, x27, VecMask::No); },
+     {InstructionId::VNCLIP_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VNMSAC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VNMSAC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VNMSAC(v21, x14, v27, VecMask::No); },
+     {InstructionId::VNMSAC_VX, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VNMSUB(v21, v14, v27, VecMask::No); },
+     {InstructionId::VNMSUB_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VNMSUB(v21, x14, v27, VecMask::No); },
+     {InstructionId::VNMSUB_VX, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VNSRA(v21, v14, 31, VecMask::No); },
+     {InstructionId::VNSRA_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VNSRA(v21, v14, v27, VecMask::No); },
+     {InstructionId::VNSRA_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VNSRA(v21, v14, x27, VecMask::No); },
+     {InstructionId::VNSRA_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VNSRL(v21, v14, 31, VecMask::No); },
+     {InstructionId::VNSRL_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VNSRL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VNSRL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VNSRL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VNSRL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VOR(v21, v14, -1, VecMask::No); },
+     {InstructionId::VOR_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VOR(v21, v14, v27, VecMask::No); },
+     {InstructionId::VOR_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VOR(v21, v14, x27, VecMask::No); },
+     {InstructionId::VOR_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VPOPC(x21, v14, VecMask::No); },
+     {InstructionId::VPOPC, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREDAND(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREDAND, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREDMAX(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREDMAX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREDMAXU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREDMAXU, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREDMIN(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREDMIN, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREDMINU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREDMINU, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREDOR(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREDOR, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREDSUM(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREDSUM, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREDXOR(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREDXOR, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREMU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREMU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREMU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VREMU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREM(v21, v14, v27, VecMask::No); },
+     {InstructionId::VREM_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREM(v21, v14, x27, VecMask::No); },
+     {InstructionId::VREM_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VREV8(v21, v14, VecMask::No); },
+     {InstructionId::VREV8, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VRGATHEREI16(v21, v14, v27, VecMask::No); },
+     {InstructionId::VRGATHEREI16, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VRGATHER(v21, v14, 31, VecMask::No); },
+     {InstructionId::VRGATHER_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VRGATHER(v21, v14, v27, VecMask::No); },
+     {InstructionId::VRGATHER_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VRGATHER(v21, v14, x27, VecMask::No); },
+     {InstructionId::VRGATHER_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VROL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VROL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VROL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VROL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VROR(v21, v14, 63, VecMask::No); },
+     {InstructionId::VROR_VI, 4, 21, 0, 14, 0, 1, 63}},
+    {[](Assembler& as) { as.VROR(v21, v14, v27, VecMask::No); },
+     {InstructionId::VROR_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VROR(v21, v14, x27, VecMask::No); },
+     {InstructionId::VROR_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VRSUB(v21, v14, -1, VecMask::No); },
+     {InstructionId::VRSUB_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VRSUB(v21, v14, x27, VecMask::No); },
+     {InstructionId::VRSUB_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VS1R(v21, x14); },
+     {InstructionId::VS1R, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VS2R(v14, x14); },
+     {InstructionId::VS2R, 4, 14, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VS4R(v12, x14); },
+     {InstructionId::VS4R, 4, 12, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VS8R(v24, x14); },
+     {InstructionId::VS8R, 4, 24, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VSADDU(v21, v14, -1, VecMask::No); },
+     {InstructionId::VSADDU_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VSADDU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSADDU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSADDU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSADDU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSADD(v21, v14, -1, VecMask::No); },
+     {InstructionId::VSADD_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VSADD(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSADD_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSADD(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSADD_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSBC(v21, v14, v27); },
+     {InstructionId::VSBC_VV, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VSBC(v21, v14, x27); },
+     {InstructionId::VSBC_VX, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VSE16(v21, x14, VecMask::No); },
+     {InstructionId::VSE16, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VSE32(v21, x14, VecMask::No); },
+     {InstructionId::VSE32, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VSE64(v21, x14, VecMask::No); },
+     {InstructionId::VSE64, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VSE8(v21, x14, VecMask::No); },
+     {InstructionId::VSE8, 4, 21, 14, 0, 0, 1, 0}},
+    {[](Assembler& as) { as.VSETIVLI(x21, 31, SEW::E1024, LMUL::MF2, VTA::Yes, VMA::Yes); },
+     {InstructionId::VSETIVLI, 4, 21, 31, 0, 0, 0, 255}},
+    {[](Assembler& as) { as.VSETVL(x21, x14, x27); },
+     {InstructionId::VSETVL, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.VSETVLI(x21, x14, SEW::E1024, LMUL::MF2, VTA::Yes, VMA::Yes); },
+     {InstructionId::VSETVLI, 4, 21, 14, 0, 0, 0, 255}},
+    {[](Assembler& as) { as.VSEXTVF2(v21, v14, VecMask::No); },
+     {InstructionId::VSEXTVF2, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSEXTVF4(v21, v14, VecMask::No); },
+     {InstructionId::VSEXTVF4, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSEXTVF8(v21, v14, VecMask::No); },
+     {InstructionId::VSEXTVF8, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSHA2CH(v21, v14, v27); },
+     {InstructionId::VSHA2CH, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VSHA2CL(v21, v14, v27); },
+     {InstructionId::VSHA2CL, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VSHA2MS(v21, v14, v27); },
+     {InstructionId::VSHA2MS, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VSLIDE1DOWN(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSLIDE1DOWN, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSLIDE1UP(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSLIDE1UP, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSLIDEDOWN(v21, v14, 31, VecMask::No); },
+     {InstructionId::VSLIDEDOWN_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VSLIDEDOWN(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSLIDEDOWN_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSLIDEUP(v21, v14, 31, VecMask::No); },
+     {InstructionId::VSLIDEUP_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VSLIDEUP(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSLIDEUP_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSLL(v21, v14, 31, VecMask::No); },
+     {InstructionId::VSLL_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VSLL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSLL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSLL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSLL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSM(v21, x14); },
+     {InstructionId::VSM, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.VSM3C(v21, v14, 31); },
+     {InstructionId::VSM3C, 4, 21, 0, 14, 0, 0, 31}},
+    {[](Assembler& as) { as.VSM3ME(v21, v14, v27); },
+     {InstructionId::VSM3ME, 4, 21, 27, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VSM4K(v21, v14, 7); },
+     {InstructionId::VSM4K, 4, 21, 0, 14, 0, 0, 7}},
+    {[](Assembler& as) { as.VSM4R_VS(v21, v14); },
+     {InstructionId::VSM4R_VS, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VSM4R_VV(v21, v14); },
+     {InstructionId::VSM4R_VV, 4, 21, 0, 14, 0, 0, 0}},
+    {[](Assembler& as) { as.VSMUL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSMUL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSMUL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSMUL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSOXEI16(v21, x14, v27, VecMask::No); },
+     {InstructionId::VSOXEI16, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSOXEI32(v21, x14, v27, VecMask::No); },
+     {InstructionId::VSOXEI32, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSOXEI64(v21, x14, v27, VecMask::No); },
+     {InstructionId::VSOXEI64, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSOXEI8(v21, x14, v27, VecMask::No); },
+     {InstructionId::VSOXEI8, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSOXSEGEI16(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VSOXSEGEI16, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSOXSEGEI32(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VSOXSEGEI32, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSOXSEGEI64(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VSOXSEGEI64, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSOXSEGEI8(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VSOXSEGEI8, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSRA(v21, v14, 31, VecMask::No); },
+     {InstructionId::VSRA_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VSRA(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSRA_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSRA(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSRA_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSRL(v21, v14, 31, VecMask::No); },
+     {InstructionId::VSRL_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VSRL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSRL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSRL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSRL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSE16(v21, x14, x27, VecMask::No); },
+     {InstructionId::VSSE16, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSE32(v21, x14, x27, VecMask::No); },
+     {InstructionId::VSSE32, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSE64(v21, x14, x27, VecMask::No); },
+     {InstructionId::VSSE64, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSE8(v21, x14, x27, VecMask::No); },
+     {InstructionId::VSSE8, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSEGE16(8, v14, x27, VecMask::No); },
+     {InstructionId::VSSEGE16, 4, 14, 27, 0, 0, 1, 8}},
+    {[](Assembler& as) { as.VSSEGE32(8, v14, x27, VecMask::No); },
+     {InstructionId::VSSEGE32, 4, 14, 27, 0, 0, 1, 8}},
+    {[](Assembler& as) { as.VSSEGE64(8, v14, x27, VecMask::No); },
+     {InstructionId::VSSEGE64, 4, 14, 27, 0, 0, 1, 8}},
+    {[](Assembler& as) { as.VSSEGE8(8, v14, x27, VecMask::No); },
+     {InstructionId::VSSEGE8, 4, 14, 27, 0, 0, 1, 8}},
+    {[](Assembler& as) { as.VSSRA(v21, v14, 31, VecMask::No); },
+     {InstructionId::VSSRA_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VSSRA(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSSRA_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSRA(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSSRA_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSRL(v21, v14, 31, VecMask::No); },
+     {InstructionId::VSSRL_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VSSRL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSSRL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSRL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSSRL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSSEGE16(8, v14, x27, x5, VecMask::No); },
+     {InstructionId::VSSSEGE16, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSSSEGE32(8, v14, x27, x5, VecMask::No); },
+     {InstructionId::VSSSEGE32, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSSSEGE64(8, v14, x27, x5, VecMask::No); },
+     {InstructionId::VSSSEGE64, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSSSEGE8(8, v14, x27, x5, VecMask::No); },
+     {InstructionId::VSSSEGE8, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSSUBU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSSUBU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSUBU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSSUBU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSUB(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSSUB_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSSUB(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSSUB_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSUB(v21, v14, v27, VecMask::No); },
+     {InstructionId::VSUB_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSUB(v21, v14, x27, VecMask::No); },
+     {InstructionId::VSUB_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VSUXEI16(v21, x14, v27, VecMask::No); },
+     {InstructionId::VSUXEI16, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSUXEI32(v21, x14, v27, VecMask::No); },
+     {InstructionId::VSUXEI32, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSUXEI64(v21, x14, v27, VecMask::No); },
+     {InstructionId::VSUXEI64, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSUXEI8(v21, x14, v27, VecMask::No); },
+     {InstructionId::VSUXEI8, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VSUXSEGEI16(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VSUXSEGEI16, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSUXSEGEI32(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VSUXSEGEI32, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSUXSEGEI64(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VSUXSEGEI64, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VSUXSEGEI8(8, v14, x27, v5, VecMask::No); },
+     {InstructionId::VSUXSEGEI8, 4, 14, 27, 5, 0, 1, 8}},
+    {[](Assembler& as) { as.VWADDUW(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWADDUW_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWADDUW(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWADDUW_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWADDU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWADDU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWADDU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWADDU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWADDW(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWADDW_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWADDW(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWADDW_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWADD(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWADD_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWADD(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWADD_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMACCSU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWMACCSU_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMACCSU(v21, x14, v27, VecMask::No); },
+     {InstructionId::VWMACCSU_VX, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMACCUS(v21, x14, v27, VecMask::No); },
+     {InstructionId::VWMACCUS, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMACCU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWMACCU_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMACCU(v21, x14, v27, VecMask::No); },
+     {InstructionId::VWMACCU_VX, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMACC(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWMACC_VV, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMACC(v21, x14, v27, VecMask::No); },
+     {InstructionId::VWMACC_VX, 4, 21, 14, 27, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMULSU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWMULSU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMULSU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWMULSU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMULU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWMULU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMULU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWMULU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMUL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWMUL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWMUL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWMUL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWREDSUM(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWREDSUM, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWREDSUMU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWREDSUMU, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSLL(v21, v14, 31, VecMask::No); },
+     {InstructionId::VWSLL_VI, 4, 21, 0, 14, 0, 1, 31}},
+    {[](Assembler& as) { as.VWSLL(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWSLL_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSLL(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWSLL_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSUBUW(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWSUBUW_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSUBUW(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWSUBUW_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSUBU(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWSUBU_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSUBU(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWSUBU_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSUBW(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWSUBW_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSUBW(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWSUBW_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSUB(v21, v14, v27, VecMask::No); },
+     {InstructionId::VWSUB_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VWSUB(v21, v14, x27, VecMask::No); },
+     {InstructionId::VWSUB_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VXOR(v21, v14, -1, VecMask::No); },
+     {InstructionId::VXOR_VI, 4, 21, 0, 14, 0, 1, -1}},
+    {[](Assembler& as) { as.VXOR(v21, v14, v27, VecMask::No); },
+     {InstructionId::VXOR_VV, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VXOR(v21, v14, x27, VecMask::No); },
+     {InstructionId::VXOR_VX, 4, 21, 27, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VZEXTVF2(v21, v14, VecMask::No); },
+     {InstructionId::VZEXTVF2, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VZEXTVF4(v21, v14, VecMask::No); },
+     {InstructionId::VZEXTVF4, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.VZEXTVF8(v21, v14, VecMask::No); },
+     {InstructionId::VZEXTVF8, 4, 21, 0, 14, 0, 1, 0}},
+    {[](Assembler& as) { as.WFI(); },
+     {InstructionId::WFI, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.WRS_NTO(); },
+     {InstructionId::WRS_NTO, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.WRS_STO(); },
+     {InstructionId::WRS_STO, 4, 0, 0, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.XNOR(x21, x14, x27); },
+     {InstructionId::XNOR, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.XOR(x21, x14, x27); },
+     {InstructionId::XOR, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.XORI(x21, x14, 0xFFF); },
+     {InstructionId::XORI, 4, 21, 14, 0, 0, 0, -1}},
+    {[](Assembler& as) { as.XPERM4(x21, x14, x27); },
+     {InstructionId::XPERM4, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.XPERM8(x21, x14, x27); },
+     {InstructionId::XPERM8, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.ZEXTH(x21, x14); },
+     {InstructionId::ZEXTH, 4, 21, 14, 0, 0, 0, 0}},
+}};
+
+constexpr std::array<DecodeCase, 27> rv32_cases{{
+    {[](Assembler& as) { as.AES32DSI(x21, x14, x27, 3); },
+     {InstructionId::AES32DSI, 4, 21, 14, 27, 0, 0, 3}},
+    {[](Assembler& as) { as.AES32DSMI(x21, x14, x27, 3); },
+     {InstructionId::AES32DSMI, 4, 21, 14, 27, 0, 0, 3}},
+    {[](Assembler& as) { as.AES32ESI(x21, x14, x27, 3); },
+     {InstructionId::AES32ESI, 4, 21, 14, 27, 0, 0, 3}},
+    {[](Assembler& as) { as.AES32ESMI(x21, x14, x27, 3); },
+     {InstructionId::AES32ESMI, 4, 21, 14, 27, 0, 0, 3}},
+    {[](Assembler& as) { as.AMOCAS_D(Ordering::AQRL, x14, x12, x5); },
+     {InstructionId::AMOCAS_D, 4, 14, 5, 12, 0, 3, 0}},
+    {[](Assembler& as) { as.BCLRI(x21, x14, 31); },
+     {InstructionId::BCLRI, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.BEXTI(x21, x14, 31); },
+     {InstructionId::BEXTI, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.BINVI(x21, x14, 31); },
+     {InstructionId::BINVI, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.BSETI(x21, x14, 31); },
+     {InstructionId::BSETI, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.C_FLW(f14, 12, x12); },
+     {InstructionId::C_FLW, 2, 14, 12, 0, 0, 0, 12}},
+    {[](Assembler& as) { as.C_FLWSP(f21, 12); },
+     {InstructionId::C_FLWSP, 2, 21, 0, 0, 0, 0, 12}},
+    {[](Assembler& as) { as.C_FSW(f14, 12, x12); },
+     {InstructionId::C_FSW, 2, 0, 12, 14, 0, 0, 12}},
+    {[](Assembler& as) { as.C_FSWSP(f21, 12); },
+     {InstructionId::C_FSWSP, 2, 0, 0, 21, 0, 0, 12}},
+    {[](Assembler& as) { as.C_JAL(-2); },
+     {InstructionId::C_JAL, 2, 0, 0, 0, 0, 0, -2}},
+    {[](Assembler& as) { as.REV8(x21, x14); },
+     {InstructionId::REV8, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SIG0H(x21, x14, x27); },
+     {InstructionId::SHA512SIG0H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SIG0L(x21, x14, x27); },
+     {InstructionId::SHA512SIG0L, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SIG1H(x21, x14, x27); },
+     {InstructionId::SHA512SIG1H, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SIG1L(x21, x14, x27); },
+     {InstructionId::SHA512SIG1L, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SUM0R(x21, x14, x27); },
+     {InstructionId::SHA512SUM0R, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SHA512SUM1R(x21, x14, x27); },
+     {InstructionId::SHA512SUM1R, 4, 21, 14, 27, 0, 0, 0}},
+    {[](Assembler& as) { as.SLLI(x21, x14, 31); },
+     {InstructionId::SLLI, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.SRAI(x21, x14, 31); },
+     {InstructionId::SRAI, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.SRLI(x21, x14, 31); },
+     {InstructionId::SRLI, 4, 21, 14, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.UNZIP(x21, x14); },
+     {InstructionId::UNZIP, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.ZEXTH(x21, x14); },
+     {InstructionId::ZEXTH, 4, 21, 14, 0, 0, 0, 0}},
+    {[](Assembler& as) { as.ZIP(x21, x14); },
+     {InstructionId::ZIP, 4, 21, 14, 0, 0, 0, 0}},
+}};
+
+// Zcmp and Zcmt replace Zcd, so they are checked separately.
+constexpr std::array<DecodeCase, 8> zcmp_rv64_cases{{
+    {[](Assembler& as) { as.CM_JALT(255); },
+     {InstructionId::CM_JALT, 2, 0, 0, 0, 0, 0, 255}},
+    {[](Assembler& as) { as.CM_JT(31); },
+     {InstructionId::CM_JT, 2, 0, 0, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.CM_MVA01S(x21, x9); },
+     {InstructionId::CM_MVA01S, 2, 0, 21, 9, 0, 0, 0}},
+    {[](Assembler& as) { as.CM_MVSA01(x21, x9); },
+     {InstructionId::CM_MVSA01, 2, 0, 21, 9, 0, 0, 0}},
+    {[](Assembler& as) { as.CM_POP({ra, {s0, s2}}, 64); },
+     {InstructionId::CM_POP, 2, 0, 0, 0, 0, 7, 64}},
+    {[](Assembler& as) { as.CM_POPRET({ra, {s0, s2}}, 64); },
+     {InstructionId::CM_POPRET, 2, 0, 0, 0, 0, 7, 64}},
+    {[](Assembler& as) { as.CM_POPRETZ({ra, {s0, s2}}, 64); },
+     {InstructionId::CM_POPRETZ, 2, 0, 0, 0, 0, 7, 64}},
+    {[](Assembler& as) { as.CM_PUSH({ra, {s0, s2}}, -64); },
+     {InstructionId::CM_PUSH, 2, 0, 0, 0, 0, 7, -64}},
+}};
+
+constexpr std::array<DecodeCase, 8> zcmp_rv32_cases{{
+    {[](Assembler& as) { as.CM_JALT(255); },
+     {InstructionId::CM_JALT, 2, 0, 0, 0, 0, 0, 255}},
+    {[](Assembler& as) { as.CM_JT(31); },
+     {InstructionId::CM_JT, 2, 0, 0, 0, 0, 0, 31}},
+    {[](Assembler& as) { as.CM_MVA01S(x21, x9); },
+     {InstructionId::CM_MVA01S, 2, 0, 21, 9, 0, 0, 0}},
+    {[](Assembler& as) { as.CM_MVSA01(x21, x9); },
+     {InstructionId::CM_MVSA01, 2, 0, 21, 9, 0, 0, 0}},
+    {[](Assembler& as) { as.CM_POP({ra, {s0, s2}}, 64); },
+     {InstructionId::CM_POP, 2, 0, 0, 0, 0, 7, 64}},
+    {[](Assembler& as) { as.CM_POPRET({ra, {s0, s2}}, 64); },
+     {InstructionId::CM_POPRET, 2, 0, 0, 0, 0, 7, 64}},
+    {[](Assembler& as) { as.CM_POPRETZ({ra, {s0, s2}}, 64); },
+     {InstructionId::CM_POPRETZ, 2, 0, 0, 0, 0, 7, 64}},
+    {[](Assembler& as) { as.CM_PUSH({ra, {s0, s2}}, -64); },
+     {InstructionId::CM_PUSH, 2, 0, 0, 0, 0, 7, -64}},
+}};
+
+uint32_t Emit(void (*emit)(Assembler&), ArchFeature features) {
+    std::array<uint8_t, 16> code{};
+    Assembler as{code.data(), code.size(), features};
+    emit(as);
+
+    uint32_t instruction = 0;
+    std::memcpy(&instruction, code.data(), as.GetCodeBuffer().GetSizeInBytes());
+    return instruction;
+}
+
+template <size_t N>
+void RequireRoundTrip(const std::array<DecodeCase, N>& cases, const Decoder& decoder) {
+    for (const auto& [emit, expected] : cases) {
+        const auto instruction = Emit(emit, decoder.GetArchFeatures());
+        INFO("instruction: 0x" << std::hex << instruction);
+        REQUIRE(decoder.Decode(instruction) == expected);
+
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&instruction);
+        REQUIRE(decoder.Decode(std::span{bytes, expected.length}) == expected);
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("Decoder round-trips every instruction the Assembler emits", "[decoder]") {
+    SECTION("RV64") {
+        const Decoder decoder{ArchFeature::RV64, Extension::Zca | Extension::Zcb | Extension::Zcd};
+        RequireRoundTrip(rv64_cases, decoder);
+    }
+
+    SECTION("RV32") {
+        const Decoder decoder{ArchFeature::RV32,
+                              Extension::Zca | Extension::Zcb | Extension::Zcd | Extension::Zcf};
+        RequireRoundTrip(rv32_cases, decoder);
+    }
+
+    SECTION("Zcmp and Zcmt on RV64") {
+        const Decoder decoder{ArchFeature::RV64, Extension::Zca | Extension::Zcb};
+        RequireRoundTrip(zcmp_rv64_cases, decoder);
+    }
+
+    SECTION("Zcmp and Zcmt on RV32") {
+        const Decoder decoder{ArchFeature::RV32, Extension::Zca | Extension::Zcb};
+        RequireRoundTrip(zcmp_rv32_cases, decoder);
+    }
+}
+
+TEST_CASE("Decoder decodes pseudo-instructions as what they expand to", "[decoder]") {
+    const Decoder decoder;
+
+    REQUIRE(decoder.Decode(Emit([](Assembler& as) { as.MV(a0, a1); }, ArchFeature::RV64)) ==
+            DecodedInstruction{InstructionId::ADDI, 4, 10, 11, 0, 0, 0, 0});
+    REQUIRE(decoder.Decode(Emit([](Assembler& as) { as.RET(); }, ArchFeature::RV64)) ==
+            DecodedInstruction{InstructionId::JALR, 4, 0, 1, 0, 0, 0, 0});
+    REQUIRE(decoder.Decode(Emit([](Assembler& as) { as.C_NOP(); }, ArchFeature::RV64)) ==
+            DecodedInstruction{InstructionId::C_NOP, 2, 0, 0, 0, 0, 0, 0});
+    REQUIRE(decoder.Decode(Emit([](Assembler& as) { as.FNEG_D(f1, f2); }, ArchFeature::RV64)) ==
+            DecodedInstruction{InstructionId::FSGNJN_D, 4, 1, 2, 2, 0, 0, 0});
+}
+
+TEST_CASE("Decoder resolves encodings by configuration", "[decoder]") {
+    // C.JAL on RV32 is C.ADDIW on RV64.
+    const auto c_jal = Emit([](Assembler& as) { as.C_JAL(-2); }, ArchFeature::RV32);
+    REQUIRE(Decoder{ArchFeature::RV32}.Decode(c_jal).id == InstructionId::C_JAL);
+    REQUIRE(Decoder{ArchFeature::RV64}.Decode(c_jal).id == InstructionId::C_ADDIW);
+
+    // C.FLW on RV32 is C.LD on RV64, and isn't decoded without Zcf.
+    const auto c_flw = Emit([](Assembler& as) { as.C_FLW(f8, 4, x9); }, ArchFeature::RV32);
+    REQUIRE(Decoder{ArchFeature::RV32}.Decode(c_flw).id == InstructionId::C_FLW);
+    REQUIRE(Decoder{ArchFeature::RV32, Extension::Zca}.Decode(c_flw).id == InstructionId::Invalid);
+    REQUIRE(Decoder{ArchFeature::RV64}.Decode(c_flw).id == InstructionId::C_LD);
+
+    // Zcmp and Zcmt reuse the encoding of C.FSDSP.
+    const auto cm_push = Emit([](Assembler& as) { as.CM_PUSH({ra, {s0, s1}}, -32); }, ArchFeature::RV64);
+    REQUIRE(Decoder{ArchFeature::RV64}.Decode(cm_push).id == InstructionId::C_FSDSP);
+    REQUIRE(Decoder{ArchFeature::RV64, Extension::Zca}.Decode(cm_push) ==
+            DecodedInstruction{InstructionId::CM_PUSH, 2, 0, 0, 0, 0, 6, -32});
+
+    // Compressed instructions aren't decoded without Zca.
+    const auto c_add = Emit([](Assembler& as) { as.C_ADD(a0, a1); }, ArchFeature::RV64);
+    REQUIRE(Decoder{ArchFeature::RV64, Extension::None}.Decode(c_add).id == InstructionId::Invalid);
+}
+
+TEST_CASE("Decoder rejects unknown encodings", "[decoder]") {
+    const Decoder decoder{ArchFeature::RV64, Extension::Zca | Extension::Zcb};
+
+    // The all-zero encoding is the defined illegal instruction, so it has an ID.
+    REQUIRE(decoder.Decode(0x00000000).id == InstructionId::C_UNDEF);
+    REQUIRE(decoder.Decode(0xFFFFFFFF) == DecodedInstruction{});
+
+    // Reserved register lists of CM.PUSH.
+    REQUIRE(decoder.Decode(0xB802) == DecodedInstruction{});
+
+    // 48-bit instructions.
+    REQUIRE(decoder.Decode(0x0000001F) == DecodedInstruction{});
+
+    // Spans that end partway through an instruction.
+    const std::array<uint8_t, 4> add{0x33, 0x05, 0xB5, 0x00};
+    REQUIRE(decoder.Decode(std::span{add}).id == InstructionId::ADD);
+    REQUIRE(decoder.Decode(std::span{add}.first(3)) == DecodedInstruction{});
+    REQUIRE(decoder.Decode(std::span{add}.first(1)) == DecodedInstruction{});
+    REQUIRE(decoder.Decode(std::span<const uint8_t>{}) == DecodedInstruction{});
+}
+
+TEST_CASE("Decoder names instructions", "[decoder]") {
+    REQUIRE(Decoder::GetName(InstructionId::Invalid) == "Invalid");
+    REQUIRE(Decoder::GetName(InstructionId::ADD) == "ADD");
+    REQUIRE(Decoder::GetName(InstructionId::VADD_VX) == "VADD_VX");
+    REQUIRE(Decoder::GetName(InstructionId::C_ADDI4SPN) == "C_ADDI4SPN");
+}
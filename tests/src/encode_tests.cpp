@@ -0,0 +1,87 @@
+#include <catch/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <biscuit/assembler.hpp>
+#include <biscuit/encode.hpp>
+
+using namespace biscuit;
+
+namespace {
+// Encoded entirely at compile time.
+constexpr std::array<uint32_t, 6> stub = {
+    encode::LD(a0, 8, s1),
+    encode::ADDI(a0, a0, -1),
+    encode::SD(a0, 8, s1),
+    encode::BNE(a0, x0, -12),
+    encode::JAL(x0, 2048),
+    encode::RET(),
+};
+
+static_assert(stub[0] == 0x0084B503);
+static_assert(stub[1] == 0xFFF50513);
+static_assert(stub[2] == 0x00A4B423);
+static_assert(stub[3] == 0xFE051AE3);
+static_assert(stub[4] == 0x0010006F);
+static_assert(stub[5] == 0x00008067);
+static_assert(encode::CJType(0b101, -2, 0b01) == 0xBFFD); // C.J -2
+} // Anonymous namespace
+
+TEST_CASE("Encoders match the assembler", "[encode]") {
+    Assembler as{256};
+    as.DisableOptimization(Optimization::AutoCompress);
+
+    as.ADD(a0, a1, a2);
+    as.SUBW(t0, t1, t2);
+    as.ADDI(a0, a1, -2048);
+    as.SLLI(a0, a1, 63);
+    as.SRAI(a0, a1, 5);
+    as.SRAIW(a0, a1, 31);
+    as.LUI(a0, 0xFFFFF);
+    as.AUIPC(a0, -1);
+    as.LBU(a0, 2047, sp);
+    as.SW(a0, -4, sp);
+    as.BGEU(a0, a1, -4096);
+    as.JAL(ra, 0x7FFFE);
+    as.JALR(x0, 16, t1);
+    as.MULHSU(a0, a1, a2);
+    as.REMUW(a0, a1, a2);
+
+    const std::array<uint32_t, 15> expected = {
+        encode::ADD(a0, a1, a2),
+        encode::SUBW(t0, t1, t2),
+        encode::ADDI(a0, a1, -2048),
+        encode::SLLI(a0, a1, 63),
+        encode::SRAI(a0, a1, 5),
+        encode::SRAIW(a0, a1, 31),
+        encode::LUI(a0, 0xFFFFF),
+        encode::AUIPC(a0, -1),
+        encode::LBU(a0, 2047, sp),
+        encode::SW(a0, -4, sp),
+        encode::BGEU(a0, a1, -4096),
+        encode::JAL(ra, 0x7FFFE),
+        encode::JALR(x0, 16, t1),
+        encode::MULHSU(a0, a1, a2),
+        encode::REMUW(a0, a1, a2),
+    };
+
+    auto& buffer = as.GetCodeBuffer();
+    REQUIRE(buffer.GetSizeInBytes() == sizeof(expected));
+    REQUIRE(std::memcmp(buffer.GetOffsetPointer(0), expected.data(), sizeof(expected)) == 0);
+}
+
+TEST_CASE("Encoders skip code buffer checks", "[encode]") {
+    Assembler as{64};
+    auto& buffer = as.GetCodeBuffer();
+
+    // Batch-encoding into a reservation only checks the capacity once.
+    {
+        auto reservation = buffer.Reserve(sizeof(stub));
+        for (const auto instruction : stub) {
+            reservation.Emit32(instruction);
+        }
+    }
+
+    REQUIRE(buffer.GetSizeInBytes() == sizeof(stub));
+    REQUIRE(std::memcmp(buffer.GetOffsetPointer(0), stub.data(), sizeof(stub)) == 0);
+}
@@ -0,0 +1,139 @@
+#include <catch/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <biscuit/assembler.hpp>
+#include <biscuit/linker.hpp>
+
+using namespace biscuit;
+
+namespace {
+uint32_t ReadInstruction(uint64_t address) {
+    uint32_t instruction = 0;
+    std::memcpy(&instruction, reinterpret_cast<const void*>(address), sizeof(instruction));
+    return instruction;
+}
+} // Anonymous namespace
+
+TEST_CASE("Linking cross-function references", "[linker]") {
+    Linker linker;
+
+    Assembler first{256};
+    first.CALL(linker.Reference("second"));
+    first.J(linker.Reference("second", 4));
+
+    Assembler second{256};
+    second.ADDI(a0, a0, 1);
+    second.RET();
+    second.J(linker.Reference("first"));
+
+    // Sections may be added in any order.
+    linker.AddSection("second", second);
+    linker.AddSection("first", first);
+
+    std::array<uint32_t, 64> data{};
+    CodeBuffer buffer{reinterpret_cast<uint8_t*>(data.data()), sizeof(data)};
+    REQUIRE(linker.Link(buffer) == LinkError::None);
+    REQUIRE(linker.GetNumVeneers() == 0);
+
+    const auto first_address = linker.GetSymbolAddress("first");
+    const auto second_address = linker.GetSymbolAddress("second");
+    REQUIRE(second_address == buffer.GetOffsetAddress(0));
+    REQUIRE(first_address == second_address + 16);
+    REQUIRE(buffer.GetSizeInBytes() == 28);
+    REQUIRE(buffer.HasDirtyRanges());
+
+    const auto first_relocations = first.GetRelocations();
+    auto* const code = reinterpret_cast<const uint8_t*>(first_address);
+    REQUIRE(ReadRelocationTarget(code, first_address, first_relocations[0]) == second_address);
+    REQUIRE(ReadRelocationTarget(code, first_address, first_relocations[1]) == second_address + 4);
+
+    // The code of the sections is otherwise left as is.
+    REQUIRE(ReadInstruction(second_address) == 0x00150513);
+    REQUIRE(ReadInstruction(second_address + 4) == 0x00008067);
+    REQUIRE(ReadInstruction(second_address + 8) == 0x0080006F); // J +8
+}
+
+TEST_CASE("Linking far references through veneers", "[linker]") {
+    Linker linker;
+
+    std::array<uint64_t, 64> data{};
+    CodeBuffer buffer{reinterpret_cast<uint8_t*>(data.data()), sizeof(data)};
+    const auto base = static_cast<uint64_t>(buffer.GetCursorAddress());
+
+    // Far out of range of both AUIPC pairs and JAL.
+    const auto far_function = base ^ 0x4000'0000'0000;
+    const auto near_function = base - 0x1000;
+    linker.DefineSymbol("far", far_function);
+    linker.DefineSymbol("near", near_function);
+
+    Assembler function{256};
+    function.CALL(linker.Reference("far"));
+    function.CALL(linker.Reference("near"));
+    function.J(linker.Reference("far"));
+    linker.AddSection("function", function);
+
+    REQUIRE(linker.Link(buffer) == LinkError::None);
+    REQUIRE(linker.GetNumVeneers() == 2);
+
+    const auto address = linker.GetSymbolAddress("function");
+    const auto relocations = function.GetRelocations();
+    auto* const code = reinterpret_cast<const uint8_t*>(address);
+
+    // The veneers follow the 20 bytes of code, aligned to 8 bytes.
+    const auto veneer_start = (address + 20 + 7) & ~uint64_t{7};
+    REQUIRE(ReadRelocationTarget(code, address, relocations[0]) == veneer_start);
+    REQUIRE(ReadRelocationTarget(code, address, relocations[1]) == near_function);
+    REQUIRE(ReadRelocationTarget(code, address, relocations[2]) == veneer_start + Linker::veneer_size);
+
+    for (const auto veneer : {veneer_start, veneer_start + Linker::veneer_size}) {
+        REQUIRE(ReadInstruction(veneer) == 0x00000317);      // AUIPC t1, 0
+        REQUIRE(ReadInstruction(veneer + 4) == 0x01033303);  // LD t1, 16(t1)
+        REQUIRE(ReadInstruction(veneer + 8) == 0x00030067);  // JR t1
+
+        uint64_t target = 0;
+        std::memcpy(&target, reinterpret_cast<const void*>(veneer + 16), sizeof(target));
+        REQUIRE(target == far_function);
+    }
+}
+
+TEST_CASE("Linking failures", "[linker]") {
+    Linker linker;
+
+    Assembler function{256};
+    function.CALL(linker.Reference("missing"));
+    function.RET();
+    linker.AddSection("function", function);
+
+    std::array<uint32_t, 2> data{};
+    CodeBuffer buffer{reinterpret_cast<uint8_t*>(data.data()), sizeof(data)};
+
+    REQUIRE(linker.Link(buffer) == LinkError::UndefinedSymbol);
+    REQUIRE(linker.GetUndefinedSymbols().size() == 1);
+    REQUIRE(linker.GetUndefinedSymbols()[0] == "missing");
+
+    linker.DefineSymbol("missing", buffer.GetOffsetAddress(0));
+    REQUIRE(linker.GetUndefinedSymbols().empty());
+    REQUIRE(linker.Link(buffer) == LinkError::OutOfSpace);
+    REQUIRE(buffer.GetCursorOffset() == 0);
+}
+
+TEST_CASE("Linking failures with sections larger than the range of a jump", "[linker]") {
+    Linker linker;
+
+    std::array<uint32_t, 2> data{};
+    CodeBuffer buffer{reinterpret_cast<uint8_t*>(data.data()), sizeof(data)};
+    const auto base = static_cast<uint64_t>(buffer.GetCursorAddress());
+    linker.DefineSymbol("far", base ^ 0x4000'0000'0000);
+
+    // The veneer for the jump would be placed after 1MB of code.
+    Assembler function{2 * 1024 * 1024};
+    function.J(linker.Reference("far"));
+    for (size_t i = 0; i < 256 * 1024; i++) {
+        function.NOP();
+    }
+    linker.AddSection("function", function);
+
+    REQUIRE(linker.Link(buffer) == LinkError::VeneerOutOfRange);
+    REQUIRE(buffer.GetCursorOffset() == 0);
+}
@@ -0,0 +1,126 @@
+#include <catch/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <biscuit/assembler.hpp>
+#include <biscuit/stencil.hpp>
+
+using namespace biscuit;
+
+namespace {
+void RequireSameCode(CodeBuffer& stamped, ptrdiff_t offset, Assembler& expected) {
+    const auto& buffer = expected.GetCodeBuffer();
+    REQUIRE(stamped.GetCursorOffset() - offset == buffer.GetCursorOffset());
+    REQUIRE(std::memcmp(stamped.GetOffsetPointer(offset), buffer.GetOffsetPointer(0),
+                        buffer.GetSizeInBytes()) == 0);
+}
+} // Anonymous namespace
+
+TEST_CASE("Stencil register and immediate holes", "[stencil]") {
+    Assembler as{256};
+    as.DisableOptimization(Optimization::AutoCompress);
+
+    StencilBuilder builder{as};
+    as.ADDI(x31, x31, 2047);
+    REQUIRE(builder.Hole("dst", StencilField::Rd) == 0);
+    REQUIRE(builder.Hole("src", StencilField::Rs1) == 1);
+    REQUIRE(builder.Hole("imm", StencilField::IImm) == 2);
+    as.SD(x31, -1, s1);
+    REQUIRE(builder.Hole("dst", StencilField::Rs2) == 0);
+    REQUIRE(builder.Hole("offset", StencilField::SImm) == 3);
+    as.LUI(x31, 0xFFFFF);
+    builder.Hole("dst", StencilField::Rd);
+    REQUIRE(builder.Hole("upper", StencilField::UImm) == 4);
+    as.FMADD_D(f31, f31, f2, f31);
+    builder.Hole("fdst", StencilField::Rd);
+    builder.Hole("fdst", StencilField::Rs3);
+    builder.Hole("src", StencilField::Rs1);
+
+    const Stencil stencil = builder.Build();
+    REQUIRE(stencil.GetNumHoles() == 6);
+    REQUIRE(stencil.GetSizeInBytes() == 16);
+    REQUIRE(stencil.GetHole("offset") == 3);
+    REQUIRE(stencil.GetHole("fdst") == 5);
+
+    // Placeholder bits are cleared out of the template.
+    uint32_t first = 0;
+    std::memcpy(&first, stencil.GetCode().data(), sizeof(first));
+    REQUIRE(first == 0x00000013);
+
+    for (const int64_t imm : {-2048, -1, 0, 1, 2047}) {
+        CodeBuffer buffer{256};
+        buffer.Emit32(0); // Stamps don't have to start at the beginning of the buffer.
+
+        const auto offset = stencil.Stamp(buffer, {a0, a1, imm, imm, 0x12345, f7});
+        REQUIRE(offset == 4);
+
+        Assembler expected{256};
+        expected.DisableOptimization(Optimization::AutoCompress);
+        expected.ADDI(a0, a1, static_cast<int32_t>(imm));
+        expected.SD(a0, static_cast<int32_t>(imm), s1);
+        expected.LUI(a0, 0x12345);
+        expected.FMADD_D(f7, f11, f2, f7);
+        RequireSameCode(buffer, offset, expected);
+    }
+}
+
+TEST_CASE("Stencil branch holes", "[stencil]") {
+    Assembler as{256};
+    as.DisableOptimization(Optimization::AutoCompress);
+
+    StencilBuilder builder{as};
+    Label inner;
+    as.BEQ(a0, x0, &inner);
+    builder.Hole("exit", StencilField::BTarget);
+    as.J(4);
+    builder.Hole("jump", StencilField::JImm);
+    as.Bind(&inner);
+    as.BNE(a0, a1, 0);
+    builder.Hole("branch", StencilField::BImm);
+    as.J(0);
+    builder.Hole("exit", StencilField::JTarget);
+
+    const Stencil stencil = builder.Build();
+
+    CodeBuffer buffer{4096};
+    buffer.Emit32(0x00000013);
+    const auto exit = static_cast<int64_t>(buffer.GetOffsetAddress(0));
+    for (int i = 0; i < 3; i++) {
+        const auto offset = stencil.Stamp(buffer, {exit, -0x80000, 4094});
+        const auto pc = static_cast<int64_t>(buffer.GetOffsetAddress(offset));
+
+        Assembler expected{256};
+        expected.DisableOptimization(Optimization::AutoCompress);
+        expected.BEQ(a0, x0, static_cast<int32_t>(exit - pc));
+        expected.J(-0x80000);
+        expected.BNE(a0, a1, 4094);
+        expected.J(static_cast<int32_t>(exit - (pc + 12)));
+        RequireSameCode(buffer, offset, expected);
+    }
+}
+
+TEST_CASE("Stencil PC-relative pair holes", "[stencil]") {
+    Assembler as{256};
+    as.DisableOptimization(Optimization::AutoCompress);
+
+    StencilBuilder builder{as};
+    as.MV(a0, s0);
+    as.AUIPC(t1, 0x12345);
+    as.JALR(ra, 0x678, t1);
+    builder.Hole("helper", StencilField::PCRelativePair);
+
+    const Stencil stencil = builder.Build();
+
+    CodeBuffer buffer{4096};
+    const auto helper = static_cast<int64_t>(buffer.GetOffsetAddress(0)) + 0x12345FFE;
+    const auto offset = stencil.Stamp(buffer, {helper});
+    const auto auipc_pc = static_cast<int64_t>(buffer.GetOffsetAddress(offset + 4));
+    const auto relative = helper - auipc_pc;
+
+    Assembler expected{256};
+    expected.DisableOptimization(Optimization::AutoCompress);
+    expected.MV(a0, s0);
+    expected.AUIPC(t1, static_cast<int32_t>((relative + 0x800) >> 12));
+    expected.JALR(ra, static_cast<int32_t>(static_cast<uint32_t>(relative) << 20) >> 20, t1);
+    RequireSameCode(buffer, offset, expected);
+}